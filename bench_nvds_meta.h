@@ -0,0 +1,57 @@
+#ifndef BENCH_NVDS_META_H
+#define BENCH_NVDS_META_H
+
+// udpmulticast_bench 使用的 DeepStream 元数据替身。
+// 只保留 render 实际访问的字段，链表结构与 NvDsMetaList（GList）一致，
+// 使基准在没有 GPU / DeepStream 的机器上也能走与插件相同的遍历路径。
+
+#define BENCH_MAX_LABEL_SIZE 128
+
+struct NvDsMetaList
+{
+    void         *data;
+    NvDsMetaList *next;
+    NvDsMetaList *prev;
+};
+
+struct NvOSD_RectParams
+{
+    float left;
+    float top;
+    float width;
+    float height;
+};
+
+struct NvDsLabelInfo
+{
+    unsigned int result_class_id;
+    float        result_prob;
+};
+
+struct NvDsClassifierMeta
+{
+    NvDsMetaList *label_info_list;
+};
+
+struct NvDsObjectMeta
+{
+    int              class_id;
+    float            confidence;
+    NvOSD_RectParams rect_params;
+    char             obj_label[BENCH_MAX_LABEL_SIZE];
+    NvDsMetaList    *classifier_meta_list;
+};
+
+struct NvDsFrameMeta
+{
+    unsigned int  pad_index;
+    int           frame_num;
+    NvDsMetaList *obj_meta_list;
+};
+
+struct NvDsBatchMeta
+{
+    NvDsMetaList *frame_meta_list;
+};
+
+#endif // BENCH_NVDS_META_H
@@ -0,0 +1,214 @@
+#include "eo_protocol_parser.h"
+#include "target_label_map.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <sys/time.h>
+
+// render 逐帧处理路径的微基准：原实现（每帧都构造目标、逐目标取时间、
+// std::map 统计、字符串比较映射标签）与现实现（仅发送帧构造目标、每帧取一次时间、
+// 定长数组统计、TargetLabelMap 查表）对比。
+// 上游 60 fps、上报 25 fps，每帧 20 个目标。
+
+namespace
+{
+const int kFrames = 200000;
+const int kObjectsPerFrame = 20;
+const int kMaxClasses = 128;
+
+struct FakeObject
+{
+    int   class_id;
+    int   result_class_id;
+    float left;
+    float width;
+    float height;
+    float confidence;
+    char  label[128];
+};
+
+struct MapAnalysis
+{
+    uint64_t                     frameNum;
+    std::map<uint16_t, unsigned> primaryClassCountMap;
+    std::map<uint16_t, unsigned> secondaryClassCountMap;
+    uint16_t                     minPixel;
+    uint16_t                     meanPixel;
+};
+
+struct FlatAnalysis
+{
+    uint64_t frameNum;
+    unsigned primaryClassCount[kMaxClasses];
+    unsigned secondaryClassCount[kMaxClasses];
+    unsigned primaryClassOverflow;
+    unsigned secondaryClassOverflow;
+    uint16_t minPixel;
+    uint16_t meanPixel;
+};
+
+void FillTimestamp(EOTargetInfo &t, const struct timeval &tv)
+{
+    struct tm tm_info;
+    localtime_r(&tv.tv_sec, &tm_info);
+    t.yr = tm_info.tm_year + 1900;
+    t.mo = tm_info.tm_mon + 1;
+    t.dy = tm_info.tm_mday;
+    t.h = tm_info.tm_hour;
+    t.min = tm_info.tm_min;
+    t.sec = tm_info.tm_sec;
+    t.msec = tv.tv_usec / 1000.0f;
+}
+
+void FillTarget(EOTargetInfo &t, const FakeObject &o, unsigned source_id)
+{
+    t.tar_rect = (int)(o.left + o.width / 2);
+    t.source_id = source_id;
+    const bool person = strcmp(o.label, "person") == 0;
+    t.tar_category = person ? static_cast<int>(TargetClass::PEDESTRIAN)
+                            : static_cast<int>(TargetClass::UAV);
+    t.tar_iden = person ? "person" : "无人机";
+    t.tar_cfid = o.confidence;
+    t.trk_stat = (o.confidence < 0.0f) ? 2 : 1;
+}
+
+void FillTarget(EOTargetInfo &t, const FakeObject &o, unsigned source_id,
+                TargetLabelMap &label_map)
+{
+    const TargetLabelEntry &entry = label_map.Lookup(o.class_id, o.label);
+    t.tar_rect = (int)(o.left + o.width / 2);
+    t.source_id = source_id;
+    t.tar_category = entry.tar_category;
+    t.tar_iden = entry.tar_iden;
+    t.tar_cfid = o.confidence;
+    t.trk_stat = (o.confidence < 0.0f) ? 2 : 1;
+}
+
+bool ShouldSend(int frame)
+{
+    // 60 fps 输入按 25 fps 上报
+    return (frame * 25) / 60 != ((frame - 1) * 25) / 60;
+}
+
+// 原实现
+size_t LegacyFrame(const FakeObject *objects, int frame)
+{
+    std::vector<EOTargetInfo> target_infos;
+    MapAnalysis               analysis = {};
+    uint64_t                  pixel_sum = 0;
+    struct timeval            tv;
+
+    gettimeofday(&tv, NULL);
+    const bool should_send = ShouldSend(frame);
+    analysis.minPixel = 0xffff;
+    for (int i = 0; i < kObjectsPerFrame; ++i)
+    {
+        const FakeObject &o = objects[i];
+        analysis.primaryClassCountMap[o.class_id]++;
+        analysis.secondaryClassCountMap[o.result_class_id]++;
+        uint32_t pixel = (uint32_t)(o.width * o.height);
+        if (pixel < analysis.minPixel)
+            analysis.minPixel = (uint16_t)std::min<uint32_t>(pixel, 0xffff);
+        pixel_sum += pixel;
+
+        EOTargetInfo t = {};
+        struct timeval obj_tv;
+        gettimeofday(&obj_tv, NULL);
+        FillTimestamp(t, obj_tv);
+        FillTarget(t, o, 0);
+        target_infos.push_back(t);
+    }
+    analysis.meanPixel = (uint16_t)(pixel_sum / kObjectsPerFrame);
+    return (should_send ? target_infos.size() : 0) + analysis.meanPixel +
+           analysis.primaryClassCountMap.size();
+}
+
+// 现实现
+size_t FlatFrame(const FakeObject *objects, int frame,
+                 std::vector<EOTargetInfo> &target_infos,
+                 TargetLabelMap            &label_map)
+{
+    FlatAnalysis   analysis;
+    uint64_t       pixel_sum = 0;
+    struct timeval tv;
+    EOTargetInfo   stamp = {};
+
+    gettimeofday(&tv, NULL);
+    const bool should_send = ShouldSend(frame);
+    if (should_send)
+    {
+        FillTimestamp(stamp, tv);
+        target_infos.clear();
+    }
+    memset(&analysis, 0, sizeof(analysis));
+    analysis.minPixel = 0xffff;
+    for (int i = 0; i < kObjectsPerFrame; ++i)
+    {
+        const FakeObject &o = objects[i];
+        if ((unsigned)o.class_id < kMaxClasses)
+            analysis.primaryClassCount[o.class_id]++;
+        else
+            analysis.primaryClassOverflow++;
+        if ((unsigned)o.result_class_id < kMaxClasses)
+            analysis.secondaryClassCount[o.result_class_id]++;
+        else
+            analysis.secondaryClassOverflow++;
+        uint32_t pixel = (uint32_t)(o.width * o.height);
+        if (pixel < analysis.minPixel)
+            analysis.minPixel = (uint16_t)std::min<uint32_t>(pixel, 0xffff);
+        pixel_sum += pixel;
+
+        if (!should_send)
+            continue;
+        target_infos.emplace_back(stamp);
+        FillTarget(target_infos.back(), o, 0, label_map);
+    }
+    analysis.meanPixel = (uint16_t)(pixel_sum / kObjectsPerFrame);
+    return (should_send ? target_infos.size() : 0) + analysis.meanPixel +
+           analysis.primaryClassCount[objects[0].class_id];
+}
+
+template <typename F> double MeasureNsPerFrame(F frameFunc)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (int frame = 1; frame <= kFrames; ++frame)
+    {
+        frameFunc(frame);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() /
+           kFrames;
+}
+} // namespace
+
+int main()
+{
+    FakeObject objects[kObjectsPerFrame];
+    for (int i = 0; i < kObjectsPerFrame; ++i)
+    {
+        objects[i].class_id = i % 4;
+        objects[i].result_class_id = (i * 7) % 11;
+        objects[i].left = 100.0f * i;
+        objects[i].width = 20.0f + i;
+        objects[i].height = 30.0f + i;
+        objects[i].confidence = 0.5f + i * 0.01f;
+        snprintf(objects[i].label, sizeof(objects[i].label), "%s",
+                 (i % 2) ? "uav" : "person");
+    }
+
+    volatile size_t           sink = 0;
+    std::vector<EOTargetInfo> target_infos;
+    TargetLabelMap            label_map;
+    double legacy = MeasureNsPerFrame([&](int frame)
+                                      { sink += LegacyFrame(objects, frame); });
+    double flat = MeasureNsPerFrame(
+        [&](int frame) { sink += FlatFrame(objects, frame, target_infos, label_map); });
+
+    printf("legacy render path: %8.1f ns/frame\n", legacy);
+    printf("current render path: %7.1f ns/frame (%.1fx)\n", flat,
+           legacy / flat);
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "destination_router.h"
+#include "spec_parser.h"
+#include "udp_address.h"
+#include <net/if.h>
+
+namespace
+{
+// 读取到任一分隔符（或末尾）之前的内容，去掉首尾空白
+std::string ReadToken(const std::string &text, size_t &pos, const char *delimiters)
+{
+    SkipSpaces(text, pos);
+    const size_t end = text.find_first_of(delimiters, pos);
+    std::string  token = text.substr(pos, end == std::string::npos ? std::string::npos
+                                                                    : end - pos);
+    pos = (end == std::string::npos) ? text.size() : end;
+    while (!token.empty() && (token.back() == ' ' || token.back() == '\t'))
+        token.pop_back();
+    return token;
+}
+} // namespace
+
+bool DestinationRouter::SetDestinations(const std::string &spec, std::string &error)
+{
+    std::vector<Destination> destinations;
+    size_t                   pos = 0;
+
+    SkipSpaces(spec, pos);
+    while (pos < spec.size())
+    {
+        Destination destination;
+        const size_t start = pos;
+        SkipSpaces(spec, pos);
+        if (pos < spec.size() && spec[pos] == '[')
+        {
+            // IPv6 地址写在方括号内："[ff15::1]:5000"
+            const size_t close = spec.find(']', pos);
+            if (close == std::string::npos)
+            {
+                error = "missing ']' at offset " + std::to_string(pos);
+                return false;
+            }
+            destination.host = spec.substr(pos + 1, close - pos - 1);
+            pos = close + 1;
+        }
+        else
+        {
+            destination.host = ReadToken(spec, pos, ":,");
+        }
+        UdpAddress  address;
+        std::string address_error;
+        if (destination.host.empty() || pos >= spec.size() || spec[pos] != ':' ||
+            !ParseUdpAddress(destination.host, 0, "", address, address_error))
+        {
+            error = "expected ipv4:port or [ipv6]:port at offset " + std::to_string(start);
+            return false;
+        }
+        ++pos;
+        if (!ParseUnsigned(spec, pos, 65535, destination.port) || destination.port == 0)
+        {
+            error = "invalid port at offset " + std::to_string(pos);
+            return false;
+        }
+        if (pos < spec.size() && spec[pos] == '/')
+        {
+            ++pos;
+            destination.iface = ReadToken(spec, pos, ",");
+            if (destination.iface.empty() || destination.iface.size() >= IFNAMSIZ)
+            {
+                error = "invalid interface name at offset " + std::to_string(pos);
+                return false;
+            }
+        }
+        if (!ParseSpecSeparator(spec, pos, ',', error))
+            return false;
+        if (destinations.size() == kMaxDestinations)
+        {
+            error = "more than " + std::to_string(kMaxDestinations) + " destinations";
+            return false;
+        }
+        destinations.push_back(destination);
+    }
+
+    destinations_.swap(destinations);
+    routes_.clear();
+    all_ = destinations_.empty()
+               ? 1u
+               : static_cast<uint32_t>((uint64_t(1) << destinations_.size()) - 1);
+    return true;
+}
+
+bool DestinationRouter::SetRoutes(const std::string &spec, std::string &error)
+{
+    std::vector<uint32_t> routes;
+    size_t                pos = 0;
+
+    SkipSpaces(spec, pos);
+    if (pos < spec.size() && destinations_.empty())
+    {
+        error = "routes need a destinations list";
+        return false;
+    }
+    while (pos < spec.size())
+    {
+        unsigned source_id;
+        if (!ParseSpecKey(spec, pos, kMaxSourceId, "source_id:destination", source_id, error))
+            return false;
+        if (routes.size() <= source_id)
+            routes.resize(source_id + 1, 0);
+        for (;;)
+        {
+            unsigned index;
+            if (!ParseUnsigned(spec, pos, static_cast<unsigned>(destinations_.size() - 1),
+                               index))
+            {
+                error = "invalid destination index at offset " + std::to_string(pos) +
+                        " (0~" + std::to_string(destinations_.size() - 1) + ")";
+                return false;
+            }
+            routes[source_id] |= uint32_t(1) << index;
+            if (pos >= spec.size() || spec[pos] != '|')
+                break;
+            ++pos;
+        }
+        if (!ParseSpecSeparator(spec, pos, ',', error))
+            return false;
+    }
+
+    routes_.swap(routes);
+    return true;
+}
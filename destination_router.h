@@ -0,0 +1,54 @@
+#ifndef DESTINATION_ROUTER_H
+#define DESTINATION_ROUTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 发送目的地
+struct Destination
+{
+    std::string host;  // IPv4 或 IPv6 地址（组播或单播，不含方括号，IPv6 可带 %网卡）
+    unsigned    port;
+    std::string iface; // 发送网卡名，为空时使用插件 iface 属性的网卡
+};
+
+// 多目的地与按视频源路由：目的地列表与 source_id → 目的地的路由表。
+// 报文只编码一次，由 Route() 给出应发往的目的地集合（位掩码，第 i 位对应第 i 个目的地）。
+// 配置完成后只读，可整体作为配置快照发布（运行中修改目的地或路由时重建新对象）。
+class DestinationRouter
+{
+  public:
+    static const size_t kMaxDestinations = 32;
+
+    // 解析目的地列表，格式 "239.1.1.1:5000/eth0,[ff15::1]:6000/eth1,239.2.2.2:6000"，
+    // IPv6 地址写在方括号内，网卡可省略。
+    // 空字符串表示不配置（由调用方使用单一目的地）。失败时返回 false 并给出原因，
+    // 原有配置保持不变；路由表随之清空
+    bool SetDestinations(const std::string &spec, std::string &error);
+
+    // 解析路由表，格式 "0:0,1:0|1,2:1"：source_id 发往 '|' 分隔的目的地下标，
+    // 同一 source_id 可出现多次（取并集）；未列出的视频源发往全部目的地。
+    // 需先配置目的地。失败时返回 false，原有路由保持不变
+    bool SetRoutes(const std::string &spec, std::string &error);
+
+    size_t             size() const { return destinations_.size(); }
+    const Destination &destination(size_t index) const { return destinations_[index]; }
+    bool               routed() const { return !routes_.empty(); }
+
+    // source_id 的目的地掩码。未配置目的地时为 1（调用方的单一目的地）
+    uint32_t Route(unsigned source_id) const
+    {
+        return (source_id < routes_.size() && routes_[source_id] != 0) ? routes_[source_id]
+                                                                       : all_;
+    }
+    uint32_t all() const { return all_; }
+
+  private:
+    std::vector<Destination> destinations_;
+    std::vector<uint32_t>    routes_; // source_id → 目的地掩码，0 表示未配置
+    uint32_t                 all_ = 1;
+};
+
+#endif // DESTINATION_ROUTER_H
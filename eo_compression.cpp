@@ -0,0 +1,613 @@
+#include "eo_compression.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+#include <zlib.h>
+
+namespace
+{
+const uint8_t kMagic0 = 0xEC;
+const uint8_t kMagic1 = 0x5A;
+const size_t  kMaxMessageSize = 65535; // 原报文长度字段为 uint16
+
+// LZ4 块格式参数（见 lz4 的 lz4_Block_format.md）
+const unsigned kHashLog = 12;
+const uint32_t kNoPosition = 0xFFFFFFFFu;
+const size_t   kMinMatch = 4;
+const size_t   kLastLiterals = 5;   // 最后 5 字节必须是字面量
+const size_t   kMatchFindLimit = 12; // 最后一个匹配须在块末尾 12 字节之前开始
+const size_t   kMaxOffset = 65535;
+
+const int kDeflateLevel = 6;
+
+// 训练参数：片段长度与候选区间长度
+const size_t kTrainKmer = 8;
+const size_t kTrainSegment = 64;
+
+uint32_t Read32(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+unsigned Lz4Hash(uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+size_t Lz4Bound(size_t length)
+{
+    return length + length / 255 + 16;
+}
+
+uint8_t *WriteLz4Length(uint8_t *op, size_t length)
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+// 写一个序列：token、字面量长度扩展、字面量，matchLength 为 0 时是块末尾只含字面量的序列
+uint8_t *WriteLz4Sequence(uint8_t *op, const uint8_t *literals, size_t literalLength,
+                          size_t offset, size_t matchLength)
+{
+    uint8_t     *token = op++;
+    const size_t match_code = matchLength > 0 ? matchLength - kMinMatch : 0;
+    *token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                  (match_code < 15 ? match_code : 15));
+    if (literalLength >= 15)
+        op = WriteLz4Length(op, literalLength - 15);
+    memcpy(op, literals, literalLength);
+    op += literalLength;
+    if (matchLength == 0)
+        return op;
+    *op++ = static_cast<uint8_t>(offset);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    if (match_code >= 15)
+        op = WriteLz4Length(op, match_code - 15);
+    return op;
+}
+
+void WriteHeader(uint8_t *out, EOCompression codec, uint32_t dictionaryId, size_t length)
+{
+    out[0] = kMagic0;
+    out[1] = kMagic1;
+    out[2] = kEOCompressedVersion;
+    out[3] = static_cast<uint8_t>(codec);
+    for (int i = 0; i < 4; ++i)
+        out[4 + i] = static_cast<uint8_t>(dictionaryId >> (8 * i));
+    out[8] = static_cast<uint8_t>(length);
+    out[9] = static_cast<uint8_t>(length >> 8);
+    out[10] = 0;
+    out[11] = 0;
+}
+} // namespace
+
+uint32_t EODictionaryId(const uint8_t *dictionary, size_t length)
+{
+    if (length == 0)
+        return 0;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ dictionary[i]) * 16777619u;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+bool IsEOCompressedMessage(const uint8_t *data, size_t length)
+{
+    return data != nullptr && length >= kEOCompressedHeaderSize && data[0] == kMagic0 &&
+           data[1] == kMagic1;
+}
+
+bool EOLoadDictionaryFile(const char *path, std::vector<uint8_t> &dictionary, std::string &error)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        error = std::string("cannot open ") + path + ": " + strerror(errno);
+        return false;
+    }
+    std::vector<uint8_t> content;
+    uint8_t              chunk[4096];
+    size_t               n = 0;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        content.insert(content.end(), chunk, chunk + n);
+    }
+    fclose(file);
+    if (content.empty())
+    {
+        error = std::string(path) + " is empty";
+        return false;
+    }
+    const size_t keep = std::min(content.size(), kEOMaxDictionarySize);
+    dictionary.assign(content.end() - static_cast<std::ptrdiff_t>(keep), content.end());
+    return true;
+}
+
+bool EOReadCaptureFile(const char *path, std::vector<std::vector<uint8_t>> &samples,
+                       std::string &error)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        error = std::string("cannot open ") + path + ": " + strerror(errno);
+        return false;
+    }
+    samples.clear();
+    uint8_t prefix[4];
+    size_t  n = 0;
+    while ((n = fread(prefix, 1, sizeof(prefix), file)) == sizeof(prefix))
+    {
+        const size_t length = prefix[0] | (prefix[1] << 8) | (prefix[2] << 16) |
+                              (static_cast<size_t>(prefix[3]) << 24);
+        if (length == 0 || length > kMaxMessageSize)
+        {
+            error = "record " + std::to_string(samples.size()) + " has invalid length " +
+                    std::to_string(length);
+            fclose(file);
+            return false;
+        }
+        samples.emplace_back(length);
+        if (fread(samples.back().data(), 1, length, file) != length)
+        {
+            error = "record " + std::to_string(samples.size() - 1) + " is truncated";
+            fclose(file);
+            return false;
+        }
+    }
+    fclose(file);
+    if (n != 0)
+    {
+        error = "trailing bytes after record " + std::to_string(samples.size());
+        return false;
+    }
+    return true;
+}
+
+bool EOAppendCaptureRecord(FILE *file, const uint8_t *data, size_t length)
+{
+    const uint8_t prefix[4] = {static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8),
+                               static_cast<uint8_t>(length >> 16),
+                               static_cast<uint8_t>(length >> 24)};
+    return fwrite(prefix, 1, sizeof(prefix), file) == sizeof(prefix) &&
+           fwrite(data, 1, length, file) == length;
+}
+
+std::vector<uint8_t> EOTrainDictionary(const std::vector<std::vector<uint8_t>> &samples,
+                                       size_t dictionarySize)
+{
+    std::vector<uint8_t> dictionary;
+    dictionarySize = std::min(dictionarySize, kEOMaxDictionarySize);
+    size_t total = 0;
+    for (const std::vector<uint8_t> &sample : samples)
+        total += sample.size();
+    if (dictionarySize == 0 || total == 0)
+        return dictionary;
+    if (total <= dictionarySize)
+    {
+        for (const std::vector<uint8_t> &sample : samples)
+            dictionary.insert(dictionary.end(), sample.begin(), sample.end());
+        return dictionary;
+    }
+
+    // 1. 各 8 字节片段出现在多少个样本中；片段跨样本边界的位置记为无片段
+    struct Kmer
+    {
+        uint32_t id;
+        uint32_t last_sample;
+    };
+    std::unordered_map<uint64_t, Kmer> kmers;
+    std::vector<uint32_t>              counts;
+    std::vector<uint8_t>               all;
+    std::vector<uint32_t>              position_kmer; // all 中每个位置的片段编号
+    const uint32_t                     kNoKmer = 0xFFFFFFFFu;
+    all.reserve(total);
+    position_kmer.reserve(total);
+    for (size_t s = 0; s < samples.size(); ++s)
+    {
+        const std::vector<uint8_t> &sample = samples[s];
+        for (size_t p = 0; p < sample.size(); ++p)
+        {
+            all.push_back(sample[p]);
+            if (p + kTrainKmer > sample.size())
+            {
+                position_kmer.push_back(kNoKmer);
+                continue;
+            }
+            uint64_t key;
+            memcpy(&key, sample.data() + p, kTrainKmer);
+            auto inserted = kmers.emplace(key, Kmer{static_cast<uint32_t>(counts.size()), 0});
+            Kmer &kmer = inserted.first->second;
+            if (inserted.second)
+                counts.push_back(0);
+            if (kmer.last_sample != s + 1)
+            {
+                kmer.last_sample = static_cast<uint32_t>(s + 1);
+                ++counts[kmer.id];
+            }
+            position_kmer.push_back(kmer.id);
+        }
+    }
+
+    // 2. 均分为若干段，每段选出片段得分之和最高的区间，选中后其片段计数清零，避免重复入选
+    struct Segment
+    {
+        uint64_t score;
+        size_t   begin;
+    };
+    std::vector<Segment> segments;
+    const size_t         epochs = std::max<size_t>(1, dictionarySize / kTrainSegment);
+    const size_t         epoch_size = std::max(total / epochs, kTrainSegment);
+    for (size_t epoch_begin = 0; epoch_begin + kTrainSegment <= total; epoch_begin += epoch_size)
+    {
+        const size_t epoch_end = std::min(total, epoch_begin + epoch_size);
+        const size_t window = kTrainSegment - kTrainKmer + 1; // 区间内的片段起点数
+        uint64_t     score = 0;
+        Segment      best = {0, 0};
+        for (size_t p = epoch_begin; p < epoch_end; ++p)
+        {
+            if (position_kmer[p] != kNoKmer)
+                score += counts[position_kmer[p]];
+            if (p >= epoch_begin + window && position_kmer[p - window] != kNoKmer)
+                score -= counts[position_kmer[p - window]];
+            const size_t begin = p + 1 - std::min(window, p + 1 - epoch_begin);
+            if (p + 1 - epoch_begin >= window && begin + kTrainSegment <= total &&
+                score > best.score)
+            {
+                best.score = score;
+                best.begin = begin;
+            }
+        }
+        if (best.score <= 1)
+            continue; // 只在单个样本中出现的区间对其他报文没有帮助
+        segments.push_back(best);
+        for (size_t p = best.begin; p < best.begin + window; ++p)
+        {
+            if (position_kmer[p] != kNoKmer)
+                counts[position_kmer[p]] = 0;
+        }
+    }
+
+    // 3. 得分高的放在末尾；超出大小时丢弃得分最低的
+    std::sort(segments.begin(), segments.end(),
+              [](const Segment &a, const Segment &b) { return a.score < b.score; });
+    const size_t keep = std::min(segments.size(), dictionarySize / kTrainSegment);
+    for (size_t i = segments.size() - keep; i < segments.size(); ++i)
+    {
+        const uint8_t *begin = all.data() + segments[i].begin;
+        dictionary.insert(dictionary.end(), begin, begin + kTrainSegment);
+    }
+    return dictionary;
+}
+
+EOCompressor::EOCompressor() = default;
+
+EOCompressor::~EOCompressor()
+{
+    if (deflate_ != nullptr)
+    {
+        deflateEnd(deflate_);
+        delete deflate_;
+    }
+}
+
+bool EOCompressor::Configure(EOCompression codec, const std::vector<uint8_t> &dictionary,
+                             std::string &error)
+{
+    if (codec != EOCompression::NONE && codec != EOCompression::LZ4 &&
+        codec != EOCompression::DEFLATE)
+    {
+        error = "unknown compression " + std::to_string(static_cast<int>(codec));
+        return false;
+    }
+    if (dictionary.size() > kEOMaxDictionarySize)
+    {
+        error = "dictionary larger than " + std::to_string(kEOMaxDictionarySize) + " bytes";
+        return false;
+    }
+    if (codec == EOCompression::DEFLATE && deflate_ == nullptr)
+    {
+        z_stream *stream = new z_stream();
+        if (deflateInit2(stream, kDeflateLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            delete stream;
+            error = "deflateInit2 failed";
+            return false;
+        }
+        deflate_ = stream;
+    }
+
+    codec_ = codec;
+    dictionary_ = dictionary;
+    dictionary_id_ = EODictionaryId(dictionary_.data(), dictionary_.size());
+    output_.resize(kEOCompressedHeaderSize + Lz4Bound(kMaxMessageSize));
+    if (codec_ != EOCompression::LZ4)
+        return true;
+
+    window_.resize(dictionary_.size() + kMaxMessageSize);
+    if (!dictionary_.empty())
+        memcpy(window_.data(), dictionary_.data(), dictionary_.size());
+    dict_table_.assign(size_t(1) << kHashLog, kNoPosition);
+    for (size_t p = 0; p + kMinMatch <= dictionary_.size(); ++p)
+    {
+        dict_table_[Lz4Hash(Read32(window_.data() + p))] = static_cast<uint32_t>(p);
+    }
+    table_.resize(dict_table_.size());
+    return true;
+}
+
+size_t EOCompressor::Compress(const uint8_t *data, size_t length)
+{
+    if (codec_ == EOCompression::NONE || length <= kEOCompressedHeaderSize + 1 ||
+        length > kMaxMessageSize)
+    {
+        return 0;
+    }
+    uint8_t *out = output_.data() + kEOCompressedHeaderSize;
+    size_t   size = (codec_ == EOCompression::LZ4)
+                        ? CompressLz4(data, length, out)
+                        : CompressDeflate(data, length, out, length - kEOCompressedHeaderSize - 1);
+    if (size == 0 || kEOCompressedHeaderSize + size >= length)
+    {
+        return 0;
+    }
+    WriteHeader(output_.data(), codec_, dictionary_id_, length);
+    return kEOCompressedHeaderSize + size;
+}
+
+size_t EOCompressor::CompressLz4(const uint8_t *data, size_t length, uint8_t *out)
+{
+    // 报文接在字典之后，匹配可以引用字典；哈希表从只含字典位置的状态开始
+    const size_t dict = dictionary_.size();
+    memcpy(window_.data() + dict, data, length);
+    memcpy(table_.data(), dict_table_.data(), table_.size() * sizeof(uint32_t));
+
+    const uint8_t *base = window_.data();
+    const uint8_t *ip = base + dict;
+    const uint8_t *anchor = ip;
+    const uint8_t *end = ip + length;
+    uint8_t       *op = out;
+    if (length > kMatchFindLimit)
+    {
+        const uint8_t *mflimit = end - kMatchFindLimit;
+        const uint8_t *matchlimit = end - kLastLiterals;
+        while (ip <= mflimit)
+        {
+            const uint32_t sequence = Read32(ip);
+            const unsigned h = Lz4Hash(sequence);
+            const uint32_t candidate = table_[h];
+            const uint32_t position = static_cast<uint32_t>(ip - base);
+            table_[h] = position;
+            if (candidate == kNoPosition || position - candidate > kMaxOffset ||
+                Read32(base + candidate) != sequence)
+            {
+                ++ip;
+                continue;
+            }
+
+            const uint8_t *match = base + candidate;
+            while (ip > anchor && match > base && ip[-1] == match[-1])
+            {
+                --ip;
+                --match;
+            }
+            const uint8_t *p = ip + kMinMatch;
+            const uint8_t *m = match + kMinMatch;
+            while (p < matchlimit && *p == *m)
+            {
+                ++p;
+                ++m;
+            }
+            op = WriteLz4Sequence(op, anchor, static_cast<size_t>(ip - anchor),
+                                  static_cast<size_t>(ip - match), static_cast<size_t>(p - ip));
+            ip = p;
+            anchor = ip;
+            // 匹配末尾附近的位置补入哈希表，提高下一个匹配的命中率
+            table_[Lz4Hash(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - base);
+        }
+    }
+    op = WriteLz4Sequence(op, anchor, static_cast<size_t>(end - anchor), 0, 0);
+    return static_cast<size_t>(op - out);
+}
+
+size_t EOCompressor::CompressDeflate(const uint8_t *data, size_t length, uint8_t *out,
+                                     size_t capacity)
+{
+    if (deflateReset(deflate_) != Z_OK)
+        return 0;
+    if (!dictionary_.empty() &&
+        deflateSetDictionary(deflate_, dictionary_.data(),
+                             static_cast<uInt>(dictionary_.size())) != Z_OK)
+    {
+        return 0;
+    }
+    deflate_->next_in = const_cast<Bytef *>(data);
+    deflate_->avail_in = static_cast<uInt>(length);
+    deflate_->next_out = out;
+    deflate_->avail_out = static_cast<uInt>(capacity);
+    // 输出空间不足（压缩后不够短）时不会返回 Z_STREAM_END
+    if (deflate(deflate_, Z_FINISH) != Z_STREAM_END)
+        return 0;
+    return deflate_->total_out;
+}
+
+EODecompressor::EODecompressor()
+{
+    window_.resize(kMaxMessageSize);
+}
+
+EODecompressor::~EODecompressor()
+{
+    if (inflate_ != nullptr)
+    {
+        inflateEnd(inflate_);
+        delete inflate_;
+    }
+}
+
+void EODecompressor::SetDictionary(const std::vector<uint8_t> &dictionary)
+{
+    const size_t keep = std::min(dictionary.size(), kEOMaxDictionarySize);
+    dictionary_size_ = keep;
+    window_.assign(keep + kMaxMessageSize, 0);
+    if (keep > 0)
+        memcpy(window_.data(), dictionary.data() + dictionary.size() - keep, keep);
+    dictionary_id_ = EODictionaryId(window_.data(), keep);
+}
+
+size_t EODecompressor::Decompress(const uint8_t *data, size_t length)
+{
+    if (!IsEOCompressedMessage(data, length) || data[2] != kEOCompressedVersion)
+    {
+        error_ = "not a compressed datagram";
+        return 0;
+    }
+    const uint32_t dictionary_id = data[4] | (data[5] << 8) | (data[6] << 16) |
+                                   (static_cast<uint32_t>(data[7]) << 24);
+    const size_t   original = data[8] | (data[9] << 8);
+    if (dictionary_id != 0 && dictionary_id != dictionary_id_)
+    {
+        error_ = dictionary_id_ == 0 ? "datagram needs a compression dictionary"
+                                     : "compression dictionary mismatch";
+        return 0;
+    }
+    if (original == 0)
+    {
+        error_ = "empty datagram";
+        return 0;
+    }
+
+    const uint8_t *src = data + kEOCompressedHeaderSize;
+    const size_t   size = length - kEOCompressedHeaderSize;
+    bool           ok = false;
+    const bool     with_dictionary = dictionary_id != 0;
+    switch (static_cast<EOCompression>(data[3]))
+    {
+    case EOCompression::LZ4:
+        ok = DecompressLz4(src, size, original, with_dictionary);
+        break;
+    case EOCompression::DEFLATE:
+        ok = DecompressDeflate(src, size, original, with_dictionary);
+        break;
+    default:
+        error_ = "unknown compression";
+        return 0;
+    }
+    return ok ? original : 0;
+}
+
+bool EODecompressor::DecompressLz4(const uint8_t *src, size_t length, size_t original,
+                                   bool withDictionary)
+{
+    // 每一步都检查输入与输出边界，损坏或恶意构造的报文不会越界
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + length;
+    uint8_t       *out = window_.data() + dictionary_size_;
+    uint8_t       *op = out;
+    uint8_t       *oend = out + original;
+    const uint8_t *lowest = withDictionary ? window_.data() : out;
+    error_ = "corrupt lz4 data";
+    while (ip < iend)
+    {
+        const unsigned token = *ip++;
+        size_t         literals = token >> 4;
+        if (literals == 15)
+        {
+            uint8_t byte = 255;
+            while (byte == 255)
+            {
+                if (ip >= iend)
+                    return false;
+                byte = *ip++;
+                literals += byte;
+            }
+        }
+        if (literals > static_cast<size_t>(iend - ip) ||
+            literals > static_cast<size_t>(oend - op))
+        {
+            return false;
+        }
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == iend)
+            break; // 最后一个序列只有字面量
+
+        if (iend - ip < 2)
+            return false;
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        size_t match = (token & 15) + kMinMatch;
+        if ((token & 15) == 15)
+        {
+            uint8_t byte = 255;
+            while (byte == 255)
+            {
+                if (ip >= iend)
+                    return false;
+                byte = *ip++;
+                match += byte;
+            }
+        }
+        if (offset == 0 || offset > static_cast<size_t>(op - lowest) ||
+            match > static_cast<size_t>(oend - op))
+        {
+            return false;
+        }
+        // 匹配可以与输出重叠（offset < match），须逐字节复制
+        const uint8_t *from = op - offset;
+        for (size_t i = 0; i < match; ++i)
+            op[i] = from[i];
+        op += match;
+    }
+    if (op != oend)
+    {
+        error_ = "lz4 length mismatch";
+        return false;
+    }
+    return true;
+}
+
+bool EODecompressor::DecompressDeflate(const uint8_t *src, size_t length, size_t original,
+                                       bool withDictionary)
+{
+    if (inflate_ == nullptr)
+    {
+        z_stream *stream = new z_stream();
+        if (inflateInit2(stream, -15) != Z_OK)
+        {
+            delete stream;
+            error_ = "inflateInit2 failed";
+            return false;
+        }
+        inflate_ = stream;
+    }
+    error_ = "corrupt deflate data";
+    if (inflateReset(inflate_) != Z_OK)
+        return false;
+    if (withDictionary &&
+        inflateSetDictionary(inflate_, window_.data(), static_cast<uInt>(dictionary_size_)) !=
+            Z_OK)
+    {
+        return false;
+    }
+    inflate_->next_in = const_cast<Bytef *>(src);
+    inflate_->avail_in = static_cast<uInt>(length);
+    inflate_->next_out = window_.data() + dictionary_size_;
+    inflate_->avail_out = static_cast<uInt>(original);
+    if (inflate(inflate_, Z_FINISH) != Z_STREAM_END || inflate_->total_out != original ||
+        inflate_->avail_in != 0)
+    {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef EO_COMPRESSION_H
+#define EO_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+typedef struct z_stream_s z_stream;
+
+// 报文压缩方式，取值即压缩报文头中的方式字段
+enum class EOCompression : uint8_t
+{
+    NONE = 0,    // 不压缩
+    LZ4 = 1,     // LZ4 块格式，字典作为前缀（与 liblz4 的 LZ4_decompress_safe_usingDict 兼容）
+    DEFLATE = 2  // 原始 deflate（zlib windowBits = -15），字典作为预置字典
+};
+
+// 压缩报文：原报文（JSON、二进制、心跳）整体压缩，前加 12 字节报文头，全部多字节字段为小端序：
+//   0   2  魔数 EC 5A
+//   2   1  版本 1
+//   3   1  压缩方式（EOCompression）
+//   4   4  字典 ID（EODictionaryId），0 表示不使用字典
+//   8   2  原报文长度
+//   10  2  保留，填 0
+//   12  -  压缩数据
+static const size_t  kEOCompressedHeaderSize = 12;
+static const uint8_t kEOCompressedVersion = 1;
+// 字典上限：deflate 的预置字典只用最后 32 KB
+static const size_t  kEOMaxDictionarySize = 32 * 1024;
+
+// 字典 ID：字典内容的 FNV-1a 32 位哈希，结果为 0 时取 1；空字典为 0
+uint32_t EODictionaryId(const uint8_t *dictionary, size_t length);
+
+// 判断报文是否为压缩报文
+bool IsEOCompressedMessage(const uint8_t *data, size_t length);
+
+// 从文件读取字典（原始字节，超过 kEOMaxDictionarySize 时只保留末尾部分）
+bool EOLoadDictionaryFile(const char *path, std::vector<uint8_t> &dictionary, std::string &error);
+
+// 抓包文件：依次存放 [长度 uint32 小端][报文内容]，由 recv_multicast.py --capture
+// 或 udpmulticast_bench --capture 写出，供 EOTrainDictionary 训练字典
+bool EOReadCaptureFile(const char *path, std::vector<std::vector<uint8_t>> &samples,
+                       std::string &error);
+bool EOAppendCaptureRecord(FILE *file, const uint8_t *data, size_t length);
+
+// 从样本报文训练共享字典（COVER 方法的简化版）：统计各 8 字节片段出现在多少个样本中，
+// 把样本均分为若干段，每段选出片段覆盖最多的 64 字节区间，按得分从低到高拼接
+// （得分高的靠近字典末尾、距报文最近）。样本总长不超过 dictionarySize 时直接拼接样本
+std::vector<uint8_t> EOTrainDictionary(const std::vector<std::vector<uint8_t>> &samples,
+                                       size_t dictionarySize);
+
+// 报文压缩（发送端）。压缩结果写入内部缓冲，复用容量；非线程安全
+class EOCompressor
+{
+  public:
+    EOCompressor();
+    ~EOCompressor();
+    EOCompressor(const EOCompressor &) = delete;
+    EOCompressor &operator=(const EOCompressor &) = delete;
+
+    // 设置压缩方式与字典（可为空），失败时返回 false 并给出原因，原配置不变
+    bool Configure(EOCompression codec, const std::vector<uint8_t> &dictionary,
+                   std::string &error);
+
+    EOCompression codec() const { return codec_; }
+    uint32_t      dictionary_id() const { return dictionary_id_; }
+
+    // 压缩一个报文，返回压缩报文（含报文头）的长度，结果在 output()；
+    // 未启用、报文为空或过长、压缩后不比原报文短时返回 0，调用方应发送原报文
+    size_t         Compress(const uint8_t *data, size_t length);
+    const uint8_t *output() const { return output_.data(); }
+
+  private:
+    size_t CompressLz4(const uint8_t *data, size_t length, uint8_t *out);
+    size_t CompressDeflate(const uint8_t *data, size_t length, uint8_t *out, size_t capacity);
+
+    EOCompression         codec_ = EOCompression::NONE;
+    std::vector<uint8_t>  dictionary_;
+    uint32_t              dictionary_id_ = 0;
+    std::vector<uint8_t>  window_;     // LZ4：字典 + 当前报文，匹配可引用字典
+    std::vector<uint32_t> dict_table_; // LZ4：只含字典位置的哈希表，每个报文从它开始
+    std::vector<uint32_t> table_;
+    std::vector<uint8_t>  output_;
+    z_stream             *deflate_ = nullptr;
+};
+
+// 报文解压（接收端）。结果写入内部缓冲，复用容量；非线程安全
+class EODecompressor
+{
+  public:
+    EODecompressor();
+    ~EODecompressor();
+    EODecompressor(const EODecompressor &) = delete;
+    EODecompressor &operator=(const EODecompressor &) = delete;
+
+    // 设置字典（可为空）。字典 ID 与报文头不一致的报文解压失败
+    void SetDictionary(const std::vector<uint8_t> &dictionary);
+
+    // 解压一个压缩报文，返回原报文长度，结果在 output()；格式错误、字典不一致或
+    // 数据损坏时返回 0，并在 error() 中给出原因
+    size_t         Decompress(const uint8_t *data, size_t length);
+    const uint8_t *output() const { return window_.data() + dictionary_size_; }
+    const char    *error() const { return error_; }
+
+  private:
+    bool DecompressLz4(const uint8_t *src, size_t length, size_t original, bool withDictionary);
+    bool DecompressDeflate(const uint8_t *src, size_t length, size_t original,
+                           bool withDictionary);
+
+    std::vector<uint8_t> window_; // 字典 + 解压结果，LZ4 匹配可直接引用字典
+    size_t               dictionary_size_ = 0;
+    uint32_t             dictionary_id_ = 0;
+    const char          *error_ = "";
+    z_stream            *inflate_ = nullptr;
+};
+
+#endif // EO_COMPRESSION_H
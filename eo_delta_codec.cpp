@@ -0,0 +1,149 @@
+#include "eo_delta_codec.h"
+
+EODeltaEncoder::EODeltaEncoder(unsigned keyframeInterval)
+    : keyframe_interval_(keyframeInterval)
+{
+}
+
+void EODeltaEncoder::SetKeyframeInterval(unsigned keyframeInterval)
+{
+    keyframe_interval_ = keyframeInterval;
+}
+
+size_t EODeltaEncoder::PackDelta(uint32_t sourceId, const EOTargetInfo *targetInfos,
+                                 size_t count, uint16_t sendCount, uint8_t *buffer,
+                                 size_t capacity, const EOSequence *sequence)
+{
+    if (sourceId >= sources_.size() || count == 0)
+    {
+        return 0;
+    }
+    SourceState &state = sources_[sourceId];
+    if (!state.valid || state.since_keyframe >= keyframe_interval_)
+    {
+        return 0;
+    }
+
+    size_t size = EOProtocolParser::PackEOTargetDeltaMessage(
+        targetInfos, count, state.targets.data(), state.targets.size(), sourceId,
+        sendCount, state.last_sn, buffer, capacity, sequence);
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    state.last_sn = sendCount;
+    ++state.since_keyframe;
+    state.targets.assign(targetInfos, targetInfos + count);
+    return size;
+}
+
+void EODeltaEncoder::CommitKeyframe(uint32_t sourceId, const EOTargetInfo *targetInfos,
+                                    size_t count, uint16_t sendCount)
+{
+    if (sourceId >= kMaxSources || keyframe_interval_ == 0)
+    {
+        return;
+    }
+    if (sourceId >= sources_.size())
+    {
+        sources_.resize(sourceId + 1);
+    }
+
+    SourceState &state = sources_[sourceId];
+    state.valid = count > 0;
+    state.last_sn = sendCount;
+    state.since_keyframe = 0;
+    state.targets.assign(targetInfos, targetInfos + count);
+}
+
+void EODeltaEncoder::Reset()
+{
+    for (SourceState &state : sources_)
+    {
+        state.valid = false;
+    }
+}
+
+EODeltaDecoder::SourceState *EODeltaDecoder::Source(uint32_t sourceId)
+{
+    if (sourceId >= EODeltaEncoder::kMaxSources)
+    {
+        return nullptr;
+    }
+    if (sourceId >= sources_.size())
+    {
+        sources_.resize(sourceId + 1);
+    }
+    return &sources_[sourceId];
+}
+
+void EODeltaDecoder::OnKeyframe(const MessageHeader                &header,
+                                const std::vector<EOTargetInfo> &targets,
+                                bool                             complete)
+{
+    // 聚合报文含多个视频源的目标，不能作为单一视频源的参考帧
+    if (targets.empty() || targets[0].source_id < 0 || header.src_cnt > 0)
+    {
+        return;
+    }
+    SourceState *state = Source(static_cast<uint32_t>(targets[0].source_id));
+    if (state == nullptr)
+    {
+        return;
+    }
+
+    state->valid = complete;
+    state->last_sn = static_cast<uint16_t>(header.msg_sn);
+    if (complete)
+    {
+        state->targets = targets;
+    }
+}
+
+bool EODeltaDecoder::Decode(const uint8_t *data, size_t length, MessageHeader &header,
+                            std::vector<EOTargetInfo> &targets)
+{
+    uint32_t source_id = 0;
+    uint16_t base_sn = 0;
+    if (!EOProtocolParser::ReadEOTargetDeltaInfo(data, length, header, source_id, base_sn))
+    {
+        ++invalid_;
+        return false;
+    }
+
+    SourceState *state = Source(source_id);
+    if (state == nullptr)
+    {
+        ++invalid_;
+        return false;
+    }
+    if (!state->valid || state->last_sn != base_sn)
+    {
+        ++gaps_;
+        state->valid = false;
+        return false;
+    }
+
+    if (!EOProtocolParser::ParseEOTargetDeltaMessage(data, length, state->targets.data(),
+                                                     state->targets.size(), header,
+                                                     targets))
+    {
+        ++invalid_;
+        state->valid = false;
+        return false;
+    }
+
+    ++decoded_;
+    state->last_sn = static_cast<uint16_t>(header.msg_sn);
+    state->targets = targets;
+    return true;
+}
+
+void EODeltaDecoder::Reset()
+{
+    for (SourceState &state : sources_)
+    {
+        state.valid = false;
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef EO_DELTA_CODEC_H
+#define EO_DELTA_CODEC_H
+
+#include "eo_protocol_parser.h"
+#include <cstdint>
+#include <vector>
+
+// 差分帧编解码状态（格式见 eo_protocol_parser.h 中 BodyType::DELTA）。
+// 按视频源保存上一报文的目标作为参考；关键帧为完整的二进制报文。
+// 视频源编号超过 kMaxSources 时不做差分，总是发送关键帧。非线程安全。
+
+// 发送端：决定每个视频源发送关键帧还是差分帧
+class EODeltaEncoder
+{
+  public:
+    // keyframeInterval：两个关键帧之间最多的差分帧数，0 表示不发送差分帧
+    explicit EODeltaEncoder(unsigned keyframeInterval = 25);
+
+    void     SetKeyframeInterval(unsigned keyframeInterval);
+    unsigned keyframe_interval() const { return keyframe_interval_; }
+
+    // 尝试封装差分帧，成功时返回字节数并把本报文记为该视频源的参考。
+    // 需要关键帧时返回0：没有参考、到达关键帧间隔或差分帧超过 capacity。
+    size_t PackDelta(uint32_t sourceId, const EOTargetInfo *targetInfos, size_t count,
+                     uint16_t sendCount, uint8_t *buffer, size_t capacity,
+                     const EOSequence *sequence = nullptr);
+
+    // 记录已发送的关键帧
+    void CommitKeyframe(uint32_t sourceId, const EOTargetInfo *targetInfos,
+                        size_t count, uint16_t sendCount);
+
+    // 丢弃全部参考，下一报文起重新发送关键帧
+    void Reset();
+
+    static const uint32_t kMaxSources = 4096;
+
+  private:
+    struct SourceState
+    {
+        bool                      valid = false;
+        uint16_t                  last_sn = 0;
+        unsigned                  since_keyframe = 0;
+        std::vector<EOTargetInfo> targets;
+    };
+
+    unsigned                 keyframe_interval_;
+    std::vector<SourceState> sources_;
+};
+
+// 接收端：以完整关键帧为参考还原差分帧
+class EODeltaDecoder
+{
+  public:
+    // 记录一条非差分报文；未收齐的分片报文使该视频源失效，直到下一个关键帧
+    void OnKeyframe(const MessageHeader &header, const std::vector<EOTargetInfo> &targets,
+                    bool complete);
+
+    // 还原差分帧并更新参考。base_sn 与上一报文不符（丢包、乱序）或尚无关键帧时
+    // 返回 false，该视频源在下一个关键帧之前的差分帧都会被丢弃
+    bool Decode(const uint8_t *data, size_t length, MessageHeader &header,
+                std::vector<EOTargetInfo> &targets);
+
+    void Reset();
+
+    uint64_t decoded() const { return decoded_; }
+    uint64_t gaps() const { return gaps_; }
+    uint64_t invalid() const { return invalid_; }
+
+  private:
+    struct SourceState
+    {
+        bool                      valid = false;
+        uint16_t                  last_sn = 0;
+        std::vector<EOTargetInfo> targets;
+    };
+
+    SourceState *Source(uint32_t sourceId);
+
+    std::vector<SourceState> sources_;
+    uint64_t                 decoded_ = 0;
+    uint64_t                 gaps_ = 0;
+    uint64_t                 invalid_ = 0;
+};
+
+#endif // EO_DELTA_CODEC_H
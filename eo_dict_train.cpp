@@ -0,0 +1,94 @@
+#include "eo_compression.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// 压缩字典训练工具：从抓包文件训练共享字典，并按 LZ4 / deflate 对比有无字典的压缩率。
+// 每 10 个样本留出 1 个不参与训练，压缩率在留出的样本上计算，避免高估字典效果。
+//
+// 用法：eo_dict_train CAPTURE OUT [--size N]
+//   CAPTURE  udpmulticast_bench --capture 或 recv_multicast.py --capture 写出的抓包文件
+//   OUT      字典文件，供插件 compression-dictionary 与接收端使用
+//   --size   字典大小上限（字节），默认 4096，最大 32768
+
+namespace
+{
+const size_t kDefaultDictionarySize = 4096;
+const size_t kHoldOut = 10;
+
+// 压缩后总长 / 原总长，不值得压缩的报文按原长计入
+double Ratio(EOCompression codec, const std::vector<uint8_t> &dictionary,
+             const std::vector<std::vector<uint8_t>> &samples)
+{
+    EOCompressor compressor;
+    std::string  error;
+    compressor.Configure(codec, dictionary, error);
+    size_t original = 0;
+    size_t compressed = 0;
+    for (const std::vector<uint8_t> &sample : samples)
+    {
+        const size_t size = compressor.Compress(sample.data(), sample.size());
+        original += sample.size();
+        compressed += size > 0 ? size : sample.size();
+    }
+    return original > 0 ? static_cast<double>(compressed) / original : 1.0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t dictionary_size = kDefaultDictionarySize;
+    if (argc == 5 && strcmp(argv[3], "--size") == 0)
+        dictionary_size = strtoul(argv[4], NULL, 10);
+    if ((argc != 3 && argc != 5) || dictionary_size == 0 ||
+        dictionary_size > kEOMaxDictionarySize)
+    {
+        fprintf(stderr, "usage: %s CAPTURE OUT [--size N (1..%zu)]\n", argv[0],
+                kEOMaxDictionarySize);
+        return 2;
+    }
+
+    std::vector<std::vector<uint8_t>> samples;
+    std::string                       error;
+    if (!EOReadCaptureFile(argv[1], samples, error))
+    {
+        fprintf(stderr, "%s: %s\n", argv[1], error.c_str());
+        return 1;
+    }
+    std::vector<std::vector<uint8_t>> training;
+    std::vector<std::vector<uint8_t>> evaluation;
+    for (size_t i = 0; i < samples.size(); ++i)
+        (i % kHoldOut == kHoldOut - 1 ? evaluation : training).push_back(samples[i]);
+    if (evaluation.empty())
+        evaluation = training;
+
+    const std::vector<uint8_t> dictionary = EOTrainDictionary(training, dictionary_size);
+    if (dictionary.empty())
+    {
+        fprintf(stderr, "%s: no samples to train on\n", argv[1]);
+        return 1;
+    }
+    FILE *out = fopen(argv[2], "wb");
+    if (out == NULL || fwrite(dictionary.data(), 1, dictionary.size(), out) != dictionary.size())
+    {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        if (out != NULL)
+            fclose(out);
+        return 1;
+    }
+    fclose(out);
+
+    printf("samples:    %zu (%zu for training, %zu for evaluation)\n", samples.size(),
+           training.size(), evaluation.size());
+    printf("dictionary: %zu bytes, id %08x\n", dictionary.size(),
+           EODictionaryId(dictionary.data(), dictionary.size()));
+    printf("lz4:        %.3f -> %.3f with dictionary\n",
+           Ratio(EOCompression::LZ4, std::vector<uint8_t>(), evaluation),
+           Ratio(EOCompression::LZ4, dictionary, evaluation));
+    printf("deflate:    %.3f -> %.3f with dictionary\n",
+           Ratio(EOCompression::DEFLATE, std::vector<uint8_t>(), evaluation),
+           Ratio(EOCompression::DEFLATE, dictionary, evaluation));
+    return 0;
+}
@@ -0,0 +1,495 @@
+#include "eo_fec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// GF(2^8)，本原多项式 x^8 + x^4 + x^3 + x^2 + 1（0x11D）
+struct GaloisTables
+{
+    uint8_t exp[512];
+    uint8_t log[256];
+    uint8_t mul[256][256]; // mul[c] 为乘以 c 的查找表，逐字节乘加只需一次查表
+
+    GaloisTables()
+    {
+        unsigned x = 1;
+        for (unsigned i = 0; i < 255; ++i)
+        {
+            exp[i] = static_cast<uint8_t>(x);
+            log[x] = static_cast<uint8_t>(i);
+            x <<= 1;
+            if (x & 0x100)
+                x ^= 0x11D;
+        }
+        for (unsigned i = 255; i < 512; ++i)
+        {
+            exp[i] = exp[i - 255];
+        }
+        log[0] = 0;
+        for (unsigned a = 0; a < 256; ++a)
+        {
+            for (unsigned b = 0; b < 256; ++b)
+            {
+                mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+            }
+        }
+    }
+};
+
+const GaloisTables &Gf()
+{
+    static const GaloisTables tables;
+    return tables;
+}
+
+uint8_t GfMul(uint8_t a, uint8_t b)
+{
+    return Gf().mul[a][b];
+}
+
+uint8_t GfInv(uint8_t a)
+{
+    const GaloisTables &gf = Gf();
+    return gf.exp[255 - gf.log[a]];
+}
+
+// Cauchy 矩阵系数 1 / (x_j + y_i)：x_j = 255 - j，y_i = i，两组取值不相交，
+// 任意方阵子矩阵均可逆。XOR 方案的系数恒为 1
+uint8_t Coefficient(uint8_t scheme, unsigned parity, unsigned data)
+{
+    if (scheme == 0)
+        return 1;
+    return GfInv(static_cast<uint8_t>((255 - parity) ^ data));
+}
+
+// dst[i] ^= c * src[i]
+void MulAdd(uint8_t *dst, const uint8_t *src, size_t length, uint8_t c)
+{
+    if (c == 0)
+        return;
+    size_t i = 0;
+    if (c == 1)
+    {
+        // 按 8 字节异或，dst 与 src 可能未对齐
+        for (; i + 8 <= length; i += 8)
+        {
+            uint64_t a;
+            uint64_t b;
+            memcpy(&a, dst + i, 8);
+            memcpy(&b, src + i, 8);
+            a ^= b;
+            memcpy(dst + i, &a, 8);
+        }
+        for (; i < length; ++i)
+            dst[i] ^= src[i];
+        return;
+    }
+    // 每 8 字节查表拼成一个字再异或，避免逐字节读写 dst
+    const uint8_t *row = Gf().mul[c];
+    for (; i + 8 <= length; i += 8)
+    {
+        uint8_t product[8];
+        for (size_t b = 0; b < 8; ++b)
+            product[b] = row[src[i + b]];
+        uint64_t a;
+        uint64_t p;
+        memcpy(&a, dst + i, 8);
+        memcpy(&p, product, 8);
+        a ^= p;
+        memcpy(dst + i, &a, 8);
+    }
+    for (; i < length; ++i)
+        dst[i] ^= row[src[i]];
+}
+
+const uint8_t kSchemeXor = 0;
+const uint8_t kSchemeReedSolomon = 1;
+} // namespace
+
+uint32_t EOFecHash(const uint8_t *data, size_t length)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ length;
+    for (size_t i = 0; i < length; i += 8)
+    {
+        // 小端 8 字节一组，末尾不足 8 字节的部分补 0
+        uint64_t word = 0;
+        if (length - i >= 8)
+            memcpy(&word, data + i, 8);
+        else
+            memcpy(&word, data + i, length - i);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    return static_cast<uint32_t>(hash);
+}
+
+bool EOFecEncoder::Configure(unsigned groupSize, unsigned parityCount)
+{
+    if (groupSize > kMaxGroupSize || (groupSize > 0 && (parityCount == 0 || parityCount > kMaxParity)))
+    {
+        return false;
+    }
+    group_size_ = groupSize;
+    parity_count_ = groupSize > 0 ? parityCount : 1;
+    parity_.resize(parity_count_);
+    Reset();
+    return true;
+}
+
+void EOFecEncoder::Reset()
+{
+    entries_.clear();
+    for (std::vector<uint8_t> &parity : parity_)
+    {
+        parity.clear();
+    }
+    group_sn_ = 1;
+    first_ns_ = 0;
+}
+
+size_t EOFecEncoder::overhead() const
+{
+    return EOProtocolParser::GetEOFecParityMessageSize(group_size_, 0);
+}
+
+bool EOFecEncoder::Add(const uint8_t *data, size_t length, int64_t nowNs)
+{
+    if (!enabled() || length == 0 || length > UINT16_MAX)
+    {
+        return false;
+    }
+    if (entries_.empty())
+    {
+        first_ns_ = nowNs;
+    }
+
+    const unsigned index = static_cast<unsigned>(entries_.size());
+    const uint8_t  scheme = (parity_count_ == 1) ? kSchemeXor : kSchemeReedSolomon;
+    for (unsigned j = 0; j < parity_count_; ++j)
+    {
+        // 较短的数据报文按末尾补 0 参与计算，补 0 部分不改变校验
+        std::vector<uint8_t> &parity = parity_[j];
+        if (parity.size() < length)
+            parity.resize(length, 0);
+        MulAdd(parity.data(), data, length, Coefficient(scheme, j, index));
+    }
+    EOFecEntry entry = {static_cast<uint16_t>(length), EOFecHash(data, length)};
+    entries_.push_back(entry);
+    return entries_.size() >= group_size_;
+}
+
+size_t EOFecEncoder::Finish(std::vector<uint8_t> &buffer, size_t offset,
+                            std::vector<EOFragment> &parities)
+{
+    parities.clear();
+    if (entries_.empty())
+    {
+        return 0;
+    }
+
+    EOFecParity info;
+    info.group_sn = group_sn_++;
+    info.data_count = static_cast<uint8_t>(entries_.size());
+    info.parity_count = static_cast<uint8_t>(parity_count_);
+    info.scheme = (parity_count_ == 1) ? kSchemeXor : kSchemeReedSolomon;
+    info.symbol_size = static_cast<uint16_t>(parity_[0].size());
+
+    const size_t size =
+        EOProtocolParser::GetEOFecParityMessageSize(info.data_count, info.symbol_size);
+    if (buffer.size() < offset + size * parity_count_)
+    {
+        buffer.resize(offset + size * parity_count_);
+    }
+    size_t used = 0;
+    for (unsigned j = 0; j < parity_count_; ++j)
+    {
+        info.parity_idx = static_cast<uint8_t>(j);
+        size_t length = EOProtocolParser::PackEOFecParityMessage(
+            info, entries_.data(), parity_[j].data(), buffer.data() + offset + used, size);
+        if (length > 0)
+        {
+            EOFragment fragment = {used, length, 0, 0};
+            parities.push_back(fragment);
+            used += length;
+        }
+        parity_[j].clear();
+    }
+    entries_.clear();
+    return parities.size();
+}
+
+EOFecDecoder::Sender *EOFecDecoder::Find(uint64_t sender)
+{
+    for (Sender &state : senders_)
+    {
+        if (state.id == sender)
+            return &state;
+    }
+    return nullptr;
+}
+
+EOFecDecoder::Datagram *EOFecDecoder::Lookup(Sender &sender, uint16_t length, uint32_t hash)
+{
+    for (Datagram &datagram : sender.ring)
+    {
+        if (datagram.used && datagram.hash == hash && datagram.length == length)
+            return &datagram;
+    }
+    return nullptr;
+}
+
+void EOFecDecoder::Store(Sender &sender, const uint8_t *data, size_t length, uint32_t hash,
+                         bool recovered)
+{
+    Datagram &slot = sender.ring[sender.next];
+    sender.next = (sender.next + 1) % kWindow;
+    slot.used = true;
+    slot.hash = hash;
+    slot.length = static_cast<uint16_t>(length);
+    slot.recovered = recovered;
+    slot.data.assign(data, data + length);
+}
+
+bool EOFecDecoder::OnData(uint64_t sender, const uint8_t *data, size_t length)
+{
+    Sender *state = Find(sender);
+    if (state == nullptr || length == 0 || length > UINT16_MAX)
+    {
+        return true;
+    }
+    const uint32_t hash = EOFecHash(data, length);
+    Datagram      *existing = Lookup(*state, static_cast<uint16_t>(length), hash);
+    if (existing != nullptr && existing->recovered)
+    {
+        existing->recovered = false;
+        return false;
+    }
+    Store(*state, data, length, hash, false);
+    return true;
+}
+
+size_t EOFecDecoder::Missing(Sender &sender, const Group &group, std::vector<size_t> &missing)
+{
+    missing.clear();
+    for (size_t i = 0; i < group.entries.size(); ++i)
+    {
+        if (Lookup(sender, group.entries[i].length, group.entries[i].hash) == nullptr)
+            missing.push_back(i);
+    }
+    return missing.size();
+}
+
+bool EOFecDecoder::OnParity(uint64_t sender, const uint8_t *data, size_t length, int64_t nowNs,
+                            const Output &output)
+{
+    EOFecParity              info;
+    std::vector<EOFecEntry> &entries = entries_;
+    const uint8_t           *symbol = nullptr;
+    if (!EOProtocolParser::ParseEOFecParityMessage(data, length, info, entries, symbol) ||
+        info.data_count > EOFecEncoder::kMaxGroupSize ||
+        info.parity_count > EOFecEncoder::kMaxParity ||
+        (info.scheme == kSchemeXor && info.parity_count != 1) || info.scheme > kSchemeReedSolomon)
+    {
+        return false;
+    }
+
+    Sender *state = Find(sender);
+    if (state == nullptr)
+    {
+        // 第一次收到该发送端的校验报文：此前的数据报文没有缓存，从下一个分组开始处理
+        if (senders_.size() >= kMaxSenders)
+        {
+            return true;
+        }
+        senders_.emplace_back();
+        state = &senders_.back();
+        state->id = sender;
+        state->ring.resize(kWindow);
+        state->first_group = info.group_sn + 1;
+        state->last_parity_ns = nowNs;
+        return true;
+    }
+    state->last_parity_ns = nowNs;
+    if (static_cast<int32_t>(info.group_sn - state->first_group) < 0)
+    {
+        return true;
+    }
+
+    Group *group = nullptr;
+    for (Group &candidate : state->groups)
+    {
+        if (candidate.info.group_sn == info.group_sn)
+        {
+            group = &candidate;
+            break;
+        }
+    }
+    if (group == nullptr)
+    {
+        if (state->groups.size() >= kMaxGroups)
+        {
+            // 最旧的分组提前到期
+            Group &oldest = state->groups.front();
+            if (!oldest.done)
+                unrecoverable_ += Missing(*state, oldest, missing_);
+            state->groups.erase(state->groups.begin());
+        }
+        state->groups.emplace_back();
+        group = &state->groups.back();
+        group->info = info;
+        group->entries = entries;
+        group->symbols.assign(static_cast<size_t>(info.parity_count) * info.symbol_size, 0);
+        group->received.assign(info.parity_count, 0);
+        group->first_ns = nowNs;
+    }
+    else if (group->info.data_count != info.data_count ||
+             group->info.parity_count != info.parity_count ||
+             group->info.symbol_size != info.symbol_size || group->info.scheme != info.scheme)
+    {
+        return false;
+    }
+
+    if (group->done || group->received[info.parity_idx])
+    {
+        return true;
+    }
+    group->received[info.parity_idx] = 1;
+    ++group->received_count;
+    memcpy(group->symbols.data() + static_cast<size_t>(info.parity_idx) * info.symbol_size,
+           symbol, info.symbol_size);
+
+    const size_t lost = Missing(*state, *group, missing_);
+    if (lost == 0)
+    {
+        group->done = true;
+    }
+    else if (lost <= group->received_count)
+    {
+        group->done = true;
+        if (!Recover(*state, *group, output))
+            unrecoverable_ += lost;
+    }
+    return true;
+}
+
+bool EOFecDecoder::Recover(Sender &sender, Group &group, const Output &output)
+{
+    const EOFecParity &info = group.info;
+    const size_t       symbol_size = info.symbol_size;
+    const size_t       lost = missing_.size();
+    const std::vector<size_t> &missing = missing_;
+
+    // 选用前 lost 个已收到的校验报文
+    std::vector<unsigned> rows;
+    for (unsigned j = 0; j < info.parity_count && rows.size() < lost; ++j)
+    {
+        if (group.received[j])
+            rows.push_back(j);
+    }
+
+    // 右端：校验数据减去已收到数据报文的贡献
+    scratch_.assign(lost * symbol_size, 0);
+    for (size_t r = 0; r < lost; ++r)
+    {
+        uint8_t *rhs = scratch_.data() + r * symbol_size;
+        memcpy(rhs, group.symbols.data() + rows[r] * symbol_size, symbol_size);
+        for (size_t i = 0; i < group.entries.size(); ++i)
+        {
+            if (std::find(missing.begin(), missing.end(), i) != missing.end())
+                continue;
+            const Datagram *datagram =
+                Lookup(sender, group.entries[i].length, group.entries[i].hash);
+            MulAdd(rhs, datagram->data.data(), datagram->length,
+                   Coefficient(info.scheme, rows[r], static_cast<unsigned>(i)));
+        }
+    }
+
+    // 系数矩阵求逆（Gauss-Jordan），Cauchy 子矩阵必然可逆
+    std::vector<uint8_t> a(lost * lost);
+    std::vector<uint8_t> inv(lost * lost, 0);
+    for (size_t r = 0; r < lost; ++r)
+    {
+        for (size_t c = 0; c < lost; ++c)
+            a[r * lost + c] =
+                Coefficient(info.scheme, rows[r], static_cast<unsigned>(missing[c]));
+        inv[r * lost + r] = 1;
+    }
+    for (size_t col = 0; col < lost; ++col)
+    {
+        size_t pivot = col;
+        while (pivot < lost && a[pivot * lost + col] == 0)
+            ++pivot;
+        if (pivot == lost)
+            return false;
+        for (size_t c = 0; c < lost; ++c)
+        {
+            std::swap(a[col * lost + c], a[pivot * lost + c]);
+            std::swap(inv[col * lost + c], inv[pivot * lost + c]);
+        }
+        const uint8_t scale = GfInv(a[col * lost + col]);
+        for (size_t c = 0; c < lost; ++c)
+        {
+            a[col * lost + c] = GfMul(a[col * lost + c], scale);
+            inv[col * lost + c] = GfMul(inv[col * lost + c], scale);
+        }
+        for (size_t r = 0; r < lost; ++r)
+        {
+            const uint8_t factor = a[r * lost + col];
+            if (r == col || factor == 0)
+                continue;
+            for (size_t c = 0; c < lost; ++c)
+            {
+                a[r * lost + c] ^= GfMul(factor, a[col * lost + c]);
+                inv[r * lost + c] ^= GfMul(factor, inv[col * lost + c]);
+            }
+        }
+    }
+
+    std::vector<uint8_t> datagram(symbol_size);
+    bool                 ok = true;
+    for (size_t c = 0; c < lost; ++c)
+    {
+        std::fill(datagram.begin(), datagram.end(), 0);
+        for (size_t r = 0; r < lost; ++r)
+        {
+            MulAdd(datagram.data(), scratch_.data() + r * symbol_size, symbol_size,
+                   inv[c * lost + r]);
+        }
+        const EOFecEntry &entry = group.entries[missing[c]];
+        if (EOFecHash(datagram.data(), entry.length) != entry.hash)
+        {
+            ok = false; // 缓存中的同哈希报文并非原报文（哈希碰撞），放弃恢复
+            continue;
+        }
+        Store(sender, datagram.data(), entry.length, entry.hash, true);
+        ++recovered_;
+        output(datagram.data(), entry.length);
+    }
+    return ok;
+}
+
+void EOFecDecoder::Expire(int64_t nowNs)
+{
+    for (size_t s = 0; s < senders_.size();)
+    {
+        Sender &sender = senders_[s];
+        while (!sender.groups.empty() && nowNs - sender.groups.front().first_ns > kTimeoutNs)
+        {
+            Group &group = sender.groups.front();
+            if (!group.done)
+                unrecoverable_ += Missing(sender, group, missing_);
+            sender.groups.erase(sender.groups.begin());
+        }
+        // 发送端停止发送校验报文后不再缓存其数据报文
+        if (sender.groups.empty() && nowNs - sender.last_parity_ns > 10 * kTimeoutNs)
+        {
+            senders_.erase(senders_.begin() + static_cast<std::ptrdiff_t>(s));
+            continue;
+        }
+        ++s;
+    }
+}
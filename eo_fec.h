@@ -0,0 +1,130 @@
+#ifndef EO_FEC_H
+#define EO_FEC_H
+
+#include "eo_protocol_parser.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 数据报文哈希，FEC 校验报文据此标识分组内的数据报文。按小端 8 字节一组
+// （末组补 0）计算：h = 0x9E3779B97F4A7C15 ^ length；每组 h = (h ^ w) * 0xFF51AFD7ED558CCD，
+// h ^= h >> 32；结果取 h 的低 32 位
+uint32_t EOFecHash(const uint8_t *data, size_t length);
+
+// FEC 编码（发送端）：每 group_size 个数据报文生成 parity_count 个校验报文（报文类型 4）。
+// 数据报文原样发送，不支持 FEC 的接收端不受影响。parity_count 为 1 时校验为各报文的 XOR，
+// 否则为 GF(256) 上的 Cauchy Reed-Solomon：分组内任意不超过 parity_count 个报文丢失都可恢复。
+// 校验随数据报文到达增量累加，不保留数据报文副本。非线程安全。
+class EOFecEncoder
+{
+  public:
+    static const unsigned kMaxGroupSize = 64;
+    static const unsigned kMaxParity = 16;
+
+    // groupSize 为 0 表示关闭；超出范围时返回 false，配置不变。同时丢弃未完成的分组
+    bool Configure(unsigned groupSize, unsigned parityCount);
+    // 丢弃未完成的分组，分组序号从 1 重新开始
+    void Reset();
+
+    bool     enabled() const { return group_size_ > 0; }
+    unsigned group_size() const { return group_size_; }
+    unsigned parity_count() const { return parity_count_; }
+    size_t   pending() const { return entries_.size(); }
+    int64_t  first_ns() const { return first_ns_; }
+
+    // 校验报文比分组内最长数据报文多出的字节数。发送端把数据报文限制在
+    // mtu - 28 - overhead() 以内，校验报文就不会超过 mtu
+    size_t overhead() const;
+
+    // 累加一个数据报文，返回 true 表示分组已满，应调用 Finish()
+    bool Add(const uint8_t *data, size_t length, int64_t nowNs);
+
+    // 为当前分组（可以未满）生成校验报文，依次写入 buffer 的 offset 之后，
+    // 各报文相对 offset 的位置写入 parities。返回校验报文数，没有待编码的数据报文时返回 0
+    size_t Finish(std::vector<uint8_t> &buffer, size_t offset,
+                  std::vector<EOFragment> &parities);
+
+  private:
+    unsigned                          group_size_ = 0;
+    unsigned                          parity_count_ = 1;
+    uint32_t                          group_sn_ = 1;
+    int64_t                           first_ns_ = 0;
+    std::vector<EOFecEntry>           entries_;
+    std::vector<std::vector<uint8_t>> parity_; // 按校验报文累加的校验数据
+};
+
+// FEC 解码（接收端）：按发送端缓存最近收到的数据报文，收到校验报文时恢复分组内丢失的报文。
+// 发送端第一次发来校验报文之后才开始缓存，不使用 FEC 的发送端没有额外开销。
+// 恢复出的报文经回调交给调用方按普通报文处理；恢复之后才迟到的原报文由 OnData 返回 false。
+// 非线程安全。
+class EOFecDecoder
+{
+  public:
+    typedef std::function<void(const uint8_t *data, size_t length)> Output;
+
+    // 记录一个数据报文。返回 false 表示该报文此前已由校验恢复，调用方应丢弃
+    bool OnData(uint64_t sender, const uint8_t *data, size_t length);
+
+    // 处理一个校验报文，能恢复时逐个回调恢复出的数据报文。格式错误返回 false
+    bool OnParity(uint64_t sender, const uint8_t *data, size_t length, int64_t nowNs,
+                  const Output &output);
+
+    // 超时仍无法恢复的分组计入 unrecoverable()；长时间无报文的发送端被清除
+    void Expire(int64_t nowNs);
+
+    uint64_t recovered() const { return recovered_; }         // 由校验恢复的数据报文
+    uint64_t unrecoverable() const { return unrecoverable_; } // 丢失且无法恢复的数据报文
+
+    static const size_t  kWindow = 256;   // 每个发送端缓存的数据报文数
+    static const size_t  kMaxGroups = 16; // 每个发送端同时等待的分组数
+    static const size_t  kMaxSenders = 64;
+    static const int64_t kTimeoutNs = 200 * 1000 * 1000LL;
+
+  private:
+    struct Datagram
+    {
+        uint32_t             hash = 0;
+        uint16_t             length = 0;
+        bool                 used = false;
+        bool                 recovered = false; // 由校验恢复，原报文尚未到达
+        std::vector<uint8_t> data;
+    };
+
+    struct Group
+    {
+        EOFecParity             info;
+        std::vector<EOFecEntry> entries;
+        std::vector<uint8_t>    symbols;  // parity_count 个校验数据
+        std::vector<uint8_t>    received; // 按 parity_idx 标记已收到的校验报文
+        size_t                  received_count = 0;
+        int64_t                 first_ns = 0;
+        bool                    done = false;
+    };
+
+    struct Sender
+    {
+        uint64_t              id = 0;
+        std::vector<Datagram> ring;
+        size_t                next = 0;
+        std::vector<Group>    groups;
+        uint32_t              first_group = 0; // 早于该序号的分组缓存不完整，不处理
+        int64_t               last_parity_ns = 0;
+    };
+
+    Sender   *Find(uint64_t sender);
+    Datagram *Lookup(Sender &sender, uint16_t length, uint32_t hash);
+    void      Store(Sender &sender, const uint8_t *data, size_t length, uint32_t hash,
+                    bool recovered);
+    size_t    Missing(Sender &sender, const Group &group, std::vector<size_t> &missing);
+    bool      Recover(Sender &sender, Group &group, const Output &output);
+
+    std::vector<Sender>     senders_;
+    std::vector<EOFecEntry> entries_; // 解析校验报文的缓冲
+    std::vector<size_t>     missing_;
+    std::vector<uint8_t>    scratch_;
+    uint64_t                recovered_ = 0;
+    uint64_t                unrecoverable_ = 0;
+};
+
+#endif // EO_FEC_H
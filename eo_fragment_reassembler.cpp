@@ -0,0 +1,156 @@
+#include "eo_fragment_reassembler.h"
+#include <utility>
+
+EOFragmentReassembler::EOFragmentReassembler(int64_t timeoutNs, size_t maxPending)
+    : timeout_ns_(timeoutNs), slots_(maxPending == 0 ? 1 : maxPending)
+{
+}
+
+size_t EOFragmentReassembler::pending() const
+{
+    size_t count = 0;
+    for (const Pending &slot : slots_)
+    {
+        count += slot.used ? 1 : 0;
+    }
+    return count;
+}
+
+void EOFragmentReassembler::Push(uint64_t sender, const MessageHeader &header,
+                                 std::vector<EOTargetInfo> &targets,
+                                 int64_t nowNs, const Output &output)
+{
+    if (header.frag_cnt <= 1)
+    {
+        output(header, targets, true);
+        return;
+    }
+    if (header.frag_cnt > kMaxFragments || header.frag_idx < 0 ||
+        header.frag_idx >= header.frag_cnt)
+    {
+        ++invalid_fragments_;
+        return;
+    }
+
+    Pending *slot = Find(sender, header.msg_sn);
+    if (slot != nullptr && static_cast<int>(slot->have.size()) != header.frag_cnt)
+    {
+        // msg_sn 回绕后复用：先输出旧报文
+        Emit(*slot, output);
+        slot = nullptr;
+    }
+    if (slot == nullptr)
+    {
+        slot = Allocate(output);
+        slot->used = true;
+        slot->sender = sender;
+        slot->msg_sn = header.msg_sn;
+        slot->received = 0;
+        slot->first_ns = nowNs;
+        slot->header = header;
+        slot->have.assign(header.frag_cnt, 0);
+        if (slot->parts.size() < static_cast<size_t>(header.frag_cnt))
+        {
+            slot->parts.resize(header.frag_cnt);
+        }
+    }
+
+    if (slot->have[header.frag_idx])
+    {
+        return; // 重复分片
+    }
+    slot->have[header.frag_idx] = 1;
+    slot->parts[header.frag_idx].swap(targets);
+    if (++slot->received == header.frag_cnt)
+    {
+        Emit(*slot, output);
+    }
+}
+
+void EOFragmentReassembler::Expire(int64_t nowNs, const Output &output)
+{
+    for (Pending &slot : slots_)
+    {
+        if (slot.used && nowNs - slot.first_ns >= timeout_ns_)
+        {
+            Emit(slot, output);
+        }
+    }
+}
+
+EOFragmentReassembler::Pending *EOFragmentReassembler::Find(uint64_t sender,
+                                                            int      msg_sn)
+{
+    for (Pending &slot : slots_)
+    {
+        if (slot.used && slot.sender == sender && slot.msg_sn == msg_sn)
+        {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+EOFragmentReassembler::Pending *EOFragmentReassembler::Allocate(const Output &output)
+{
+    Pending *oldest = &slots_[0];
+    for (Pending &slot : slots_)
+    {
+        if (!slot.used)
+        {
+            return &slot;
+        }
+        if (slot.first_ns < oldest->first_ns)
+        {
+            oldest = &slot;
+        }
+    }
+    // 槽位用尽：提前输出最早的未完成报文
+    Emit(*oldest, output);
+    return oldest;
+}
+
+void EOFragmentReassembler::Emit(Pending &slot, const Output &output)
+{
+    const int frag_cnt = static_cast<int>(slot.have.size());
+    const bool complete = (slot.received == frag_cnt);
+    size_t     total = 0;
+
+    for (int i = 0; i < frag_cnt; ++i)
+    {
+        if (slot.have[i])
+            total += slot.parts[i].size();
+    }
+
+    // 逐个交换而非拷贝，各分片缓冲区的容量留给后续报文复用
+    merged_.resize(total);
+    size_t next = 0;
+    for (int i = 0; i < frag_cnt; ++i)
+    {
+        if (!slot.have[i])
+            continue;
+        for (EOTargetInfo &target : slot.parts[i])
+        {
+            std::swap(merged_[next++], target);
+        }
+    }
+
+    MessageHeader header = slot.header;
+    header.frag_idx = 0;
+    header.cont_sum = static_cast<int>(total);
+    slot.used = false;
+
+    if (complete)
+    {
+        ++completed_;
+    }
+    else
+    {
+        ++partial_;
+        lost_fragments_ += frag_cnt - slot.received;
+    }
+    if (total > 0)
+    {
+        output(header, merged_, complete);
+    }
+}
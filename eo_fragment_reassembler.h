@@ -0,0 +1,69 @@
+#ifndef EO_FRAGMENT_REASSEMBLER_H
+#define EO_FRAGMENT_REASSEMBLER_H
+
+#include "eo_protocol_parser.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 分片报文重组器（见 EOProtocolParser::PackEOTargetFragments）。
+// 按 (发送端, msg_sn) 缓存分片，收齐后输出完整报文；超时或缓存槽位用尽时
+// 输出已收到的部分，丢包只影响丢失分片内的目标。未分片报文直接输出。
+// 缓存槽位数固定，稳定运行后不再分配内存。非线程安全。
+class EOFragmentReassembler
+{
+  public:
+    // 输出一条报文：header.cont_sum 为实际输出的目标数，complete 表示分片是否收齐
+    using Output = std::function<void(const MessageHeader &,
+                                      const std::vector<EOTargetInfo> &,
+                                      bool complete)>;
+
+    // timeoutNs：首个分片到达后等待其余分片的最长时间；maxPending：同时重组的报文数上限
+    explicit EOFragmentReassembler(int64_t timeoutNs = 100 * 1000000LL,
+                                   size_t  maxPending = 32);
+
+    // 输入一条已解析的报文，targets 的内容会被取走。
+    // sender 区分多个发送端（如源地址与端口），nowNs 为单调时钟纳秒。
+    void Push(uint64_t sender, const MessageHeader &header,
+              std::vector<EOTargetInfo> &targets, int64_t nowNs,
+              const Output &output);
+
+    // 输出所有超时的未完成报文
+    void Expire(int64_t nowNs, const Output &output);
+
+    size_t   pending() const;
+    uint64_t completed() const { return completed_; }
+    uint64_t partial() const { return partial_; }
+    uint64_t lost_fragments() const { return lost_fragments_; }
+    uint64_t invalid_fragments() const { return invalid_fragments_; }
+
+    // 单条报文的分片数上限，超出的分片视为非法
+    static const int kMaxFragments = 4096;
+
+  private:
+    struct Pending
+    {
+        bool                                   used = false;
+        uint64_t                               sender = 0;
+        int                                    msg_sn = 0;
+        int                                    received = 0;
+        int64_t                                first_ns = 0;
+        MessageHeader                          header = {};
+        std::vector<uint8_t>                   have;
+        std::vector<std::vector<EOTargetInfo>> parts;
+    };
+
+    Pending *Find(uint64_t sender, int msg_sn);
+    Pending *Allocate(const Output &output);
+    void     Emit(Pending &slot, const Output &output);
+
+    int64_t                   timeout_ns_;
+    std::vector<Pending>      slots_;
+    std::vector<EOTargetInfo> merged_;
+    uint64_t                  completed_ = 0;
+    uint64_t                  partial_ = 0;
+    uint64_t                  lost_fragments_ = 0;
+    uint64_t                  invalid_fragments_ = 0;
+};
+
+#endif // EO_FRAGMENT_REASSEMBLER_H
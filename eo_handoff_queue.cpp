@@ -0,0 +1,47 @@
+#include "eo_handoff_queue.h"
+
+EODatagramRing::EODatagramRing(size_t slotCount, size_t slotSize)
+    : slot_size_(slotSize),
+      storage_(new uint8_t[(slotCount == 0 ? 1 : slotCount) * slotSize]),
+      slots_(slotCount == 0 ? 1 : slotCount)
+{
+    for (size_t i = 0; i < slots_.size(); ++i)
+    {
+        slots_[i].data = storage_.get() + i * slot_size_;
+        slots_[i].length = 0;
+        slots_[i].sender = 0;
+    }
+}
+
+size_t EODatagramRing::Writable() const
+{
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    return slots_.size() - (tail - head);
+}
+
+EODatagramRing::Slot &EODatagramRing::WriteSlot(size_t index)
+{
+    return slots_[(tail_.load(std::memory_order_relaxed) + index) % slots_.size()];
+}
+
+void EODatagramRing::Commit(size_t count)
+{
+    tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+size_t EODatagramRing::Readable() const
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    return tail_.load(std::memory_order_acquire) - head;
+}
+
+const EODatagramRing::Slot &EODatagramRing::ReadSlot(size_t index) const
+{
+    return slots_[(head_.load(std::memory_order_relaxed) + index) % slots_.size()];
+}
+
+void EODatagramRing::Release(size_t count)
+{
+    head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
@@ -0,0 +1,190 @@
+#ifndef EO_HANDOFF_QUEUE_H
+#define EO_HANDOFF_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// 接收流水线（接收 -> 解析 -> 分发）各级之间的无锁交接结构
+
+// 队列已满时生产者的处理方式
+enum class EOOverflowPolicy
+{
+    DROP = 0, // 丢弃新数据并计数，生产者不等待
+    BLOCK = 1 // 等待消费者腾出空间，压力传递给上一级
+};
+
+// 单生产者单消费者的报文环。槽位在构造时一次分配，接收线程直接把报文
+// 写入槽位（如 recvmmsg 的 iovec），解析线程原地读取，稳定运行后没有拷贝和分配。
+class EODatagramRing
+{
+  public:
+    struct Slot
+    {
+        uint8_t *data;
+        size_t   length;
+        uint64_t sender; // 发送端地址与端口
+    };
+
+    EODatagramRing(size_t slotCount, size_t slotSize);
+
+    // 生产者：可写入的槽位数；WriteSlot(i) 为写入位置之后第 i 个空闲槽位，
+    // 填好 length / sender 后以 Commit(count) 一次发布前 count 个
+    size_t Writable() const;
+    Slot  &WriteSlot(size_t index);
+    void   Commit(size_t count);
+
+    // 消费者：可读取的槽位数；ReadSlot(i) 为读取位置之后第 i 个槽位，
+    // 处理完后以 Release(count) 归还
+    size_t      Readable() const;
+    const Slot &ReadSlot(size_t index) const;
+    void        Release(size_t count);
+
+    size_t slot_count() const { return slots_.size(); }
+    size_t slot_size() const { return slot_size_; }
+
+  private:
+    size_t                     slot_size_;
+    std::unique_ptr<uint8_t[]> storage_;
+    std::vector<Slot>          slots_;
+    // 读写位置单调递增，分处不同缓存行，避免生产者与消费者伪共享
+    std::atomic<size_t> head_{0}; // 消费者
+    char                pad_[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail_{0}; // 生产者
+};
+
+// 有界多生产者单消费者队列（Vyukov 序号槽算法），容量向上取 2 的幂。
+// 元素以 swap 交接：TryPush 换回槽位中上一轮的旧元素，TryPop 换出时交回调用者
+// 的旧元素，容器类成员的容量因此在生产者与消费者之间循环复用。
+template <typename T>
+class EOMpscQueue
+{
+  public:
+    explicit EOMpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // 任意线程调用；队列已满时返回 false，item 保持不变
+    bool TryPush(T &item)
+    {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell  *cell;
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            size_t   sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        std::swap(cell->value, item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅消费者线程调用；队列为空时返回 false
+    bool TryPop(T &item)
+    {
+        Cell  *cell = &cells_[dequeue_pos_ & mask_];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (sequence != dequeue_pos_ + 1)
+        {
+            return false;
+        }
+        std::swap(item, cell->value);
+        cell->sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+    // 仅消费者线程调用
+    bool Empty() const
+    {
+        return cells_[dequeue_pos_ & mask_].sequence.load(std::memory_order_acquire) !=
+               dequeue_pos_ + 1;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T                   value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t                  mask_ = 0;
+    std::atomic<size_t>     enqueue_pos_{0};
+    char                    pad_[64 - sizeof(std::atomic<size_t>)];
+    size_t                  dequeue_pos_ = 0;
+};
+
+// 消费者空闲时休眠、生产者发布后唤醒。生产者在无人等待时只付出一次内存屏障，
+// 不进入互斥锁。单个等待者。
+class EOWakeup
+{
+  public:
+    // 生产者发布数据后调用
+    void Notify()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_.notify_one();
+        }
+    }
+
+    // 消费者：ready() 为 false 时最多等待 timeout
+    template <typename Ready>
+    void WaitFor(Ready ready, std::chrono::microseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiting_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready())
+        {
+            cond_.wait_for(lock, timeout);
+        }
+        waiting_.store(false, std::memory_order_relaxed);
+    }
+
+  private:
+    std::mutex              mutex_;
+    std::condition_variable cond_;
+    std::atomic<bool>       waiting_{false};
+};
+
+#endif // EO_HANDOFF_QUEUE_H
@@ -1,66 +1,3236 @@
 #include "eo_protocol_parser.h"
+#include "eo_target_columns.h"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
-#include <jsoncpp/json/reader.h>
-#include <jsoncpp/json/value.h>
-#include <jsoncpp/json/writer.h>
-#include <memory>
-#include <sstream>
+#include <ostream>
 #include <sys/time.h>
 
+void EOIdenString::assign(const char *text, size_t length)
+{
+    if (length > kCapacity)
+    {
+        // 不拆开 UTF-8 多字节字符：回退到首字节（非 10xxxxxx）之前
+        length = kCapacity;
+        while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80)
+        {
+            --length;
+        }
+    }
+    if (length > 0)
+    {
+        memmove(data_, text, length);
+    }
+    size_ = static_cast<uint8_t>(length);
+}
+
+std::ostream &operator<<(std::ostream &os, const EOIdenString &iden)
+{
+    return os.write(iden.data(), static_cast<std::streamsize>(iden.size()));
+}
+
+namespace
+{
+// 单个数值字段格式化后的最大长度（%.17g 最长形如 -1.2345678901234567e-308）
+constexpr size_t kMaxNumberLength = 32;
+
+// 报文头/单个目标中除 tar_iden 以外部分的长度上限
+constexpr size_t kMaxHeaderJsonSize = 1024;
+constexpr size_t kMaxTargetJsonSize = 1536;
+
+// 按 %.17g 格式化单精度浮点数（精确转换为 double 后的结果，与 snprintf 一致）。
+// float 尾数只有 24 位，定点格式范围内（十进制指数 -4~16）可用 128 位整数精确
+// 算出 17 位有效数字并按偶数舍入，省去 snprintf。返回写入长度；0 值、非规格化数、
+// 非有限值和需要指数格式的值返回 0，由调用方回退到 snprintf。
+size_t FormatFloat17g(float value, char *out)
+{
+#if defined(__SIZEOF_INT128__)
+    typedef unsigned __int128 u128;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint32_t exponent = (bits >> 23) & 0xFF;
+    if (exponent == 0 || exponent == 0xFF || exponent >= 150)
+    {
+        return 0; // 0、非规格化数、非有限值，以及没有小数位的大整数
+    }
+
+    // value = mantissa / 2^shift，shift 为 1~149；小于 1e-4 的值不走此路径
+    const uint32_t mantissa = (bits & 0x7FFFFF) | 0x800000;
+    const unsigned shift = 150 - exponent;
+    if (shift > 64)
+    {
+        return 0;
+    }
+    static const uint64_t kPow10[] = {1ull,
+                                      10ull,
+                                      100ull,
+                                      1000ull,
+                                      10000ull,
+                                      100000ull,
+                                      1000000ull,
+                                      10000000ull,
+                                      100000000ull,
+                                      1000000000ull,
+                                      10000000000ull,
+                                      100000000000ull,
+                                      1000000000000ull,
+                                      10000000000000ull,
+                                      100000000000000ull,
+                                      1000000000000000ull,
+                                      10000000000000000ull,
+                                      100000000000000000ull,
+                                      1000000000000000000ull,
+                                      10000000000000000000ull};
+    const u128 lower = static_cast<u128>(kPow10[16]) << shift;
+    const u128 upper = static_cast<u128>(kPow10[17]) << shift;
+
+    // 十进制指数 d 满足 10^d <= value < 10^(d+1)，即 scaled = value * 10^(16-d) * 2^shift
+    // 落在 [lower, upper)
+    int  d = static_cast<int>(std::floor(std::log10(std::fabs(value))));
+    u128 scaled = 0;
+    for (int attempt = 0; attempt < 3; ++attempt)
+    {
+        if (d < -4 || d > 16)
+        {
+            return 0;
+        }
+        const unsigned power = static_cast<unsigned>(16 - d); // 0~20
+        scaled = static_cast<u128>(mantissa) *
+                 (power < 20 ? static_cast<u128>(kPow10[power])
+                             : static_cast<u128>(kPow10[19]) * 10);
+        if (scaled < lower)
+            --d;
+        else if (scaled >= upper)
+            ++d;
+        else
+            break;
+    }
+    if (scaled < lower || scaled >= upper)
+    {
+        return 0;
+    }
+
+    // 舍入到 17 位有效数字（恰为一半时取偶）
+    uint64_t  digits = static_cast<uint64_t>(scaled >> shift);
+    const u128 rest = scaled & ((static_cast<u128>(1) << shift) - 1);
+    const u128 half = static_cast<u128>(1) << (shift - 1);
+    if (rest > half || (rest == half && (digits & 1)))
+    {
+        ++digits;
+    }
+    if (digits == kPow10[17])
+    {
+        digits = kPow10[16];
+        ++d;
+        if (d > 16)
+        {
+            return 0;
+        }
+    }
+
+    char text[17];
+    for (int i = 16; i >= 0; --i)
+    {
+        text[i] = static_cast<char>('0' + digits % 10);
+        digits /= 10;
+    }
+
+    // 定点格式：小数部分 16-d 位，去掉末尾的 0
+    char *p = out;
+    if (bits >> 31)
+    {
+        *p++ = '-';
+    }
+    const char *fraction;
+    size_t      fraction_length;
+    size_t      leading_zeros = 0;
+    if (d >= 0)
+    {
+        memcpy(p, text, static_cast<size_t>(d) + 1);
+        p += d + 1;
+        fraction = text + d + 1;
+        fraction_length = static_cast<size_t>(16 - d);
+    }
+    else
+    {
+        *p++ = '0';
+        leading_zeros = static_cast<size_t>(-d - 1);
+        fraction = text;
+        fraction_length = 17;
+    }
+    while (fraction_length > 0 && fraction[fraction_length - 1] == '0')
+    {
+        --fraction_length;
+    }
+    if (fraction_length > 0)
+    {
+        *p++ = '.';
+        memset(p, '0', leading_zeros);
+        p += leading_zeros;
+        memcpy(p, fraction, fraction_length);
+        p += fraction_length;
+    }
+    return static_cast<size_t>(p - out);
+#else
+    (void)value;
+    (void)out;
+    return 0;
+#endif
+}
+
+// 流式 JSON 写入器，直接写入调用方缓冲区。
+// 输出格式与 jsoncpp StreamWriterBuilder(indentation="") 逐字节一致：
+// 键按字典序输出、浮点数按 %.17g 格式化、非 ASCII 字符转义为 \uXXXX。
+class JsonStreamWriter
+{
+  public:
+    JsonStreamWriter(uint8_t *buffer, size_t capacity)
+        : cur_(buffer), end_(buffer + capacity), begin_(buffer)
+    {
+    }
+
+    // 写入字面量（键名、分隔符等）
+    template <size_t N> void Literal(const char (&text)[N])
+    {
+        Raw(text, N - 1);
+    }
+
+    void Int(int value) { Int64(value); }
+
+    void Int64(int64_t value)
+    {
+        char     digits[24];
+        char    *p = digits + sizeof(digits);
+        uint64_t magnitude = value < 0 ? 0u - static_cast<uint64_t>(value)
+                                       : static_cast<uint64_t>(value);
+        do
+        {
+            *--p = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0)
+        {
+            *--p = '-';
+        }
+        Raw(p, digits + sizeof(digits) - p);
+    }
+
+    void Double(double value)
+    {
+        if (!std::isfinite(value))
+        {
+            // 与 jsoncpp useSpecialFloats=false 时的输出保持一致
+            if (std::isnan(value))
+                Literal("null");
+            else if (value < 0)
+                Literal("-1e+9999");
+            else
+                Literal("1e+9999");
+            return;
+        }
+
+        // 快速路径：整数值（含最常见的 0.0）无需经过 snprintf
+        if (std::fabs(value) < 1e15 && value == std::trunc(value))
+        {
+            int64_t integral = static_cast<int64_t>(value);
+            if (integral == 0 && std::signbit(value))
+            {
+                Literal("-0.0");
+                return;
+            }
+            char     digits[24];
+            char    *p = digits + sizeof(digits);
+            uint64_t magnitude = integral < 0
+                                     ? 0u - static_cast<uint64_t>(integral)
+                                     : static_cast<uint64_t>(integral);
+            *--p = '0';
+            *--p = '.';
+            do
+            {
+                *--p = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+            if (integral < 0)
+            {
+                *--p = '-';
+            }
+            Raw(p, digits + sizeof(digits) - p);
+            return;
+        }
+
+        char text[kMaxNumberLength];
+        int  len = snprintf(text, sizeof(text), "%.17g", value);
+        if (len <= 0 || static_cast<size_t>(len) >= sizeof(text))
+        {
+            overflow_ = true;
+            return;
+        }
+
+        bool has_point = false;
+        for (int i = 0; i < len; ++i)
+        {
+            if (text[i] == ',') // 规避小数点本地化
+                text[i] = '.';
+            if (text[i] == '.' || text[i] == 'e')
+                has_point = true;
+        }
+        Raw(text, static_cast<size_t>(len));
+        if (!has_point)
+        {
+            Literal(".0");
+        }
+    }
+
+    // 单精度字段（msec、tar_cfid）：输出与 Double(value) 相同，多数取值不经过 snprintf
+    void Float(float value)
+    {
+        char         text[kMaxNumberLength];
+        const size_t length = FormatFloat17g(value, text);
+        if (length == 0)
+        {
+            Double(value);
+            return;
+        }
+        Raw(text, length);
+        // length 不超过 text 的长度，显式限定以免编译器按 size_t 全范围告警越界读
+        if (memchr(text, '.', std::min(length, sizeof(text))) == nullptr)
+        {
+            Literal(".0");
+        }
+    }
+
+    // 写入带引号的字符串，转义规则与 jsoncpp(emitUTF8=false) 一致
+    void String(const std::string &value) { String(value.data(), value.size()); }
+
+    void String(const char *value, size_t length)
+    {
+        Char('"');
+        const char *s = value;
+        const char *e = s + length;
+        for (; s < e; ++s)
+        {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            switch (c)
+            {
+            case '"':
+                Literal("\\\"");
+                break;
+            case '\\':
+                Literal("\\\\");
+                break;
+            case '\b':
+                Literal("\\b");
+                break;
+            case '\f':
+                Literal("\\f");
+                break;
+            case '\n':
+                Literal("\\n");
+                break;
+            case '\r':
+                Literal("\\r");
+                break;
+            case '\t':
+                Literal("\\t");
+                break;
+            default:
+                if (c >= 0x20 && c < 0x80)
+                {
+                    Char(static_cast<char>(c));
+                }
+                else
+                {
+                    unsigned int codepoint = DecodeUtf8(s, e);
+                    if (codepoint < 0x10000)
+                    {
+                        Escape16(codepoint);
+                    }
+                    else
+                    {
+                        codepoint -= 0x10000;
+                        Escape16(0xD800 + ((codepoint >> 10) & 0x3FF));
+                        Escape16(0xDC00 + (codepoint & 0x3FF));
+                    }
+                }
+                break;
+            }
+        }
+        Char('"');
+    }
+
+    void Char(char c)
+    {
+        if (cur_ < end_)
+            *cur_++ = static_cast<uint8_t>(c);
+        else
+            overflow_ = true;
+    }
+
+    // 写入已编码好的 JSON 片段
+    void Append(const uint8_t *data, size_t length)
+    {
+        Raw(reinterpret_cast<const char *>(data), length);
+    }
+
+    bool   ok() const { return !overflow_; }
+    size_t size() const { return static_cast<size_t>(cur_ - begin_); }
+
+  private:
+    void Raw(const char *text, size_t length)
+    {
+        if (static_cast<size_t>(end_ - cur_) < length)
+        {
+            overflow_ = true;
+            cur_ = end_;
+            return;
+        }
+        memcpy(cur_, text, length);
+        cur_ += length;
+    }
+
+    void Escape16(unsigned int unit)
+    {
+        static const char hex[] = "0123456789abcdef";
+        char              text[6] = {'\\',
+                                     'u',
+                                     hex[(unit >> 12) & 0xF],
+                                     hex[(unit >> 8) & 0xF],
+                                     hex[(unit >> 4) & 0xF],
+                                     hex[unit & 0xF]};
+        Raw(text, sizeof(text));
+    }
+
+    // 解码一个 UTF-8 码点，非法序列返回 U+FFFD（与 jsoncpp 行为一致）
+    static unsigned int DecodeUtf8(const char *&s, const char *e)
+    {
+        const unsigned int kReplacement = 0xFFFD;
+        const unsigned int first = static_cast<unsigned char>(*s);
+
+        if (first < 0x80)
+            return first;
+        if (first < 0xE0)
+        {
+            if (e - s < 2)
+                return kReplacement;
+            unsigned int cp = ((first & 0x1F) << 6) |
+                              (static_cast<unsigned int>(s[1]) & 0x3F);
+            s += 1;
+            return cp < 0x80 ? kReplacement : cp;
+        }
+        if (first < 0xF0)
+        {
+            if (e - s < 3)
+                return kReplacement;
+            unsigned int cp = ((first & 0x0F) << 12) |
+                              ((static_cast<unsigned int>(s[1]) & 0x3F) << 6) |
+                              (static_cast<unsigned int>(s[2]) & 0x3F);
+            s += 2;
+            if (cp >= 0xD800 && cp <= 0xDFFF)
+                return kReplacement;
+            return cp < 0x800 ? kReplacement : cp;
+        }
+        if (first < 0xF8)
+        {
+            if (e - s < 4)
+                return kReplacement;
+            unsigned int cp = ((first & 0x07) << 18) |
+                              ((static_cast<unsigned int>(s[1]) & 0x3F) << 12) |
+                              ((static_cast<unsigned int>(s[2]) & 0x3F) << 6) |
+                              (static_cast<unsigned int>(s[3]) & 0x3F);
+            s += 3;
+            return cp < 0x10000 ? kReplacement : cp;
+        }
+        return kReplacement;
+    }
+
+    uint8_t       *cur_;
+    uint8_t *const end_;
+    uint8_t *const begin_;
+    bool           overflow_ = false;
+};
+
+// 写入报文头中 "cont" 之后的字段（字典序）
+void WriteHeaderFields(JsonStreamWriter &w, const MessageHeader &header)
+{
+    w.Literal(",\"cont_sum\":");
+    w.Int(header.cont_sum);
+    w.Literal(",\"cont_type\":");
+    w.Int(header.cont_type);
+    w.Literal(",\"dy\":");
+    w.Int(header.dy);
+    if (header.frag_cnt > 1)
+    {
+        w.Literal(",\"frag_cnt\":");
+        w.Int(header.frag_cnt);
+        w.Literal(",\"frag_idx\":");
+        w.Int(header.frag_idx);
+    }
+    w.Literal(",\"h\":");
+    w.Int(header.h);
+    w.Literal(",\"min\":");
+    w.Int(header.min);
+    w.Literal(",\"mo\":");
+    w.Int(header.mo);
+    w.Literal(",\"msec\":");
+    w.Float(header.msec);
+    w.Literal(",\"msg_id\":");
+    w.Int(header.msg_id);
+    w.Literal(",\"msg_sn\":");
+    w.Int(header.msg_sn);
+    w.Literal(",\"msg_type\":");
+    w.Int(header.msg_type);
+    w.Literal(",\"rx_dev_id\":");
+    w.Int(header.rx_dev_id);
+    w.Literal(",\"rx_dev_type\":");
+    w.Int(header.rx_dev_type);
+    w.Literal(",\"rx_subdev_id\":");
+    w.Int(header.rx_subdev_id);
+    w.Literal(",\"rx_sys_id\":");
+    w.Int(header.rx_sys_id);
+    w.Literal(",\"sec\":");
+    w.Int(header.sec);
+    if (header.send_us != 0)
+    {
+        w.Literal(",\"send_us\":");
+        w.Int64(header.send_us);
+        if (header.src_cnt > 0)
+        {
+            w.Literal(",\"src_cnt\":");
+            w.Int(header.src_cnt);
+        }
+        w.Literal(",\"src_sn\":");
+        w.Int64(header.src_sn);
+    }
+    w.Literal(",\"tx_dev_id\":");
+    w.Int(header.tx_dev_id);
+    w.Literal(",\"tx_dev_type\":");
+    w.Int(header.tx_dev_type);
+    w.Literal(",\"tx_subdev_id\":");
+    w.Int(header.tx_subdev_id);
+    w.Literal(",\"tx_sys_id\":");
+    w.Int(header.tx_sys_id);
+    w.Literal(",\"yr\":");
+    w.Int(header.yr);
+}
+
+// 目标对象按字典序分段写入：逐目标变化的 tar_category、tar_cfid、tar_iden、
+// tar_rect、trk_stat 把对象分成若干段，段内字段在列式编码时整帧共享、只格式化一次。
+
+// "{\"alt\":" ... ",\"tar_category\":"
+void WriteTargetHead(JsonStreamWriter &w, const EOTargetInfo &t)
+{
+    w.Literal("{\"alt\":");
+    w.Double(t.alt);
+    w.Literal(",\"dev_id\":");
+    w.Int(t.dev_id);
+    w.Literal(",\"dy\":");
+    w.Int(t.dy);
+    w.Literal(",\"fov_angle\":");
+    w.Double(t.fov_angle);
+    w.Literal(",\"fov_h\":");
+    w.Double(t.fov_h);
+    w.Literal(",\"fov_v\":");
+    w.Double(t.fov_v);
+    w.Literal(",\"guid_id\":");
+    w.Int(t.guid_id);
+    w.Literal(",\"h\":");
+    w.Int(t.h);
+    w.Literal(",\"lat\":");
+    w.Double(t.lat);
+    w.Literal(",\"lon\":");
+    w.Double(t.lon);
+    w.Literal(",\"min\":");
+    w.Int(t.min);
+    w.Literal(",\"mo\":");
+    w.Int(t.mo);
+    w.Literal(",\"msec\":");
+    w.Float(t.msec);
+    w.Literal(",\"offset_h\":");
+    w.Int(t.offset_h);
+    w.Literal(",\"offset_v\":");
+    w.Int(t.offset_v);
+    w.Literal(",\"sec\":");
+    w.Int(t.sec);
+    w.Literal(",\"source_id\":");
+    w.Int(t.source_id);
+    w.Literal(",\"tar_a\":");
+    w.Double(t.tar_a);
+    w.Literal(",\"tar_av\":");
+    w.Double(t.tar_av);
+    w.Literal(",\"tar_category\":");
+}
+
+// tar_cfid 之后到 ",\"tar_iden\":"
+void WriteTargetBody(JsonStreamWriter &w, const EOTargetInfo &t)
+{
+    w.Literal(",\"tar_e\":");
+    w.Double(t.tar_e);
+    w.Literal(",\"tar_ev\":");
+    w.Double(t.tar_ev);
+    w.Literal(",\"tar_id\":");
+    w.Int(t.tar_id);
+    w.Literal(",\"tar_iden\":");
+}
+
+// tar_rect 之后到 ",\"trk_stat\":"
+void WriteTargetTail(JsonStreamWriter &w, const EOTargetInfo &t)
+{
+    w.Literal(",\"tar_rng\":");
+    w.Double(t.tar_rng);
+    w.Literal(",\"tar_rv\":");
+    w.Double(t.tar_rv);
+    w.Literal(",\"trk_mod\":");
+    w.Int(t.trk_mod);
+    w.Literal(",\"trk_stat\":");
+}
+
+// trk_stat 之后到对象结束
+void WriteTargetEnd(JsonStreamWriter &w, const EOTargetInfo &t)
+{
+    w.Literal(",\"yr\":");
+    w.Int(t.yr);
+    w.Char('}');
+}
+
+// 写入单个目标对象（字典序）
+void WriteTargetInfo(JsonStreamWriter &w, const EOTargetInfo &t)
+{
+    WriteTargetHead(w, t);
+    w.Int(t.tar_category);
+    w.Literal(",\"tar_cfid\":");
+    w.Float(t.tar_cfid);
+    WriteTargetBody(w, t);
+    w.String(t.tar_iden.data(), t.tar_iden.size());
+    w.Literal(",\"tar_rect\":");
+    w.Int(t.tar_rect);
+    WriteTargetTail(w, t);
+    w.Int(t.trk_stat);
+    WriteTargetEnd(w, t);
+}
+
+// ---------------------------------------------------------------------------
+// 单遍 JSON 解码
+// ---------------------------------------------------------------------------
+
+// 报文头与目标对象中已知的字段名
+enum class FieldKey : uint8_t
+{
+    UNKNOWN = 0,
+    CONT,
+    CONT_SUM,
+    CONT_TYPE,
+    FRAG_IDX,
+    FRAG_CNT,
+    SRC_SN,
+    SEND_US,
+    MSG_ID,
+    MSG_SN,
+    MSG_TYPE,
+    TX_SYS_ID,
+    TX_DEV_TYPE,
+    TX_DEV_ID,
+    TX_SUBDEV_ID,
+    RX_SYS_ID,
+    RX_DEV_TYPE,
+    RX_DEV_ID,
+    RX_SUBDEV_ID,
+    YR,
+    MO,
+    DY,
+    H,
+    MIN,
+    SEC,
+    MSEC,
+    DEV_ID,
+    GUID_ID,
+    TAR_ID,
+    TRK_STAT,
+    TRK_MOD,
+    FOV_ANGLE,
+    LON,
+    LAT,
+    ALT,
+    TAR_A,
+    TAR_E,
+    TAR_RNG,
+    TAR_AV,
+    TAR_EV,
+    TAR_RV,
+    TAR_CATEGORY,
+    TAR_IDEN,
+    TAR_CFID,
+    FOV_H,
+    FOV_V,
+    OFFSET_H,
+    OFFSET_V,
+    TAR_RECT,
+    SOURCE_ID,
+    HEARTBEAT,
+    SRC_CNT
+};
+
+struct FieldName
+{
+    const char *name;
+    size_t      length;
+    FieldKey    key;
+};
+
+#define EO_FIELD(text, key) {text, sizeof(text) - 1, FieldKey::key}
+constexpr FieldName kFieldNames[] = {
+    EO_FIELD("cont", CONT),
+    EO_FIELD("cont_sum", CONT_SUM),
+    EO_FIELD("cont_type", CONT_TYPE),
+    EO_FIELD("frag_idx", FRAG_IDX),
+    EO_FIELD("frag_cnt", FRAG_CNT),
+    EO_FIELD("src_sn", SRC_SN),
+    EO_FIELD("src_cnt", SRC_CNT),
+    EO_FIELD("send_us", SEND_US),
+    EO_FIELD("msg_id", MSG_ID),
+    EO_FIELD("msg_sn", MSG_SN),
+    EO_FIELD("msg_type", MSG_TYPE),
+    EO_FIELD("tx_sys_id", TX_SYS_ID),
+    EO_FIELD("tx_dev_type", TX_DEV_TYPE),
+    EO_FIELD("tx_dev_id", TX_DEV_ID),
+    EO_FIELD("tx_subdev_id", TX_SUBDEV_ID),
+    EO_FIELD("rx_sys_id", RX_SYS_ID),
+    EO_FIELD("rx_dev_type", RX_DEV_TYPE),
+    EO_FIELD("rx_dev_id", RX_DEV_ID),
+    EO_FIELD("rx_subdev_id", RX_SUBDEV_ID),
+    EO_FIELD("yr", YR),
+    EO_FIELD("mo", MO),
+    EO_FIELD("dy", DY),
+    EO_FIELD("h", H),
+    EO_FIELD("min", MIN),
+    EO_FIELD("sec", SEC),
+    EO_FIELD("msec", MSEC),
+    EO_FIELD("dev_id", DEV_ID),
+    EO_FIELD("guid_id", GUID_ID),
+    EO_FIELD("tar_id", TAR_ID),
+    EO_FIELD("trk_stat", TRK_STAT),
+    EO_FIELD("trk_mod", TRK_MOD),
+    EO_FIELD("fov_angle", FOV_ANGLE),
+    EO_FIELD("lon", LON),
+    EO_FIELD("lat", LAT),
+    EO_FIELD("alt", ALT),
+    EO_FIELD("tar_a", TAR_A),
+    EO_FIELD("tar_e", TAR_E),
+    EO_FIELD("tar_rng", TAR_RNG),
+    EO_FIELD("tar_av", TAR_AV),
+    EO_FIELD("tar_ev", TAR_EV),
+    EO_FIELD("tar_rv", TAR_RV),
+    EO_FIELD("tar_category", TAR_CATEGORY),
+    EO_FIELD("tar_iden", TAR_IDEN),
+    EO_FIELD("tar_cfid", TAR_CFID),
+    EO_FIELD("fov_h", FOV_H),
+    EO_FIELD("fov_v", FOV_V),
+    EO_FIELD("offset_h", OFFSET_H),
+    EO_FIELD("offset_v", OFFSET_V),
+    EO_FIELD("tar_rect", TAR_RECT),
+    EO_FIELD("source_id", SOURCE_ID),
+    EO_FIELD("heartbeat", HEARTBEAT),
+};
+#undef EO_FIELD
+
+constexpr size_t kFieldCount = sizeof(kFieldNames) / sizeof(kFieldNames[0]);
+
+// 完美哈希：FNV-1a 变体，种子经离线搜索使上述字段名在 128 个槽位中无冲突
+constexpr uint32_t kFieldHashSeed = 60610;
+constexpr uint32_t kFieldTableMask = 127;
+
+constexpr uint32_t HashFieldName(const char *name, size_t length)
+{
+    uint32_t hash = kFieldHashSeed;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ static_cast<uint8_t>(name[i])) * 16777619u;
+    }
+    return (hash ^ (hash >> 15)) & kFieldTableMask;
+}
+
+// 槽位存放 kFieldNames 下标 + 1，0 表示空槽
+struct FieldTable
+{
+    uint8_t slots[kFieldTableMask + 1];
+};
+
+constexpr FieldTable BuildFieldTable()
+{
+    FieldTable table = {};
+    for (size_t i = 0; i < kFieldCount; ++i)
+    {
+        table.slots[HashFieldName(kFieldNames[i].name, kFieldNames[i].length)] =
+            static_cast<uint8_t>(i + 1);
+    }
+    return table;
+}
+
+constexpr bool FieldTableIsPerfect()
+{
+    for (size_t i = 0; i < kFieldCount; ++i)
+    {
+        for (size_t j = i + 1; j < kFieldCount; ++j)
+        {
+            if (HashFieldName(kFieldNames[i].name, kFieldNames[i].length) ==
+                HashFieldName(kFieldNames[j].name, kFieldNames[j].length))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(FieldTableIsPerfect(),
+              "field name hash collides, search a new kFieldHashSeed");
+
+constexpr FieldTable kFieldTable = BuildFieldTable();
+
+FieldKey LookupField(const char *name, size_t length)
+{
+    const uint8_t slot = kFieldTable.slots[HashFieldName(name, length)];
+    if (slot == 0)
+    {
+        return FieldKey::UNKNOWN;
+    }
+    const FieldName &field = kFieldNames[slot - 1];
+    if (field.length != length || memcmp(field.name, name, length) != 0)
+    {
+        return FieldKey::UNKNOWN;
+    }
+    return field.key;
+}
+
+// 就地遍历报文的 JSON 读取器，不做任何中间拷贝
+class JsonCursor
+{
+  public:
+    // 标量值的解析结果
+    enum class Kind
+    {
+        NUMBER,
+        BOOLEAN,
+        NULL_VALUE,
+        OTHER
+    };
+
+    JsonCursor(const char *begin, const char *end) : p_(begin), end_(end) {}
+
+    void SkipWhitespace()
+    {
+        while (p_ < end_ &&
+               (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r'))
+        {
+            ++p_;
+        }
+    }
+
+    bool Consume(char c)
+    {
+        SkipWhitespace();
+        if (p_ < end_ && *p_ == c)
+        {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    char Peek()
+    {
+        SkipWhitespace();
+        return p_ < end_ ? *p_ : '\0';
+    }
+
+    // 读取对象键（不解码转义；带转义的键按未知键处理）
+    bool ReadKey(FieldKey &key)
+    {
+        if (!Consume('"'))
+        {
+            return false;
+        }
+        const char *start = p_;
+        bool        escaped = false;
+        while (p_ < end_ && *p_ != '"')
+        {
+            if (*p_ == '\\')
+            {
+                escaped = true;
+                ++p_;
+            }
+            ++p_;
+        }
+        if (p_ >= end_)
+        {
+            return false;
+        }
+        key = escaped ? FieldKey::UNKNOWN
+                      : LookupField(start, static_cast<size_t>(p_ - start));
+        ++p_;
+        return Consume(':');
+    }
+
+    // 读取标量数值；数值以外的合法值（字符串、对象、数组）返回 Kind::OTHER
+    bool ReadNumber(double &value, Kind &kind)
+    {
+        char c = Peek();
+        if (c == '-' || (c >= '0' && c <= '9'))
+        {
+            const char *start = p_;
+            bool        integral = true;
+            while (p_ < end_ &&
+                   ((*p_ >= '0' && *p_ <= '9') || *p_ == '-' || *p_ == '+' ||
+                    *p_ == '.' || *p_ == 'e' || *p_ == 'E'))
+            {
+                if (*p_ == '.' || *p_ == 'e' || *p_ == 'E')
+                    integral = false;
+                ++p_;
+            }
+            const size_t length = static_cast<size_t>(p_ - start);
+            kind = Kind::NUMBER;
+            if (integral && length < 19)
+            {
+                const char *d = start;
+                bool        negative = (*d == '-');
+                if (negative)
+                    ++d;
+                if (d == p_)
+                    return false;
+                int64_t magnitude = 0;
+                for (; d < p_; ++d)
+                {
+                    if (*d < '0' || *d > '9')
+                        return false;
+                    magnitude = magnitude * 10 + (*d - '0');
+                }
+                value = static_cast<double>(negative ? -magnitude : magnitude);
+                return true;
+            }
+            // 报文不以 '\0' 结尾，复制到栈上再交给 strtod
+            char text[64];
+            if (length >= sizeof(text))
+                return false;
+            memcpy(text, start, length);
+            text[length] = '\0';
+            char *parsed_end = nullptr;
+            value = strtod(text, &parsed_end);
+            return parsed_end == text + length;
+        }
+        if (MatchLiteral("true"))
+        {
+            kind = Kind::BOOLEAN;
+            value = 1.0;
+            return true;
+        }
+        if (MatchLiteral("false"))
+        {
+            kind = Kind::BOOLEAN;
+            value = 0.0;
+            return true;
+        }
+        if (MatchLiteral("null"))
+        {
+            kind = Kind::NULL_VALUE;
+            value = 0.0;
+            return true;
+        }
+        if (c == '{' || c == '[' || c == '"')
+        {
+            kind = Kind::OTHER;
+            return SkipValue(0);
+        }
+        return false;
+    }
+
+    // 读取字符串值到 out（复用其已有容量），null 视为空字符串
+    bool ReadString(std::string &out, bool &is_string)
+    {
+        out.clear();
+        is_string = false;
+        char c = Peek();
+        if (c != '"')
+        {
+            if (MatchLiteral("null"))
+            {
+                is_string = true;
+                return true;
+            }
+            return SkipValue(0);
+        }
+        ++p_;
+        is_string = true;
+        while (p_ < end_)
+        {
+            const char *run = p_;
+            while (p_ < end_ && *p_ != '"' && *p_ != '\\')
+                ++p_;
+            out.append(run, static_cast<size_t>(p_ - run));
+            if (p_ >= end_)
+                return false;
+            if (*p_ == '"')
+            {
+                ++p_;
+                return true;
+            }
+            ++p_; // '\\'
+            if (p_ >= end_)
+                return false;
+            switch (*p_++)
+            {
+            case '"':
+                out.push_back('"');
+                break;
+            case '\\':
+                out.push_back('\\');
+                break;
+            case '/':
+                out.push_back('/');
+                break;
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u':
+            {
+                unsigned int codepoint = 0;
+                if (!ReadHex16(codepoint))
+                    return false;
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+                {
+                    unsigned int low = 0;
+                    if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u')
+                        return false;
+                    p_ += 2;
+                    if (!ReadHex16(low) || low < 0xDC00 || low > 0xDFFF)
+                        return false;
+                    codepoint = 0x10000 + ((codepoint & 0x3FF) << 10) +
+                                (low & 0x3FF);
+                }
+                AppendUtf8(out, codepoint);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // 跳过任意 JSON 值（用于未知键和不关心的字段）
+    bool SkipValue(int depth)
+    {
+        if (depth > kMaxDepth)
+            return false;
+        char c = Peek();
+        if (c == '{' || c == '[')
+        {
+            const char close = (c == '{') ? '}' : ']';
+            ++p_;
+            if (Consume(close))
+                return true;
+            do
+            {
+                if (c == '{')
+                {
+                    FieldKey ignored;
+                    if (!ReadKey(ignored))
+                        return false;
+                }
+                if (!SkipValue(depth + 1))
+                    return false;
+            } while (Consume(','));
+            return Consume(close);
+        }
+        if (c == '"')
+        {
+            ++p_;
+            while (p_ < end_ && *p_ != '"')
+            {
+                if (*p_ == '\\')
+                    ++p_;
+                ++p_;
+            }
+            if (p_ >= end_)
+                return false;
+            ++p_;
+            return true;
+        }
+        double value;
+        Kind   kind;
+        return ReadNumber(value, kind) && kind != Kind::OTHER;
+    }
+
+  private:
+    static constexpr int kMaxDepth = 64;
+
+    bool MatchLiteral(const char *literal)
+    {
+        const size_t length = strlen(literal);
+        if (static_cast<size_t>(end_ - p_) >= length &&
+            memcmp(p_, literal, length) == 0)
+        {
+            p_ += length;
+            return true;
+        }
+        return false;
+    }
+
+    bool ReadHex16(unsigned int &unit)
+    {
+        if (end_ - p_ < 4)
+            return false;
+        unit = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const char c = *p_++;
+            unit <<= 4;
+            if (c >= '0' && c <= '9')
+                unit |= static_cast<unsigned int>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                unit |= static_cast<unsigned int>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                unit |= static_cast<unsigned int>(c - 'A' + 10);
+            else
+                return false;
+        }
+        return true;
+    }
+
+    static void AppendUtf8(std::string &out, unsigned int codepoint)
+    {
+        if (codepoint < 0x80)
+        {
+            out.push_back(static_cast<char>(codepoint));
+        }
+        else if (codepoint < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+        else if (codepoint < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    const char *p_;
+    const char *end_;
+};
+
+// 读取整型字段，数值/布尔/null 均可，与 jsoncpp asInt() 一致截断小数。
+// 返回 false 表示语法错误；valid 置 false 表示类型不符（jsoncpp 会抛异常）
+bool ReadIntField(JsonCursor &cursor, int &out, bool &valid)
+{
+    double           value = 0.0;
+    JsonCursor::Kind kind;
+    if (!cursor.ReadNumber(value, kind))
+        return false;
+    if (kind == JsonCursor::Kind::OTHER || value < INT32_MIN ||
+        value > INT32_MAX)
+    {
+        valid = false;
+        out = 0;
+        return true;
+    }
+    out = static_cast<int>(value);
+    return true;
+}
+
+// 读取 64 位整型字段（限 ±2^53，超出时按类型不符处理），语义同 ReadIntField
+bool ReadInt64Field(JsonCursor &cursor, int64_t &out, bool &valid)
+{
+    const double     kMaxExact = 9007199254740992.0;
+    double           value = 0.0;
+    JsonCursor::Kind kind;
+    if (!cursor.ReadNumber(value, kind))
+        return false;
+    if (kind == JsonCursor::Kind::OTHER || value < -kMaxExact || value > kMaxExact)
+    {
+        valid = false;
+        out = 0;
+        return true;
+    }
+    out = static_cast<int64_t>(value);
+    return true;
+}
+
+// 读取浮点字段，语义同 ReadIntField
+bool ReadDoubleField(JsonCursor &cursor, double &out, bool &valid)
+{
+    JsonCursor::Kind kind;
+    if (!cursor.ReadNumber(out, kind))
+        return false;
+    valid = (kind != JsonCursor::Kind::OTHER);
+    if (!valid)
+        out = 0.0;
+    return true;
+}
+
+// 解析报文头中的标量字段，未知键直接跳过；valid 置 false 表示字段类型不符
+bool ParseHeaderField(JsonCursor    &cursor,
+                      FieldKey       key,
+                      MessageHeader &header,
+                      bool          &valid)
+{
+    double value = 0.0;
+    switch (key)
+    {
+    case FieldKey::MSG_ID:
+        return ReadIntField(cursor, header.msg_id, valid);
+    case FieldKey::MSG_SN:
+        return ReadIntField(cursor, header.msg_sn, valid);
+    case FieldKey::MSG_TYPE:
+        return ReadIntField(cursor, header.msg_type, valid);
+    case FieldKey::TX_SYS_ID:
+        return ReadIntField(cursor, header.tx_sys_id, valid);
+    case FieldKey::TX_DEV_TYPE:
+        return ReadIntField(cursor, header.tx_dev_type, valid);
+    case FieldKey::TX_DEV_ID:
+        return ReadIntField(cursor, header.tx_dev_id, valid);
+    case FieldKey::TX_SUBDEV_ID:
+        return ReadIntField(cursor, header.tx_subdev_id, valid);
+    case FieldKey::RX_SYS_ID:
+        return ReadIntField(cursor, header.rx_sys_id, valid);
+    case FieldKey::RX_DEV_TYPE:
+        return ReadIntField(cursor, header.rx_dev_type, valid);
+    case FieldKey::RX_DEV_ID:
+        return ReadIntField(cursor, header.rx_dev_id, valid);
+    case FieldKey::RX_SUBDEV_ID:
+        return ReadIntField(cursor, header.rx_subdev_id, valid);
+    case FieldKey::YR:
+        return ReadIntField(cursor, header.yr, valid);
+    case FieldKey::MO:
+        return ReadIntField(cursor, header.mo, valid);
+    case FieldKey::DY:
+        return ReadIntField(cursor, header.dy, valid);
+    case FieldKey::H:
+        return ReadIntField(cursor, header.h, valid);
+    case FieldKey::MIN:
+        return ReadIntField(cursor, header.min, valid);
+    case FieldKey::SEC:
+        return ReadIntField(cursor, header.sec, valid);
+    case FieldKey::MSEC:
+        if (!ReadDoubleField(cursor, value, valid))
+            return false;
+        header.msec = static_cast<float>(value);
+        return true;
+    case FieldKey::CONT_TYPE:
+        return ReadIntField(cursor, header.cont_type, valid);
+    case FieldKey::CONT_SUM:
+        return ReadIntField(cursor, header.cont_sum, valid);
+    case FieldKey::FRAG_IDX:
+        return ReadIntField(cursor, header.frag_idx, valid);
+    case FieldKey::FRAG_CNT:
+        return ReadIntField(cursor, header.frag_cnt, valid);
+    case FieldKey::SRC_SN:
+    {
+        int64_t sn = 0;
+        if (!ReadInt64Field(cursor, sn, valid))
+            return false;
+        if (sn < 0 || sn > UINT32_MAX)
+        {
+            valid = false;
+            sn = 0;
+        }
+        header.src_sn = static_cast<uint32_t>(sn);
+        return true;
+    }
+    case FieldKey::SEND_US:
+        return ReadInt64Field(cursor, header.send_us, valid);
+    case FieldKey::SRC_CNT:
+        return ReadIntField(cursor, header.src_cnt, valid);
+    default:
+        return cursor.SkipValue(0);
+    }
+}
+
+// 解析目标对象中的字段，未知键直接跳过；valid 置 false 表示字段类型不符
+bool ParseTargetField(JsonCursor   &cursor,
+                      FieldKey      key,
+                      EOTargetInfo &t,
+                      bool         &valid)
+{
+    double value = 0.0;
+    bool   ok = true;
+    switch (key)
+    {
+    case FieldKey::YR:
+        return ReadIntField(cursor, t.yr, valid);
+    case FieldKey::MO:
+        return ReadIntField(cursor, t.mo, valid);
+    case FieldKey::DY:
+        return ReadIntField(cursor, t.dy, valid);
+    case FieldKey::H:
+        return ReadIntField(cursor, t.h, valid);
+    case FieldKey::MIN:
+        return ReadIntField(cursor, t.min, valid);
+    case FieldKey::SEC:
+        return ReadIntField(cursor, t.sec, valid);
+    case FieldKey::MSEC:
+        ok = ReadDoubleField(cursor, value, valid);
+        t.msec = static_cast<float>(value);
+        return ok;
+    case FieldKey::DEV_ID:
+        return ReadIntField(cursor, t.dev_id, valid);
+    case FieldKey::GUID_ID:
+        return ReadIntField(cursor, t.guid_id, valid);
+    case FieldKey::TAR_ID:
+        return ReadIntField(cursor, t.tar_id, valid);
+    case FieldKey::TRK_STAT:
+        return ReadIntField(cursor, t.trk_stat, valid);
+    case FieldKey::TRK_MOD:
+        return ReadIntField(cursor, t.trk_mod, valid);
+    case FieldKey::FOV_ANGLE:
+        return ReadDoubleField(cursor, t.fov_angle, valid);
+    case FieldKey::LON:
+        return ReadDoubleField(cursor, t.lon, valid);
+    case FieldKey::LAT:
+        return ReadDoubleField(cursor, t.lat, valid);
+    case FieldKey::ALT:
+        return ReadDoubleField(cursor, t.alt, valid);
+    case FieldKey::TAR_A:
+        return ReadDoubleField(cursor, t.tar_a, valid);
+    case FieldKey::TAR_E:
+        return ReadDoubleField(cursor, t.tar_e, valid);
+    case FieldKey::TAR_RNG:
+        return ReadDoubleField(cursor, t.tar_rng, valid);
+    case FieldKey::TAR_AV:
+        return ReadDoubleField(cursor, t.tar_av, valid);
+    case FieldKey::TAR_EV:
+        return ReadDoubleField(cursor, t.tar_ev, valid);
+    case FieldKey::TAR_RV:
+        return ReadDoubleField(cursor, t.tar_rv, valid);
+    case FieldKey::TAR_CATEGORY:
+        return ReadIntField(cursor, t.tar_category, valid);
+    case FieldKey::TAR_IDEN:
+    {
+        // 先解码到线程内复用的缓冲区，再按 EOIdenString 容量截断
+        static thread_local std::string iden;
+        bool                            is_string = false;
+        ok = cursor.ReadString(iden, is_string);
+        t.tar_iden.assign(iden.data(), iden.size());
+        if (!is_string)
+            valid = false;
+        return ok;
+    }
+    case FieldKey::TAR_CFID:
+        ok = ReadDoubleField(cursor, value, valid);
+        t.tar_cfid = static_cast<float>(value);
+        return ok;
+    case FieldKey::FOV_H:
+        return ReadDoubleField(cursor, t.fov_h, valid);
+    case FieldKey::FOV_V:
+        return ReadDoubleField(cursor, t.fov_v, valid);
+    case FieldKey::OFFSET_H:
+        return ReadIntField(cursor, t.offset_h, valid);
+    case FieldKey::OFFSET_V:
+        return ReadIntField(cursor, t.offset_v, valid);
+    case FieldKey::TAR_RECT:
+        return ReadIntField(cursor, t.tar_rect, valid);
+    case FieldKey::SOURCE_ID:
+        return ReadIntField(cursor, t.source_id, valid);
+    default:
+        return cursor.SkipValue(0);
+    }
+}
+
+// 将复用的目标对象恢复为缺省值
+void ResetTargetInfo(EOTargetInfo &t)
+{
+    t = EOTargetInfo();
+}
+
+// 解析 "cont" 数组，目标对象写入 targetInfos 中已有元素以复用内存
+bool ParseTargetArray(JsonCursor                &cursor,
+                      std::vector<EOTargetInfo> &targetInfos,
+                      size_t                    &count)
+{
+    if (cursor.Peek() != '[')
+    {
+        return cursor.SkipValue(0); // "cont" 不是数组时忽略
+    }
+    cursor.Consume('[');
+    if (cursor.Consume(']'))
+    {
+        return true;
+    }
+
+    do
+    {
+        if (cursor.Peek() != '{')
+        {
+            if (!cursor.SkipValue(1))
+                return false;
+            continue;
+        }
+        if (count == targetInfos.size())
+        {
+            targetInfos.emplace_back();
+        }
+        EOTargetInfo &target = targetInfos[count];
+        ResetTargetInfo(target);
+
+        bool valid = true;
+        cursor.Consume('{');
+        if (!cursor.Consume('}'))
+        {
+            do
+            {
+                FieldKey key;
+                if (!cursor.ReadKey(key) ||
+                    !ParseTargetField(cursor, key, target, valid))
+                {
+                    return false;
+                }
+            } while (cursor.Consume(','));
+            if (!cursor.Consume('}'))
+            {
+                return false;
+            }
+        }
+        if (valid)
+        {
+            ++count;
+        }
+    } while (cursor.Consume(','));
+
+    return cursor.Consume(']');
+}
+
+// ---------------------------------------------------------------------------
+// 二进制编解码（BodyType::BINARY）
+// ---------------------------------------------------------------------------
+
+// 帧头：帧头(2) + 版本(1) + 报文类型(1) + 帧长(4)
+constexpr size_t kBinaryPreambleSize = 8;
+// 报文头：11 个 int32 标识 + 紧凑时间(8) + msec(4) + cont_type(2) + cont_sum(2)
+constexpr size_t kBinaryHeaderSize = 60;
+// 分片报文（kEOBinaryFragmentVersion）在报文头后追加 frag_idx(2) + frag_cnt(2)
+constexpr size_t kBinaryFragmentFieldsSize = 4;
+// 序号报文（kEOBinarySequenceVersion）追加 src_sn(4) + send_us(8) + frag_idx(2) + frag_cnt(2)
+constexpr size_t kBinarySequenceFieldsSize = 16;
+// 聚合报文（kEOBinaryBatchVersion）在序号字段后再追加 src_cnt(2) + 保留(2)
+constexpr size_t kBinaryBatchFieldsSize = 20;
+// 校验和(2) + 帧尾(2)
+constexpr size_t kBinaryTrailerSize = 4;
+// 目标记录固定部分：记录长度(2) + 浮点掩码(2) + 紧凑时间(8) + msec(4)
+// + 10 个 int32 + tar_cfid(4) + tar_iden 长度(1)
+constexpr size_t kBinaryTargetFixedSize = 61;
+// 目标记录中按掩码出现的双精度字段个数
+constexpr size_t kBinaryDoubleCount = 12;
+
+// 小端序写入器，写入调用方缓冲区
+class BinaryWriter
+{
+  public:
+    BinaryWriter(uint8_t *buffer, size_t capacity)
+        : begin_(buffer), cur_(buffer), end_(buffer + capacity)
+    {
+    }
+
+    void U8(uint8_t value)
+    {
+        if (cur_ < end_)
+            *cur_++ = value;
+        else
+            overflow_ = true;
+    }
+
+    void U16(uint16_t value)
+    {
+        U8(static_cast<uint8_t>(value));
+        U8(static_cast<uint8_t>(value >> 8));
+    }
+
+    void U32(uint32_t value)
+    {
+        U16(static_cast<uint16_t>(value));
+        U16(static_cast<uint16_t>(value >> 16));
+    }
+
+    void U64(uint64_t value)
+    {
+        U32(static_cast<uint32_t>(value));
+        U32(static_cast<uint32_t>(value >> 32));
+    }
+
+    void I32(int32_t value) { U32(static_cast<uint32_t>(value)); }
+
+    void F32(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        U32(bits);
+    }
+
+    void F64(double value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        U64(bits);
+    }
+
+    void Bytes(const void *data, size_t length)
+    {
+        if (static_cast<size_t>(end_ - cur_) < length)
+        {
+            overflow_ = true;
+            cur_ = end_;
+            return;
+        }
+        memcpy(cur_, data, length);
+        cur_ += length;
+    }
+
+    // 无符号 LEB128 变长整数
+    void Varint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            U8(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        U8(static_cast<uint8_t>(value));
+    }
+
+    // 在已写入位置回填 16 位数值
+    void PatchU16(size_t offset, uint16_t value)
+    {
+        if (offset + 2 <= size())
+        {
+            begin_[offset] = static_cast<uint8_t>(value);
+            begin_[offset + 1] = static_cast<uint8_t>(value >> 8);
+        }
+    }
+
+    void PatchU32(size_t offset, uint32_t value)
+    {
+        PatchU16(offset, static_cast<uint16_t>(value));
+        PatchU16(offset + 2, static_cast<uint16_t>(value >> 16));
+    }
+
+    bool     ok() const { return !overflow_; }
+    size_t   size() const { return static_cast<size_t>(cur_ - begin_); }
+    uint8_t *data() const { return begin_; }
+
+  private:
+    uint8_t *const begin_;
+    uint8_t       *cur_;
+    uint8_t *const end_;
+    bool           overflow_ = false;
+};
+
+// 小端序读取器，越界时置位错误并返回0
+class BinaryReader
+{
+  public:
+    BinaryReader(const uint8_t *begin, const uint8_t *end)
+        : cur_(begin), end_(end)
+    {
+    }
+
+    uint8_t U8()
+    {
+        if (cur_ < end_)
+            return *cur_++;
+        error_ = true;
+        return 0;
+    }
+
+    uint16_t U16()
+    {
+        uint16_t lo = U8();
+        return static_cast<uint16_t>(lo | (U8() << 8));
+    }
+
+    uint32_t U32()
+    {
+        uint32_t lo = U16();
+        return lo | (static_cast<uint32_t>(U16()) << 16);
+    }
+
+    uint64_t U64()
+    {
+        uint64_t lo = U32();
+        return lo | (static_cast<uint64_t>(U32()) << 32);
+    }
+
+    int32_t I32() { return static_cast<int32_t>(U32()); }
+
+    float F32()
+    {
+        uint32_t bits = U32();
+        float    value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    double F64()
+    {
+        uint64_t bits = U64();
+        double   value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    const uint8_t *Bytes(size_t length)
+    {
+        if (static_cast<size_t>(end_ - cur_) < length)
+        {
+            error_ = true;
+            cur_ = end_;
+            return nullptr;
+        }
+        const uint8_t *data = cur_;
+        cur_ += length;
+        return data;
+    }
+
+    uint64_t Varint()
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            const uint8_t byte = U8();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        error_ = true;
+        return 0;
+    }
+
+    const uint8_t *position() const { return cur_; }
+    bool           ok() const { return !error_; }
+
+  private:
+    const uint8_t *cur_;
+    const uint8_t *end_;
+    bool           error_ = false;
+};
+
+// 紧凑时间：年(2) 月 日 时 分 秒(各1) 保留(1)
+template <typename T> void WriteCompactTime(BinaryWriter &w, const T &t)
+{
+    w.U16(static_cast<uint16_t>(t.yr));
+    w.U8(static_cast<uint8_t>(t.mo));
+    w.U8(static_cast<uint8_t>(t.dy));
+    w.U8(static_cast<uint8_t>(t.h));
+    w.U8(static_cast<uint8_t>(t.min));
+    w.U8(static_cast<uint8_t>(t.sec));
+    w.U8(0);
+}
+
+template <typename T> void ReadCompactTime(BinaryReader &r, T &t)
+{
+    t.yr = r.U16();
+    t.mo = r.U8();
+    t.dy = r.U8();
+    t.h = r.U8();
+    t.min = r.U8();
+    t.sec = r.U8();
+    r.U8();
+}
+
+// 按掩码位序排列的双精度字段，全部为0的字段不占报文空间
+template <typename Target>
+auto TargetDoubleField(Target &t, size_t index) -> decltype(&t.lon)
+{
+    decltype(&t.lon) const fields[kBinaryDoubleCount] = {
+        &t.fov_angle, &t.lon,    &t.lat,    &t.alt,   &t.tar_a, &t.tar_e,
+        &t.tar_rng,   &t.tar_av, &t.tar_ev, &t.tar_rv, &t.fov_h, &t.fov_v};
+    return fields[index];
+}
+
+void WriteBinaryHeader(BinaryWriter &w, const MessageHeader &header)
+{
+    w.I32(header.msg_id);
+    w.I32(header.msg_sn);
+    w.I32(header.msg_type);
+    w.I32(header.tx_sys_id);
+    w.I32(header.tx_dev_type);
+    w.I32(header.tx_dev_id);
+    w.I32(header.tx_subdev_id);
+    w.I32(header.rx_sys_id);
+    w.I32(header.rx_dev_type);
+    w.I32(header.rx_dev_id);
+    w.I32(header.rx_subdev_id);
+    WriteCompactTime(w, header);
+    w.F32(header.msec);
+    w.U16(static_cast<uint16_t>(header.cont_type));
+    w.U16(static_cast<uint16_t>(header.cont_sum));
+}
+
+void ReadBinaryHeader(BinaryReader &r, MessageHeader &header)
+{
+    header.msg_id = r.I32();
+    header.msg_sn = r.I32();
+    header.msg_type = r.I32();
+    header.tx_sys_id = r.I32();
+    header.tx_dev_type = r.I32();
+    header.tx_dev_id = r.I32();
+    header.tx_subdev_id = r.I32();
+    header.rx_sys_id = r.I32();
+    header.rx_dev_type = r.I32();
+    header.rx_dev_id = r.I32();
+    header.rx_subdev_id = r.I32();
+    ReadCompactTime(r, header);
+    header.msec = r.F32();
+    header.cont_type = r.U16();
+    header.cont_sum = r.U16();
+}
+
+void WriteBinaryTarget(BinaryWriter &w, const EOTargetInfo &t)
+{
+    const size_t start = w.size();
+    uint16_t      mask = 0;
+    for (size_t i = 0; i < kBinaryDoubleCount; ++i)
+    {
+        if (*TargetDoubleField(t, i) != 0.0)
+            mask = static_cast<uint16_t>(mask | (1u << i));
+    }
+
+    w.U16(0); // 记录长度，写完后回填
+    w.U16(mask);
+    WriteCompactTime(w, t);
+    w.F32(t.msec);
+    w.I32(t.dev_id);
+    w.I32(t.guid_id);
+    w.I32(t.tar_id);
+    w.I32(t.trk_stat);
+    w.I32(t.trk_mod);
+    w.I32(t.tar_category);
+    w.I32(t.offset_h);
+    w.I32(t.offset_v);
+    w.I32(t.tar_rect);
+    w.I32(t.source_id);
+    w.F32(t.tar_cfid);
+    const size_t iden_length = t.tar_iden.size();
+    w.U8(static_cast<uint8_t>(iden_length));
+    w.Bytes(t.tar_iden.data(), iden_length);
+    for (size_t i = 0; i < kBinaryDoubleCount; ++i)
+    {
+        if (mask & (1u << i))
+            w.F64(*TargetDoubleField(t, i));
+    }
+    w.PatchU16(start, static_cast<uint16_t>(w.size() - start));
+}
+
+bool ReadBinaryTarget(BinaryReader &r, EOTargetInfo &t)
+{
+    const uint8_t *start = r.position();
+    const uint16_t record_length = r.U16();
+    if (record_length < kBinaryTargetFixedSize)
+    {
+        return false;
+    }
+    const uint16_t mask = r.U16();
+    ReadCompactTime(r, t);
+    t.msec = r.F32();
+    t.dev_id = r.I32();
+    t.guid_id = r.I32();
+    t.tar_id = r.I32();
+    t.trk_stat = r.I32();
+    t.trk_mod = r.I32();
+    t.tar_category = r.I32();
+    t.offset_h = r.I32();
+    t.offset_v = r.I32();
+    t.tar_rect = r.I32();
+    t.source_id = r.I32();
+    t.tar_cfid = r.F32();
+    const uint8_t  iden_length = r.U8();
+    const uint8_t *iden = r.Bytes(iden_length);
+    if (iden != nullptr)
+        t.tar_iden.assign(reinterpret_cast<const char *>(iden), iden_length);
+    for (size_t i = 0; i < kBinaryDoubleCount; ++i)
+    {
+        *TargetDoubleField(t, i) = (mask & (1u << i)) ? r.F64() : 0.0;
+    }
+
+    // 跳过新版本在记录末尾追加的字段
+    const size_t consumed = static_cast<size_t>(r.position() - start);
+    if (!r.ok() || consumed > record_length)
+    {
+        return false;
+    }
+    r.Bytes(record_length - consumed);
+    return r.ok();
+}
+
+// 按报文头选择帧版本：聚合报文为版本 4，带发送时刻为版本 3，分片为版本 2，否则为版本 1
+uint8_t BinaryVersionFor(const MessageHeader &header)
+{
+    if (header.send_us != 0)
+        return header.src_cnt > 0 ? kEOBinaryBatchVersion : kEOBinarySequenceVersion;
+    return header.frag_cnt > 1 ? kEOBinaryFragmentVersion : kEOBinaryVersion;
+}
+
+// 报文头之后扩展字段的长度；不支持的版本返回 SIZE_MAX
+size_t BinaryExtensionSize(uint8_t version)
+{
+    switch (version)
+    {
+    case kEOBinaryVersion:
+        return 0;
+    case kEOBinaryFragmentVersion:
+        return kBinaryFragmentFieldsSize;
+    case kEOBinarySequenceVersion:
+        return kBinarySequenceFieldsSize;
+    case kEOBinaryBatchVersion:
+        return kBinaryBatchFieldsSize;
+    default:
+        return SIZE_MAX;
+    }
+}
+
+void WriteBinaryExtension(BinaryWriter &w, uint8_t version, const MessageHeader &header)
+{
+    if (version >= kEOBinarySequenceVersion)
+    {
+        w.U32(header.src_sn);
+        w.U64(static_cast<uint64_t>(header.send_us));
+    }
+    if (version != kEOBinaryVersion)
+    {
+        w.U16(static_cast<uint16_t>(header.frag_idx));
+        w.U16(static_cast<uint16_t>(header.frag_cnt));
+    }
+    if (version == kEOBinaryBatchVersion)
+    {
+        w.U16(static_cast<uint16_t>(header.src_cnt));
+        w.U16(0);
+    }
+}
+
+void ReadBinaryExtension(BinaryReader &r, uint8_t version, MessageHeader &header)
+{
+    if (version >= kEOBinarySequenceVersion)
+    {
+        header.src_sn = r.U32();
+        header.send_us = static_cast<int64_t>(r.U64());
+    }
+    if (version != kEOBinaryVersion)
+    {
+        header.frag_idx = r.U16();
+        header.frag_cnt = r.U16();
+    }
+    if (version == kEOBinaryBatchVersion)
+    {
+        header.src_cnt = r.U16();
+        r.U16();
+    }
+}
+
+// 帧头、版本、报文类型与帧长占位
+void WriteBinaryPreamble(BinaryWriter &w, uint8_t version, BodyType type)
+{
+    w.U8(kEOBinarySync0);
+    w.U8(kEOBinarySync1);
+    w.U8(version);
+    w.U8(static_cast<uint8_t>(type));
+    w.U32(0); // 帧长，写完后回填
+}
+
+// 回填帧长并写入校验和与帧尾，返回整帧长度；缓冲区不足时返回0
+size_t FinishBinaryFrame(BinaryWriter &w)
+{
+    if (!w.ok())
+    {
+        return 0;
+    }
+
+    const size_t frame_length = w.size() + kBinaryTrailerSize;
+    w.PatchU32(4, static_cast<uint32_t>(frame_length));
+    w.U16(EOProtocolParser::CalculateChecksum(w.data(), w.size()));
+    w.U8(kEOBinaryTail0);
+    w.U8(kEOBinaryTail1);
+    return w.ok() ? w.size() : 0;
+}
+
+// 校验帧长、帧尾与校验和；headerSize 为帧头之后的最小报文头长度
+bool CheckBinaryFrame(const uint8_t *data, size_t length, size_t headerSize,
+                      size_t &checksumOffset)
+{
+    if (length < kBinaryPreambleSize + headerSize + kBinaryTrailerSize)
+    {
+        return false;
+    }
+    BinaryReader   preamble(data + 4, data + 8);
+    const uint32_t frame_length = preamble.U32();
+    if (frame_length > length ||
+        frame_length < kBinaryPreambleSize + headerSize + kBinaryTrailerSize ||
+        !EOProtocolParser::VerifyFrameTail(data, frame_length))
+    {
+        return false;
+    }
+
+    checksumOffset = frame_length - kBinaryTrailerSize;
+    BinaryReader trailer(data + checksumOffset, data + frame_length);
+    return trailer.U16() == EOProtocolParser::CalculateChecksum(data, checksumOffset);
+}
+
+// 差分帧字段掩码位，按变化频率排序，使稳定场景下的掩码只占 1 字节
+constexpr unsigned kDeltaMsec = 0;
+constexpr unsigned kDeltaTarCfid = 3;
+constexpr unsigned kDeltaTarIden = 6;
+constexpr unsigned kDeltaDoubles = 19; // 19~30 依次对应 TargetDoubleField
+constexpr unsigned kDeltaFieldCount = kDeltaDoubles + kBinaryDoubleCount;
+// source_id(4) + base_sn(2)
+constexpr size_t kDeltaInfoSize = 6;
+
+// 心跳报文：send_us(8) + 视频源个数(2)，之后每个视频源 source_id(4) + src_sn(4)
+constexpr size_t kHeartbeatInfoSize = 10;
+constexpr size_t kHeartbeatEntrySize = 8;
+// FEC 校验报文：group_sn(4) + k(1) + m(1) + parity_idx(1) + scheme(1) + symbol_size(2)
+// + 保留(2)，之后每个数据报文 length(2) + hash(4)，最后为校验数据
+constexpr size_t kFecInfoSize = 12;
+constexpr size_t kFecEntrySize = 6;
+// JSON 心跳：{"heartbeat":[...],"send_us":...} 的固定部分与单个视频源的最大长度
+constexpr size_t kHeartbeatJsonFixedSize = 64;
+constexpr size_t kHeartbeatJsonEntrySize = 48;
+
+// 以 zigzag 变长差值编码的整型字段；time 表示参考本报文前一个目标
+struct DeltaIntField
+{
+    unsigned          bit;
+    int EOTargetInfo::*member;
+    bool              time;
+};
+
+const DeltaIntField kDeltaIntFields[] = {
+    {1, &EOTargetInfo::sec, true},
+    {2, &EOTargetInfo::tar_rect, false},
+    {4, &EOTargetInfo::trk_stat, false},
+    {5, &EOTargetInfo::tar_category, false},
+    {7, &EOTargetInfo::min, true},
+    {8, &EOTargetInfo::h, true},
+    {9, &EOTargetInfo::dy, true},
+    {10, &EOTargetInfo::mo, true},
+    {11, &EOTargetInfo::yr, true},
+    {12, &EOTargetInfo::offset_h, false},
+    {13, &EOTargetInfo::offset_v, false},
+    {14, &EOTargetInfo::source_id, false},
+    {15, &EOTargetInfo::tar_id, false},
+    {16, &EOTargetInfo::guid_id, false},
+    {17, &EOTargetInfo::dev_id, false},
+    {18, &EOTargetInfo::trk_mod, false},
+};
+
+// 没有上一报文时的参考目标（全部字段为 0）
+const EOTargetInfo kZeroTarget = EOTargetInfo();
+
+template <typename T> bool SameBits(T a, T b)
+{
+    return memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+uint64_t ZigZag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// 差分帧第 index 个目标的参考：时间字段参考本报文前一个目标，其余字段参考上一报文
+const EOTargetInfo &DeltaReference(const EOTargetInfo *reference,
+                                   size_t referenceCount, size_t index)
+{
+    if (referenceCount == 0)
+        return kZeroTarget;
+    return reference[index < referenceCount ? index : referenceCount - 1];
+}
+
+void WriteDeltaTarget(BinaryWriter &w, const EOTargetInfo &t,
+                      const EOTargetInfo &timeRef, const EOTargetInfo &ref)
+{
+    uint32_t mask = 0;
+    if (!SameBits(t.msec, timeRef.msec))
+        mask |= 1u << kDeltaMsec;
+    if (!SameBits(t.tar_cfid, ref.tar_cfid))
+        mask |= 1u << kDeltaTarCfid;
+    if (t.tar_iden != ref.tar_iden)
+        mask |= 1u << kDeltaTarIden;
+    for (const DeltaIntField &field : kDeltaIntFields)
+    {
+        const EOTargetInfo &r = field.time ? timeRef : ref;
+        if (t.*field.member != r.*field.member)
+            mask |= 1u << field.bit;
+    }
+    for (size_t i = 0; i < kBinaryDoubleCount; ++i)
+    {
+        if (!SameBits(*TargetDoubleField(t, i), *TargetDoubleField(ref, i)))
+            mask |= 1u << (kDeltaDoubles + i);
+    }
+
+    w.Varint(mask);
+    if (mask & (1u << kDeltaMsec))
+        w.F32(t.msec);
+    if (mask & (1u << kDeltaTarCfid))
+        w.F32(t.tar_cfid);
+    if (mask & (1u << kDeltaTarIden))
+    {
+        const size_t iden_length = t.tar_iden.size();
+        w.U8(static_cast<uint8_t>(iden_length));
+        w.Bytes(t.tar_iden.data(), iden_length);
+    }
+    for (const DeltaIntField &field : kDeltaIntFields)
+    {
+        const EOTargetInfo &r = field.time ? timeRef : ref;
+        if (mask & (1u << field.bit))
+            w.Varint(ZigZag(static_cast<int64_t>(t.*field.member) - r.*field.member));
+    }
+    for (size_t i = 0; i < kBinaryDoubleCount; ++i)
+    {
+        if (mask & (1u << (kDeltaDoubles + i)))
+            w.F64(*TargetDoubleField(t, i));
+    }
+}
+
+bool ReadDeltaTarget(BinaryReader &r, EOTargetInfo &t,
+                     const EOTargetInfo &timeRef, const EOTargetInfo &ref)
+{
+    const uint64_t mask = r.Varint();
+    if (!r.ok() || mask >= (1ull << kDeltaFieldCount))
+    {
+        return false;
+    }
+
+    t = ref; // 未置位的字段等于参考值
+    t.yr = timeRef.yr;
+    t.mo = timeRef.mo;
+    t.dy = timeRef.dy;
+    t.h = timeRef.h;
+    t.min = timeRef.min;
+    t.sec = timeRef.sec;
+    t.msec = timeRef.msec;
+
+    if (mask & (1u << kDeltaMsec))
+        t.msec = r.F32();
+    if (mask & (1u << kDeltaTarCfid))
+        t.tar_cfid = r.F32();
+    if (mask & (1u << kDeltaTarIden))
+    {
+        const uint8_t  iden_length = r.U8();
+        const uint8_t *iden = r.Bytes(iden_length);
+        if (iden != nullptr)
+            t.tar_iden.assign(reinterpret_cast<const char *>(iden), iden_length);
+    }
+    for (const DeltaIntField &field : kDeltaIntFields)
+    {
+        if (mask & (1u << field.bit))
+            t.*field.member = static_cast<int>(t.*field.member + UnZigZag(r.Varint()));
+    }
+    for (size_t i = 0; i < kBinaryDoubleCount; ++i)
+    {
+        if (mask & (1u << (kDeltaDoubles + i)))
+            *TargetDoubleField(t, i) = r.F64();
+    }
+    return r.ok();
+}
+
+// 校验差分帧并读取报文头、source_id 与 base_sn，返回目标差分的起始位置；非法时返回 nullptr
+const uint8_t *ReadDeltaPrefix(const uint8_t *data, size_t length, MessageHeader &header,
+                               uint32_t &sourceId, uint16_t &baseSn,
+                               size_t &checksumOffset)
+{
+    if (!EOProtocolParser::IsDeltaMessage(data, length) || length < kBinaryPreambleSize ||
+        data[2] == kEOBinaryFragmentVersion || BinaryExtensionSize(data[2]) == SIZE_MAX)
+    {
+        return nullptr;
+    }
+    const size_t prefix_size = kBinaryHeaderSize + BinaryExtensionSize(data[2]) + kDeltaInfoSize;
+    if (!CheckBinaryFrame(data, length, prefix_size, checksumOffset))
+    {
+        return nullptr;
+    }
+
+    BinaryReader r(data + kBinaryPreambleSize, data + kBinaryPreambleSize + prefix_size);
+    header = MessageHeader();
+    ReadBinaryHeader(r, header);
+    ReadBinaryExtension(r, data[2], header);
+    sourceId = r.U32();
+    baseSn = r.U16();
+    return r.ok() ? r.position() : nullptr;
+}
+
+// 按给定报文头封装 JSON 报文。
+// 按 jsoncpp 的键顺序输出："cont" 数组在最前，其余报文头字段随后
+size_t PackJsonMessage(const EOTargetInfo  *targetInfos,
+                       size_t               count,
+                       const MessageHeader &header,
+                       uint8_t             *buffer,
+                       size_t               capacity)
+{
+    JsonStreamWriter w(buffer, capacity);
+    w.Literal("{\"cont\":[");
+    for (size_t i = 0; i < count && w.ok(); ++i) // 超出容量后不再格式化剩余目标
+    {
+        if (i > 0)
+        {
+            w.Char(',');
+        }
+        WriteTargetInfo(w, targetInfos[i]);
+    }
+    w.Char(']');
+    WriteHeaderFields(w, header);
+    w.Char('}');
+
+    return w.ok() ? w.size() : 0;
+}
+
+// 按给定报文头封装二进制报文
+size_t PackBinaryMessage(const EOTargetInfo  *targetInfos,
+                         size_t               count,
+                         const MessageHeader &header,
+                         uint8_t             *buffer,
+                         size_t               capacity)
+{
+    const uint8_t version = BinaryVersionFor(header);
+    BinaryWriter  w(buffer, capacity);
+    WriteBinaryPreamble(w, version, BodyType::BINARY);
+    WriteBinaryHeader(w, header);
+    WriteBinaryExtension(w, version, header);
+    for (size_t i = 0; i < count; ++i)
+    {
+        WriteBinaryTarget(w, targetInfos[i]);
+    }
+    return FinishBinaryFrame(w);
+}
+
+// 把单个目标编码到 scratch，返回编码长度；空间不足时返回0
+size_t EncodeTarget(const EOTargetInfo &t, BodyType format, uint8_t *scratch,
+                    size_t capacity)
+{
+    if (format == BodyType::BINARY)
+    {
+        BinaryWriter w(scratch, capacity);
+        WriteBinaryTarget(w, t);
+        return w.ok() ? w.size() : 0;
+    }
+    JsonStreamWriter w(scratch, capacity);
+    WriteTargetInfo(w, t);
+    return w.ok() ? w.size() : 0;
+}
+
+// 用已编码的 cont 数组内容（目标之间含逗号）封装 JSON 分片报文
+size_t PackJsonFragment(const uint8_t *body, size_t length,
+                        const MessageHeader &header, uint8_t *buffer,
+                        size_t capacity)
+{
+    JsonStreamWriter w(buffer, capacity);
+    w.Literal("{\"cont\":[");
+    w.Append(body, length);
+    w.Char(']');
+    WriteHeaderFields(w, header);
+    w.Char('}');
+    return w.ok() ? w.size() : 0;
+}
+
+// 用已编码的目标记录封装二进制分片报文；frag_cnt 为 1 时（单个超长目标）按普通报文输出
+size_t PackBinaryFragment(const uint8_t *body, size_t length,
+                          const MessageHeader &header, uint8_t *buffer,
+                          size_t capacity)
+{
+    const uint8_t version = BinaryVersionFor(header);
+    BinaryWriter  w(buffer, capacity);
+    WriteBinaryPreamble(w, version, BodyType::BINARY);
+    WriteBinaryHeader(w, header);
+    WriteBinaryExtension(w, version, header);
+    w.Bytes(body, length);
+    return FinishBinaryFrame(w);
+}
+
+// 报文中除目标以外部分的长度上限（frag_idx / frag_cnt / cont_sum 按最宽取值估算）
+size_t MeasureFragmentOverhead(const MessageHeader &header, BodyType format,
+                               uint8_t *scratch, size_t capacity)
+{
+    if (format == BodyType::BINARY)
+    {
+        MessageHeader fragmented = header;
+        fragmented.frag_cnt = 2;
+        return kBinaryPreambleSize + kBinaryHeaderSize +
+               BinaryExtensionSize(BinaryVersionFor(fragmented)) + kBinaryTrailerSize;
+    }
+    MessageHeader widest = header;
+    widest.cont_sum = UINT16_MAX;
+    widest.frag_idx = UINT16_MAX;
+    widest.frag_cnt = UINT16_MAX;
+    JsonStreamWriter w(scratch, capacity);
+    w.Literal("{\"cont\":[");
+    w.Char(']');
+    WriteHeaderFields(w, widest);
+    w.Char('}');
+    return w.ok() ? w.size() : 0;
+}
+
+// 列式 JSON 编码：帧内共享的字段段、按种类转义好的 tar_iden、整列格式化好的
+// tar_cfid 在封装前各准备一次，逐目标只拼接片段并格式化 3 个整数。
+// 线程内复用一个实例，稳定运行后不分配内存。
+class JsonColumnEncoder
+{
+  public:
+    bool Prepare(const EOTargetColumns &columns)
+    {
+        columns_ = &columns;
+        const EOTargetInfo &common = columns.common();
+        segments_.resize(kMaxTargetJsonSize);
+        JsonStreamWriter w(segments_.data(), segments_.size());
+        WriteTargetHead(w, common);
+        head_ = w.size();
+        WriteTargetBody(w, common);
+        body_ = w.size();
+        WriteTargetTail(w, common);
+        tail_ = w.size();
+        WriteTargetEnd(w, common);
+        end_ = w.size();
+        if (!w.ok())
+        {
+            return false;
+        }
+
+        // 每种 tar_iden 只转义一次
+        idens_.resize(columns.iden_count() * kMaxIdenJsonSize);
+        iden_length_.resize(columns.iden_count());
+        for (size_t i = 0; i < columns.iden_count(); ++i)
+        {
+            const EOIdenString &iden = columns.iden(i);
+            JsonStreamWriter    iw(&idens_[i * kMaxIdenJsonSize], kMaxIdenJsonSize);
+            iw.String(iden.data(), iden.size());
+            iden_length_[i] = static_cast<uint16_t>(iw.size());
+        }
+
+        // 整列格式化置信度
+        const size_t count = columns.size();
+        cfid_.resize(count * kMaxNumberLength);
+        cfid_length_.resize(count);
+        const float *cfid = columns.tar_cfid();
+        for (size_t i = 0; i < count; ++i)
+        {
+            JsonStreamWriter fw(&cfid_[i * kMaxNumberLength], kMaxNumberLength);
+            fw.Float(cfid[i]);
+            cfid_length_[i] = static_cast<uint8_t>(fw.size());
+        }
+        return true;
+    }
+
+    size_t size() const { return columns_->size(); }
+
+    void Write(JsonStreamWriter &w, size_t index) const
+    {
+        const EOTargetColumns &c = *columns_;
+        const uint16_t         iden = c.iden_index()[index];
+        w.Append(segments_.data(), head_);
+        w.Int(c.tar_category()[index]);
+        w.Literal(",\"tar_cfid\":");
+        w.Append(&cfid_[index * kMaxNumberLength], cfid_length_[index]);
+        w.Append(segments_.data() + head_, body_ - head_);
+        w.Append(&idens_[iden * kMaxIdenJsonSize], iden_length_[iden]);
+        w.Literal(",\"tar_rect\":");
+        w.Int(c.tar_rect()[index]);
+        w.Append(segments_.data() + body_, tail_ - body_);
+        w.Int(c.trk_stat()[index]);
+        w.Append(segments_.data() + tail_, end_ - tail_);
+    }
+
+  private:
+    // 63 字节的 tar_iden 每字节最多转义为 6 字节，另加两个引号
+    static const size_t kMaxIdenJsonSize = EOIdenString::kCapacity * 6 + 2;
+
+    const EOTargetColumns *columns_ = nullptr;
+    std::vector<uint8_t>   segments_;
+    size_t                 head_ = 0;
+    size_t                 body_ = 0;
+    size_t                 tail_ = 0;
+    size_t                 end_ = 0;
+    std::vector<uint8_t>   idens_;
+    std::vector<uint16_t>  iden_length_;
+    std::vector<uint8_t>   cfid_;
+    std::vector<uint8_t>   cfid_length_;
+};
+
+// 目标记录中逐目标字段的偏移，对应 WriteBinaryTarget 的写入顺序
+constexpr size_t kRecordTrkStatOffset = 28;
+constexpr size_t kRecordTarCategoryOffset = 36;
+constexpr size_t kRecordTarRectOffset = 48;
+constexpr size_t kRecordTarCfidOffset = 56;
+constexpr size_t kRecordIdenLengthOffset = 60;
+
+void StoreU32(uint8_t *p, uint32_t value)
+{
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+// 列式二进制编码：以共享字段编码一条 tar_iden 为空的记录作为模板，
+// 逐目标拷贝模板后回填记录长度与 5 个变化字段
+class BinaryColumnEncoder
+{
+  public:
+    bool Prepare(const EOTargetColumns &columns)
+    {
+        columns_ = &columns;
+        BinaryWriter w(record_, sizeof(record_));
+        WriteBinaryTarget(w, columns.common());
+        if (!w.ok() || w.size() < kBinaryTargetFixedSize)
+        {
+            return false;
+        }
+        doubles_length_ = w.size() - kBinaryTargetFixedSize;
+        memcpy(doubles_, record_ + kBinaryTargetFixedSize, doubles_length_);
+        return true;
+    }
+
+    size_t size() const { return columns_->size(); }
+
+    void Write(BinaryWriter &w, size_t index) const
+    {
+        const EOTargetColumns &c = *columns_;
+        const EOIdenString    &iden = c.iden(c.iden_index()[index]);
+        uint8_t                record[sizeof(record_)];
+        const size_t           length = kBinaryTargetFixedSize + iden.size() + doubles_length_;
+        uint32_t               cfid;
+        memcpy(&cfid, &c.tar_cfid()[index], sizeof(cfid));
+
+        memcpy(record, record_, kBinaryTargetFixedSize);
+        record[0] = static_cast<uint8_t>(length);
+        record[1] = static_cast<uint8_t>(length >> 8);
+        StoreU32(record + kRecordTrkStatOffset, static_cast<uint32_t>(c.trk_stat()[index]));
+        StoreU32(record + kRecordTarCategoryOffset,
+                 static_cast<uint32_t>(c.tar_category()[index]));
+        StoreU32(record + kRecordTarRectOffset, static_cast<uint32_t>(c.tar_rect()[index]));
+        StoreU32(record + kRecordTarCfidOffset, cfid);
+        record[kRecordIdenLengthOffset] = static_cast<uint8_t>(iden.size());
+        memcpy(record + kBinaryTargetFixedSize, iden.data(), iden.size());
+        memcpy(record + kBinaryTargetFixedSize + iden.size(), doubles_, doubles_length_);
+        w.Bytes(record, length);
+    }
+
+  private:
+    const EOTargetColumns *columns_ = nullptr;
+    uint8_t record_[kBinaryTargetFixedSize + EOIdenString::kCapacity +
+                    kBinaryDoubleCount * sizeof(double)];
+    uint8_t doubles_[kBinaryDoubleCount * sizeof(double)];
+    size_t  doubles_length_ = 0;
+};
+
+// 分片规划与封装，逐个目标与列式两种输入共用。
+// packWhole(header, buffer, capacity) 封装整条报文；
+// encodeTarget(index, scratch, capacity) 编码单个目标，空间不足时返回0
+template <typename PackWhole, typename EncodeTarget>
+size_t PackFragments(size_t count, MessageHeader &header, BodyType format,
+                     size_t maxDatagramSize, uint8_t *buffer, size_t capacity,
+                     std::vector<EOFragment> &fragments, PackWhole packWhole,
+                     EncodeTarget encodeTarget)
+{
+    const bool binary = (format == BodyType::BINARY);
+
+    // 常见情况：整条报文不超过上限，只编码一次
+    if (!binary || count <= UINT16_MAX)
+    {
+        size_t length = packWhole(header, buffer, std::min(capacity, maxDatagramSize));
+        if (length > 0)
+        {
+            fragments.push_back(EOFragment{0, length, 0, count});
+            return 1;
+        }
+    }
+
+    // 分片：每个目标只编码一次，写入 buffer 后半部分的暂存区，同时贪心规划分片；
+    // JSON 目标之间的逗号一并写入暂存区。fragments 先记录各分片在暂存区中的范围，
+    // 再逐个拷贝到前半部分组成报文（容量见 GetMaxEOTargetFragmentsSize）。
+    const size_t overhead =
+        MeasureFragmentOverhead(header, format, buffer, capacity);
+    const size_t   half = capacity / 2;
+    uint8_t *const scratch = buffer + half;
+    const size_t   scratch_capacity = capacity - half;
+    const size_t   separator = binary ? 0 : 1;
+    size_t         pos = 0;
+    size_t         used = 0;
+    if (overhead == 0)
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t start = pos + separator;
+        const size_t size =
+            (start < scratch_capacity)
+                ? encodeTarget(i, scratch + start, scratch_capacity - start)
+                : 0;
+        if (size == 0)
+        {
+            fragments.clear();
+            return 0;
+        }
+        if (fragments.empty() ||
+            used + separator + size > maxDatagramSize ||
+            fragments.back().count == UINT16_MAX)
+        {
+            fragments.push_back(EOFragment{start, 0, i, 0});
+            used = overhead + size;
+        }
+        else
+        {
+            if (!binary)
+                scratch[pos] = ',';
+            used += separator + size;
+        }
+        EOFragment &fragment = fragments.back();
+        fragment.length = start + size - fragment.offset;
+        ++fragment.count;
+        pos = start + size;
+    }
+    if (fragments.size() > UINT16_MAX)
+    {
+        fragments.clear();
+        return 0;
+    }
+
+    // 逐个封装：各分片共用 msg_sn 与时间，cont_sum 为分片内目标数
+    auto   pack_fragment = binary ? PackBinaryFragment : PackJsonFragment;
+    size_t offset = 0;
+    header.frag_cnt = static_cast<int>(fragments.size());
+    for (size_t i = 0; i < fragments.size(); ++i)
+    {
+        EOFragment  &fragment = fragments[i];
+        const size_t body = fragment.offset;
+        header.frag_idx = static_cast<int>(i);
+        header.cont_sum = static_cast<int>(fragment.count);
+        fragment.offset = offset;
+        fragment.length = (offset < half)
+                              ? pack_fragment(scratch + body, fragment.length,
+                                              header, buffer + offset, half - offset)
+                              : 0;
+        if (fragment.length == 0)
+        {
+            fragments.clear();
+            return 0;
+        }
+        offset += fragment.length;
+    }
+    return fragments.size();
+}
+
+// 多帧列式目标中的全局下标 → (帧, 帧内下标)。分片编码按下标顺序访问，
+// 缓存当前帧，只有跨帧时才二分查找
+class ColumnBatchIndex
+{
+  public:
+    void Reset(const EOTargetColumns *const *frames, size_t count)
+    {
+        starts_.resize(count + 1);
+        starts_[0] = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            starts_[i + 1] = starts_[i] + frames[i]->size();
+        }
+        frame_ = 0;
+    }
+
+    size_t total() const { return starts_.back(); }
+
+    size_t Locate(size_t index, size_t &local)
+    {
+        if (index < starts_[frame_] || index >= starts_[frame_ + 1])
+        {
+            frame_ = static_cast<size_t>(
+                std::upper_bound(starts_.begin(), starts_.end(), index) - starts_.begin() - 1);
+        }
+        local = index - starts_[frame_];
+        return frame_;
+    }
+
+  private:
+    std::vector<size_t> starts_;
+    size_t              frame_ = 0;
+};
+
+// 按给定报文头封装多帧列式目标的 JSON 报文
+size_t PackColumnJsonMessage(const JsonColumnEncoder *encoders, size_t frameCount,
+                             const MessageHeader &header, uint8_t *buffer, size_t capacity)
+{
+    JsonStreamWriter w(buffer, capacity);
+    bool             first = true;
+    w.Literal("{\"cont\":[");
+    for (size_t f = 0; f < frameCount; ++f)
+    {
+        for (size_t i = 0; i < encoders[f].size() && w.ok(); ++i)
+        {
+            if (!first)
+            {
+                w.Char(',');
+            }
+            first = false;
+            encoders[f].Write(w, i);
+        }
+    }
+    w.Char(']');
+    WriteHeaderFields(w, header);
+    w.Char('}');
+    return w.ok() ? w.size() : 0;
+}
+
+// 按给定报文头封装多帧列式目标的二进制报文
+size_t PackColumnBinaryMessage(const BinaryColumnEncoder *encoders, size_t frameCount,
+                               const MessageHeader &header, uint8_t *buffer,
+                               size_t capacity)
+{
+    const uint8_t version = BinaryVersionFor(header);
+    BinaryWriter  w(buffer, capacity);
+    WriteBinaryPreamble(w, version, BodyType::BINARY);
+    WriteBinaryHeader(w, header);
+    WriteBinaryExtension(w, version, header);
+    for (size_t f = 0; f < frameCount; ++f)
+    {
+        for (size_t i = 0; i < encoders[f].size() && w.ok(); ++i)
+        {
+            encoders[f].Write(w, i);
+        }
+    }
+    return FinishBinaryFrame(w);
+}
+
+// 列式分片所需缓冲区大小上限：binary 与逐个目标编码相同，JSON 的 tar_iden 按 63 字节全部转义估算
+size_t ColumnFragmentsSize(size_t count, BodyType format)
+{
+    if (format == BodyType::BINARY)
+    {
+        return EOProtocolParser::GetMaxEOTargetFragmentsSize(nullptr, count, format);
+    }
+    return (kMaxHeaderJsonSize + count * (kMaxTargetJsonSize + EOIdenString::kCapacity * 6) +
+            count * kMaxHeaderJsonSize) *
+           2;
+}
+
+} // namespace
+
 std::vector<uint8_t>
 EOProtocolParser::PackEOTargetMessage(const std::vector<EOTargetInfo> &targetInfos,
                                       uint16_t                          sendCount)
 {
-    // 如果没有目标信息，返回空消息
-    if (targetInfos.empty()) {
-        return std::vector<uint8_t>();
+    // 如果没有目标信息，返回空消息
+    if (targetInfos.empty()) {
+        return std::vector<uint8_t>();
+    }
+
+    std::vector<uint8_t> message(
+        GetMaxEOTargetMessageSize(targetInfos.data(), targetInfos.size()));
+    size_t length = PackEOTargetMessage(targetInfos.data(), targetInfos.size(),
+                                        sendCount, message.data(),
+                                        message.size());
+    message.resize(length);
+
+    return message;
+}
+
+size_t EOProtocolParser::PackEOTargetMessage(const EOTargetInfo *targetInfos,
+                                             size_t              count,
+                                             uint16_t            sendCount,
+                                             uint8_t            *buffer,
+                                             size_t              capacity)
+{
+    if (targetInfos == nullptr || count == 0 || buffer == nullptr)
+    {
+        return 0;
+    }
+
+    // 创建报文头
+    MessageHeader header;
+    FillMessageHeader(header, sendCount, static_cast<int>(count));
+
+    return PackJsonMessage(targetInfos, count, header, buffer, capacity);
+}
+
+size_t EOProtocolParser::GetMaxEOTargetMessageSize(const EOTargetInfo *targetInfos,
+                                                   size_t              count)
+{
+    size_t size = kMaxHeaderJsonSize;
+    for (size_t i = 0; i < count; ++i)
+    {
+        // 每个输入字节最多转义为 6 字节（\uXXXX）
+        size += kMaxTargetJsonSize + targetInfos[i].tar_iden.size() * 6;
+    }
+    return size;
+}
+
+size_t EOProtocolParser::PackEOTargetBinaryMessage(const EOTargetInfo *targetInfos,
+                                                   size_t              count,
+                                                   uint16_t            sendCount,
+                                                   uint8_t            *buffer,
+                                                   size_t              capacity)
+{
+    if (targetInfos == nullptr || count == 0 || buffer == nullptr ||
+        count > UINT16_MAX)
+    {
+        return 0;
     }
 
-    // 创建报文头
     MessageHeader header;
-    FillMessageHeader(header, sendCount, static_cast<int>(targetInfos.size()));
+    FillMessageHeader(header, sendCount, static_cast<int>(count));
 
-    // 创建JSON报文 - 包含报文头和目标数组
-    Json::Value jsonMessage;
-    
-    // 添加报文头
-    jsonMessage["msg_id"] = header.msg_id;
-    jsonMessage["msg_sn"] = header.msg_sn;
-    jsonMessage["msg_type"] = header.msg_type;
-    jsonMessage["tx_sys_id"] = header.tx_sys_id;
-    jsonMessage["tx_dev_type"] = header.tx_dev_type;
-    jsonMessage["tx_dev_id"] = header.tx_dev_id;
-    jsonMessage["tx_subdev_id"] = header.tx_subdev_id;
-    jsonMessage["rx_sys_id"] = header.rx_sys_id;
-    jsonMessage["rx_dev_type"] = header.rx_dev_type;
-    jsonMessage["rx_dev_id"] = header.rx_dev_id;
-    jsonMessage["rx_subdev_id"] = header.rx_subdev_id;
-    jsonMessage["yr"] = header.yr;
-    jsonMessage["mo"] = header.mo;
-    jsonMessage["dy"] = header.dy;
-    jsonMessage["h"] = header.h;
-    jsonMessage["min"] = header.min;
-    jsonMessage["sec"] = header.sec;
-    jsonMessage["msec"] = header.msec;
-    jsonMessage["cont_type"] = header.cont_type;
-    jsonMessage["cont_sum"] = header.cont_sum;
-    
-    // 添加目标数组
-    jsonMessage["cont"] = Json::Value(Json::arrayValue);
-    for (const auto& targetInfo : targetInfos) {
-        Json::Value targetJson = CreateTargetInfoJson(targetInfo);
-        jsonMessage["cont"].append(targetJson);
+    return PackBinaryMessage(targetInfos, count, header, buffer, capacity);
+}
+
+size_t EOProtocolParser::GetMaxEOTargetBinaryMessageSize(size_t count)
+{
+    return kBinaryPreambleSize + kBinaryHeaderSize + kBinaryTrailerSize +
+           count * (kBinaryTargetFixedSize + kEOBinaryMaxIdenLength +
+                    kBinaryDoubleCount * sizeof(double));
+}
+
+size_t EOProtocolParser::PackEOTargetFragments(const EOTargetInfo      *targetInfos,
+                                               size_t                   count,
+                                               uint16_t                 sendCount,
+                                               BodyType                 format,
+                                               size_t                   maxDatagramSize,
+                                               uint8_t                 *buffer,
+                                               size_t                   capacity,
+                                               std::vector<EOFragment> &fragments,
+                                               const EOSequence        *sequence)
+{
+    fragments.clear();
+    if (targetInfos == nullptr || count == 0 || buffer == nullptr ||
+        maxDatagramSize == 0)
+    {
+        return 0;
     }
-    
-    auto        writerBuilder = GetWriterBuilder();
-    std::string jsonStr = Json::writeString(*writerBuilder, jsonMessage);
 
-    // 将JSON字符串转换为字节数组
-    std::vector<uint8_t> message(jsonStr.begin(), jsonStr.end());
+    const bool binary = (format == BodyType::BINARY);
+    auto       pack = binary ? PackBinaryMessage : PackJsonMessage;
+    MessageHeader header;
+    FillMessageHeader(header, sendCount, static_cast<int>(count));
+    if (sequence != nullptr)
+    {
+        header.src_sn = sequence->src_sn;
+        header.send_us = sequence->send_us;
+        header.src_cnt = sequence->src_cnt;
+    }
 
-    return message;
+    return PackFragments(
+        count, header, format, maxDatagramSize, buffer, capacity, fragments,
+        [=](const MessageHeader &h, uint8_t *out, size_t size) {
+            return pack(targetInfos, count, h, out, size);
+        },
+        [=](size_t index, uint8_t *scratch, size_t size) {
+            return EncodeTarget(targetInfos[index], format, scratch, size);
+        });
+}
+
+size_t EOProtocolParser::PackEOTargetColumnFragments(const EOTargetColumns  &columns,
+                                                     uint16_t                 sendCount,
+                                                     BodyType                 format,
+                                                     size_t                   maxDatagramSize,
+                                                     uint8_t                 *buffer,
+                                                     size_t                   capacity,
+                                                     std::vector<EOFragment> &fragments,
+                                                     const EOSequence        *sequence)
+{
+    const EOTargetColumns *frames[1] = {&columns};
+    return PackEOTargetBatchFragments(frames, 1, sendCount, format, maxDatagramSize, buffer,
+                                      capacity, fragments, sequence);
+}
+
+size_t EOProtocolParser::GetMaxEOTargetColumnFragmentsSize(const EOTargetColumns &columns,
+                                                           BodyType               format)
+{
+    return ColumnFragmentsSize(columns.size(), format);
+}
+
+size_t EOProtocolParser::PackEOTargetBatchFragments(const EOTargetColumns *const *frames,
+                                                    size_t                        frameCount,
+                                                    uint16_t                      sendCount,
+                                                    BodyType                      format,
+                                                    size_t                        maxDatagramSize,
+                                                    uint8_t                      *buffer,
+                                                    size_t                        capacity,
+                                                    std::vector<EOFragment>      &fragments,
+                                                    const EOSequence             *sequence)
+{
+    fragments.clear();
+    if (frames == nullptr || frameCount == 0 || buffer == nullptr || maxDatagramSize == 0)
+    {
+        return 0;
+    }
+    for (size_t f = 0; f < frameCount; ++f)
+    {
+        if (frames[f] == nullptr)
+        {
+            return 0;
+        }
+    }
+
+    // 编码器与下标映射在线程内复用，稳定运行后不分配内存
+    static thread_local ColumnBatchIndex index;
+    index.Reset(frames, frameCount);
+    const size_t count = index.total();
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    MessageHeader header;
+    FillMessageHeader(header, sendCount, static_cast<int>(count));
+    if (sequence != nullptr)
+    {
+        header.src_sn = sequence->src_sn;
+        header.send_us = sequence->send_us;
+        header.src_cnt = sequence->src_cnt;
+    }
+
+    if (format == BodyType::BINARY)
+    {
+        static thread_local std::vector<BinaryColumnEncoder> encoders;
+        encoders.resize(std::max(encoders.size(), frameCount));
+        for (size_t f = 0; f < frameCount; ++f)
+        {
+            if (!encoders[f].Prepare(*frames[f]))
+            {
+                return 0;
+            }
+        }
+        return PackFragments(
+            count, header, format, maxDatagramSize, buffer, capacity, fragments,
+            [&](const MessageHeader &h, uint8_t *out, size_t size) {
+                return PackColumnBinaryMessage(encoders.data(), frameCount, h, out, size);
+            },
+            [&](size_t i, uint8_t *scratch, size_t size) -> size_t {
+                size_t       local = 0;
+                const size_t frame = index.Locate(i, local);
+                BinaryWriter w(scratch, size);
+                encoders[frame].Write(w, local);
+                return w.ok() ? w.size() : 0;
+            });
+    }
+
+    static thread_local std::vector<JsonColumnEncoder> encoders;
+    encoders.resize(std::max(encoders.size(), frameCount));
+    for (size_t f = 0; f < frameCount; ++f)
+    {
+        if (!encoders[f].Prepare(*frames[f]))
+        {
+            return 0;
+        }
+    }
+    return PackFragments(
+        count, header, format, maxDatagramSize, buffer, capacity, fragments,
+        [&](const MessageHeader &h, uint8_t *out, size_t size) {
+            return PackColumnJsonMessage(encoders.data(), frameCount, h, out, size);
+        },
+        [&](size_t i, uint8_t *scratch, size_t size) -> size_t {
+            size_t           local = 0;
+            const size_t     frame = index.Locate(i, local);
+            JsonStreamWriter w(scratch, size);
+            encoders[frame].Write(w, local);
+            return w.ok() ? w.size() : 0;
+        });
+}
+
+size_t EOProtocolParser::GetMaxEOTargetBatchFragmentsSize(const EOTargetColumns *const *frames,
+                                                          size_t                        frameCount,
+                                                          BodyType                      format)
+{
+    size_t count = 0;
+    for (size_t f = 0; f < frameCount; ++f)
+    {
+        count += frames[f]->size();
+    }
+    return ColumnFragmentsSize(count, format);
+}
+
+size_t EOProtocolParser::GetMaxEOTargetFragmentsSize(const EOTargetInfo *targetInfos,
+                                                     size_t              count,
+                                                     BodyType            format)
+{
+    // 前半部分存放报文（每个分片至少一个目标，分片数不超过目标数），
+    // 后半部分为编码目标的暂存区
+    size_t messages;
+    if (format == BodyType::BINARY)
+    {
+        messages = GetMaxEOTargetBinaryMessageSize(count) +
+                   (count + 1) * kBinaryBatchFieldsSize +
+                   count * (kBinaryPreambleSize + kBinaryHeaderSize + kBinaryTrailerSize);
+    }
+    else
+    {
+        messages = GetMaxEOTargetMessageSize(targetInfos, count) +
+                   count * kMaxHeaderJsonSize;
+    }
+    return messages * 2;
+}
+
+bool EOProtocolParser::IsBinaryMessage(const uint8_t *data, size_t length)
+{
+    return data != nullptr && length >= 2 && data[0] == kEOBinarySync0 &&
+           data[1] == kEOBinarySync1;
+}
+
+bool EOProtocolParser::ParseEOTargetBinaryMessage(const uint8_t             *data,
+                                                  size_t                     length,
+                                                  MessageHeader             &header,
+                                                  std::vector<EOTargetInfo> &targetInfos)
+{
+    if (length < kBinaryPreambleSize + kBinaryHeaderSize + kBinaryTrailerSize ||
+        !IsBinaryMessage(data, length) || BinaryExtensionSize(data[2]) == SIZE_MAX ||
+        data[3] != static_cast<uint8_t>(BodyType::BINARY))
+    {
+        return false;
+    }
+    const size_t header_size = kBinaryHeaderSize + BinaryExtensionSize(data[2]);
+
+    size_t checksum_offset = 0;
+    if (!CheckBinaryFrame(data, length, header_size, checksum_offset))
+    {
+        return false;
+    }
+
+    BinaryReader r(data + kBinaryPreambleSize, data + checksum_offset);
+    header = MessageHeader();
+    ReadBinaryHeader(r, header);
+    ReadBinaryExtension(r, data[2], header);
+    if (!r.ok())
+    {
+        return false;
+    }
+
+    // 目标数与剩余长度不符时直接拒绝，避免按伪造的 cont_sum 分配内存
+    const size_t count = static_cast<size_t>(header.cont_sum);
+    if (count * kBinaryTargetFixedSize >
+        checksum_offset - kBinaryPreambleSize - header_size)
+    {
+        return false;
+    }
+    if (targetInfos.size() < count)
+    {
+        targetInfos.resize(count);
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!ReadBinaryTarget(r, targetInfos[i]))
+        {
+            targetInfos.clear();
+            return false;
+        }
+    }
+    targetInfos.resize(count);
+
+    return !targetInfos.empty();
+}
+
+size_t EOProtocolParser::PackEOTargetDeltaMessage(const EOTargetInfo *targetInfos,
+                                                  size_t              count,
+                                                  const EOTargetInfo *reference,
+                                                  size_t              referenceCount,
+                                                  uint32_t            sourceId,
+                                                  uint16_t            sendCount,
+                                                  uint16_t            baseSn,
+                                                  uint8_t            *buffer,
+                                                  size_t              capacity,
+                                                  const EOSequence   *sequence)
+{
+    if (targetInfos == nullptr || count == 0 || buffer == nullptr)
+    {
+        return 0;
+    }
+
+    MessageHeader header;
+    FillMessageHeader(header, sendCount, count);
+    if (sequence != nullptr)
+    {
+        header.src_sn = sequence->src_sn;
+        header.send_us = sequence->send_us;
+    }
+
+    const uint8_t version = BinaryVersionFor(header);
+    BinaryWriter  w(buffer, capacity);
+    WriteBinaryPreamble(w, version, BodyType::DELTA);
+    WriteBinaryHeader(w, header);
+    WriteBinaryExtension(w, version, header);
+    w.U32(sourceId);
+    w.U16(baseSn);
+    for (size_t i = 0; i < count && w.ok(); ++i)
+    {
+        const EOTargetInfo &time_ref =
+            (i == 0) ? DeltaReference(reference, referenceCount, 0) : targetInfos[i - 1];
+        WriteDeltaTarget(w, targetInfos[i], time_ref,
+                         DeltaReference(reference, referenceCount, i));
+    }
+    return FinishBinaryFrame(w);
+}
+
+bool EOProtocolParser::IsDeltaMessage(const uint8_t *data, size_t length)
+{
+    return IsBinaryMessage(data, length) && length > 3 &&
+           data[3] == static_cast<uint8_t>(BodyType::DELTA);
+}
+
+bool EOProtocolParser::ReadEOTargetDeltaInfo(const uint8_t *data, size_t length,
+                                             MessageHeader &header, uint32_t &sourceId,
+                                             uint16_t &baseSn)
+{
+    size_t checksum_offset = 0;
+    return ReadDeltaPrefix(data, length, header, sourceId, baseSn, checksum_offset) !=
+           nullptr;
+}
+
+bool EOProtocolParser::ParseEOTargetDeltaMessage(const uint8_t             *data,
+                                                 size_t                     length,
+                                                 const EOTargetInfo        *reference,
+                                                 size_t                     referenceCount,
+                                                 MessageHeader             &header,
+                                                 std::vector<EOTargetInfo> &targetInfos)
+{
+    uint32_t       source_id = 0;
+    uint16_t       base_sn = 0;
+    size_t         checksum_offset = 0;
+    const uint8_t *body =
+        ReadDeltaPrefix(data, length, header, source_id, base_sn, checksum_offset);
+    if (body == nullptr)
+    {
+        return false;
+    }
+    BinaryReader r(body, data + checksum_offset);
+
+    // 每个目标至少 1 字节掩码
+    const size_t count = static_cast<size_t>(header.cont_sum);
+    if (count == 0 || count > static_cast<size_t>(data + checksum_offset - body))
+    {
+        return false;
+    }
+    targetInfos.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const EOTargetInfo &time_ref =
+            (i == 0) ? DeltaReference(reference, referenceCount, 0) : targetInfos[i - 1];
+        if (!ReadDeltaTarget(r, targetInfos[i], time_ref,
+                             DeltaReference(reference, referenceCount, i)))
+        {
+            targetInfos.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t EOProtocolParser::PackEOHeartbeatMessage(const EOHeartbeat *sources,
+                                                size_t             count,
+                                                BodyType           format,
+                                                int64_t            sendUs,
+                                                uint8_t           *buffer,
+                                                size_t             capacity)
+{
+    if (sources == nullptr || count == 0 || count > UINT16_MAX || buffer == nullptr)
+    {
+        return 0;
+    }
+
+    if (format == BodyType::JSON)
+    {
+        JsonStreamWriter w(buffer, capacity);
+        w.Literal("{\"heartbeat\":[");
+        for (size_t i = 0; i < count && w.ok(); ++i)
+        {
+            if (i > 0)
+                w.Char(',');
+            w.Literal("{\"source_id\":");
+            w.Int64(sources[i].source_id);
+            w.Literal(",\"src_sn\":");
+            w.Int64(sources[i].src_sn);
+            w.Char('}');
+        }
+        w.Literal("],\"send_us\":");
+        w.Int64(sendUs);
+        w.Char('}');
+        return w.ok() ? w.size() : 0;
+    }
+
+    BinaryWriter w(buffer, capacity);
+    WriteBinaryPreamble(w, kEOBinaryVersion, BodyType::HEARTBEAT);
+    w.U64(static_cast<uint64_t>(sendUs));
+    w.U16(static_cast<uint16_t>(count));
+    for (size_t i = 0; i < count; ++i)
+    {
+        w.U32(sources[i].source_id);
+        w.U32(sources[i].src_sn);
+    }
+    return FinishBinaryFrame(w);
+}
+
+size_t EOProtocolParser::GetMaxEOHeartbeatMessageSize(size_t count, BodyType format)
+{
+    if (format == BodyType::JSON)
+    {
+        return kHeartbeatJsonFixedSize + count * kHeartbeatJsonEntrySize;
+    }
+    return kBinaryPreambleSize + kHeartbeatInfoSize + count * kHeartbeatEntrySize +
+           kBinaryTrailerSize;
+}
+
+size_t EOProtocolParser::GetMaxEOHeartbeatSources(size_t maxDatagramSize, BodyType format)
+{
+    size_t fixed = GetMaxEOHeartbeatMessageSize(0, format);
+    size_t entry = (format == BodyType::JSON) ? kHeartbeatJsonEntrySize : kHeartbeatEntrySize;
+    if (maxDatagramSize <= fixed)
+    {
+        return 0;
+    }
+    return std::min<size_t>((maxDatagramSize - fixed) / entry, UINT16_MAX);
+}
+
+bool EOProtocolParser::IsHeartbeatMessage(const uint8_t *data, size_t length)
+{
+    if (IsBinaryMessage(data, length))
+    {
+        return length > 3 && data[3] == static_cast<uint8_t>(BodyType::HEARTBEAT);
+    }
+    if (data == nullptr)
+    {
+        return false;
+    }
+
+    // JSON 心跳以 "heartbeat" 键开头，目标报文以 "cont" 开头
+    auto   space = [](uint8_t c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    size_t i = 0;
+    while (i < length && space(data[i]))
+        ++i;
+    if (i >= length || data[i] != '{')
+    {
+        return false;
+    }
+    ++i;
+    while (i < length && space(data[i]))
+        ++i;
+    return length - i >= 11 && memcmp(data + i, "\"heartbeat\"", 11) == 0;
+}
+
+size_t EOProtocolParser::PackEOFecParityMessage(const EOFecParity &parity,
+                                                const EOFecEntry  *entries,
+                                                const uint8_t     *symbol,
+                                                uint8_t           *buffer,
+                                                size_t             capacity)
+{
+    if (entries == nullptr || symbol == nullptr || buffer == nullptr ||
+        parity.data_count == 0 || parity.parity_count == 0 ||
+        parity.parity_idx >= parity.parity_count)
+    {
+        return 0;
+    }
+
+    BinaryWriter w(buffer, capacity);
+    WriteBinaryPreamble(w, kEOBinaryVersion, BodyType::FEC);
+    w.U32(parity.group_sn);
+    w.U8(parity.data_count);
+    w.U8(parity.parity_count);
+    w.U8(parity.parity_idx);
+    w.U8(parity.scheme);
+    w.U16(parity.symbol_size);
+    w.U16(0);
+    for (size_t i = 0; i < parity.data_count; ++i)
+    {
+        w.U16(entries[i].length);
+        w.U32(entries[i].hash);
+    }
+    w.Bytes(symbol, parity.symbol_size);
+    return FinishBinaryFrame(w);
+}
+
+size_t EOProtocolParser::GetEOFecParityMessageSize(size_t dataCount, size_t symbolSize)
+{
+    return kBinaryPreambleSize + kFecInfoSize + dataCount * kFecEntrySize + symbolSize +
+           kBinaryTrailerSize;
+}
+
+bool EOProtocolParser::IsFecMessage(const uint8_t *data, size_t length)
+{
+    return IsBinaryMessage(data, length) && length > 3 &&
+           data[3] == static_cast<uint8_t>(BodyType::FEC);
+}
+
+bool EOProtocolParser::ParseEOFecParityMessage(const uint8_t           *data,
+                                               size_t                   length,
+                                               EOFecParity             &parity,
+                                               std::vector<EOFecEntry> &entries,
+                                               const uint8_t          *&symbol)
+{
+    entries.clear();
+    symbol = nullptr;
+    size_t checksum_offset = 0;
+    if (!IsFecMessage(data, length) || data[2] != kEOBinaryVersion ||
+        !CheckBinaryFrame(data, length, kFecInfoSize, checksum_offset))
+    {
+        return false;
+    }
+
+    BinaryReader r(data + kBinaryPreambleSize, data + checksum_offset);
+    parity.group_sn = r.U32();
+    parity.data_count = r.U8();
+    parity.parity_count = r.U8();
+    parity.parity_idx = r.U8();
+    parity.scheme = r.U8();
+    parity.symbol_size = r.U16();
+    r.U16();
+    if (parity.data_count == 0 || parity.parity_count == 0 ||
+        parity.parity_idx >= parity.parity_count ||
+        GetEOFecParityMessageSize(parity.data_count, parity.symbol_size) !=
+            checksum_offset + kBinaryTrailerSize)
+    {
+        return false;
+    }
+    entries.resize(parity.data_count);
+    for (EOFecEntry &entry : entries)
+    {
+        entry.length = r.U16();
+        entry.hash = r.U32();
+        if (entry.length > parity.symbol_size)
+        {
+            return false;
+        }
+    }
+    symbol = data + checksum_offset - parity.symbol_size;
+    return r.ok();
+}
+
+bool EOProtocolParser::ParseEOHeartbeatMessage(const uint8_t            *data,
+                                               size_t                    length,
+                                               std::vector<EOHeartbeat> &sources,
+                                               int64_t                  &sendUs)
+{
+    sources.clear();
+    sendUs = 0;
+    if (!IsHeartbeatMessage(data, length))
+    {
+        return false;
+    }
+
+    if (IsBinaryMessage(data, length))
+    {
+        size_t checksum_offset = 0;
+        if (data[2] != kEOBinaryVersion ||
+            !CheckBinaryFrame(data, length, kHeartbeatInfoSize, checksum_offset))
+        {
+            return false;
+        }
+        BinaryReader r(data + kBinaryPreambleSize, data + checksum_offset);
+        sendUs = static_cast<int64_t>(r.U64());
+        const size_t count = r.U16();
+        if (count == 0 || count * kHeartbeatEntrySize !=
+                              checksum_offset - kBinaryPreambleSize - kHeartbeatInfoSize)
+        {
+            return false;
+        }
+        sources.resize(count);
+        for (EOHeartbeat &source : sources)
+        {
+            source.source_id = r.U32();
+            source.src_sn = r.U32();
+        }
+        return r.ok();
+    }
+
+    JsonCursor cursor(reinterpret_cast<const char *>(data),
+                      reinterpret_cast<const char *>(data) + length);
+    bool       valid = true;
+    bool       found = false;
+    if (!cursor.Consume('{'))
+    {
+        return false;
+    }
+    do
+    {
+        FieldKey key;
+        if (!cursor.ReadKey(key))
+        {
+            return false;
+        }
+        if (key == FieldKey::SEND_US)
+        {
+            if (!ReadInt64Field(cursor, sendUs, valid))
+                return false;
+            continue;
+        }
+        if (key != FieldKey::HEARTBEAT)
+        {
+            if (!cursor.SkipValue(0))
+                return false;
+            continue;
+        }
+        found = true;
+        if (!cursor.Consume('['))
+        {
+            return false;
+        }
+        if (cursor.Consume(']'))
+        {
+            continue;
+        }
+        do
+        {
+            EOHeartbeat source = {0, 0};
+            if (!cursor.Consume('{'))
+            {
+                return false;
+            }
+            if (!cursor.Consume('}'))
+            {
+                do
+                {
+                    FieldKey field;
+                    int64_t  value = 0;
+                    if (!cursor.ReadKey(field))
+                        return false;
+                    if (field != FieldKey::SOURCE_ID && field != FieldKey::SRC_SN)
+                    {
+                        if (!cursor.SkipValue(0))
+                            return false;
+                        continue;
+                    }
+                    if (!ReadInt64Field(cursor, value, valid))
+                        return false;
+                    if (value < 0 || value > UINT32_MAX)
+                        valid = false;
+                    (field == FieldKey::SOURCE_ID ? source.source_id : source.src_sn) =
+                        static_cast<uint32_t>(value);
+                } while (cursor.Consume(','));
+                if (!cursor.Consume('}'))
+                    return false;
+            }
+            sources.push_back(source);
+        } while (cursor.Consume(','));
+        if (!cursor.Consume(']'))
+        {
+            return false;
+        }
+    } while (cursor.Consume(','));
+
+    return cursor.Consume('}') && found && valid && !sources.empty();
 }
 
 bool EOProtocolParser::ParseEOTargetMessage(const uint8_t           *data,
@@ -73,59 +3243,48 @@ bool EOProtocolParser::ParseEOTargetMessage(const uint8_t           *data,
         return false;
     }
 
-    // 解析JSON报文
-    const char *jsonStr = reinterpret_cast<const char *>(data);
-    auto        readerBuilder = GetReaderBuilder();
-    Json::Value jsonMessage;
-    std::string errors;
-
-    std::istringstream jsonStream(std::string(jsonStr, length));
-    if (!Json::parseFromStream(*readerBuilder, jsonStream, &jsonMessage, &errors))
+    if (IsBinaryMessage(data, length))
     {
-        return false;
+        return ParseEOTargetBinaryMessage(data, length, header, targetInfos);
     }
 
-    // 解析报文头
-    try {
-        header.msg_id = jsonMessage["msg_id"].asInt();
-        header.msg_sn = jsonMessage["msg_sn"].asInt();
-        header.msg_type = jsonMessage["msg_type"].asInt();
-        header.tx_sys_id = jsonMessage["tx_sys_id"].asInt();
-        header.tx_dev_type = jsonMessage["tx_dev_type"].asInt();
-        header.tx_dev_id = jsonMessage["tx_dev_id"].asInt();
-        header.tx_subdev_id = jsonMessage["tx_subdev_id"].asInt();
-        header.rx_sys_id = jsonMessage["rx_sys_id"].asInt();
-        header.rx_dev_type = jsonMessage["rx_dev_type"].asInt();
-        header.rx_dev_id = jsonMessage["rx_dev_id"].asInt();
-        header.rx_subdev_id = jsonMessage["rx_subdev_id"].asInt();
-        header.yr = jsonMessage["yr"].asInt();
-        header.mo = jsonMessage["mo"].asInt();
-        header.dy = jsonMessage["dy"].asInt();
-        header.h = jsonMessage["h"].asInt();
-        header.min = jsonMessage["min"].asInt();
-        header.sec = jsonMessage["sec"].asInt();
-        header.msec = jsonMessage["msec"].asFloat();
-        header.cont_type = jsonMessage["cont_type"].asInt();
-        header.cont_sum = jsonMessage["cont_sum"].asInt();
-    } catch (...) {
+    // 单遍就地解析：缺失字段保持为0，未知字段跳过
+    JsonCursor cursor(reinterpret_cast<const char *>(data),
+                      reinterpret_cast<const char *>(data) + length);
+    header = MessageHeader();
+    size_t count = 0;
+    bool   headerValid = true;
+
+    if (!cursor.Consume('{'))
+    {
         return false;
     }
-
-    // 清空目标列表
-    targetInfos.clear();
-
-    // 解析目标数组
-    if (jsonMessage.isMember("cont") && jsonMessage["cont"].isArray()) {
-        const Json::Value& contArray = jsonMessage["cont"];
-        for (const auto& targetJson : contArray) {
-            EOTargetInfo targetInfo;
-            if (ParseTargetInfoFromJson(targetJson, targetInfo)) {
-                targetInfos.push_back(targetInfo);
+    if (!cursor.Consume('}'))
+    {
+        do
+        {
+            FieldKey key;
+            if (!cursor.ReadKey(key))
+            {
+                return false;
             }
+            bool ok = (key == FieldKey::CONT)
+                          ? ParseTargetArray(cursor, targetInfos, count)
+                          : ParseHeaderField(cursor, key, header, headerValid);
+            if (!ok)
+            {
+                return false;
+            }
+        } while (cursor.Consume(','));
+        if (!cursor.Consume('}'))
+        {
+            return false;
         }
     }
 
-    return !targetInfos.empty();
+    targetInfos.resize(count);
+
+    return headerValid && !targetInfos.empty();
 }
 
 uint16_t EOProtocolParser::CalculateChecksum(const uint8_t *data, size_t length)
@@ -153,8 +3312,13 @@ uint16_t EOProtocolParser::CalculateChecksum(const uint8_t *data, size_t length)
 
 bool EOProtocolParser::VerifyFrameTail(const uint8_t *data, size_t length)
 {
-    // 保留用于兼容，新JSON格式不使用帧尾
-    return true;
+    // JSON 报文不使用帧尾
+    if (!IsBinaryMessage(data, length))
+    {
+        return true;
+    }
+    return length >= 2 && data[length - 2] == kEOBinaryTail0 &&
+           data[length - 1] == kEOBinaryTail1;
 }
 
 void EOProtocolParser::FillMessageHeader(MessageHeader &header,
@@ -191,100 +3355,9 @@ void EOProtocolParser::FillMessageHeader(MessageHeader &header,
     header.msec = msec;              // 毫秒
     header.cont_type = 1;        // 固定为1（多信息）
     header.cont_sum = cont_sum;  // 目标数量
-}
-
-bool EOProtocolParser::ParseTargetInfoFromJson(const Json::Value &json,
-                                               EOTargetInfo      &targetInfo)
-{
-    try
-    {
-        targetInfo.yr = json["yr"].asInt();
-        targetInfo.mo = json["mo"].asInt();
-        targetInfo.dy = json["dy"].asInt();
-        targetInfo.h = json["h"].asInt();
-        targetInfo.min = json["min"].asInt();
-        targetInfo.sec = json["sec"].asInt();
-        targetInfo.msec = json["msec"].asFloat();
-        targetInfo.dev_id = json["dev_id"].asInt();
-        targetInfo.guid_id = json["guid_id"].asInt();
-        targetInfo.tar_id = json["tar_id"].asInt();
-        targetInfo.trk_stat = json["trk_stat"].asInt();
-        targetInfo.trk_mod = json["trk_mod"].asInt();
-        targetInfo.fov_angle = json["fov_angle"].asDouble();
-        targetInfo.lon = json["lon"].asDouble();
-        targetInfo.lat = json["lat"].asDouble();
-        targetInfo.alt = json["alt"].asDouble();
-        targetInfo.tar_a = json["tar_a"].asDouble();
-        targetInfo.tar_e = json["tar_e"].asDouble();
-        targetInfo.tar_rng = json["tar_rng"].asDouble();
-        targetInfo.tar_av = json["tar_av"].asDouble();
-        targetInfo.tar_ev = json["tar_ev"].asDouble();
-        targetInfo.tar_rv = json["tar_rv"].asDouble();
-        targetInfo.tar_category = json["tar_category"].asInt();
-        targetInfo.tar_iden = json["tar_iden"].asString();
-        targetInfo.tar_cfid = json["tar_cfid"].asFloat();
-        targetInfo.fov_h = json["fov_h"].asDouble();
-        targetInfo.fov_v = json["fov_v"].asDouble();
-        targetInfo.offset_h = json["offset_h"].asInt();
-        targetInfo.offset_v = json["offset_v"].asInt();
-        targetInfo.tar_rect = json["tar_rect"].asInt();
-        targetInfo.source_id = json.get("source_id", 0).asInt();
-
-        return true;
-    }
-    catch (...)
-    {
-        return false;
-    }
-}
-
-Json::Value
-EOProtocolParser::CreateTargetInfoJson(const EOTargetInfo &targetInfo)
-{
-    Json::Value json;
-    json["yr"] = targetInfo.yr;
-    json["mo"] = targetInfo.mo;
-    json["dy"] = targetInfo.dy;
-    json["h"] = targetInfo.h;
-    json["min"] = targetInfo.min;
-    json["sec"] = targetInfo.sec;
-    json["msec"] = targetInfo.msec;
-    json["dev_id"] = targetInfo.dev_id;
-    json["guid_id"] = targetInfo.guid_id;
-    json["tar_id"] = targetInfo.tar_id;
-    json["trk_stat"] = targetInfo.trk_stat;
-    json["trk_mod"] = targetInfo.trk_mod;
-    json["fov_angle"] = targetInfo.fov_angle;
-    json["lon"] = targetInfo.lon;
-    json["lat"] = targetInfo.lat;
-    json["alt"] = targetInfo.alt;
-    json["tar_a"] = targetInfo.tar_a;
-    json["tar_e"] = targetInfo.tar_e;
-    json["tar_rng"] = targetInfo.tar_rng;
-    json["tar_av"] = targetInfo.tar_av;
-    json["tar_ev"] = targetInfo.tar_ev;
-    json["tar_rv"] = targetInfo.tar_rv;
-    json["tar_category"] = targetInfo.tar_category;
-    json["tar_iden"] = targetInfo.tar_iden;
-    json["tar_cfid"] = targetInfo.tar_cfid;
-    json["fov_h"] = targetInfo.fov_h;
-    json["fov_v"] = targetInfo.fov_v;
-    json["offset_h"] = targetInfo.offset_h;
-    json["offset_v"] = targetInfo.offset_v;
-    json["tar_rect"] = targetInfo.tar_rect;
-    json["source_id"] = targetInfo.source_id;
-
-    return json;
-}
-
-std::unique_ptr<Json::StreamWriterBuilder> EOProtocolParser::GetWriterBuilder()
-{
-    auto builder = std::make_unique<Json::StreamWriterBuilder>();
-    builder->settings_["indentation"] = ""; // 紧凑格式，无缩进
-    return builder;
-}
-
-std::unique_ptr<Json::CharReaderBuilder> EOProtocolParser::GetReaderBuilder()
-{
-    return std::make_unique<Json::CharReaderBuilder>();
+    header.frag_idx = 0;         // 未分片
+    header.frag_cnt = 0;
+    header.src_sn = 0;           // 由 PackEOTargetFragments 的 sequence 参数填写
+    header.send_us = 0;
+    header.src_cnt = 0;
 }
@@ -2,20 +2,12 @@
 #define EOPROTOCOLPARSER_H
 
 #include <cstdint>
-#include <memory>
+#include <cstring>
+#include <iosfwd>
 #include <string>
+#include <type_traits>
 #include <vector>
 
-// 前向声明 Json 相关类
-namespace Json
-{
-class Value;
-class StreamWriter;
-class StreamWriterBuilder;
-class CharReader;
-class CharReaderBuilder;
-} // namespace Json
-
 // 系统类型定义
 enum class SystemType : uint8_t
 {
@@ -38,10 +30,42 @@ enum class MessageType : uint16_t
 // 报文类型定义
 enum class BodyType : uint16_t
 {
-    JSON = 0,  // 0:json
-    BINARY = 1 // 1:二进制
+    JSON = 0,   // 0:json
+    BINARY = 1, // 1:二进制
+    DELTA = 2,    // 2:差分帧（二进制，解析需要该视频源上一报文的目标）
+    HEARTBEAT = 3, // 3:心跳（仅作报文类型，不是 format 取值）
+    FEC = 4        // 4:前向纠错校验报文（仅作报文类型，不是 format 取值）
 };
 
+// 二进制报文（BodyType::BINARY）帧格式，全部多字节字段为小端序：
+//   帧头 EB 90 | 版本(1) | 报文类型(1) | 帧长(4, 含帧头帧尾) | 报文头(60)
+//   | 目标记录 x cont_sum | 校验和(2) | 帧尾 AA 55
+// 目标记录以 2 字节记录长度开头，解析端按记录长度跳过新版本追加的字段。
+constexpr uint8_t  kEOBinarySync0 = 0xEB;
+constexpr uint8_t  kEOBinarySync1 = 0x90;
+constexpr uint8_t  kEOBinaryTail0 = 0xAA;
+constexpr uint8_t  kEOBinaryTail1 = 0x55;
+constexpr uint8_t  kEOBinaryVersion = 1;
+constexpr uint8_t  kEOBinaryFragmentVersion = 2; // 报文头后追加 frag_idx(2) frag_cnt(2)
+// 报文头后追加 src_sn(4) send_us(8) frag_idx(2) frag_cnt(2)，发送端提供 send_us 时使用
+constexpr uint8_t  kEOBinarySequenceVersion = 3;
+// 版本 3 的扩展字段后再追加 src_cnt(2) 保留(2)，多视频源聚合报文使用
+constexpr uint8_t  kEOBinaryBatchVersion = 4;
+constexpr size_t   kEOBinaryMaxIdenLength = 255; // 格式允许的 tar_iden 最大字节数（EOIdenString 只保留 63 字节）
+
+// 差分帧（BodyType::DELTA）格式，帧头/报文头/帧尾与二进制报文相同，报文类型为 2：
+//   帧头 | 报文头(60) [| 版本 3 扩展字段(16)] | source_id(4) | base_sn(2)
+//   | 目标差分 x cont_sum | 校验和 | 帧尾
+// base_sn 为该视频源上一报文的 msg_sn，接收端状态不一致时丢弃并等待下一个关键帧。
+// 每个目标差分以变长字段掩码开头，只携带与参考目标不同的字段：时间字段参考本报文
+// 前一个目标（首个目标参考上一报文的首个目标），其余字段参考上一报文同位置的目标
+// （超出时参考最后一个目标）。整型字段为 zigzag 变长差值，浮点与字符串为原值。
+
+// 心跳报文：空闲视频源的保活，二进制为报文类型 3、版本 1：
+//   帧头 | send_us(8) | 视频源个数(2) | (source_id(4) src_sn(4)) x 个数 | 校验和 | 帧尾
+// JSON 为 {"heartbeat":[{"source_id":0,"src_sn":12},...],"send_us":...}，"heartbeat" 键在最前。
+// src_sn 为该视频源最近一个目标报文的序号，接收端据此发现丢失的目标报文。
+
 // 报文ID定义
 enum class MessageID : uint16_t
 {
@@ -104,28 +128,97 @@ enum class DeviceType : int
 // 报文头结构体（JSON格式）
 struct MessageHeader
 {
-    int   msg_id;       // 报文ID, 唯一标识（整型），固定为0x7112
-    int   msg_sn;       // 报文计数（整型）
-    int   msg_type;     // 报文类型, 0：控制；1：回馈；2：查询；3数据流（备份）（整型），固定为3
-    int   tx_sys_id;    // 系统号（整型），固定为0
-    int   tx_dev_type;  // 0-雷达 1-光电 2-侦收 3-融合 4-无人机（反制）5-ads-b 6-ais 7-干扰反制（整型），固定为1
-    int   tx_dev_id;    // 每个设备编号（根据系统要求编），固定为0
-    int   tx_subdev_id; // 参见雷达分系统编号（光电0-可见光，1-红外，2-测距；侦收  0-定向 1-定位），固定为0
-    int   rx_sys_id;    // 系统号（整型），999-不指定，固定为0
-    int   rx_dev_type;  // 0-雷达 1-光电 2-侦收 3-融合 4-无人机（反制）5-ads-b 6-ais 7-干扰反制, 999-不指定（整型），固定为1
-    int   rx_dev_id;    // 每个设备编号（根据系统要求编），999-不指定，固定为0
-    int   rx_subdev_id; // 参见雷达分系统编号（光电0-可见光，1-红外，2-测距；侦收  0-定向 1-定位），999-不指定，固定为0
-    int   yr;           // 年（整型）
-    int   mo;           // 月（整型）
-    int   dy;           // 日（整型）
-    int   h;            // 时（整型）
-    int   min;          // 分（整型）
-    int   sec;          // 秒（整型）
-    float msec;         // 毫秒（单精度浮点）
-    int   cont_type;    // 信息类型，0单信息，1多信息，固定为1
-    int   cont_sum;     // 目标数量
+    int      msg_id;       // 报文ID, 唯一标识（整型），固定为0x7112
+    int      msg_sn;       // 报文计数（整型）
+    int      msg_type;     // 报文类型, 0：控制；1：回馈；2：查询；3数据流（备份）（整型），固定为3
+    int      tx_sys_id;    // 系统号（整型），固定为0
+    int      tx_dev_type;  // 0-雷达 1-光电 2-侦收 3-融合 4-无人机（反制）5-ads-b 6-ais 7-干扰反制（整型），固定为1
+    int      tx_dev_id;    // 每个设备编号（根据系统要求编），固定为0
+    int      tx_subdev_id; // 参见雷达分系统编号（光电0-可见光，1-红外，2-测距；侦收  0-定向 1-定位），固定为0
+    int      rx_sys_id;    // 系统号（整型），999-不指定，固定为0
+    int      rx_dev_type;  // 0-雷达 1-光电 2-侦收 3-融合 4-无人机（反制）5-ads-b 6-ais 7-干扰反制, 999-不指定（整型），固定为1
+    int      rx_dev_id;    // 每个设备编号（根据系统要求编），999-不指定，固定为0
+    int      rx_subdev_id; // 参见雷达分系统编号（光电0-可见光，1-红外，2-测距；侦收  0-定向 1-定位），999-不指定，固定为0
+    int      yr;           // 年（整型）
+    int      mo;           // 月（整型）
+    int      dy;           // 日（整型）
+    int      h;            // 时（整型）
+    int      min;          // 分（整型）
+    int      sec;          // 秒（整型）
+    float    msec;         // 毫秒（单精度浮点）
+    int      cont_type;    // 信息类型，0单信息，1多信息，固定为1
+    int      cont_sum;     // 目标数量（分片报文为本分片内的目标数）
+    int      frag_idx;     // 分片序号，从0开始；未分片报文为0
+    int      frag_cnt;     // 分片总数；未分片报文为0，报文中不出现分片字段
+    uint32_t src_sn;       // 按视频源递增的报文序号，从1开始（分片共用）；0 表示发送端未提供
+    int64_t  send_us;      // 发送时刻，Unix 时间微秒（CLOCK_REALTIME）；0 表示未提供，报文中不出现
+    int      src_cnt;      // 聚合报文（同一批次多路视频源）中的视频源个数，此时 src_sn 按发送端的批次递增；
+                           // 0 表示单视频源报文，报文中不出现
+};
+
+// 发送端为每条报文提供的序号与发送时刻（写入 MessageHeader::src_sn / send_us）
+struct EOSequence
+{
+    uint32_t src_sn;
+    int64_t  send_us;
+    int      src_cnt; // 聚合报文中的视频源个数，单视频源报文为 0
+};
+
+// tar_iden 的定长内联存储（UTF-8）。超过 kCapacity 字节时在字符边界截断。
+// 不占用堆内存，EOTargetInfo 因此可平凡复制，复用、拷贝、交换目标都不分配内存。
+class EOIdenString
+{
+  public:
+    static constexpr size_t kCapacity = 63;
+
+    EOIdenString() = default;
+    EOIdenString(const char *text) { assign(text); }
+    EOIdenString(const std::string &text) { assign(text.data(), text.size()); }
+
+    EOIdenString &operator=(const char *text)
+    {
+        assign(text);
+        return *this;
+    }
+    EOIdenString &operator=(const std::string &text)
+    {
+        assign(text.data(), text.size());
+        return *this;
+    }
+
+    // 复制 length 字节，超出容量时截断到完整的 UTF-8 字符
+    void assign(const char *text, size_t length);
+    void assign(const char *text) { assign(text, text ? strlen(text) : 0); }
+    void clear() { size_ = 0; }
+
+    const char *data() const { return data_; }
+    size_t      size() const { return size_; }
+    bool        empty() const { return size_ == 0; }
+    std::string str() const { return std::string(data_, size_); }
+
+    bool operator==(const EOIdenString &other) const
+    {
+        return size_ == other.size_ && memcmp(data_, other.data_, size_) == 0;
+    }
+    bool operator!=(const EOIdenString &other) const { return !(*this == other); }
+    bool operator==(const char *text) const
+    {
+        return text != nullptr && strlen(text) == size_ && memcmp(data_, text, size_) == 0;
+    }
+    bool operator!=(const char *text) const { return !(*this == text); }
+    bool operator==(const std::string &text) const
+    {
+        return text.size() == size_ && memcmp(data_, text.data(), size_) == 0;
+    }
+    bool operator!=(const std::string &text) const { return !(*this == text); }
+
+  private:
+    uint8_t size_ = 0;
+    char    data_[kCapacity];
 };
 
+std::ostream &operator<<(std::ostream &os, const EOIdenString &iden);
+
 // 光电目标信息结构体
 struct EOTargetInfo
 {
@@ -152,7 +245,7 @@ struct EOTargetInfo
     double       tar_ev;        // 目标垂直角速度，度（双精度浮点），0
     double       tar_rv;        // 目标径向速度，单位米/s，没有距离信息填0（双精度浮点）
     int          tar_category;  // 目标类型（整型），由目标标签名映射得到
-    std::string  tar_iden;      // 目标具体型号或标签名（字符串），来自 obj_label
+    EOIdenString tar_iden;      // 目标具体型号或标签名（UTF-8，最多 63 字节），来自 obj_label
     float        tar_cfid;      // 目标置信度（单精度浮点）
     double       fov_h;         // 视场中心水平角度，单位度（双精度浮点）0
     double       fov_v;         // 视场中心垂直角度（双精度浮点）0
@@ -162,6 +255,46 @@ struct EOTargetInfo
     int          source_id;     // DeepStream source_id，用于区分多路视频源
 };
 
+// 不含堆内存：跨帧复用的 std::vector<EOTargetInfo> 在 clear() 后重新填充不再分配
+static_assert(std::is_trivially_copyable<EOTargetInfo>::value,
+              "EOTargetInfo must stay trivially copyable");
+
+class EOTargetColumns;
+
+// 分片报文在封装缓冲区中的位置
+struct EOFragment
+{
+    size_t offset; // 报文在缓冲区中的起始偏移
+    size_t length; // 报文长度
+    size_t first;  // 分片内首个目标的下标
+    size_t count;  // 分片内目标数
+};
+
+// 心跳报文中的单个视频源
+struct EOHeartbeat
+{
+    uint32_t source_id;
+    uint32_t src_sn; // 该视频源最近一个目标报文的 src_sn，0 表示尚未发送
+};
+
+// FEC 校验报文保护的单个数据报文：接收端按长度与哈希（EOFecHash）匹配已收到的报文
+struct EOFecEntry
+{
+    uint16_t length;
+    uint32_t hash;
+};
+
+// FEC 校验报文的分组信息
+struct EOFecParity
+{
+    uint32_t group_sn;     // 分组序号，按发送端递增
+    uint8_t  data_count;   // 分组内数据报文数 k
+    uint8_t  parity_count; // 分组内校验报文数 m
+    uint8_t  parity_idx;   // 本报文是第几个校验报文（0 ~ m-1）
+    uint8_t  scheme;       // 0: XOR（m 为 1），1: GF(256) Cauchy Reed-Solomon
+    uint16_t symbol_size;  // 校验数据长度，等于分组内最长数据报文的长度
+};
+
 // 光电报文封装和解析类
 class EOProtocolParser
 {
@@ -171,16 +304,175 @@ class EOProtocolParser
     PackEOTargetMessage(const std::vector<EOTargetInfo> &targetInfos,
                         uint16_t                          sendCount);
 
-    // 解析光电目标信息报文（多目标）- 新JSON格式
+    // 流式封装光电目标信息报文到调用方缓冲区（不分配内存）
+    // 返回写入的字节数；目标为空或缓冲区不足时返回0
+    static size_t PackEOTargetMessage(const EOTargetInfo *targetInfos,
+                                      size_t              count,
+                                      uint16_t            sendCount,
+                                      uint8_t            *buffer,
+                                      size_t              capacity);
+
+    // 估算封装报文所需缓冲区大小上限
+    static size_t GetMaxEOTargetMessageSize(const EOTargetInfo *targetInfos,
+                                            size_t              count);
+
+    // 封装光电目标信息报文（多目标）- 二进制格式，返回值同 JSON 版本
+    static size_t PackEOTargetBinaryMessage(const EOTargetInfo *targetInfos,
+                                            size_t              count,
+                                            uint16_t            sendCount,
+                                            uint8_t            *buffer,
+                                            size_t              capacity);
+
+    // 二进制报文所需缓冲区大小上限
+    static size_t GetMaxEOTargetBinaryMessageSize(size_t count);
+
+    // 按 maxDatagramSize 拆分封装目标报文，各报文依次写入 buffer，位置写入 fragments。
+    // 整条报文不超过上限时只产生一个不带分片字段的普通报文；否则把 cont 数组
+    // 拆成多个自描述报文，共用 msg_sn 与报文头时间，并带 frag_idx / frag_cnt。
+    // 单个目标超过上限时独占一个分片。返回报文个数；缓冲区不足时返回0。
+    // sequence 非空时报文头带 src_sn / send_us。
+    static size_t PackEOTargetFragments(const EOTargetInfo      *targetInfos,
+                                        size_t                   count,
+                                        uint16_t                 sendCount,
+                                        BodyType                 format,
+                                        size_t                   maxDatagramSize,
+                                        uint8_t                 *buffer,
+                                        size_t                   capacity,
+                                        std::vector<EOFragment> &fragments,
+                                        const EOSequence        *sequence = nullptr);
+
+    // PackEOTargetFragments 所需缓冲区大小上限
+    static size_t GetMaxEOTargetFragmentsSize(const EOTargetInfo *targetInfos,
+                                              size_t              count,
+                                              BodyType            format);
+
+    // 与 PackEOTargetFragments 相同，输入为列式目标（见 eo_target_columns.h）。
+    // 帧内共享字段与各种 tar_iden 只格式化一次，输出与逐个 EOTargetInfo 编码逐字节一致。
+    // 支持 JSON 与 BINARY 格式。
+    static size_t PackEOTargetColumnFragments(const EOTargetColumns  &columns,
+                                              uint16_t                 sendCount,
+                                              BodyType                 format,
+                                              size_t                   maxDatagramSize,
+                                              uint8_t                 *buffer,
+                                              size_t                   capacity,
+                                              std::vector<EOFragment> &fragments,
+                                              const EOSequence        *sequence = nullptr);
+
+    // PackEOTargetColumnFragments 所需缓冲区大小上限
+    static size_t GetMaxEOTargetColumnFragmentsSize(const EOTargetColumns &columns,
+                                                    BodyType               format);
+
+    // 聚合报文：同一批次多路视频源的列式目标按 frames 的顺序连续编码为一条报文，
+    // 超过 maxDatagramSize 时按目标拆分（分片共用 msg_sn，可能跨越视频源边界）。
+    // 调用方应按 source_id 排好 frames，并在 sequence->src_cnt 中给出视频源个数。
+    static size_t PackEOTargetBatchFragments(const EOTargetColumns *const *frames,
+                                             size_t                        frameCount,
+                                             uint16_t                      sendCount,
+                                             BodyType                      format,
+                                             size_t                        maxDatagramSize,
+                                             uint8_t                      *buffer,
+                                             size_t                        capacity,
+                                             std::vector<EOFragment>      &fragments,
+                                             const EOSequence             *sequence = nullptr);
+
+    // PackEOTargetBatchFragments 所需缓冲区大小上限
+    static size_t GetMaxEOTargetBatchFragmentsSize(const EOTargetColumns *const *frames,
+                                                   size_t                        frameCount,
+                                                   BodyType                      format);
+
+    // 封装差分帧：reference 为该视频源上一报文（msg_sn 为 baseSn）的目标。
+    // 返回写入的字节数；目标为空或缓冲区不足时返回0
+    static size_t PackEOTargetDeltaMessage(const EOTargetInfo *targetInfos,
+                                           size_t              count,
+                                           const EOTargetInfo *reference,
+                                           size_t              referenceCount,
+                                           uint32_t            sourceId,
+                                           uint16_t            sendCount,
+                                           uint16_t            baseSn,
+                                           uint8_t            *buffer,
+                                           size_t              capacity,
+                                           const EOSequence   *sequence = nullptr);
+
+    // 读取差分帧的报文头、视频源与 base_sn，同时校验帧长、校验和与帧尾
+    static bool ReadEOTargetDeltaInfo(const uint8_t *data, size_t length,
+                                      MessageHeader &header, uint32_t &sourceId,
+                                      uint16_t &baseSn);
+
+    // 以 reference 为参考目标解析差分帧；targetInfos 不能与 reference 为同一数组
+    static bool ParseEOTargetDeltaMessage(const uint8_t             *data,
+                                          size_t                     length,
+                                          const EOTargetInfo        *reference,
+                                          size_t                     referenceCount,
+                                          MessageHeader             &header,
+                                          std::vector<EOTargetInfo> &targetInfos);
+
+    // 判断报文是否为差分帧
+    static bool IsDeltaMessage(const uint8_t *data, size_t length);
+
+    // 封装心跳报文，format 为 JSON 时输出 JSON，否则输出二进制。
+    // 返回写入的字节数；视频源为空、超过 65535 个或缓冲区不足时返回0
+    static size_t PackEOHeartbeatMessage(const EOHeartbeat *sources,
+                                         size_t             count,
+                                         BodyType           format,
+                                         int64_t            sendUs,
+                                         uint8_t           *buffer,
+                                         size_t             capacity);
+
+    // 心跳报文所需缓冲区大小上限
+    static size_t GetMaxEOHeartbeatMessageSize(size_t count, BodyType format);
+
+    // 单个不超过 maxDatagramSize 字节的心跳报文最多携带的视频源数
+    static size_t GetMaxEOHeartbeatSources(size_t maxDatagramSize, BodyType format);
+
+    // 判断报文是否为心跳（JSON 或二进制）
+    static bool IsHeartbeatMessage(const uint8_t *data, size_t length);
+
+    // 解析心跳报文，自动识别 JSON / 二进制格式
+    static bool ParseEOHeartbeatMessage(const uint8_t            *data,
+                                        size_t                    length,
+                                        std::vector<EOHeartbeat> &sources,
+                                        int64_t                  &sendUs);
+
+    // 封装 FEC 校验报文（二进制，报文类型 4）：分组信息、k 个数据报文的长度与哈希、
+    // symbol_size 字节的校验数据。返回写入的字节数；参数不合法或缓冲区不足时返回0
+    static size_t PackEOFecParityMessage(const EOFecParity &parity,
+                                         const EOFecEntry  *entries,
+                                         const uint8_t     *symbol,
+                                         uint8_t           *buffer,
+                                         size_t             capacity);
+
+    // FEC 校验报文的大小
+    static size_t GetEOFecParityMessageSize(size_t dataCount, size_t symbolSize);
+
+    // 判断报文是否为 FEC 校验报文
+    static bool IsFecMessage(const uint8_t *data, size_t length);
+
+    // 解析 FEC 校验报文，symbol 指向 data 内的校验数据（symbol_size 字节）
+    static bool ParseEOFecParityMessage(const uint8_t           *data,
+                                        size_t                   length,
+                                        EOFecParity             &parity,
+                                        std::vector<EOFecEntry> &entries,
+                                        const uint8_t          *&symbol);
+
+    // 解析光电目标信息报文（多目标），自动识别 JSON / 二进制格式（差分帧返回 false）
     static bool ParseEOTargetMessage(const uint8_t           *data,
                                      size_t                   length,
                                      MessageHeader           &header,
                                      std::vector<EOTargetInfo> &targetInfos);
 
-    // 计算校验和（保留用于兼容）
+    // 解析光电目标信息报文（多目标）- 二进制格式
+    static bool ParseEOTargetBinaryMessage(const uint8_t             *data,
+                                           size_t                     length,
+                                           MessageHeader             &header,
+                                           std::vector<EOTargetInfo> &targetInfos);
+
+    // 判断报文是否为二进制格式（以帧头 EB 90 开头）
+    static bool IsBinaryMessage(const uint8_t *data, size_t length);
+
+    // 计算校验和（二进制报文使用）
     static uint16_t CalculateChecksum(const uint8_t *data, size_t length);
 
-    // 验证帧尾（保留用于兼容）
+    // 验证帧尾（二进制报文使用，JSON 报文无帧尾恒为 true）
     static bool VerifyFrameTail(const uint8_t *data, size_t length);
 
   private:
@@ -188,22 +480,6 @@ class EOProtocolParser
     static void FillMessageHeader(MessageHeader &header,
                                   int            msg_sn,
                                   int            cont_sum);
-
-    // 从JSON解析目标信息
-    static bool ParseTargetInfoFromJson(const Json::Value &json,
-                                        EOTargetInfo      &targetInfo);
-
-    // 生成目标信息的JSON
-    static Json::Value CreateTargetInfoJson(const EOTargetInfo &targetInfo);
-
-    // 生成报文头的JSON
-    static Json::Value CreateMessageHeaderJson(const MessageHeader &header);
-
-    // JSON 写入器构建器
-    static std::unique_ptr<Json::StreamWriterBuilder> GetWriterBuilder();
-
-    // JSON 读取器构建器
-    static std::unique_ptr<Json::CharReaderBuilder> GetReaderBuilder();
 };
 
 #endif // EOPROTOCOLPARSER_H
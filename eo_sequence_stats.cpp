@@ -0,0 +1,196 @@
+#include "eo_sequence_stats.h"
+#include <algorithm>
+#include <cmath>
+
+size_t LatencyHistogram::BucketIndex(uint64_t value)
+{
+    if (value < kLinearLimit)
+    {
+        return static_cast<size_t>(value);
+    }
+    const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    if (msb >= kMaxExponent)
+    {
+        return kBucketCount - 1;
+    }
+    const unsigned shift = msb - 4; // 保留最高 5 位：首位恒为 1，其余 4 位为子桶
+    return kLinearLimit + (msb - 5) * kSubBuckets + ((value >> shift) & (kSubBuckets - 1));
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index < kLinearLimit)
+    {
+        return index;
+    }
+    const size_t   octave = (index - kLinearLimit) / kSubBuckets;
+    const size_t   sub = (index - kLinearLimit) % kSubBuckets;
+    const unsigned shift = static_cast<unsigned>(octave) + 1;
+    return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t value)
+{
+    ++counts_[BucketIndex(value)];
+    ++count_;
+    sum_ += value;
+    max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::Reset()
+{
+    *this = LatencyHistogram();
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count_));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += counts_[i];
+        if (seen >= rank)
+        {
+            return std::min(BucketUpperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+void EOSequenceTracker::Record(uint32_t sourceId, uint32_t srcSn, int64_t sendUs,
+                               int64_t nowUs)
+{
+    if (sourceId >= kMaxSources)
+    {
+        return;
+    }
+    if (sourceId >= sources_.size())
+    {
+        sources_.resize(sourceId + 1);
+    }
+    SourceState   &state = sources_[sourceId];
+    EOSourceStats &stats = state.stats;
+    stats.source_id = sourceId;
+    stats.last_seen_us = nowUs;
+
+    // 32 位序号按回绕差值比较
+    const int32_t distance = static_cast<int32_t>(srcSn - stats.highest_sn);
+    if (!state.active || distance <= -static_cast<int32_t>(kWindow) ||
+        distance >= static_cast<int32_t>(kRestartDistance))
+    {
+        if (state.active)
+        {
+            ++stats.restarts;
+        }
+        state.active = true;
+        state.seen.reset();
+        stats.highest_sn = srcSn;
+    }
+    else if (distance > 0)
+    {
+        // 清除新进入窗口的序号，空缺先计为丢失
+        const uint32_t cleared =
+            static_cast<uint32_t>(distance) < kWindow ? static_cast<uint32_t>(distance) : kWindow;
+        for (uint32_t i = 1; i <= cleared; ++i)
+        {
+            state.seen.reset((stats.highest_sn + i) % kWindow);
+        }
+        stats.lost += static_cast<uint32_t>(distance) - 1;
+        stats.highest_sn = srcSn;
+    }
+    else if (state.seen.test(srcSn % kWindow))
+    {
+        ++stats.duplicates;
+        return;
+    }
+    else
+    {
+        // 迟到报文：此前已计为丢失
+        ++stats.reordered;
+        if (stats.lost > 0)
+            --stats.lost;
+    }
+    state.seen.set(srcSn % kWindow);
+    ++stats.received;
+
+    if (sendUs != 0)
+    {
+        if (nowUs < sendUs)
+            ++stats.clock_skew;
+        else
+            stats.latency_us.Record(static_cast<uint64_t>(nowUs - sendUs));
+    }
+}
+
+void EOSequenceTracker::RecordHeartbeat(uint32_t sourceId, uint32_t srcSn, int64_t nowUs)
+{
+    if (sourceId >= kMaxSources)
+    {
+        return;
+    }
+    if (sourceId >= sources_.size())
+    {
+        sources_.resize(sourceId + 1);
+    }
+    SourceState   &state = sources_[sourceId];
+    EOSourceStats &stats = state.stats;
+    stats.source_id = sourceId;
+    stats.last_seen_us = nowUs;
+    ++stats.heartbeats;
+
+    const int32_t distance = static_cast<int32_t>(srcSn - stats.highest_sn);
+    if (!state.active)
+    {
+        state.active = true;
+        state.seen.reset();
+        stats.highest_sn = srcSn;
+    }
+    else if (distance > 0 && distance < static_cast<int32_t>(kRestartDistance))
+    {
+        // 心跳之前的目标报文（含 srcSn 本身）尚未收到，先计为丢失
+        const uint32_t cleared =
+            static_cast<uint32_t>(distance) < kWindow ? static_cast<uint32_t>(distance) : kWindow;
+        for (uint32_t i = 1; i <= cleared; ++i)
+        {
+            state.seen.reset((stats.highest_sn + i) % kWindow);
+        }
+        stats.lost += static_cast<uint32_t>(distance);
+        stats.highest_sn = srcSn;
+    }
+}
+
+std::vector<EOSourceStats> EOSequenceTracker::Snapshot() const
+{
+    std::vector<EOSourceStats> snapshot;
+    for (const SourceState &state : sources_)
+    {
+        if (state.active)
+        {
+            snapshot.push_back(state.stats);
+        }
+    }
+    return snapshot;
+}
+
+void EOSequenceTracker::Reset()
+{
+    sources_.clear();
+}
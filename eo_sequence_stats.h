@@ -0,0 +1,90 @@
+#ifndef EO_SEQUENCE_STATS_H
+#define EO_SEQUENCE_STATS_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+// HDR 风格的对数线性直方图：0~31 逐个计数，之后每个 2 的幂区间分 16 个子桶，
+// 相对误差不超过 1/16。取值上限 2^41（微秒约 25 天），超出的值计入最后一个桶。
+class LatencyHistogram
+{
+  public:
+    void Record(uint64_t value);
+    void Merge(const LatencyHistogram &other);
+    void Reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t max() const { return max_; }
+    double   mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // 第 percentile（0~100）百分位所在桶的上界，不超过 max()
+    uint64_t Percentile(double percentile) const;
+
+    static const unsigned kSubBuckets = 16;
+    static const unsigned kLinearLimit = 2 * kSubBuckets;
+    static const unsigned kMaxExponent = 41;
+    static const size_t   kBucketCount =
+        kLinearLimit + (kMaxExponent - 5) * kSubBuckets;
+
+    static size_t   BucketIndex(uint64_t value);
+    static uint64_t BucketUpperBound(size_t index);
+
+  private:
+    std::array<uint64_t, kBucketCount> counts_ = {};
+    uint64_t                           count_ = 0;
+    uint64_t                           max_ = 0;
+    uint64_t                           sum_ = 0;
+};
+
+// 单个视频源的接收统计
+struct EOSourceStats
+{
+    uint32_t         source_id = 0;
+    uint64_t         received = 0;   // 收到的报文（不含重复）
+    uint64_t         lost = 0;       // 序号空缺数，迟到报文到达后扣除
+    uint64_t         reordered = 0;  // 晚于更大序号到达的报文
+    uint64_t         duplicates = 0; // 重复报文
+    uint64_t         restarts = 0;   // 序号大幅回退或跳跃（发送端重启）
+    uint64_t         clock_skew = 0; // 发送时刻晚于接收时刻，未计入时延
+    uint32_t         highest_sn = 0; // 收到的最大序号
+    uint64_t         heartbeats = 0;   // 收到的空闲心跳
+    int64_t          last_seen_us = 0; // 最近一次收到报文或心跳的时刻（Unix 微秒）
+    LatencyHistogram latency_us;     // 单向时延（微秒），依赖两端时钟同步
+};
+
+// 按视频源跟踪 src_sn：统计丢包、乱序、重复与单向时延。
+// last_seen_us 同时由目标报文与心跳更新，长时间未更新的视频源视为失效；
+// 只有心跳没有目标报文的视频源处于无目标状态。
+// 乱序判断窗口为 kWindow 个序号，更早的报文按发送端重启处理。非线程安全。
+class EOSequenceTracker
+{
+  public:
+    // 记录一条报文。sendUs / nowUs 为 Unix 时间微秒，sendUs 为 0 时不统计时延
+    void Record(uint32_t sourceId, uint32_t srcSn, int64_t sendUs, int64_t nowUs);
+
+    // 记录一次空闲心跳。srcSn 为发送端最近一个目标报文的序号：大于已收到的最大序号时
+    // 其间的报文计为丢失（迟到后扣除），心跳本身不占序号
+    void RecordHeartbeat(uint32_t sourceId, uint32_t srcSn, int64_t nowUs);
+
+    // 有数据的视频源的统计快照
+    std::vector<EOSourceStats> Snapshot() const;
+    void                       Reset();
+
+    static const uint32_t kMaxSources = 4096;
+    static const uint32_t kWindow = 1024;
+    static const uint32_t kRestartDistance = 1u << 16;
+
+  private:
+    struct SourceState
+    {
+        bool                 active = false;
+        EOSourceStats        stats;
+        std::bitset<kWindow> seen; // 下标为 sn % kWindow
+    };
+
+    std::vector<SourceState> sources_;
+};
+
+#endif // EO_SEQUENCE_STATS_H
@@ -0,0 +1,239 @@
+#include "eo_target_columns.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+void EOTargetColumns::Reset(const EOTargetInfo &common)
+{
+    common_ = common;
+    common_.tar_iden.clear();
+    Clear();
+}
+
+void EOTargetColumns::Clear()
+{
+    tar_rect_.clear();
+    tar_category_.clear();
+    tar_cfid_.clear();
+    trk_stat_.clear();
+    iden_index_.clear();
+    idens_.clear();
+    last_iden_ = 0;
+}
+
+bool EOTargetColumns::Append(int32_t tarRect, int32_t tarCategory, float tarCfid,
+                             int32_t trkStat, const char *iden, size_t idenLength)
+{
+    EOIdenString label;
+    label.assign(iden, idenLength);
+
+    size_t index = last_iden_;
+    if (index >= idens_.size() || idens_[index] != label)
+    {
+        for (index = 0; index < idens_.size(); ++index)
+        {
+            if (idens_[index] == label)
+                break;
+        }
+        if (index == idens_.size())
+        {
+            if (idens_.size() >= kMaxIdens)
+                return false;
+            idens_.push_back(label);
+        }
+        last_iden_ = index;
+    }
+
+    tar_rect_.push_back(tarRect);
+    tar_category_.push_back(tarCategory);
+    tar_cfid_.push_back(tarCfid);
+    trk_stat_.push_back(trkStat);
+    iden_index_.push_back(static_cast<uint16_t>(index));
+    return true;
+}
+
+void EOTargetColumns::Get(size_t index, EOTargetInfo &target) const
+{
+    target = common_;
+    target.tar_rect = tar_rect_[index];
+    target.tar_category = tar_category_[index];
+    target.tar_cfid = tar_cfid_[index];
+    target.trk_stat = trk_stat_[index];
+    target.tar_iden = idens_[iden_index_[index]];
+}
+
+void EOTargetColumns::ExpandTo(std::vector<EOTargetInfo> &targets) const
+{
+    targets.resize(size());
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        Get(i, targets[i]);
+    }
+}
+
+size_t EOTargetColumns::FilterByConfidence(float threshold)
+{
+    const size_t count = size();
+    const float *cfid = tar_cfid_.data();
+    size_t       kept = 0;
+    size_t       i = 0;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    // 4 个一组比较，得到各目标是否保留的位掩码；前面没有剔除且整组保留时无需移动
+#if defined(__SSE2__)
+    const __m128 limit = _mm_set1_ps(threshold);
+#else
+    const float32x4_t limit = vdupq_n_f32(threshold);
+#endif
+    for (; i + 4 <= count; i += 4)
+    {
+#if defined(__SSE2__)
+        const int keep = _mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(cfid + i), limit));
+#else
+        uint32_t lanes[4];
+        vst1q_u32(lanes, vcgeq_f32(vld1q_f32(cfid + i), limit));
+        const int keep = static_cast<int>((lanes[0] & 1u) | (lanes[1] & 2u) |
+                                          (lanes[2] & 4u) | (lanes[3] & 8u));
+#endif
+        if (keep == 0xF && kept == i)
+        {
+            kept += 4;
+            continue;
+        }
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            if (keep & (1 << lane))
+                Move(i + lane, kept++);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        if (cfid[i] >= threshold)
+            Move(i, kept++);
+    }
+
+    Truncate(kept);
+    return count - kept;
+}
+
+size_t EOTargetColumns::KeepTopConfidence(float threshold, size_t ties)
+{
+    const size_t count = size();
+    size_t       removed = FilterByConfidence(threshold);
+
+    // 剩余目标都不低于 threshold，只有等于阈值的目标超出 ties 个时才需要再剔除
+    size_t equal = 0;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        equal += (tar_cfid_[i] == threshold) ? 1 : 0;
+    }
+    if (equal <= ties)
+        return removed;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        if (tar_cfid_[i] == threshold)
+        {
+            if (ties == 0)
+                continue;
+            --ties;
+        }
+        Move(i, kept++);
+    }
+    Truncate(kept);
+    return count - kept;
+}
+
+void EOTargetColumns::Move(size_t from, size_t to)
+{
+    if (from != to)
+    {
+        tar_rect_[to] = tar_rect_[from];
+        tar_category_[to] = tar_category_[from];
+        tar_cfid_[to] = tar_cfid_[from];
+        trk_stat_[to] = trk_stat_[from];
+        iden_index_[to] = iden_index_[from];
+    }
+}
+
+void EOTargetColumns::Truncate(size_t count)
+{
+    tar_rect_.resize(count);
+    tar_category_.resize(count);
+    tar_cfid_.resize(count);
+    trk_stat_.resize(count);
+    iden_index_.resize(count);
+}
+
+void EOAccumulatePixelStats(const uint32_t *pixels, size_t count, uint32_t &minPixel,
+                            uint64_t &pixelSum)
+{
+    uint32_t min_pixel = minPixel;
+    uint64_t sum = 0;
+    size_t   i = 0;
+
+#if defined(__SSE2__)
+    if (count >= 4)
+    {
+        // SSE2 没有无符号 32 位比较：翻转符号位后按有符号比较
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i zero = _mm_setzero_si128();
+        __m128i       low = _mm_set1_epi32(static_cast<int>(min_pixel ^ 0x80000000u));
+        __m128i       total = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i value =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+            const __m128i biased = _mm_xor_si128(value, bias);
+            const __m128i less = _mm_cmplt_epi32(biased, low);
+            low = _mm_or_si128(_mm_and_si128(less, biased), _mm_andnot_si128(less, low));
+            total = _mm_add_epi64(total, _mm_unpacklo_epi32(value, zero));
+            total = _mm_add_epi64(total, _mm_unpackhi_epi32(value, zero));
+        }
+        uint32_t lanes[4];
+        uint64_t sums[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_xor_si128(low, bias));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(sums), total);
+        for (uint32_t lane : lanes)
+        {
+            if (lane < min_pixel)
+                min_pixel = lane;
+        }
+        sum = sums[0] + sums[1];
+    }
+#elif defined(__ARM_NEON)
+    if (count >= 4)
+    {
+        uint32x4_t low = vdupq_n_u32(min_pixel);
+        uint64x2_t total = vdupq_n_u64(0);
+        for (; i + 4 <= count; i += 4)
+        {
+            const uint32x4_t value = vld1q_u32(pixels + i);
+            low = vminq_u32(low, value);
+            total = vpadalq_u32(total, value);
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, low);
+        for (uint32_t lane : lanes)
+        {
+            if (lane < min_pixel)
+                min_pixel = lane;
+        }
+        sum = vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        if (pixels[i] < min_pixel)
+            min_pixel = pixels[i];
+        sum += pixels[i];
+    }
+
+    minPixel = min_pixel;
+    pixelSum += sum;
+}
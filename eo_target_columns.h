@@ -0,0 +1,73 @@
+#ifndef EO_TARGET_COLUMNS_H
+#define EO_TARGET_COLUMNS_H
+
+#include "eo_protocol_parser.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 单帧目标的列式（SoA）存储。同一帧内所有目标相同的字段（时间、source_id、
+// 当前部署中恒为 0 的角度/位姿/距离等）只在 common() 中保存一份；逐目标变化的
+// tar_rect、tar_category、tar_cfid、trk_stat 各自连续存放，tar_iden 按种类去重后
+// 只保存下标。大批量目标（如 BIRD_FLOCK 场景的数百个目标）由
+// EOProtocolParser::PackEOTargetColumnFragments 整列编码，输出与逐个
+// EOTargetInfo 编码逐字节一致。清空后重新填充不分配内存。非线程安全。
+class EOTargetColumns
+{
+  public:
+    // 单帧最多的 tar_iden 种类数，超出时 Append 返回 false
+    static const size_t kMaxIdens = 256;
+
+    // 清空目标并设置共享字段；common 中逐目标字段与 tar_iden 被忽略
+    void Reset(const EOTargetInfo &common);
+    void Clear();
+
+    // 追加一个目标，tar_iden 超过 63 字节时按 UTF-8 字符边界截断
+    bool Append(int32_t tarRect, int32_t tarCategory, float tarCfid, int32_t trkStat,
+                const char *iden, size_t idenLength);
+
+    size_t size() const { return tar_rect_.size(); }
+    bool   empty() const { return tar_rect_.empty(); }
+
+    const EOTargetInfo &common() const { return common_; }
+    const int32_t      *tar_rect() const { return tar_rect_.data(); }
+    const int32_t      *tar_category() const { return tar_category_.data(); }
+    const float        *tar_cfid() const { return tar_cfid_.data(); }
+    const int32_t      *trk_stat() const { return trk_stat_.data(); }
+    const uint16_t     *iden_index() const { return iden_index_.data(); }
+
+    size_t              iden_count() const { return idens_.size(); }
+    const EOIdenString &iden(size_t index) const { return idens_[index]; }
+
+    // 展开第 index 个目标，供仍按 EOTargetInfo 编码的路径（差分帧）使用
+    void Get(size_t index, EOTargetInfo &target) const;
+    void ExpandTo(std::vector<EOTargetInfo> &targets) const;
+
+    // 原地剔除置信度低于 threshold（含 NaN）的目标，保持原有顺序，返回剔除个数。
+    // 置信度列按 SIMD 宽度成组比较，整组保留时不移动数据。
+    size_t FilterByConfidence(float threshold);
+
+    // 按置信度保留前 K 个目标：threshold 与 ties 由 TargetFilter::TopConfidence() 求出，
+    // 先按 threshold 整列过滤，等于阈值的目标再按原有顺序保留前 ties 个。返回剔除个数。
+    size_t KeepTopConfidence(float threshold, size_t ties);
+
+  private:
+    void Move(size_t from, size_t to);
+    void Truncate(size_t count);
+
+    EOTargetInfo              common_ = EOTargetInfo();
+    std::vector<int32_t>      tar_rect_;
+    std::vector<int32_t>      tar_category_;
+    std::vector<float>        tar_cfid_;
+    std::vector<int32_t>      trk_stat_;
+    std::vector<uint16_t>     iden_index_;
+    std::vector<EOIdenString> idens_;
+    size_t                    last_iden_ = 0; // 上一个目标的标签下标，连续同类目标免查找
+};
+
+// 目标像素面积统计（DetectAnalysis 的最小值与累加和）：在 minPixel / pixelSum
+// 的已有值上累计 count 个面积。SSE2 / NEON 下每次处理 4 个。
+void EOAccumulatePixelStats(const uint32_t *pixels, size_t count, uint32_t &minPixel,
+                            uint64_t &pixelSum);
+
+#endif // EO_TARGET_COLUMNS_H
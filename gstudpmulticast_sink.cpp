@@ -18,23 +18,37 @@
 #include <gst/gst.h>
 #include <gst/gstinfo.h>
 // #include "nvdsmeta.h"
+#include "eo_delta_codec.h"
+#include "destination_router.h"
+#include "udp_address.h"
+#include "eo_compression.h"
+#include "eo_fec.h"
 #include "eo_protocol_parser.h"
+#include "eo_target_columns.h"
 #include "gstnvdsmeta.h"
 #include "gstudpmulticast_sink.h"
 #include "nvbufsurface.h"
+#include "source_heartbeat.h"
+#include "source_rate_limiter.h"
+#include "target_filter.h"
+#include "target_label_map.h"
 #include <gst/base/gstbasetransform.h>
 #include <gst/gstelement.h>
 #include <gst/gstinfo.h>
 
 #include "cuda_runtime_api.h"
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
-#include <map>
+#include <memory>
+#include <vector>
 #include <math.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/time.h>
 #include <fcntl.h>
 
@@ -72,7 +86,149 @@ enum
     PROP_IP,
     PROP_PORT,
     PROP_IFACE,
-    PROP_FPS
+    PROP_FPS,
+    PROP_FORMAT,
+    PROP_ASYNC,
+    PROP_QUEUE_DEPTH,
+    PROP_DROP_POLICY,
+    PROP_DROPPED_FRAMES,
+    PROP_TRUNCATED_OBJECTS,
+    PROP_BATCH_SEND,
+    PROP_STATS_MODE,
+    PROP_STATS_INTERVAL,
+    PROP_STATS_PORT,
+    PROP_MAP_BUFFER,
+    PROP_LATENCY_TIMESTAMPS,
+    PROP_LABEL_MAP_FILE,
+    PROP_RATE_MODE,
+    PROP_RATE_BURST,
+    PROP_SOURCE_FPS,
+    PROP_MTU,
+    PROP_KEYFRAME_INTERVAL,
+    PROP_MIN_CONFIDENCE,
+    PROP_CLASS_MIN_CONFIDENCE,
+    PROP_MIN_AREA,
+    PROP_ROI,
+    PROP_MAX_TARGETS,
+    PROP_FILTERED_OBJECTS,
+    PROP_HEARTBEAT_INTERVAL,
+    PROP_HEARTBEAT_AGGREGATE,
+    PROP_AGGREGATE,
+    PROP_FEC_GROUP_SIZE,
+    PROP_FEC_PARITY,
+    PROP_COMPRESSION,
+    PROP_COMPRESSION_DICTIONARY,
+    PROP_DESTINATIONS,
+    PROP_ROUTES
+};
+
+// 待发送报文在批量缓冲区中的位置
+struct UdpBatchMessage
+{
+    size_t  offset;       // 在 payload 中的起始偏移
+    size_t  length;       // 报文长度
+    guint   source_id;    // 仅用于日志
+    size_t  target_count; // 仅用于日志
+    guint32 destinations; // 目的地掩码（DestinationRouter::Route）
+};
+
+// 配置快照的读端槽位
+enum
+{
+    UDPMULTICAST_READER_RENDER = 0, // 流线程
+    UDPMULTICAST_READER_SENDER = 1  // 异步发送线程
+};
+
+// 发送目的地
+struct UdpDestination
+{
+    UdpAddress addr;
+    int        sockfd; // 所属 UdpTransport 中按地址族与网卡打开的套接字
+};
+
+// 目的地与发送套接字，按 ip / port / iface / destinations / routes 属性建立，建立后只读。
+// 这些属性在运行中修改时另建一组整体替换；套接字在最后一个引用释放时关闭，
+// 正在用旧目的地发送的线程不受影响
+struct UdpTransport
+{
+    DestinationRouter           router;
+    std::vector<UdpDestination> destinations; // 与 router 的目的地一一对应，未配置时只有 ip:port
+    std::vector<int>            sockets;      // 按地址族与网卡各一个
+    size_t udp_overhead = UDPMULTICAST_UDP_OVERHEAD; // 有 IPv6 目的地时按 IPv6 头计
+
+    UdpTransport() = default;
+    UdpTransport(const UdpTransport &) = delete;
+    UdpTransport &operator=(const UdpTransport &) = delete;
+    ~UdpTransport()
+    {
+        for (int sockfd : sockets)
+            close(sockfd);
+    }
+};
+
+// 运行中可修改的配置快照：render 与发送线程经 RcuSnapshot 无锁读取，属性修改时整体替换。
+// 目的地未修改时新旧快照共用同一个 transport
+struct UdpLiveConfig
+{
+    guint                               fps;
+    std::string                         source_fps; // 发布前已校验
+    TargetFilter                        filter;
+    std::shared_ptr<const UdpTransport> transport;
+    guint64                             generation; // 每次发布递增，自 start() 起为 1
+};
+
+// sendmmsg 中的一个报文副本：第 message 个报文发往第 destination 个目的地
+struct UdpBatchEntry
+{
+    size_t message;
+    size_t destination;
+};
+
+// sendmmsg 批量发送缓冲，报文连续编码在 payload 中，冲刷后复用容量
+struct UdpSendBatch
+{
+    std::vector<guint8>          payload;
+    size_t                       used = 0;
+    std::vector<UdpBatchMessage> messages;
+    std::vector<struct mmsghdr>  headers;
+    std::vector<struct iovec>    iovecs;
+    std::vector<EOFragment>      fragments; // 当前帧编码出的报文（超过 MTU 时为多个分片）
+    std::vector<guint32>         source_sn; // 按 source_id 索引的上一报文 src_sn
+    bool                         sendmmsg_supported = true; // 内核不支持时回退 sendto
+    EOTargetColumns              columns; // 当前帧的目标（列式），跨帧复用容量
+    std::vector<EOTargetInfo>    targets; // delta 格式按 EOTargetInfo 编码时的展开结果
+    SourceHeartbeat              heartbeat; // 空闲心跳状态，由发送报文的线程独占
+    std::vector<guint32>         heartbeat_due;     // 聚合模式下本次到期的视频源
+    std::vector<EOHeartbeat>     heartbeat_sources; // 心跳报文中的视频源
+    bool                         aggregate = false; // 聚合发送，start() 中按属性与格式确定
+    std::vector<EOTargetColumns> frames;      // 聚合模式下本批次待发送的帧，跨批次复用容量
+    size_t                       frame_count = 0;
+    std::vector<const EOTargetColumns *> frame_order; // frames 按 source_id 排序后的顺序
+    guint32                      batch_sn = 0;     // 聚合报文的批次序号（报文头 src_sn）
+    guint                        pending_seq = 0;  // 异步模式下 frames 所属的 batch_seq
+    std::shared_ptr<const UdpTransport> transport; // 当前发送的目的地，由 use_send_transport() 换用
+    std::vector<EOFecEncoder>    fec;          // 按目的地的 FEC 分组，各目的地收到的报文可能不同
+    std::vector<UdpBatchEntry>   entries;      // 与 headers 一一对应
+    std::vector<EOFragment>      fec_parities; // 当前分组生成的校验报文
+    std::vector<guint8>          fec_buffer;   // 逐个发送时校验报文的编码缓冲
+    EOCompressor                 compressor;   // 报文压缩，start() 中按属性配置
+};
+
+// 检测统计窗口，仅在流线程中访问
+struct DetectStatsWindow
+{
+    std::vector<DetectAnalysis> sources;          // 按 source_id 索引
+    gint64                      window_start = 0; // 窗口起点（单调时钟，微秒）
+    std::vector<guint32>        pixels;           // 当前帧各目标的像素面积，帧末整列统计
+};
+
+// 异步模式下当前帧通过逐目标过滤的目标，帧末按 max-targets 选出后写入发送记录；
+// 仅在流线程中访问
+struct AsyncFrameObjects
+{
+    std::vector<AsyncObjectRecord> objects;
+    std::vector<gfloat>            confidences; // 与 objects 一一对应，供前 K 个选择
+    guint                          batch_seq = 0; // 每个 NvDsBatchMeta 递增，写入发送记录
 };
 
 /* the capabilities of the inputs and outputs.
@@ -90,6 +246,10 @@ static void gst_udpmulticast_sink_get_property(GObject    *object,
                                                guint       property_id,
                                                GValue     *value,
                                                GParamSpec *pspec);
+static void gst_udpmulticast_sink_read_property(Gstudpmulticast_sink *self,
+                                                guint                 property_id,
+                                                GValue               *value,
+                                                GParamSpec           *pspec);
 static void gst_udpmulticast_sink_finalize(GObject *object);
 
 #define gst_udpmulticast_sink_parent_class parent_class
@@ -103,61 +263,149 @@ static GstFlowReturn gst_udpmulticast_sink_render(GstBaseSink *sink,
 static gboolean      gst_udpmulticast_sink_start(GstBaseSink *sink);
 static gboolean      gst_udpmulticast_sink_stop(GstBaseSink *sink);
 
-struct TargetLabelMapping
+GType gst_udpmulticast_sink_format_get_type(void)
 {
-    int         tar_category; // 映射后的目标类别编码
-    std::string tar_iden;     // 映射后的目标标签名
-};
+    static gsize format_type = 0;
+    if (g_once_init_enter(&format_type))
+    {
+        static const GEnumValue values[] = {
+            {static_cast<gint>(BodyType::JSON), "JSON text payload", "json"},
+            {static_cast<gint>(BodyType::BINARY),
+             "Compact little-endian binary payload", "binary"},
+            {static_cast<gint>(BodyType::DELTA),
+             "Binary keyframes with per-source delta frames", "delta"},
+            {0, NULL, NULL}};
+        GType type =
+            g_enum_register_static("GstUdpMulticastSinkFormat", values);
+        g_once_init_leave(&format_type, type);
+    }
+    return format_type;
+}
 
-static gdouble
-get_current_time_seconds(void)
+GType gst_udpmulticast_sink_drop_policy_get_type(void)
 {
-    struct timeval tv_now;
-    gettimeofday(&tv_now, NULL);
-    return tv_now.tv_sec + tv_now.tv_usec / 1000000.0;
+    static gsize drop_policy_type = 0;
+    if (g_once_init_enter(&drop_policy_type))
+    {
+        static const GEnumValue values[] = {
+            {UDPMULTICAST_DROP_OLDEST, "Drop the oldest queued frame",
+             "drop-oldest"},
+            {UDPMULTICAST_DROP_NEWEST, "Drop the incoming frame", "drop-newest"},
+            {0, NULL, NULL}};
+        GType type = g_enum_register_static("GstUdpMulticastSinkDropPolicy",
+                                            values);
+        g_once_init_leave(&drop_policy_type, type);
+    }
+    return drop_policy_type;
 }
 
-static gboolean
-should_send_for_source(Gstudpmulticast_sink *self, guint source_id,
-                       gdouble current_time)
+// 目标时间戳字段，按帧计算一次
+struct TargetTimestamp
 {
-    gdouble send_interval = (self->fps > 0) ? (1.0 / self->fps) : 0.04;
-    auto    last_it = self->last_send_time_by_source.find(source_id);
+    int   yr;
+    int   mo;
+    int   dy;
+    int   h;
+    int   min;
+    int   sec;
+    float msec;
+};
 
-    if (last_it == self->last_send_time_by_source.end() ||
-        current_time - last_it->second >= send_interval)
+GType gst_udpmulticast_sink_stats_mode_get_type(void)
+{
+    static gsize stats_mode_type = 0;
+    if (g_once_init_enter(&stats_mode_type))
     {
-        self->last_send_time_by_source[source_id] = current_time;
-        return TRUE;
+        static const GEnumValue values[] = {
+            {UDPMULTICAST_STATS_NONE, "Disable detection statistics", "none"},
+            {UDPMULTICAST_STATS_LOG, "Log statistics once per window", "log"},
+            {UDPMULTICAST_STATS_MESSAGE,
+             "Post an element message on the bus once per window", "message"},
+            {UDPMULTICAST_STATS_DATAGRAM,
+             "Send a JSON multicast datagram once per window", "datagram"},
+            {0, NULL, NULL}};
+        GType type = g_enum_register_static("GstUdpMulticastSinkStatsMode",
+                                            values);
+        g_once_init_leave(&stats_mode_type, type);
     }
+    return stats_mode_type;
+}
 
-    return FALSE;
+GType gst_udpmulticast_sink_rate_mode_get_type(void)
+{
+    static gsize rate_mode_type = 0;
+    if (g_once_init_enter(&rate_mode_type))
+    {
+        static const GEnumValue values[] = {
+            {UDPMULTICAST_RATE_INTERVAL, "Fixed send interval per source",
+             "interval"},
+            {UDPMULTICAST_RATE_TOKEN_BUCKET,
+             "Token bucket per source allowing short bursts", "token-bucket"},
+            {0, NULL, NULL}};
+        GType type = g_enum_register_static("GstUdpMulticastSinkRateMode",
+                                            values);
+        g_once_init_leave(&rate_mode_type, type);
+    }
+    return rate_mode_type;
 }
 
-static void
-fill_target_timestamp(EOTargetInfo *target_info)
+GType gst_udpmulticast_sink_compression_get_type(void)
 {
-    struct timeval tv;
-    struct tm      tm_info;
+    static gsize compression_type = 0;
+    if (g_once_init_enter(&compression_type))
+    {
+        static const GEnumValue values[] = {
+            {UDPMULTICAST_COMPRESSION_NONE, "Send datagrams uncompressed", "none"},
+            {UDPMULTICAST_COMPRESSION_LZ4, "LZ4 block compression", "lz4"},
+            {UDPMULTICAST_COMPRESSION_DEFLATE, "Raw deflate compression", "deflate"},
+            {0, NULL, NULL}};
+        GType type = g_enum_register_static("GstUdpMulticastSinkCompression",
+                                            values);
+        g_once_init_leave(&compression_type, type);
+    }
+    return compression_type;
+}
 
-    gettimeofday(&tv, NULL);
-    localtime_r(&tv.tv_sec, &tm_info);
+/**
+ * @brief 由帧时间生成目标时间戳字段。
+ *
+ * 每帧只做一次 localtime_r，帧内所有目标共用结果。
+ */
+static void
+make_target_timestamp(const struct timeval *tv, TargetTimestamp *timestamp)
+{
+    struct tm tm_info;
+
+    localtime_r(&tv->tv_sec, &tm_info);
+    timestamp->yr = tm_info.tm_year + 1900;
+    timestamp->mo = tm_info.tm_mon + 1;
+    timestamp->dy = tm_info.tm_mday;
+    timestamp->h = tm_info.tm_hour;
+    timestamp->min = tm_info.tm_min;
+    timestamp->sec = tm_info.tm_sec;
+    timestamp->msec = tv->tv_usec / 1000.0f;
+}
 
-    target_info->yr = tm_info.tm_year + 1900;
-    target_info->mo = tm_info.tm_mon + 1;
-    target_info->dy = tm_info.tm_mday;
-    target_info->h = tm_info.tm_hour;
-    target_info->min = tm_info.tm_min;
-    target_info->sec = tm_info.tm_sec;
-    target_info->msec = tv.tv_usec / 1000.0f;
+static void
+fill_target_timestamp(EOTargetInfo *target_info,
+                      const TargetTimestamp &timestamp)
+{
+    target_info->yr = timestamp.yr;
+    target_info->mo = timestamp.mo;
+    target_info->dy = timestamp.dy;
+    target_info->h = timestamp.h;
+    target_info->min = timestamp.min;
+    target_info->sec = timestamp.sec;
+    target_info->msec = timestamp.msec;
 }
 
+// 无目标帧的占位目标；其时间、source_id 等字段同时作为列式目标的帧内共享字段
 static EOTargetInfo
-create_empty_target(guint source_id)
+create_empty_target(guint source_id, const TargetTimestamp &timestamp)
 {
     EOTargetInfo empty_target = {};
 
-    fill_target_timestamp(&empty_target);
+    fill_target_timestamp(&empty_target, timestamp);
 
     empty_target.dev_id = 0;
     empty_target.guid_id = 0;
@@ -188,384 +436,2039 @@ create_empty_target(guint source_id)
 }
 
 /**
- * @brief 根据 DeepStream 目标标签名映射 EO 报文中的类别字段。
+ * @brief 把检测目标追加到当前帧的列式目标中。
+ *
+ * 时间、source_id 等帧内共享字段已由 EOTargetColumns::Reset() 设置。
  *
- * @param obj_label DeepStream 生成的目标标签名，通常来自 labelfile-path。
- * @return 映射后的目标类别编码和目标标签名。
+ * @param columns 当前帧的目标。
+ * @param tar_rect 目标中心的像素值。
+ * @param confidence 最终置信度。
+ * @param label_entry 目标标签映射结果。
+ */
+static void
+append_detected_target(EOTargetColumns *columns, gint tar_rect, gfloat confidence,
+                       const TargetLabelEntry &label_entry)
+{
+    columns->Append(tar_rect, label_entry.tar_category, confidence,
+                    (confidence < 0.0f) ? 2 : 1, // 置信度<0置2，否则为1
+                    label_entry.tar_iden.data(), label_entry.tar_iden.size());
+}
+
+/**
+ * @brief 当前帧没有目标时追加 1 个占位目标，字段与 create_empty_target() 相同。
  */
-static TargetLabelMapping
-map_target_label_to_eo_fields(const gchar *obj_label)
+static void
+append_empty_target(EOTargetColumns *columns)
+{
+    if (columns->empty())
+    {
+        columns->Append(0, static_cast<int>(TargetClass::UNKNOWN), 0.0f, 0, "none", 4);
+    }
+}
+
+/**
+ * @brief 单个目标 / 心跳报文的最大长度。启用 FEC 时预留校验报文的分组信息，
+ * 使校验报文同样不超过 MTU。
+ */
+static size_t
+max_datagram_size(Gstudpmulticast_sink *self)
 {
-    const std::string label_name = (obj_label != NULL) ? obj_label : ""; // 目标标签文本
+    const UdpSendBatch *batch = self->send_batch;
+    size_t              max_datagram =
+        MIN(self->mtu - batch->transport->udp_overhead, UDPMULTICAST_MAX_PAYLOAD);
+    if (!batch->fec.empty() && batch->fec[0].enabled())
+        max_datagram -= MIN(batch->fec[0].overhead(), max_datagram / 2);
+    return max_datagram;
+}
 
-    if (label_name.empty())
+/**
+ * @brief 按 format 属性编码 send_batch->columns 中的目标报文，超过 MTU 时按目标拆分为多个报文。
+ *
+ * 报文写入 send_batch->payload 中 used 之后的位置，各报文相对该位置的
+ * 偏移写入 send_batch->fragments；分片共用同一个 msg_sn。
+ * json / binary 格式直接整列编码；delta 格式先展开为 EOTargetInfo，优先发送
+ * 单个差分帧，需要关键帧时按 binary 格式发送并记为参考。
+ * 报文头带按源递增的 32 位 src_sn 与发送时刻 send_us，供接收端统计丢包与时延。
+ *
+ * @return 报文个数；编码失败时告警并返回 0。
+ */
+static size_t
+pack_target_message(Gstudpmulticast_sink *self, guint source_id)
+{
+    UdpSendBatch          *batch = self->send_batch;
+    const EOTargetColumns &columns = batch->columns;
+    const bool             delta = (self->format == static_cast<guint>(BodyType::DELTA));
+    const BodyType format = delta ? BodyType::BINARY : static_cast<BodyType>(self->format);
+    const size_t   max_datagram = max_datagram_size(self);
+    const size_t capacity =
+        EOProtocolParser::GetMaxEOTargetColumnFragmentsSize(columns, format);
+
+    if (batch->payload.size() < batch->used + capacity)
     {
-        return {static_cast<int>(TargetClass::UNKNOWN), "unknown"};
+        batch->payload.resize(batch->used + capacity);
     }
 
-    if (label_name == "人" || label_name == "person" || label_name == "Person" ||
-        label_name == "pedestrian" || label_name == "Pedestrian")
+    if (batch->source_sn.size() <= source_id)
     {
-        return {static_cast<int>(TargetClass::PEDESTRIAN), label_name};
+        batch->source_sn.resize(source_id + 1, 0);
     }
+    const guint16    send_count = ++self->send_count;
+    const EOSequence sequence = {++batch->source_sn[source_id], g_get_real_time(), 0};
+    size_t           count = 0;
+    if (delta)
+    {
+        // 差分帧不分片，超过单个报文时改发关键帧
+        std::vector<EOTargetInfo> &target_infos = batch->targets;
+        columns.ExpandTo(target_infos);
+        size_t size = self->delta_encoder->PackDelta(
+            source_id, target_infos.data(), target_infos.size(), send_count,
+            batch->payload.data() + batch->used, MIN(capacity, max_datagram),
+            &sequence);
+        if (size > 0)
+        {
+            EOFragment fragment = {0, size, 0, target_infos.size()};
+            batch->fragments.assign(1, fragment);
+            return 1;
+        }
 
-    if (label_name == "无人机" || label_name == "uav" || label_name == "UAV" ||
-        label_name == "drone" || label_name == "Drone")
+        count = EOProtocolParser::PackEOTargetFragments(
+            target_infos.data(), target_infos.size(), send_count, format, max_datagram,
+            batch->payload.data() + batch->used, capacity, batch->fragments, &sequence);
+        if (count > 0)
+        {
+            self->delta_encoder->CommitKeyframe(source_id, target_infos.data(),
+                                                target_infos.size(), send_count);
+        }
+    }
+    else
     {
-        return {static_cast<int>(TargetClass::UAV), label_name};
+        count = EOProtocolParser::PackEOTargetColumnFragments(
+            columns, send_count, format, max_datagram, batch->payload.data() + batch->used,
+            capacity, batch->fragments, &sequence);
     }
 
-    return {static_cast<int>(TargetClass::UNKNOWN), label_name};
+    if (count == 0)
+    {
+        GST_WARNING_OBJECT(self,
+                           "Failed to encode EO target message for source_id=%u "
+                           "with %zu targets, dropping frame",
+                           source_id, columns.size());
+    }
+    else if (count > 1)
+    {
+        GST_LOG_OBJECT(self,
+                       "EO target message for source_id=%u with %zu targets "
+                       "split into %zu datagrams (mtu %u)",
+                       source_id, columns.size(), count, self->mtu);
+    }
+    return count;
 }
-
+/**
+ * @brief 用 sendto 向一个目的地发送单个报文。
+ */
 static void
-log_detect_analysis(guint source_id, const DetectAnalysis &detect_analysis)
+send_datagram(Gstudpmulticast_sink *self, const UdpDestination &destination,
+              const guint8 *data, size_t size, guint source_id, size_t target_count)
 {
-    GST_INFO("<===================================");
-    GST_INFO("source_id: %u", source_id);
-    GST_INFO("frameNum: %lu", detect_analysis.frameNum);
-    for (std::map<guint16, guint>::const_iterator it =
-             detect_analysis.primaryClassCountMap.begin();
-         it != detect_analysis.primaryClassCountMap.end(); ++it)
+    ssize_t sent = sendto(destination.sockfd, data, size, MSG_DONTWAIT,
+                          destination.addr.get(), destination.addr.length);
+    if (sent < 0)
     {
-        GST_INFO("primaryClassCountMap: %d, %d", it->first, it->second);
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            GST_WARNING_OBJECT(self, "Multicast socket busy, dropping frame");
+        }
+        else
+        {
+            GST_WARNING(
+                "Failed to send EO target message for source_id=%u with %zu targets: %s",
+                source_id, target_count, strerror(errno));
+        }
     }
-    for (std::map<guint16, guint>::const_iterator it =
-             detect_analysis.secondaryClassCountMap.begin();
-         it != detect_analysis.secondaryClassCountMap.end(); ++it)
+    else
     {
-        GST_INFO("secondaryClassCountMap: %d, %d", it->first, it->second);
+        GST_DEBUG("Successfully sent EO target message for source_id=%u "
+                  "with %zu targets, size: %zu bytes",
+                  source_id, target_count, size);
     }
-    GST_INFO("minPixel: %d", detect_analysis.minPixel);
-    GST_INFO("meanPixel: %d", detect_analysis.meanPixel);
-    GST_INFO("===================================>");
 }
 
-/* GObject vmethod implementations */
+/**
+ * @brief 为目的地 index 的当前 FEC 分组生成校验报文并逐个发送（未启用 batch-send 时）。
+ */
+static void
+send_fec_parities(Gstudpmulticast_sink *self, size_t index)
+{
+    UdpSendBatch         *batch = self->send_batch;
+    const UdpDestination &destination = batch->transport->destinations[index];
+    const size_t          count =
+        batch->fec[index].Finish(batch->fec_buffer, 0, batch->fec_parities);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const EOFragment &parity = batch->fec_parities[i];
+        send_datagram(self, destination, batch->fec_buffer.data() + parity.offset,
+                      parity.length, 0, 0);
+    }
+}
 
-/* initialize the _udpmulticast_sink's class */
-static void gst_udpmulticast_sink_class_init(Gstudpmulticast_sinkClass *klass)
+/**
+ * @brief 逐个发送目标 / 心跳报文；启用压缩时发送压缩后更短的报文。
+ * 报文按 source_id 的路由发往各目的地，启用 FEC 时按目的地累加校验，
+ * 分组满后紧接着向该目的地发送校验报文。
+ */
+static void
+send_data_datagram(Gstudpmulticast_sink *self, const guint8 *data, size_t size,
+                   guint source_id, size_t target_count)
 {
-    GObjectClass     *gobject_class = G_OBJECT_CLASS(klass);
-    GstElementClass  *gstelement_class;
-    GstBaseSinkClass *base_sink_class = GST_BASE_SINK_CLASS(klass);
+    UdpSendBatch *batch = self->send_batch;
+    EOCompressor &compressor = batch->compressor;
+    const size_t  compressed = compressor.Compress(data, size);
+    if (compressed > 0)
+    {
+        data = compressor.output();
+        size = compressed;
+    }
+    const UdpTransport &transport = *batch->transport;
+    const guint32       mask = transport.router.Route(source_id);
+    const gint64        now_ns = SourceRateLimiter::NowNs();
+    for (size_t d = 0; d < transport.destinations.size(); ++d)
+    {
+        if (!(mask & (1u << d)))
+            continue;
+        send_datagram(self, transport.destinations[d], data, size, source_id, target_count);
+        if (batch->fec[d].Add(data, size, now_ns))
+        {
+            send_fec_parities(self, d);
+        }
+    }
+}
 
-    gstelement_class = (GstElementClass *)klass;
+/**
+ * @brief 为目的地 index 的当前 FEC 分组生成校验报文，追加到批量缓冲区末尾，只发往该目的地。
+ */
+static void
+append_fec_parities(Gstudpmulticast_sink *self, size_t index)
+{
+    UdpSendBatch *batch = self->send_batch;
+    const size_t  count = batch->fec[index].Finish(batch->payload, batch->used,
+                                                   batch->fec_parities);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const EOFragment &parity = batch->fec_parities[i];
+        UdpBatchMessage   message = {batch->used + parity.offset, parity.length, 0, 0,
+                                     1u << index};
+        batch->messages.push_back(message);
+    }
+    if (count > 0)
+    {
+        const EOFragment &last = batch->fec_parities[count - 1];
+        batch->used += last.offset + last.length;
+    }
+}
 
-    gobject_class->set_property = gst_udpmulticast_sink_set_property;
-    gobject_class->get_property = gst_udpmulticast_sink_get_property;
-    gobject_class->finalize = gst_udpmulticast_sink_finalize;
+/**
+ * @brief 冲刷前就地压缩批量缓冲区中的报文：压缩后更短时覆盖原报文并缩短长度，
+ * 否则保持原样。须在 protect_send_batch() 之前调用，校验按压缩后的报文计算。
+ */
+static void
+compress_send_batch(Gstudpmulticast_sink *self)
+{
+    UdpSendBatch *batch = self->send_batch;
+    if (batch->compressor.codec() == EOCompression::NONE)
+        return;
 
-    base_sink_class->render = GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_render);
-    base_sink_class->start = GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_start);
-    base_sink_class->stop = GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_stop);
-    base_sink_class->set_caps =
-        GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_set_caps);
+    for (UdpBatchMessage &message : batch->messages)
+    {
+        guint8      *data = batch->payload.data() + message.offset;
+        const size_t compressed = batch->compressor.Compress(data, message.length);
+        if (compressed > 0)
+        {
+            memcpy(data, batch->compressor.output(), compressed);
+            message.length = compressed;
+        }
+    }
+}
 
-    gst_element_class_add_static_pad_template(GST_ELEMENT_CLASS(klass),
-                                              &sink_factory);
+/**
+ * @brief 冲刷前按目的地为批量缓冲区中的报文累加 FEC 校验，分组满时追加只发往该目的地的校验报文；
+ * 未满的分组等待超过 UDPMULTICAST_FEC_MAX_DELAY_NS 后按已有报文结束，避免低码率时恢复延迟过大。
+ */
+static void
+protect_send_batch(Gstudpmulticast_sink *self)
+{
+    UdpSendBatch *batch = self->send_batch;
+    if (batch->fec.empty() || !batch->fec[0].enabled())
+        return;
 
-    /* Set metadata describing the element */
-    gst_element_class_set_details_simple(
-        gstelement_class, "DsUdpMulticastSink plugin",
-        "DsUdpMulticastSink Plugin",
-        "Process a infer mst network on objects / full frame",
-        "ShenChangli "
-        "@ karmueo@163.com");
+    const gint64 now_ns = SourceRateLimiter::NowNs();
+    const size_t count = batch->messages.size();
+    for (size_t d = 0; d < batch->fec.size(); ++d)
+    {
+        EOFecEncoder &fec = batch->fec[d];
+        for (size_t i = 0; i < count; ++i)
+        {
+            // append_fec_parities() 会扩展 messages 与 payload，按下标取报文；
+            // 下标 count 之后是校验报文，不再参与编码
+            const UdpBatchMessage &message = batch->messages[i];
+            if (!(message.destinations & (1u << d)))
+                continue;
+            const size_t offset = message.offset;
+            const size_t length = message.length;
+            if (fec.Add(batch->payload.data() + offset, length, now_ns))
+                append_fec_parities(self, d);
+        }
+        if (fec.pending() > 0 && now_ns - fec.first_ns() >= UDPMULTICAST_FEC_MAX_DELAY_NS)
+        {
+            if (self->batch_send)
+                append_fec_parities(self, d);
+            else
+                send_fec_parities(self, d);
+        }
+    }
+}
 
-    /* install properties */
-    g_object_class_install_property(
-        gobject_class, PROP_SILENT,
-        g_param_spec_boolean("silent", "Silent", "Produce verbose output ?",
-                             TRUE, G_PARAM_READWRITE));
-    g_object_class_install_property(
-        gobject_class, PROP_IP,
-        g_param_spec_string(
-            "ip", "Multicast IP", "Multicast destination IP", "239.255.255.250",
-            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
-    g_object_class_install_property(
-        gobject_class, PROP_PORT,
-        g_param_spec_uint(
-            "port", "Multicast Port", "Multicast destination port", 1, 65535,
-            5000, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
-    g_object_class_install_property(
-        gobject_class, PROP_IFACE,
-        g_param_spec_string(
-            "iface", "Network Interface",
-            "Network interface name for multicast (e.g., eth0, enp5s0)", NULL,
-            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
-    g_object_class_install_property(
-        gobject_class, PROP_FPS,
-        g_param_spec_uint(
-            "fps", "Report FPS", "Frame rate for sending target reports", 1, 120,
-            25, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+/**
+ * @brief 用一次 sendmmsg 发送 headers 中发往同一套接字的全部报文副本。
+ *
+ * 部分发送时从首个未发送的报文继续；单个报文失败时跳过该报文；
+ * 套接字忙时丢弃剩余报文；内核不支持 sendmmsg 时回退为逐个 sendto。
+ */
+static void
+send_batch_entries(Gstudpmulticast_sink *self, int sockfd)
+{
+    UdpSendBatch *batch = self->send_batch;
+    const size_t  count = batch->entries.size();
+    size_t        sent = 0;
+
+    if (count > 1 && batch->sendmmsg_supported)
+    {
+        while (sent < count)
+        {
+            int n = sendmmsg(sockfd, &batch->headers[sent], (unsigned int)(count - sent),
+                             MSG_DONTWAIT);
+            if (n > 0)
+            {
+                sent += n;
+            }
+            else if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (n < 0 && errno == ENOSYS)
+            {
+                GST_WARNING_OBJECT(self,
+                                   "sendmmsg not supported, falling back to sendto");
+                batch->sendmmsg_supported = false;
+                break;
+            }
+            else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                GST_WARNING_OBJECT(self,
+                                   "Multicast socket busy, dropping %zu frames",
+                                   count - sent);
+                sent = count;
+            }
+            else if (n < 0)
+            {
+                // sendmmsg 仅在首个报文失败时返回错误，跳过该报文继续发送
+                const UdpBatchMessage &message = batch->messages[batch->entries[sent].message];
+                GST_WARNING(
+                    "Failed to send EO target message for source_id=%u with %zu targets: %s",
+                    message.source_id, message.target_count, strerror(errno));
+                ++sent;
+            }
+            else
+            {
+                break;
+            }
+        }
+        GST_DEBUG("Sent %zu EO target messages with sendmmsg", sent);
+    }
 
+    for (; sent < count; ++sent)
+    {
+        const UdpBatchEntry   &entry = batch->entries[sent];
+        const UdpBatchMessage &message = batch->messages[entry.message];
+        send_datagram(self, batch->transport->destinations[entry.destination],
+                      batch->payload.data() + message.offset, message.length,
+                      message.source_id, message.target_count);
+    }
 }
 
-/* initialize the new element
- * instantiate pads and add them to element
- * set pad callback functions
- * initialize instance structure
- * 初始化新element
- * 实例化 pads 并将它们添加到element中
- * 设置 pad 回调函数
- * 初始化实例结构
+/**
+ * @brief 冲刷批量缓冲区：每个套接字一次 sendmmsg 发送全部待发报文。
+ *
+ * 报文只编码一次，按目的地掩码展开为发往各目的地的副本（共用 payload 中的数据），
+ * 同一网卡的目的地共用套接字，在同一次 sendmmsg 中发出。
+ * 启用压缩时先就地压缩各报文；启用 FEC 时校验报文跟在所保护的报文之后一起发送。
  */
-static void gst_udpmulticast_sink_init(Gstudpmulticast_sink *self)
+static void
+flush_send_batch(Gstudpmulticast_sink *self)
 {
-    // 初始化一些参数
-    self->gpu_id = 0;
-    // default values
-    self->ip = g_strdup("239.255.255.250");
-    self->port = 5000;
-    self->iface = NULL;
-    self->fps = 25;
-    self->send_count = 0;
+    UdpSendBatch       *batch = self->send_batch;
+    const UdpTransport &transport = *batch->transport;
+    compress_send_batch(self);
+    protect_send_batch(self);
+    const size_t count = batch->messages.size();
 
-    // 创建UDP Socket
-    self->sockfd = socket(AF_INET, SOCK_DGRAM, 0);
-    if (self->sockfd < 0)
-    {
-        GST_ERROR("Failed to create socket");
+    if (count == 0)
         return;
+
+    batch->iovecs.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch->iovecs[i].iov_base = batch->payload.data() + batch->messages[i].offset;
+        batch->iovecs[i].iov_len = batch->messages[i].length;
+    }
+
+    for (int sockfd : transport.sockets)
+    {
+        batch->entries.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const guint32 mask = batch->messages[i].destinations;
+            for (size_t d = 0; d < transport.destinations.size(); ++d)
+            {
+                if ((mask & (1u << d)) && transport.destinations[d].sockfd == sockfd)
+                {
+                    UdpBatchEntry entry = {i, d};
+                    batch->entries.push_back(entry);
+                }
+            }
+        }
+        if (batch->entries.empty())
+            continue;
+
+        batch->headers.resize(batch->entries.size());
+        for (size_t j = 0; j < batch->entries.size(); ++j)
+        {
+            const UdpDestination &destination =
+                transport.destinations[batch->entries[j].destination];
+            struct mmsghdr *header = &batch->headers[j];
+
+            memset(header, 0, sizeof(*header));
+            header->msg_hdr.msg_name = const_cast<sockaddr_storage *>(&destination.addr.storage);
+            header->msg_hdr.msg_namelen = destination.addr.length;
+            header->msg_hdr.msg_iov = &batch->iovecs[batch->entries[j].message];
+            header->msg_hdr.msg_iovlen = 1;
+        }
+        send_batch_entries(self, sockfd);
+    }
+
+    batch->messages.clear();
+    batch->used = 0;
+}
+
+/**
+ * @brief 发送 send_batch->fragments 中刚编码的 count 个报文。
+ *
+ * 启用 batch-send 时报文只追加到批量缓冲区，由 flush_send_batch() 统一发送。
+ */
+static void
+send_fragments(Gstudpmulticast_sink *self, size_t count, guint source_id)
+{
+    UdpSendBatch *batch = self->send_batch;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const EOFragment &fragment = batch->fragments[i];
+        if (!self->batch_send)
+        {
+            send_data_datagram(self, batch->payload.data() + fragment.offset,
+                               fragment.length, source_id, fragment.count);
+            continue;
+        }
+        UdpBatchMessage message = {batch->used + fragment.offset, fragment.length, source_id,
+                                   fragment.count, batch->transport->router.Route(source_id)};
+        batch->messages.push_back(message);
+    }
+    if (!self->batch_send || count == 0)
+        return;
+
+    const EOFragment &last = batch->fragments[count - 1];
+    batch->used += last.offset + last.length;
+
+    if (batch->messages.size() >= UDPMULTICAST_MAX_BATCH_MESSAGES)
+    {
+        flush_send_batch(self);
+    }
+}
+
+/**
+ * @brief 编码 send_batch->columns 中的目标报文并发送。
+ */
+static void
+send_target_message(Gstudpmulticast_sink *self, guint source_id)
+{
+    send_fragments(self, pack_target_message(self, source_id), source_id);
+}
+
+/**
+ * @brief 聚合模式：把本批次暂存的各视频源帧合并编码为尽量少的报文并发送。
+ *
+ * 帧按 source_id 稳定排序，同一视频源的目标在报文中相邻并保持原有顺序；
+ * 超过 MTU 时按目标拆分，分片共用 msg_sn。报文头 src_sn 为按批次递增的序号，
+ * src_cnt 为报文中的视频源个数。
+ */
+static void
+send_batch_message(Gstudpmulticast_sink *self)
+{
+    UdpSendBatch *batch = self->send_batch;
+    const size_t  frame_count = batch->frame_count;
+    if (frame_count == 0)
+        return;
+    batch->frame_count = 0;
+
+    std::vector<const EOTargetColumns *> &order = batch->frame_order;
+    order.resize(frame_count);
+    for (size_t i = 0; i < frame_count; ++i)
+    {
+        order[i] = &batch->frames[i];
+    }
+    // 指针即暂存顺序：同一视频源按指针比较等价于稳定排序，且不申请临时缓冲
+    std::sort(order.begin(), order.end(),
+              [](const EOTargetColumns *a, const EOTargetColumns *b) {
+                  return a->common().source_id != b->common().source_id
+                             ? a->common().source_id < b->common().source_id
+                             : a < b;
+              });
+    size_t sources = 0;
+    for (size_t i = 0; i < frame_count; ++i)
+    {
+        if (i == 0 || order[i]->common().source_id != order[i - 1]->common().source_id)
+            ++sources;
+    }
+
+    const BodyType format = static_cast<BodyType>(self->format);
+    const size_t   max_datagram = max_datagram_size(self);
+    const size_t capacity =
+        EOProtocolParser::GetMaxEOTargetBatchFragmentsSize(order.data(), frame_count, format);
+    if (batch->payload.size() < batch->used + capacity)
+    {
+        batch->payload.resize(batch->used + capacity);
+    }
+
+    const guint16    send_count = ++self->send_count;
+    const EOSequence sequence = {++batch->batch_sn, g_get_real_time(), (int)sources};
+    const guint      first_source = (guint)order[0]->common().source_id;
+    size_t           count = EOProtocolParser::PackEOTargetBatchFragments(
+        order.data(), frame_count, send_count, format, max_datagram,
+        batch->payload.data() + batch->used, capacity, batch->fragments, &sequence);
+    if (count == 0)
+    {
+        GST_WARNING_OBJECT(self,
+                           "Failed to encode aggregate EO target message for %zu sources, "
+                           "dropping batch",
+                           sources);
+        return;
+    }
+    GST_LOG_OBJECT(self, "Aggregate EO target message for %zu sources in %zu datagrams",
+                   sources, count);
+    send_fragments(self, count, first_source);
+}
+
+/**
+ * @brief 发送 source_ids 中各视频源的心跳，超过 MTU 时拆分为多个报文。
+ *
+ * 心跳携带各视频源最近一个目标报文的 src_sn（不递增；聚合模式下目标报文不按源编号，
+ * 恒为 0），json 格式发送 JSON 心跳，
+ * 其余格式发送二进制心跳。与目标报文共用批量缓冲区。
+ */
+static void
+send_heartbeat_message(Gstudpmulticast_sink *self, const guint32 *source_ids, size_t count)
+{
+    UdpSendBatch  *batch = self->send_batch;
+    const BodyType format = (self->format == static_cast<guint>(BodyType::JSON))
+                                ? BodyType::JSON
+                                : BodyType::BINARY;
+    const size_t   max_datagram = max_datagram_size(self);
+    const size_t   per_message =
+        EOProtocolParser::GetMaxEOHeartbeatSources(max_datagram, format);
+    const gint64   send_us = g_get_real_time();
+
+    batch->heartbeat_sources.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const guint32 source_id = source_ids[i];
+        batch->heartbeat_sources[i].source_id = source_id;
+        batch->heartbeat_sources[i].src_sn =
+            (source_id < batch->source_sn.size()) ? batch->source_sn[source_id] : 0;
+    }
+
+    for (size_t first = 0; first < count; first += per_message)
+    {
+        const size_t n = MIN(per_message, count - first);
+        const size_t capacity = EOProtocolParser::GetMaxEOHeartbeatMessageSize(n, format);
+        if (batch->payload.size() < batch->used + capacity)
+        {
+            batch->payload.resize(batch->used + capacity);
+        }
+        size_t size = EOProtocolParser::PackEOHeartbeatMessage(
+            &batch->heartbeat_sources[first], n, format, send_us,
+            batch->payload.data() + batch->used, capacity);
+        if (size == 0)
+        {
+            GST_WARNING_OBJECT(self, "Failed to encode heartbeat for %zu sources", n);
+            return;
+        }
+        if (!self->batch_send)
+        {
+            send_data_datagram(self, batch->payload.data() + batch->used, size,
+                               source_ids[first], 0);
+            continue;
+        }
+        UdpBatchMessage message = {batch->used, size, source_ids[first], 0,
+                                   batch->transport->router.Route(source_ids[first])};
+        batch->messages.push_back(message);
+        batch->used += size;
+        if (batch->messages.size() >= UDPMULTICAST_MAX_BATCH_MESSAGES)
+        {
+            flush_send_batch(self);
+        }
+    }
+}
+
+/**
+ * @brief 按空闲心跳状态发送 send_batch->columns 中的当前帧。
+ *
+ * 有目标、未启用心跳或空闲跳变帧时照常发送（空帧补 "none" 占位目标），
+ * 聚合模式下暂存到本批次，由 send_batch_message() 合并发送；
+ * 持续空闲的帧按源模式到期时发送心跳，其余不发送。
+ */
+static void
+send_frame_report(Gstudpmulticast_sink *self, guint source_id, gint64 now_ns)
+{
+    UdpSendBatch    *batch = self->send_batch;
+    EOTargetColumns *columns = &batch->columns;
+
+    switch (batch->heartbeat.OnFrame(source_id, !columns->empty(), now_ns))
+    {
+    case SourceHeartbeat::Action::REPORT:
+        append_empty_target(columns);
+        if (batch->aggregate)
+        {
+            // 与暂存槽位交换，原槽位的容量留给下一帧
+            if (batch->frame_count == batch->frames.size())
+                batch->frames.emplace_back();
+            std::swap(*columns, batch->frames[batch->frame_count++]);
+            break;
+        }
+        send_target_message(self, source_id);
+        break;
+    case SourceHeartbeat::Action::HEARTBEAT:
+    {
+        const guint32 id = source_id;
+        send_heartbeat_message(self, &id, 1);
+        break;
+    }
+    case SourceHeartbeat::Action::SKIP:
+        break;
+    }
+}
+
+/**
+ * @brief 聚合模式下到达心跳时间时，把所有空闲视频源合并为一个心跳报文发送。
+ */
+static void
+send_due_heartbeats(Gstudpmulticast_sink *self, gint64 now_ns)
+{
+    UdpSendBatch *batch = self->send_batch;
+    if (batch->heartbeat.CollectDue(now_ns, batch->heartbeat_due))
+    {
+        send_heartbeat_message(self, batch->heartbeat_due.data(),
+                               batch->heartbeat_due.size());
+    }
+}
+
+/**
+ * @brief 按当前目的地发出暂存的报文，并为各目的地未满的 FEC 分组发出校验报文。
+ * 换用目的地或停止前调用，之后这些分组不再有报文加入。
+ */
+static void
+flush_send_transport(Gstudpmulticast_sink *self)
+{
+    UdpSendBatch *batch = self->send_batch;
+    send_batch_message(self);
+    flush_send_batch(self);
+    for (size_t d = 0; d < batch->fec.size(); ++d)
+    {
+        if (batch->fec[d].pending() > 0)
+            send_fec_parities(self, d);
+    }
+}
+
+/**
+ * @brief 发送线程空闲等待的时长（微秒）：不超过 limit_us，且不晚于最早的未满 FEC 分组
+ * 等待满 UDPMULTICAST_FEC_MAX_DELAY_NS 的时刻，醒来后由 flush_send_batch() 结束该分组。
+ */
+static gint64
+send_idle_wait_us(Gstudpmulticast_sink *self, gint64 limit_us)
+{
+    const UdpSendBatch *batch = self->send_batch;
+    const gint64        now_ns = SourceRateLimiter::NowNs();
+    gint64              wait_us = limit_us;
+    for (const EOFecEncoder &fec : batch->fec)
+    {
+        if (fec.pending() == 0)
+            continue;
+        const gint64 remaining_ns = fec.first_ns() + UDPMULTICAST_FEC_MAX_DELAY_NS - now_ns;
+        wait_us = std::min(wait_us, std::max<gint64>((remaining_ns + 999) / 1000, 0));
+    }
+    return wait_us;
+}
+
+/**
+ * @brief 发送报文的线程换用配置快照中的目的地，目的地未变时直接返回。
+ *
+ * 换用前按旧目的地发出暂存的报文，并为各目的地未满的 FEC 分组发出校验报文，
+ * 再按新目的地重新开始分组；旧目的地的套接字在最后一个引用释放时关闭。
+ */
+static void
+use_send_transport(Gstudpmulticast_sink *self, const UdpLiveConfig *config)
+{
+    UdpSendBatch *batch = self->send_batch;
+    if (config == NULL || config->transport == batch->transport)
+        return;
+
+    if (batch->transport)
+    {
+        flush_send_transport(self);
+        GST_INFO_OBJECT(self,
+                        "Switched to %zu destinations (configuration %" G_GUINT64_FORMAT ")",
+                        config->transport->destinations.size(), config->generation);
+    }
+    batch->transport = config->transport;
+    batch->fec.resize(batch->transport->destinations.size());
+    for (EOFecEncoder &fec : batch->fec)
+    {
+        fec.Configure(self->fec_group_size, self->fec_parity);
+    }
+}
+
+/**
+ * @brief 获取一条可写的异步发送记录，队列满时按 drop-policy 丢弃。
+ *
+ * @return 可写记录；当前帧被丢弃时返回 NULL。
+ */
+static AsyncFrameRecord *
+acquire_async_record(Gstudpmulticast_sink *self)
+{
+    AsyncFrameRecord *record = self->async_ring->BeginWrite();
+    if (record == NULL && self->drop_policy == UDPMULTICAST_DROP_OLDEST &&
+        self->async_ring->DropOldest())
+    {
+        self->dropped_frames.fetch_add(1, std::memory_order_relaxed);
+        record = self->async_ring->BeginWrite();
+    }
+    if (record == NULL)
+    {
+        // drop-newest，或最旧记录正被发送线程读取
+        self->dropped_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+    return record;
+}
+
+/**
+ * @brief 提交异步发送记录，发送线程休眠时唤醒它。
+ */
+static void
+commit_async_record(Gstudpmulticast_sink *self)
+{
+    self->async_ring->CommitWrite();
+    // 与发送线程的 sender_waiting / 队列检查成对：发布记录后再读取等待标记，
+    // 否则读取可能提前到发布之前，双方都以为对方会处理而漏掉唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (self->sender_waiting.load(std::memory_order_relaxed))
+    {
+        g_mutex_lock(&self->sender_lock);
+        g_cond_signal(&self->sender_cond);
+        g_mutex_unlock(&self->sender_lock);
+    }
+}
+
+/**
+ * @brief 当前帧目标超过 max-targets 时按置信度保留前 K 个（部分选择，不整帧排序）。
+ *
+ * @return 剔除的目标数。
+ */
+static guint
+keep_top_targets(const TargetFilter &filter, EOTargetColumns *columns)
+{
+    const size_t max_targets = filter.max_targets();
+    if (max_targets == 0 || columns->size() <= max_targets)
+        return 0;
+
+    size_t ties = 0;
+    float  threshold =
+        filter.TopConfidence(columns->tar_cfid(), columns->size(), max_targets, ties);
+    return (guint)columns->KeepTopConfidence(threshold, ties);
+}
+
+/**
+ * @brief 将 async_objects 中当前帧的目标写入异步发送记录。
+ *
+ * 超过 max-targets 时先按置信度保留前 K 个，再按单帧记录上限截断并计入
+ * truncated-objects，保证截断的总是置信度最低的目标。
+ *
+ * @return 被 max-targets 剔除的目标数。
+ */
+static guint
+fill_async_record(Gstudpmulticast_sink *self, const TargetFilter &filter,
+                  AsyncFrameRecord *record)
+{
+    const AsyncFrameObjects &frame = *self->async_objects;
+    const size_t             count = frame.objects.size();
+    const size_t             max_targets = filter.max_targets();
+    const bool               select = max_targets > 0 && count > max_targets;
+    float                    threshold = 0.0f;
+    size_t                   ties = 0;
+    size_t                   kept = 0;
+
+    if (select)
+    {
+        threshold = filter.TopConfidence(frame.confidences.data(), count, max_targets, ties);
+    }
+
+    record->object_count = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (select)
+        {
+            const gfloat confidence = frame.confidences[i];
+            if (!(confidence >= threshold))
+                continue; // 低于阈值或 NaN
+            if (confidence == threshold)
+            {
+                if (ties == 0)
+                    continue;
+                --ties;
+            }
+        }
+        ++kept;
+        if (record->object_count < UDPMULTICAST_ASYNC_MAX_OBJECTS)
+        {
+            record->objects[record->object_count++] = frame.objects[i];
+        }
+        else
+        {
+            self->truncated_objects.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return (guint)(count - kept);
+}
+
+/**
+ * @brief 发送线程：从队列取出帧记录，完成标签映射、编码和发送。
+ *
+ * 聚合模式下按 batch_seq 划分批次，收到批次结束标记或下一批次的帧时合并发送；
+ * 结束标记因队列满未能入队时，空闲等待一轮后发送已暂存的帧。
+ * 每轮开始时检查配置快照，目的地修改后在帧之间换用。停止时先排空队列再退出。
+ */
+static gpointer
+gst_udpmulticast_sink_sender_loop(gpointer data)
+{
+    Gstudpmulticast_sink *self = (Gstudpmulticast_sink *)data;
+    UdpSendBatch         *batch = self->send_batch;
+    EOTargetColumns      *columns = &batch->columns;
+    gboolean              waited = FALSE;
+
+    for (;;)
+    {
+        use_send_transport(self, self->live_config->Lock(UDPMULTICAST_READER_SENDER));
+        self->live_config->Unlock(UDPMULTICAST_READER_SENDER);
+
+        AsyncFrameRecord *record = self->async_ring->BeginRead();
+        if (record == NULL)
+        {
+            // 队列已排空，本轮取出的报文与到期的聚合心跳一次性发出
+            if (waited || !self->sender_running.load())
+                send_batch_message(self);
+            send_due_heartbeats(self, SourceRateLimiter::NowNs());
+            flush_send_batch(self);
+            if (!self->sender_running.load())
+                break;
+
+            g_mutex_lock(&self->sender_lock);
+            self->sender_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // 先声明等待，再检查队列
+            if (self->async_ring->empty() && self->sender_running.load())
+            {
+                g_cond_wait_until(&self->sender_cond, &self->sender_lock,
+                                  g_get_monotonic_time() +
+                                      send_idle_wait_us(self, 100 * G_TIME_SPAN_MILLISECOND));
+            }
+            self->sender_waiting.store(false);
+            g_mutex_unlock(&self->sender_lock);
+            waited = TRUE;
+            continue;
+        }
+        waited = FALSE;
+
+        if (record->batch_end)
+        {
+            self->async_ring->EndRead();
+            send_batch_message(self);
+            continue;
+        }
+        if (batch->frame_count > 0 && record->batch_seq != batch->pending_seq)
+        {
+            send_batch_message(self); // 上一批次的结束标记被丢弃
+        }
+        batch->pending_seq = record->batch_seq;
+
+        const guint     source_id = record->source_id;
+        TargetTimestamp timestamp;
+        make_target_timestamp(&record->timestamp, &timestamp);
+        columns->Reset(create_empty_target(source_id, timestamp));
+        for (guint i = 0; i < record->object_count; ++i)
+        {
+            const AsyncObjectRecord *object = &record->objects[i];
+            append_detected_target(columns, object->tar_rect, object->confidence,
+                                   *object->label_entry);
+        }
+        self->async_ring->EndRead();
+
+        send_frame_report(self, source_id, SourceRateLimiter::NowNs());
+    }
+
+    return NULL;
+}
+
+static void
+reset_detect_analysis(DetectAnalysis *detect_analysis)
+{
+    memset(detect_analysis, 0, sizeof(*detect_analysis));
+    detect_analysis->minPixel = G_MAXUINT16;
+}
+
+/**
+ * @brief 按类别编号计数，超出 UDPMULTICAST_MAX_CLASSES 的编号计入溢出计数。
+ */
+static inline void
+count_detect_class(guint *class_count, guint *overflow, guint class_id)
+{
+    if (class_id < UDPMULTICAST_MAX_CLASSES)
+        class_count[class_id]++;
+    else
+        (*overflow)++;
+}
+
+/**
+ * @brief 取当前窗口内某路视频源的统计项。
+ *
+ * @return 统计关闭或 source_id 超出上限时返回 NULL。
+ */
+static DetectAnalysis *
+acquire_source_stats(Gstudpmulticast_sink *self, guint source_id)
+{
+    if (self->stats_mode == UDPMULTICAST_STATS_NONE ||
+        source_id >= UDPMULTICAST_MAX_STATS_SOURCES)
+        return NULL;
+
+    std::vector<DetectAnalysis> &sources = self->stats->sources;
+    if (source_id >= sources.size())
+    {
+        size_t old_size = sources.size();
+        sources.resize(source_id + 1);
+        for (size_t i = old_size; i < sources.size(); ++i)
+            reset_detect_analysis(&sources[i]);
+    }
+    return &sources[source_id];
+}
+
+/**
+ * @brief 将类别计数格式化为 "编号:数量" 列表。
+ *
+ * @param json 为 true 时输出 JSON 对象 {"编号":数量,...}。
+ */
+static std::string
+format_class_counts(const guint *class_count, bool json)
+{
+    std::string out = json ? "{" : "";
+    char        item[32];
+
+    for (guint class_id = 0; class_id < UDPMULTICAST_MAX_CLASSES; ++class_id)
+    {
+        if (class_count[class_id] == 0)
+            continue;
+        if (out.size() > (json ? 1u : 0u))
+            out += ',';
+        snprintf(item, sizeof(item), json ? "\"%u\":%u" : "%u:%u", class_id,
+                 class_count[class_id]);
+        out += item;
+    }
+    if (json)
+        out += '}';
+    return out;
+}
+
+/**
+ * @brief 以 JSON 组播报文发送单路视频源的窗口统计，发往该视频源路由到的目的地。
+ */
+static void
+send_detect_stats_datagram(Gstudpmulticast_sink *self, const UdpTransport &transport,
+                           guint source_id, const DetectAnalysis &detect_analysis)
+{
+    char head[384];
+
+    snprintf(head, sizeof(head),
+             "{\"stats_type\":\"detect\",\"window_ms\":%u,\"source_id\":%u,"
+             "\"frame_num\":%" G_GUINT64_FORMAT ",\"frames\":%" G_GUINT64_FORMAT
+             ",\"objects\":%" G_GUINT64_FORMAT ",\"filtered\":%" G_GUINT64_FORMAT
+             ",\"min_pixel\":%u,"
+             "\"mean_pixel\":%u,\"primary_overflow\":%u,"
+             "\"secondary_overflow\":%u,\"primary\":",
+             self->stats_interval, source_id, detect_analysis.frameNum,
+             detect_analysis.frameCount, detect_analysis.objectCount,
+             detect_analysis.filteredCount, detect_analysis.minPixel,
+             detect_analysis.meanPixel,
+             detect_analysis.primaryClassOverflow,
+             detect_analysis.secondaryClassOverflow);
+
+    std::string payload = head;
+    payload += format_class_counts(detect_analysis.primaryClassCount, true);
+    payload += ",\"secondary\":";
+    payload += format_class_counts(detect_analysis.secondaryClassCount, true);
+    payload += '}';
+
+    const guint32 mask = transport.router.Route(source_id);
+    for (size_t d = 0; d < transport.destinations.size(); ++d)
+    {
+        if (!(mask & (1u << d)))
+            continue;
+        const UdpDestination &destination = transport.destinations[d];
+        UdpAddress            stats_addr = destination.addr;
+        if (self->stats_port != 0)
+            stats_addr.set_port(self->stats_port);
+        if (sendto(destination.sockfd, payload.data(), payload.size(), MSG_DONTWAIT,
+                   stats_addr.get(), stats_addr.length) < 0)
+        {
+            GST_WARNING_OBJECT(self, "Failed to send stats for source_id=%u: %s",
+                               source_id, strerror(errno));
+        }
+    }
+}
+
+/**
+ * @brief 发布单路视频源的窗口统计。
+ */
+static void
+publish_detect_stats(Gstudpmulticast_sink *self, const UdpTransport &transport,
+                     guint source_id, const DetectAnalysis &detect_analysis)
+{
+    switch (self->stats_mode)
+    {
+    case UDPMULTICAST_STATS_LOG:
+        GST_INFO_OBJECT(
+            self,
+            "source_id: %u, frameNum: %" G_GUINT64_FORMAT ", frames: %"
+            G_GUINT64_FORMAT ", objects: %" G_GUINT64_FORMAT ", filtered: %"
+            G_GUINT64_FORMAT ", primaryClassCount: [%s], secondaryClassCount: [%s], "
+            "minPixel: %u, meanPixel: %u",
+            source_id, detect_analysis.frameNum, detect_analysis.frameCount,
+            detect_analysis.objectCount, detect_analysis.filteredCount,
+            format_class_counts(detect_analysis.primaryClassCount, false).c_str(),
+            format_class_counts(detect_analysis.secondaryClassCount, false).c_str(),
+            detect_analysis.minPixel, detect_analysis.meanPixel);
+        break;
+    case UDPMULTICAST_STATS_MESSAGE:
+    {
+        std::string primary =
+            format_class_counts(detect_analysis.primaryClassCount, false);
+        std::string secondary =
+            format_class_counts(detect_analysis.secondaryClassCount, false);
+        GstStructure *structure = gst_structure_new(
+            "udpmulticast-stats", "source-id", G_TYPE_UINT, source_id,
+            "window-ms", G_TYPE_UINT, self->stats_interval, "frame-num",
+            G_TYPE_UINT64, detect_analysis.frameNum, "frames", G_TYPE_UINT64,
+            detect_analysis.frameCount, "objects", G_TYPE_UINT64,
+            detect_analysis.objectCount, "filtered", G_TYPE_UINT64,
+            detect_analysis.filteredCount, "min-pixel", G_TYPE_UINT,
+            (guint)detect_analysis.minPixel, "mean-pixel", G_TYPE_UINT,
+            (guint)detect_analysis.meanPixel, "primary-classes", G_TYPE_STRING,
+            primary.c_str(), "secondary-classes", G_TYPE_STRING,
+            secondary.c_str(), "primary-overflow", G_TYPE_UINT,
+            detect_analysis.primaryClassOverflow, "secondary-overflow",
+            G_TYPE_UINT, detect_analysis.secondaryClassOverflow, NULL);
+        gst_element_post_message(
+            GST_ELEMENT(self),
+            gst_message_new_element(GST_OBJECT(self), structure));
+        break;
+    }
+    case UDPMULTICAST_STATS_DATAGRAM:
+        send_detect_stats_datagram(self, transport, source_id, detect_analysis);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 统计窗口到期时发布所有有数据的视频源并开始新窗口。
+ */
+static void
+maybe_publish_detect_stats(Gstudpmulticast_sink *self, const UdpTransport &transport)
+{
+    DetectStatsWindow *stats = self->stats;
+    gint64             now = g_get_monotonic_time();
+
+    if (stats->window_start == 0)
+    {
+        stats->window_start = now;
+        return;
+    }
+    if (now - stats->window_start <
+        (gint64)self->stats_interval * G_TIME_SPAN_MILLISECOND)
+        return;
+
+    stats->window_start = now;
+    for (size_t source_id = 0; source_id < stats->sources.size(); ++source_id)
+    {
+        DetectAnalysis &detect_analysis = stats->sources[source_id];
+        if (detect_analysis.frameCount == 0)
+            continue;
+
+        if (detect_analysis.objectCount > 0)
+        {
+            detect_analysis.meanPixel =
+                (guint16)MIN(detect_analysis.pixelSum / detect_analysis.objectCount,
+                             (guint64)G_MAXUINT16);
+        }
+        else
+        {
+            detect_analysis.minPixel = 0;
+            detect_analysis.meanPixel = 0;
+        }
+        publish_detect_stats(self, transport, (guint)source_id, detect_analysis);
+        reset_detect_analysis(&detect_analysis);
+    }
+}
+
+/* GObject vmethod implementations */
+
+/* initialize the _udpmulticast_sink's class */
+static void gst_udpmulticast_sink_class_init(Gstudpmulticast_sinkClass *klass)
+{
+    GObjectClass     *gobject_class = G_OBJECT_CLASS(klass);
+    GstElementClass  *gstelement_class;
+    GstBaseSinkClass *base_sink_class = GST_BASE_SINK_CLASS(klass);
+
+    gstelement_class = (GstElementClass *)klass;
+
+    gobject_class->set_property = gst_udpmulticast_sink_set_property;
+    gobject_class->get_property = gst_udpmulticast_sink_get_property;
+    gobject_class->finalize = gst_udpmulticast_sink_finalize;
+
+    base_sink_class->render = GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_render);
+    base_sink_class->start = GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_start);
+    base_sink_class->stop = GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_stop);
+    base_sink_class->set_caps =
+        GST_DEBUG_FUNCPTR(gst_udpmulticast_sink_set_caps);
+
+    gst_element_class_add_static_pad_template(GST_ELEMENT_CLASS(klass),
+                                              &sink_factory);
+
+    /* Set metadata describing the element */
+    gst_element_class_set_details_simple(
+        gstelement_class, "DsUdpMulticastSink plugin",
+        "DsUdpMulticastSink Plugin",
+        "Process a infer mst network on objects / full frame",
+        "ShenChangli "
+        "@ karmueo@163.com");
+
+    /* install properties */
+    g_object_class_install_property(
+        gobject_class, PROP_SILENT,
+        g_param_spec_boolean("silent", "Silent", "Produce verbose output ?",
+                             TRUE, G_PARAM_READWRITE));
+    g_object_class_install_property(
+        gobject_class, PROP_IP,
+        g_param_spec_string(
+            "ip", "Multicast IP",
+            "Destination IPv4 or IPv6 address, multicast or unicast (link-local IPv6 "
+            "addresses take their scope from iface or a %iface suffix), can be changed "
+            "while playing",
+            "239.255.255.250",
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_PORT,
+        g_param_spec_uint(
+            "port", "Multicast Port",
+            "Multicast destination port, can be changed while playing", 1, 65535,
+            5000,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_IFACE,
+        g_param_spec_string(
+            "iface", "Network Interface",
+            "Network interface name for multicast (e.g., eth0, enp5s0); changing it "
+            "while playing rebinds the sockets",
+            NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_DESTINATIONS,
+        g_param_spec_string(
+            "destinations", "Destinations",
+            "Comma-separated destinations ip:port[/iface] replacing ip/port, each "
+            "datagram is encoded once and sent to all of them, can be changed while playing",
+            NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_ROUTES,
+        g_param_spec_string(
+            "routes", "Routes",
+            "Per-source routes source_id:index[|index],... into destinations "
+            "(unlisted sources go to all destinations), can be changed while playing",
+            NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_FPS,
+        g_param_spec_uint(
+            "fps", "Report FPS",
+            "Frame rate for sending target reports, can be changed while playing", 1, 120,
+            25,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_FORMAT,
+        g_param_spec_enum(
+            "format", "Payload Format",
+            "Wire format of target reports (json or compact binary)",
+            GST_TYPE_UDPMULTICAST_SINK_FORMAT,
+            static_cast<gint>(BodyType::JSON),
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_ASYNC,
+        g_param_spec_boolean(
+            "async", "Async Send",
+            "Encode and send reports on a dedicated sender thread",
+            FALSE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_QUEUE_DEPTH,
+        g_param_spec_uint(
+            "queue-depth", "Queue Depth",
+            "Number of frames buffered for the sender thread (rounded up to a "
+            "power of two)",
+            2, 1024, 64,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_DROP_POLICY,
+        g_param_spec_enum(
+            "drop-policy", "Drop Policy",
+            "Which frame to drop when the sender queue is full",
+            GST_TYPE_UDPMULTICAST_SINK_DROP_POLICY, UDPMULTICAST_DROP_OLDEST,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_DROPPED_FRAMES,
+        g_param_spec_uint64(
+            "dropped-frames", "Dropped Frames",
+            "Frames dropped because the sender queue was full", 0, G_MAXUINT64,
+            0, (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_TRUNCATED_OBJECTS,
+        g_param_spec_uint64(
+            "truncated-objects", "Truncated Objects",
+            "Objects dropped because a frame exceeded the per-frame async limit",
+            0, G_MAXUINT64, 0,
+            (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_BATCH_SEND,
+        g_param_spec_boolean(
+            "batch-send", "Batch Send",
+            "Send all reports of one batch with a single sendmmsg call",
+            TRUE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_STATS_MODE,
+        g_param_spec_enum(
+            "stats-mode", "Stats Mode",
+            "How per-source detection statistics are published once per window",
+            GST_TYPE_UDPMULTICAST_SINK_STATS_MODE, UDPMULTICAST_STATS_LOG,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_STATS_INTERVAL,
+        g_param_spec_uint(
+            "stats-interval", "Stats Interval",
+            "Statistics aggregation window in milliseconds", 100, 3600000, 1000,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_STATS_PORT,
+        g_param_spec_uint(
+            "stats-port", "Stats Port",
+            "Destination port of stats datagrams (0 = same as port)", 0, 65535,
+            0, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_MAP_BUFFER,
+        g_param_spec_boolean(
+            "map-buffer", "Map Buffer",
+            "Map the input buffer in render (frame data is not read)", FALSE,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_LATENCY_TIMESTAMPS,
+        g_param_spec_boolean(
+            "latency-timestamps", "Latency Timestamps",
+            "Record NvDs input/output system timestamps for latency measurement",
+            FALSE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_LABEL_MAP_FILE,
+        g_param_spec_string(
+            "label-map-file", "Label Map File",
+            "Label to tar_category/tar_iden mapping file, loaded at start "
+            "(lines: class_id, label, tar_category[, tar_iden])",
+            NULL, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_RATE_MODE,
+        g_param_spec_enum(
+            "rate-mode", "Rate Mode",
+            "Per-source rate limiting (fixed interval or token bucket)",
+            GST_TYPE_UDPMULTICAST_SINK_RATE_MODE, UDPMULTICAST_RATE_INTERVAL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_RATE_BURST,
+        g_param_spec_uint(
+            "rate-burst", "Rate Burst",
+            "Frames a source may send back to back in token-bucket mode", 1, 64,
+            4, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_SOURCE_FPS,
+        g_param_spec_string(
+            "source-fps", "Per-source FPS",
+            "Per-source report rate overrides, e.g. \"0:25,3:10\" "
+            "(0 disables a source), can be changed while playing",
+            NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_MTU,
+        g_param_spec_uint(
+            "mtu", "MTU",
+            "Path MTU; reports larger than mtu - 28 bytes (mtu - 48 over IPv6) are split by target "
+            "into self-describing datagrams (65535 = no splitting)",
+            576, 65535, 1500,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_KEYFRAME_INTERVAL,
+        g_param_spec_uint(
+            "keyframe-interval", "Keyframe Interval",
+            "With format=delta, number of delta frames per source between full "
+            "binary keyframes (0 = keyframes only), applied at start",
+            0, 10000, 25,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_MIN_CONFIDENCE,
+        g_param_spec_float(
+            "min-confidence", "Min Confidence",
+            "Objects below this confidence are not reported (-1 = no filtering), "
+            "can be changed while playing",
+            -1.0f, 1.0f, -1.0f,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_CLASS_MIN_CONFIDENCE,
+        g_param_spec_string(
+            "class-min-confidence", "Per-class Min Confidence",
+            "Per-class min-confidence overrides, e.g. \"0:0.5,2:0.3\", "
+            "can be changed while playing",
+            NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_MIN_AREA,
+        g_param_spec_uint(
+            "min-area", "Min Area",
+            "Objects whose box is smaller than this many pixels are not reported "
+            "(0 = no filtering), can be changed while playing",
+            0, G_MAXUINT, 0,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_ROI,
+        g_param_spec_string(
+            "roi", "ROI",
+            "Per-source ROI polygons in pixels, e.g. \"0:0,0,1920,0,1920,800,0,800;"
+            "1:...\"; only objects whose box center lies inside are reported, "
+            "can be changed while playing",
+            NULL,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_MAX_TARGETS,
+        g_param_spec_uint(
+            "max-targets", "Max Targets",
+            "Report at most this many targets per frame, keeping the most "
+            "confident ones (0 = unlimited), can be changed while playing",
+            0, 65535, 0,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+                          GST_PARAM_MUTABLE_PLAYING)));
+    g_object_class_install_property(
+        gobject_class, PROP_FILTERED_OBJECTS,
+        g_param_spec_uint64(
+            "filtered-objects", "Filtered Objects",
+            "Objects removed by min-confidence, class-min-confidence, min-area, "
+            "roi or max-targets",
+            0, G_MAXUINT64, 0,
+            (GParamFlags)(G_PARAM_READABLE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_HEARTBEAT_INTERVAL,
+        g_param_spec_uint(
+            "heartbeat-interval", "Heartbeat Interval",
+            "Milliseconds between keepalives of a source without targets; its "
+            "\"none\" report is sent only when targets disappear "
+            "(0 = \"none\" report every frame), applied at start",
+            0, 3600000, 0,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_HEARTBEAT_AGGREGATE,
+        g_param_spec_boolean(
+            "heartbeat-aggregate", "Heartbeat Aggregate",
+            "Combine keepalives of all idle sources into one datagram per "
+            "heartbeat-interval, applied at start",
+            FALSE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_AGGREGATE,
+        g_param_spec_boolean(
+            "aggregate", "Aggregate",
+            "Pack the targets of all sources in a batch into as few datagrams as "
+            "possible, grouped by source_id (ignored with format=delta), applied at start",
+            FALSE, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FEC_GROUP_SIZE,
+        g_param_spec_uint(
+            "fec-group-size", "FEC Group Size",
+            "Target and heartbeat datagrams protected by each group of FEC parity "
+            "datagrams (0 = FEC off), applied at start",
+            0, EOFecEncoder::kMaxGroupSize, 0,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_FEC_PARITY,
+        g_param_spec_uint(
+            "fec-parity", "FEC Parity",
+            "Parity datagrams per FEC group; any fec-parity lost datagrams of a group "
+            "can be recovered (1 = XOR, more = Reed-Solomon), applied at start",
+            1, EOFecEncoder::kMaxParity, 1,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_COMPRESSION,
+        g_param_spec_enum(
+            "compression", "Compression",
+            "Compress target and heartbeat datagrams (sent uncompressed when that "
+            "does not make them shorter), applied at start",
+            GST_TYPE_UDPMULTICAST_SINK_COMPRESSION, UDPMULTICAST_COMPRESSION_NONE,
+            (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+    g_object_class_install_property(
+        gobject_class, PROP_COMPRESSION_DICTIONARY,
+        g_param_spec_string(
+            "compression-dictionary", "Compression Dictionary",
+            "Shared dictionary file for compression (trained with eo_dict_train, "
+            "receivers need the same file), loaded at start",
+            NULL, (GParamFlags)(G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)));
+}
+
+/* initialize the new element
+ * instantiate pads and add them to element
+ * set pad callback functions
+ * initialize instance structure
+ * 初始化新element
+ * 实例化 pads 并将它们添加到element中
+ * 设置 pad 回调函数
+ * 初始化实例结构
+ */
+static void gst_udpmulticast_sink_init(Gstudpmulticast_sink *self)
+{
+    // 初始化一些参数
+    self->gpu_id = 0;
+    // default values
+    self->ip = g_strdup("239.255.255.250");
+    self->port = 5000;
+    self->iface = NULL;
+    self->destinations = NULL;
+    self->routes = NULL;
+    self->fps = 25;
+    self->format = static_cast<guint>(BodyType::JSON);
+    self->send_count = 0;
+    self->mtu = 1500;
+    self->keyframe_interval = 25;
+    self->heartbeat_interval = 0;
+    self->heartbeat_aggregate = FALSE;
+    self->aggregate = FALSE;
+    self->fec_group_size = 0;
+    self->fec_parity = 1;
+    self->compression = UDPMULTICAST_COMPRESSION_NONE;
+    self->compression_dictionary = NULL;
+    self->delta_encoder = new EODeltaEncoder(self->keyframe_interval);
+    self->async = FALSE;
+    self->queue_depth = 64;
+    self->drop_policy = UDPMULTICAST_DROP_OLDEST;
+    self->sender_thread = NULL;
+    self->async_ring = NULL;
+    g_mutex_init(&self->sender_lock);
+    g_cond_init(&self->sender_cond);
+    self->batch_send = TRUE;
+    self->send_batch = new UdpSendBatch();
+    self->stats_mode = UDPMULTICAST_STATS_LOG;
+    self->stats_interval = 1000;
+    self->stats_port = 0;
+    self->map_buffer = FALSE;
+    self->latency_timestamps = FALSE;
+    self->stats = new DetectStatsWindow();
+    self->label_map_file = NULL;
+    self->label_map = new TargetLabelMap();
+    self->rate_mode = UDPMULTICAST_RATE_INTERVAL;
+    self->rate_burst = 4;
+    self->source_fps = NULL;
+    self->rate_limiter = new SourceRateLimiter();
+    self->min_confidence = -1.0f;
+    self->class_min_confidence = NULL;
+    self->min_area = 0;
+    self->roi = NULL;
+    self->max_targets = 0;
+    self->async_objects = new AsyncFrameObjects();
+    self->filtered_objects.store(0);
+    g_mutex_init(&self->config_lock);
+    self->live_config = new RcuSnapshot<UdpLiveConfig, UDPMULTICAST_CONFIG_READERS>();
+    self->render_generation = 0;
+
+    /* This quark is required to identify NvDsMeta when iterating through
+     * the buffer metadatas */
+    if (!_dsmeta_quark)
+        _dsmeta_quark = g_quark_from_static_string(NVDS_META_STRING);
+}
+
+/**
+ * 当元素从上游元素接收到输入缓冲区时调用。
+ */
+static GstFlowReturn gst_udpmulticast_sink_render(GstBaseSink *sink,
+                                                  GstBuffer   *buf)
+{
+    Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(sink);
+    NvDsBatchMeta        *batch_meta = NULL;
+    NvDsMetaList         *l_frame = NULL;
+    GstMapInfo            in_map_info;
+    gboolean              mapped = FALSE;
+    EOTargetColumns      *columns = &self->send_batch->columns;
+    std::vector<guint32> &pixels = self->stats->pixels;
+    // 同一批次的帧共用一次时钟读数：单调时钟用于限速，墙上时间仅在需要发送时读取
+    gint64                now_ns = SourceRateLimiter::NowNs();
+    struct timeval        batch_time = {0, 0};
+    TargetTimestamp       timestamp = {};
+    gboolean              have_batch_time = FALSE;
+    gboolean              filter_objects = FALSE;
+    gboolean              queued = FALSE; // 本批次是否有帧进入异步队列
+    const guint           batch_seq = ++self->async_objects->batch_seq;
+    // 本批次使用的配置快照：属性在运行中修改时下一批次生效，批次内保持一致
+    const UdpLiveConfig  *config = self->live_config->Lock(UDPMULTICAST_READER_RENDER);
+
+    // render 只读取元数据，映射缓冲区和延迟时间戳仅在显式开启时执行
+    memset(&in_map_info, 0, sizeof(in_map_info));
+    if (config == NULL)
+        goto error;
+    if (config->generation != self->render_generation)
+    {
+        // 按源帧率在发布前已校验，这里只会成功；已有的发送节拍保留
+        std::string fps_error;
+        self->rate_limiter->SetSourceFps(config->source_fps, fps_error);
+        self->render_generation = config->generation;
+    }
+    if (self->async_ring == NULL)
+        use_send_transport(self, config);
+    filter_objects = config->filter.active();
+
+    if (self->map_buffer)
+    {
+        if (!gst_buffer_map(buf, &in_map_info, GST_MAP_READ))
+        {
+            g_print("Error: Failed to map gst buffer\n");
+            goto error;
+        }
+        mapped = TRUE;
+    }
+
+    if (self->latency_timestamps)
+        nvds_set_input_system_timestamp(buf, GST_ELEMENT_NAME(self));
+
+    batch_meta = gst_buffer_get_nvds_batch_meta(buf);
+    if (!batch_meta)
+    {
+        GST_WARNING_OBJECT(self, "No batch meta on buffer, dropping payload");
+        goto error;
+    }
+    for (l_frame = batch_meta->frame_meta_list; l_frame != NULL;
+         l_frame = l_frame->next)
+    {
+        NvDsFrameMeta    *frame_meta = (NvDsFrameMeta *)(l_frame->data);
+        NvDsMetaList     *l_obj = NULL;
+        guint             source_id = frame_meta->pad_index;  // 优先使用原始流索引，避免 tiled 后 source_id 被压成 0。
+        DetectAnalysis   *detect_analysis = acquire_source_stats(self, source_id);
+        AsyncFrameRecord *async_record = NULL;
+        gboolean          should_send =
+            self->rate_limiter->ShouldSend(source_id, now_ns, config->fps);
+        gboolean          build_targets; // 同步发送帧才需要构造 EOTargetInfo
+        guint             filtered = 0;  // 当前帧被发送前过滤剔除的目标数
+
+        if (should_send && !have_batch_time)
+        {
+            gettimeofday(&batch_time, NULL);
+            have_batch_time = TRUE;
+            if (self->async_ring == NULL)
+                make_target_timestamp(&batch_time, &timestamp);
+        }
+        build_targets = should_send && self->async_ring == NULL;
+        if (build_targets)
+        {
+            columns->Reset(create_empty_target(source_id, timestamp));
+        }
+        else if (should_send)
+        {
+            async_record = acquire_async_record(self);
+            if (async_record != NULL)
+            {
+                async_record->source_id = source_id;
+                async_record->object_count = 0;
+                async_record->timestamp = batch_time;
+                async_record->batch_seq = batch_seq;
+                async_record->batch_end = FALSE;
+                self->async_objects->objects.clear();
+                self->async_objects->confidences.clear();
+            }
+        }
+
+        if (detect_analysis != NULL)
+        {
+            detect_analysis->frameNum = frame_meta->frame_num + 1;
+            detect_analysis->frameCount++;
+            pixels.clear();
+        }
+        else if (!build_targets && async_record == NULL)
+        {
+            continue; // 既不发送也不统计的帧无需遍历目标
+        }
+
+        for (l_obj = frame_meta->obj_meta_list; l_obj != NULL;
+             l_obj = l_obj->next)
+        {
+            NvDsObjectMeta *obj_meta = (NvDsObjectMeta *)(l_obj->data);
+
+            if (obj_meta->class_id < 0)
+                continue;
+
+            float    final_confidence = obj_meta->confidence;
+            gboolean has_classifier = FALSE;
+
+            for (NvDsMetaList *l_class = obj_meta->classifier_meta_list;
+                 l_class != NULL; l_class = l_class->next)
+            {
+                NvDsClassifierMeta *cmeta = (NvDsClassifierMeta *)l_class->data;
+                for (NvDsMetaList *l_label = cmeta->label_info_list;
+                     l_label != NULL; l_label = l_label->next)
+                {
+                    NvDsLabelInfo *label = (NvDsLabelInfo *)l_label->data;
+                    if (detect_analysis != NULL)
+                    {
+                        count_detect_class(detect_analysis->secondaryClassCount,
+                                           &detect_analysis->secondaryClassOverflow,
+                                           label->result_class_id);
+                    }
+
+                    if (!has_classifier)
+                    {
+                        final_confidence = label->result_prob;
+                        has_classifier = TRUE;
+                    }
+                }
+            }
+
+            if (detect_analysis != NULL)
+            {
+                count_detect_class(detect_analysis->primaryClassCount,
+                                   &detect_analysis->primaryClassOverflow,
+                                   obj_meta->class_id);
+                pixels.push_back((guint32)(obj_meta->rect_params.width *
+                                           obj_meta->rect_params.height));
+            }
+
+            // 不发送的帧只需要统计信息
+            if (!build_targets && async_record == NULL)
+                continue;
+
+            // 未通过过滤的目标不做标签映射，也不进入报文
+            if (filter_objects &&
+                !config->filter.Accept(
+                    source_id, obj_meta->class_id, final_confidence,
+                    obj_meta->rect_params.left, obj_meta->rect_params.top,
+                    obj_meta->rect_params.width, obj_meta->rect_params.height))
+            {
+                filtered++;
+                continue;
+            }
+
+            gint tar_rect =
+                (gint)(obj_meta->rect_params.left +
+                       obj_meta->rect_params.width / 2); // 目标中心的像素值
+            // 标签映射在流线程中完成（映射表非线程安全），异步记录只保存结果指针
+            const TargetLabelEntry &label_entry =
+                self->label_map->Lookup(obj_meta->class_id, obj_meta->obj_label);
+
+            if (async_record != NULL)
+            {
+                // 异步模式只拷贝字段，编码由发送线程完成；帧末选出前 K 个后写入记录
+                AsyncObjectRecord object = {tar_rect, final_confidence, &label_entry};
+                self->async_objects->objects.push_back(object);
+                self->async_objects->confidences.push_back(final_confidence);
+            }
+            else
+            {
+                append_detected_target(columns, tar_rect, final_confidence,
+                                       label_entry);
+            }
+        }
+
+        if (detect_analysis != NULL && !pixels.empty())
+        {
+            // 整帧的像素面积一次统计最小值与累加和
+            guint32 min_pixel = detect_analysis->minPixel;
+            EOAccumulatePixelStats(pixels.data(), pixels.size(), min_pixel,
+                                   detect_analysis->pixelSum);
+            detect_analysis->minPixel = (guint16)MIN(min_pixel, (guint32)G_MAXUINT16);
+            detect_analysis->objectCount += pixels.size();
+        }
+
+        if (async_record != NULL)
+        {
+            filtered += fill_async_record(self, config->filter, async_record);
+            commit_async_record(self);
+            queued = TRUE;
+        }
+        else if (build_targets)
+        {
+            filtered += keep_top_targets(config->filter, columns);
+            send_frame_report(self, source_id, now_ns);
+        }
+
+        if (filtered > 0)
+        {
+            self->filtered_objects.fetch_add(filtered, std::memory_order_relaxed);
+            if (detect_analysis != NULL)
+                detect_analysis->filteredCount += filtered;
+        }
+    }
+
+    if (self->stats_mode != UDPMULTICAST_STATS_NONE)
+    {
+        maybe_publish_detect_stats(self, *config->transport);
+    }
+
+    if (self->async_ring == NULL)
+    {
+        send_batch_message(self);
+        send_due_heartbeats(self, now_ns);
+        flush_send_batch(self);
+    }
+    else if (queued && self->send_batch->aggregate)
+    {
+        // 批次结束标记不挤占帧记录：队列满时不入队，由发送线程按 batch_seq 划分
+        AsyncFrameRecord *marker = self->async_ring->BeginWrite();
+        if (marker != NULL)
+        {
+            marker->object_count = 0;
+            marker->batch_seq = batch_seq;
+            marker->batch_end = TRUE;
+            commit_async_record(self);
+        }
+    }
+
+error:
+
+    self->live_config->Unlock(UDPMULTICAST_READER_RENDER);
+    if (self->latency_timestamps)
+        nvds_set_output_system_timestamp(buf, GST_ELEMENT_NAME(self));
+    if (mapped)
+        gst_buffer_unmap(buf, &in_map_info);
+    return GST_FLOW_OK;
+}
+
+/**
+ * @brief 将套接字绑定到网卡 iface，并设置组播发送接口：
+ * IPv4 为该网卡地址（IP_MULTICAST_IF），IPv6 为网卡索引（IPV6_MULTICAST_IF）。
+ *
+ * @return 网卡不存在时返回 FALSE；绑定或设置组播接口失败只告警。
+ */
+static gboolean
+bind_socket_iface(int sockfd, int family, const char *iface)
+{
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, iface, IFNAMSIZ - 1);
+
+    // 获取网卡索引
+    if (ioctl(sockfd, SIOCGIFINDEX, &ifr) < 0)
+    {
+        GST_ERROR("Failed to get interface %s index: %s", iface, strerror(errno));
+        return FALSE;
+    }
+
+    // 绑定到指定网卡
+    if (setsockopt(sockfd, SOL_SOCKET, SO_BINDTODEVICE, iface, strlen(iface)) < 0)
+    {
+        GST_WARNING("Failed to bind to interface %s: %s. Trying to continue...", iface,
+                    strerror(errno));
+    }
+    else
+    {
+        GST_INFO("Successfully bound to interface %s", iface);
+    }
+
+    if (family == AF_INET6)
+    {
+        int index = ifr.ifr_ifindex;
+        if (setsockopt(sockfd, IPPROTO_IPV6, IPV6_MULTICAST_IF, &index, sizeof(index)) < 0)
+        {
+            GST_WARNING("Failed to set IPv6 multicast interface: %s", strerror(errno));
+        }
+        else
+        {
+            GST_INFO("Set IPv6 multicast interface to %s (index %d)", iface, index);
+        }
+        return TRUE;
     }
 
-    // 设置为非阻塞，防止网络异常时阻塞流线程导致上游误判为断流
-    int flags = fcntl(self->sockfd, F_GETFL, 0);
-    if (flags != -1)
+    // 设置组播发送接口
+    struct in_addr local_interface;
+    memset(&local_interface, 0, sizeof(local_interface));
+
+    // 获取网卡IP地址
+    if (ioctl(sockfd, SIOCGIFADDR, &ifr) < 0)
     {
-        if (fcntl(self->sockfd, F_SETFL, flags | O_NONBLOCK) == -1)
-            GST_WARNING("Failed to set multicast socket non-blocking: %s", strerror(errno));
+        GST_WARNING("Failed to get interface %s address: %s", iface, strerror(errno));
     }
     else
     {
-        GST_WARNING("Failed to query multicast socket flags: %s", strerror(errno));
-    }
+        local_interface = ((struct sockaddr_in *)&ifr.ifr_addr)->sin_addr;
 
-    // 设置组播地址
-    memset(&self->multicast_addr, 0, sizeof(self->multicast_addr));
-    self->multicast_addr.sin_family = AF_INET;
-    self->multicast_addr.sin_addr.s_addr = inet_addr(self->ip);
-    self->multicast_addr.sin_port = htons(self->port);
+        // 设置组播发送接口
+        if (setsockopt(sockfd, IPPROTO_IP, IP_MULTICAST_IF, &local_interface,
+                       sizeof(local_interface)) < 0)
+        {
+            GST_WARNING("Failed to set multicast interface: %s", strerror(errno));
+        }
+        else
+        {
+            GST_INFO("Set multicast interface to %s (IP: %s)", iface,
+                     inet_ntoa(local_interface));
+        }
+    }
+    return TRUE;
+}
 
-    // 设置TTL（可选）
-    int ttl = 32;
-    if (setsockopt(self->sockfd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl,
-                   sizeof(ttl)) < 0)
+/**
+ * @brief 打开一个发送套接字：非阻塞，组播 TTL / 跳数 32，指定网卡时绑定到该网卡。
+ *
+ * @return 套接字，失败时返回 -1。
+ */
+static int
+open_send_socket(Gstudpmulticast_sink *self, int family, const std::string &iface)
+{
+    int sockfd = socket(family, SOCK_DGRAM, 0);
+    int hops = 32;
+    if (sockfd < 0)
+    {
+        GST_ERROR_OBJECT(self, "Failed to create %s socket: %s",
+                         family == AF_INET6 ? "IPv6" : "IPv4", strerror(errno));
+        return -1;
+    }
+    fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK);
+    if (family == AF_INET6)
+    {
+        if (setsockopt(sockfd, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &hops, sizeof(hops)) < 0)
+            GST_WARNING("Failed to set IPv6 multicast hops");
+    }
+    else if (setsockopt(sockfd, IPPROTO_IP, IP_MULTICAST_TTL, &hops, sizeof(hops)) < 0)
     {
         GST_WARNING("Failed to set multicast TTL");
     }
-
-    /* This quark is required to identify NvDsMeta when iterating through
-     * the buffer metadatas */
-    if (!_dsmeta_quark)
-        _dsmeta_quark = g_quark_from_static_string(NVDS_META_STRING);
+    if (!iface.empty() && !bind_socket_iface(sockfd, family, iface.c_str()))
+    {
+        close(sockfd);
+        return -1;
+    }
+    return sockfd;
 }
 
 /**
- * 当元素从上游元素接收到输入缓冲区时调用。
+ * @brief 按 ip / port（或 destinations）、iface 与 routes 属性建立发送目的地。
+ *
+ * 未配置 destinations 时只有 ip:port 一个目的地；配置后每个目的地各自维护 FEC 分组。
+ * 地址可为 IPv4 或 IPv6，链路本地的 IPv6 地址以目的地网卡（或 iface 属性）为作用域。
+ * 目的地按地址族与网卡（未指定时用 iface 属性的网卡）各建一个套接字并绑定到该网卡，
+ * 同一套接字的目的地在冲刷时由一次 sendmmsg 发出。
+ *
+ * @return 属性无效或套接字建立失败时返回 NULL 并给出原因。
  */
-static GstFlowReturn gst_udpmulticast_sink_render(GstBaseSink *sink,
-                                                  GstBuffer   *buf)
+static UdpTransport *
+create_transport(Gstudpmulticast_sink *self, std::string &error)
 {
-    Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(sink);
-    NvDsBatchMeta        *batch_meta = NULL;
-    NvDsMetaList         *l_frame = NULL;
-    GstMapInfo            in_map_info;
-    gboolean              mapped = FALSE;
+    std::unique_ptr<UdpTransport> transport(new UdpTransport());
+    DestinationRouter            &router = transport->router;
 
-    memset(&in_map_info, 0, sizeof(in_map_info));
-    if (!gst_buffer_map(buf, &in_map_info, GST_MAP_READ))
+    if (!router.SetDestinations(self->destinations ? self->destinations : "", error) ||
+        !router.SetRoutes(self->routes ? self->routes : "", error))
     {
-        g_print("Error: Failed to map gst buffer\n");
-        goto error;
+        error = "invalid destinations/routes: " + error;
+        return NULL;
     }
-    mapped = TRUE;
-
-    nvds_set_input_system_timestamp(buf, GST_ELEMENT_NAME(self));
 
-    batch_meta = gst_buffer_get_nvds_batch_meta(buf);
-    if (!batch_meta)
+    std::vector<Destination> specs;
+    for (size_t d = 0; d < router.size(); ++d)
+        specs.push_back(router.destination(d));
+    if (specs.empty())
     {
-        GST_WARNING_OBJECT(self, "No batch meta on buffer, dropping payload");
-        goto error;
+        Destination legacy;
+        legacy.host = self->ip ? self->ip : "";
+        legacy.port = self->port;
+        specs.push_back(legacy);
     }
-    for (l_frame = batch_meta->frame_meta_list; l_frame != NULL;
-         l_frame = l_frame->next)
-    {
-        NvDsFrameMeta            *frame_meta = (NvDsFrameMeta *)(l_frame->data);
-        NvDsMetaList             *l_obj = NULL;
-        std::vector<EOTargetInfo> target_infos;
-        DetectAnalysis            detect_analysis = {};
-        guint                     source_id = frame_meta->pad_index;  // 优先使用原始流索引，避免 tiled 后 source_id 被压成 0。
-        guint                     total_object_count = 0;
-        guint64                   total_pixel_sum = 0;
-        gdouble                   current_time = get_current_time_seconds();
-        gboolean                  should_send =
-            should_send_for_source(self, source_id, current_time);
-
-        detect_analysis.frameNum = frame_meta->frame_num + 1;
-        detect_analysis.minPixel = G_MAXUINT16;
-
-        for (l_obj = frame_meta->obj_meta_list; l_obj != NULL;
-             l_obj = l_obj->next)
-        {
-            NvDsObjectMeta *obj_meta = (NvDsObjectMeta *)(l_obj->data);
-
-            if ((obj_meta->class_id >= 0))
-            {
-                std::map<guint16, guint>::iterator it =
-                    detect_analysis.primaryClassCountMap.find(
-                        obj_meta->class_id);
-                if (it != detect_analysis.primaryClassCountMap.end())
-                {
-                    it->second++;
-                }
-                else
-                {
-                    detect_analysis.primaryClassCountMap.insert(
-                        std::pair<guint16, guint>(obj_meta->class_id, 1));
-                }
-
-                float   final_confidence = obj_meta->confidence;
-                gboolean has_classifier = FALSE;
-
-                for (NvDsMetaList *l_class = obj_meta->classifier_meta_list;
-                     l_class != NULL; l_class = l_class->next)
-                {
-                    NvDsClassifierMeta *cmeta =
-                        (NvDsClassifierMeta *)l_class->data;
-                    for (NvDsMetaList *l_label = cmeta->label_info_list;
-                         l_label != NULL; l_label = l_label->next)
-                    {
-                        NvDsLabelInfo *label = (NvDsLabelInfo *)l_label->data;
-                        auto it2 = detect_analysis.secondaryClassCountMap.find(
-                            label->result_class_id);
-                        if (it2 != detect_analysis.secondaryClassCountMap.end())
-                            it2->second++;
-                        else
-                            detect_analysis.secondaryClassCountMap.insert(
-                                std::pair<guint16, guint>(
-                                    label->result_class_id, 1));
-
-                        if (!has_classifier)
-                        {
-                            final_confidence = label->result_prob;
-                            has_classifier = TRUE;
-                        }
-                    }
-                }
-
-                guint32 pixel = (guint32)(obj_meta->rect_params.width *
-                                          obj_meta->rect_params.height);
-                if (pixel < detect_analysis.minPixel)
-                {
-                    detect_analysis.minPixel =
-                        (guint16)MIN(pixel, (guint32)G_MAXUINT16);
-                }
-                total_pixel_sum += pixel;
-                total_object_count++;
-
-                EOTargetInfo targetInfo = {};
-                fill_target_timestamp(&targetInfo);
-                targetInfo.dev_id = 0;   // 固定为0（可见光）
-                targetInfo.guid_id = 0;  // 固定为0
-                targetInfo.tar_id = 0;   // 固定为0
-                targetInfo.trk_stat = 1; // 默认正常，后续根据置信度调整
-                targetInfo.trk_mod = 0;  // 固定为0（检测跟踪）
-
-                targetInfo.fov_angle = 0.0;
-                targetInfo.lon = 0.0;
-                targetInfo.lat = 0.0;
-                targetInfo.alt = 0.0;
-                targetInfo.tar_a = 0.0;
-                targetInfo.tar_e = 0.0;
-                targetInfo.tar_rng = 0.0; // 没有距离信息填0
-                targetInfo.tar_av = 0.0;
-                targetInfo.tar_ev = 0.0;
-                targetInfo.tar_rv = 0.0; // 没有距离信息填0
-                targetInfo.fov_h = 0.0;
-                targetInfo.fov_v = 0.0;
-
-                targetInfo.offset_h = 0; // 固定为0
-                targetInfo.offset_v = 0; // 固定为0
-                targetInfo.tar_rect =
-                    (int)(obj_meta->rect_params.left +
-                          obj_meta->rect_params.width / 2); // 目标中心的像素值
-                targetInfo.source_id = source_id;
-
-                const TargetLabelMapping target_mapping =
-                    map_target_label_to_eo_fields(obj_meta->obj_label); // 根据标签名映射目标类别和名称
-                targetInfo.tar_category = target_mapping.tar_category;
-                targetInfo.tar_iden = target_mapping.tar_iden;
-
-                targetInfo.tar_cfid = final_confidence;
-                targetInfo.trk_stat = (targetInfo.tar_cfid < 0.0f) ? 2 : 1;
-                target_infos.push_back(targetInfo);
-            }
-        }
 
-        if (total_object_count > 0)
+    // 与 transport->sockets 一一对应的地址族与网卡
+    const std::string        default_iface = self->iface ? self->iface : "";
+    std::vector<int>         socket_families;
+    std::vector<std::string> socket_ifaces;
+    transport->destinations.resize(specs.size());
+    for (size_t d = 0; d < specs.size(); ++d)
+    {
+        const Destination &spec = specs[d];
+        const std::string  iface = spec.iface.empty() ? default_iface : spec.iface;
+        UdpDestination    &destination = transport->destinations[d];
+        if (!ParseUdpAddress(spec.host, spec.port, iface, destination.addr, error))
         {
-            detect_analysis.meanPixel =
-                (guint16)MIN(total_pixel_sum / total_object_count,
-                             (guint64)G_MAXUINT16);
+            error = "invalid destination: " + error;
+            return NULL;
         }
-        else
+        const int family = destination.addr.family();
+        if (family == AF_INET6)
+            transport->udp_overhead = UDPMULTICAST_UDP6_OVERHEAD;
+
+        // 地址族与网卡相同的目的地共用套接字
+        size_t index = 0;
+        while (index < transport->sockets.size() &&
+               (socket_families[index] != family || socket_ifaces[index] != iface))
+            ++index;
+        if (index == transport->sockets.size())
         {
-            detect_analysis.minPixel = 0;
-            detect_analysis.meanPixel = 0;
+            int sockfd = open_send_socket(self, family, iface);
+            if (sockfd < 0)
+            {
+                error = "cannot open a socket on interface \"" + iface + "\"";
+                return NULL;
+            }
+            transport->sockets.push_back(sockfd);
+            socket_families.push_back(family);
+            socket_ifaces.push_back(iface);
         }
+        destination.sockfd = transport->sockets[index];
+        GST_INFO_OBJECT(self, "Destination %zu: %s", d,
+                        FormatUdpAddress(destination.addr).c_str());
+    }
 
-        if (target_infos.empty())
-        {
-            target_infos.push_back(create_empty_target(source_id));
-        }
+    if (router.size() > 0)
+    {
+        GST_INFO_OBJECT(self, "Sending to %zu destinations over %zu sockets%s",
+                        transport->destinations.size(), transport->sockets.size(),
+                        router.routed() ? " with per-source routes" : "");
+    }
+    return transport.release();
+}
 
-        if (should_send)
-        {
-            std::vector<uint8_t> message =
-                EOProtocolParser::PackEOTargetMessage(target_infos,
-                                                      ++self->send_count);
+/**
+ * @brief 按当前属性构建配置快照。
+ *
+ * @param previous 正在使用的快照；不为 NULL 且 rebuild_transport 为 false 时沿用其目的地。
+ * @return 属性无效时返回 NULL 并给出原因。
+ */
+static UdpLiveConfig *
+create_live_config(Gstudpmulticast_sink *self, const UdpLiveConfig *previous,
+                   bool rebuild_transport, std::string &error)
+{
+    std::unique_ptr<UdpLiveConfig> config(new UdpLiveConfig());
+    SourceRateLimiter              fps_check; // 只用于校验 source-fps
 
-            if (!message.empty())
-            {
-                ssize_t sent = sendto(self->sockfd, message.data(), message.size(),
-                                      MSG_DONTWAIT,
-                                      (struct sockaddr *)&self->multicast_addr,
-                                      sizeof(self->multicast_addr));
-                if (sent < 0)
-                {
-                    if (errno == EAGAIN || errno == EWOULDBLOCK)
-                    {
-                        GST_WARNING_OBJECT(self, "Multicast socket busy, dropping frame");
-                    }
-                    else
-                    {
-                        GST_WARNING(
-                            "Failed to send EO target message for source_id=%u with %zu targets: %s",
-                            source_id, target_infos.size(), strerror(errno));
-                    }
-                }
-                else
-                {
-                    GST_DEBUG("Successfully sent EO target message for source_id=%u "
-                              "with %zu targets, size: %zu bytes (fps: %u)",
-                              source_id, target_infos.size(), message.size(),
-                              self->fps);
-                }
-            }
-        }
+    config->fps = self->fps;
+    config->source_fps = self->source_fps ? self->source_fps : "";
+    config->generation = (previous != NULL) ? previous->generation + 1 : 1;
+    if (!fps_check.SetSourceFps(config->source_fps, error))
+    {
+        error = "invalid source-fps \"" + config->source_fps + "\": " + error;
+        return NULL;
+    }
 
-        log_detect_analysis(source_id, detect_analysis);
+    TargetFilter &filter = config->filter;
+    filter.SetMinConfidence(self->min_confidence);
+    filter.SetMinArea((float)self->min_area);
+    filter.SetMaxTargets(self->max_targets);
+    if (!filter.SetClassMinConfidence(
+            self->class_min_confidence ? self->class_min_confidence : "", error))
+    {
+        error = std::string("invalid class-min-confidence \"") +
+                self->class_min_confidence + "\": " + error;
+        return NULL;
+    }
+    if (!filter.SetRoi(self->roi ? self->roi : "", error))
+    {
+        error = std::string("invalid roi \"") + self->roi + "\": " + error;
+        return NULL;
     }
 
-error:
+    if (previous != NULL && !rebuild_transport)
+    {
+        config->transport = previous->transport;
+    }
+    else
+    {
+        UdpTransport *transport = create_transport(self, error);
+        if (transport == NULL)
+            return NULL;
+        config->transport.reset(transport);
+    }
+    return config.release();
+}
 
-    nvds_set_output_system_timestamp(buf, GST_ELEMENT_NAME(self));
-    if (mapped)
-        gst_buffer_unmap(buf, &in_map_info);
-    return GST_FLOW_OK;
+/**
+ * @brief 运行中修改属性后发布新的配置快照，未启动时直接返回（start() 时按属性构建）。
+ * 调用方持有 config_lock。
+ *
+ * render 从下一批次起使用新快照，发送线程在帧之间换用新目的地；
+ * 属性无效或目的地建立失败时告警并保持原配置。
+ *
+ * @param rebuild_transport 是否按新的 ip / port / iface / destinations / routes 重建目的地与套接字。
+ * @return 新配置被拒绝时返回 false，由调用方恢复属性原值。
+ */
+static bool
+update_live_config(Gstudpmulticast_sink *self, bool rebuild_transport)
+{
+    const UdpLiveConfig *previous = self->live_config->current();
+    std::string          error;
+    if (previous == NULL)
+        return true;
+
+    UdpLiveConfig *config = create_live_config(self, previous, rebuild_transport, error);
+    if (config != NULL && config->transport->router.routed() &&
+        (self->send_batch->aggregate || self->send_batch->heartbeat.aggregate()))
+    {
+        // 合包报文只能整体发往一个目的地集合，聚合发送在 start() 时确定
+        error = "routes need aggregate and heartbeat-aggregate off, restart to apply them";
+        delete config;
+        config = NULL;
+    }
+    if (config == NULL)
+    {
+        GST_WARNING_OBJECT(self, "Keeping previous configuration: %s", error.c_str());
+        return false;
+    }
+    self->live_config->Publish(config);
+    GST_INFO_OBJECT(self, "Applied configuration %" G_GUINT64_FORMAT, config->generation);
+    return true;
 }
 
 /**
@@ -576,66 +2479,111 @@ static gboolean gst_udpmulticast_sink_start(GstBaseSink *sink)
     g_print("gst_udpmulticast_sink_start\n");
     Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(sink);
 
-    self->last_send_time_by_source.clear();
     self->send_count = 0;
-
-    CHECK_CUDA_STATUS(cudaSetDevice(self->gpu_id), "Unable to set cuda device");
-
-    // 如果指定了网卡名称，绑定到该网卡
-    if (self->iface && strlen(self->iface) > 0)
+    self->send_batch->source_sn.clear();
+    self->send_batch->heartbeat.Configure(
+        (gint64)self->heartbeat_interval * 1000000, self->heartbeat_aggregate);
+    self->send_batch->aggregate =
+        self->aggregate && self->format != static_cast<guint>(BodyType::DELTA);
+    self->send_batch->frame_count = 0;
+    self->send_batch->batch_sn = 0;
+    if (self->aggregate && !self->send_batch->aggregate)
     {
-        struct ifreq ifr;
-        memset(&ifr, 0, sizeof(ifr));
-        strncpy(ifr.ifr_name, self->iface, IFNAMSIZ - 1);
-
-        // 获取网卡索引
-        if (ioctl(self->sockfd, SIOCGIFINDEX, &ifr) < 0)
+        GST_WARNING_OBJECT(self, "aggregate is ignored with format=delta");
+    }
+    {
+        std::vector<uint8_t> dictionary;
+        std::string          compression_error;
+        if (self->compression_dictionary && strlen(self->compression_dictionary) > 0 &&
+            !EOLoadDictionaryFile(self->compression_dictionary, dictionary, compression_error))
         {
-            GST_ERROR("Failed to get interface %s index: %s", self->iface,
-                      strerror(errno));
-            goto error;
+            GST_ERROR_OBJECT(self, "Failed to load compression dictionary: %s",
+                             compression_error.c_str());
+            return FALSE;
         }
-
-        // 绑定到指定网卡
-        if (setsockopt(self->sockfd, SOL_SOCKET, SO_BINDTODEVICE, self->iface,
-                       strlen(self->iface)) < 0)
+        EOCompressor &compressor = self->send_batch->compressor;
+        if (!compressor.Configure(static_cast<EOCompression>(self->compression), dictionary,
+                                  compression_error))
         {
-            GST_WARNING(
-                "Failed to bind to interface %s: %s. Trying to continue...",
-                self->iface, strerror(errno));
+            GST_ERROR_OBJECT(self, "Failed to configure compression: %s",
+                             compression_error.c_str());
+            return FALSE;
         }
-        else
+        if (compressor.codec() != EOCompression::NONE)
         {
-            GST_INFO("Successfully bound to interface %s", self->iface);
+            GST_INFO_OBJECT(self, "Compression enabled, dictionary %zu bytes (id %08x)",
+                            dictionary.size(), compressor.dictionary_id());
         }
+    }
+    self->delta_encoder->Reset();
+    self->delta_encoder->SetKeyframeInterval(self->keyframe_interval);
+    self->stats->sources.clear();
+    self->stats->window_start = 0;
 
-        // 设置组播发送接口
-        struct in_addr local_interface;
-        memset(&local_interface, 0, sizeof(local_interface));
+    CHECK_CUDA_STATUS(cudaSetDevice(self->gpu_id), "Unable to set cuda device");
 
-        // 获取网卡IP地址
-        if (ioctl(self->sockfd, SIOCGIFADDR, &ifr) < 0)
+    // 每次启动重新构建标签映射，同时清空上次运行驻留的未知标签
+    {
+        TargetLabelMap *label_map = new TargetLabelMap();
+        std::string     load_error;
+        if (self->label_map_file && strlen(self->label_map_file) > 0 &&
+            !label_map->LoadFile(self->label_map_file, load_error))
         {
-            GST_WARNING("Failed to get interface %s address: %s", self->iface,
-                        strerror(errno));
+            GST_ERROR_OBJECT(self, "Failed to load label map %s: %s",
+                             self->label_map_file, load_error.c_str());
+            delete label_map;
+            return FALSE;
         }
-        else
-        {
-            local_interface = ((struct sockaddr_in *)&ifr.ifr_addr)->sin_addr;
+        delete self->label_map;
+        self->label_map = label_map;
+        GST_INFO_OBJECT(self, "Loaded %zu label mappings", label_map->size());
+    }
 
-            // 设置组播发送接口
-            if (setsockopt(self->sockfd, IPPROTO_IP, IP_MULTICAST_IF,
-                           &local_interface, sizeof(local_interface)) < 0)
-            {
-                GST_WARNING("Failed to set multicast interface: %s",
-                            strerror(errno));
-            }
-            else
+    // 按源帧率随配置快照在 render 中应用
+    self->rate_limiter->Configure(static_cast<SourceRateLimiter::Mode>(self->rate_mode),
+                                  self->rate_burst);
+    self->rate_limiter->Reset();
+    self->filtered_objects.store(0);
+
+    // 目的地、fps 与发送前过滤构成首个配置快照，运行中修改这些属性时整体替换
+    {
+        std::string error;
+        g_mutex_lock(&self->config_lock);
+        UdpLiveConfig *config = create_live_config(self, NULL, true, error);
+        if (config == NULL)
+        {
+            g_mutex_unlock(&self->config_lock);
+            GST_ERROR_OBJECT(self, "%s", error.c_str());
+            return FALSE;
+        }
+        if (config->transport->router.routed())
+        {
+            // 多视频源合包的报文只能整体发往一个目的地集合，按视频源路由时不合包
+            if (self->send_batch->aggregate || self->heartbeat_aggregate)
             {
-                GST_INFO("Set multicast interface to %s (IP: %s)", self->iface,
-                         inet_ntoa(local_interface));
+                GST_WARNING_OBJECT(self,
+                                   "aggregate and heartbeat-aggregate are ignored with routes");
             }
+            self->send_batch->aggregate = false;
+            self->send_batch->heartbeat.Configure(
+                (gint64)self->heartbeat_interval * 1000000, false);
         }
+        self->render_generation = 0;
+        self->live_config->Publish(config);
+        g_mutex_unlock(&self->config_lock);
+    }
+
+    if (self->async)
+    {
+        self->async_ring = new SpscRing<AsyncFrameRecord>(self->queue_depth);
+        self->dropped_frames.store(0);
+        self->truncated_objects.store(0);
+        self->sender_waiting.store(false);
+        self->sender_running.store(true);
+        self->sender_thread = g_thread_new(
+            "udpmulticast-send", gst_udpmulticast_sink_sender_loop, self);
+        GST_INFO_OBJECT(self, "Async sender started, queue depth %zu",
+                        self->async_ring->capacity());
     }
 
     return TRUE;
@@ -653,6 +2601,35 @@ error:
 static gboolean gst_udpmulticast_sink_stop(GstBaseSink *sink)
 {
     g_print("gst_udpmulticast_sink_stop\n");
+    Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(sink);
+
+    if (self->sender_thread != NULL)
+    {
+        // 发送线程排空队列后退出
+        g_mutex_lock(&self->sender_lock);
+        self->sender_running.store(false);
+        g_cond_signal(&self->sender_cond);
+        g_mutex_unlock(&self->sender_lock);
+        g_thread_join(self->sender_thread);
+        self->sender_thread = NULL;
+
+        delete self->async_ring;
+        self->async_ring = NULL;
+        GST_INFO_OBJECT(self,
+                        "Async sender stopped, dropped frames: %" G_GUINT64_FORMAT
+                        ", truncated objects: %" G_GUINT64_FORMAT,
+                        self->dropped_frames.load(),
+                        self->truncated_objects.load());
+    }
+
+    // 流线程与发送线程都已停止，快照不再被引用；未满的 FEC 分组先发出校验报文
+    g_mutex_lock(&self->config_lock);
+    self->live_config->Publish(NULL);
+    g_mutex_unlock(&self->config_lock);
+    if (self->send_batch->transport)
+        flush_send_transport(self);
+    self->send_batch->transport.reset();
+    self->send_batch->fec.clear();
     return TRUE;
 }
 
@@ -667,12 +2644,20 @@ error:
     return FALSE;
 }
 
-static void gst_udpmulticast_sink_set_property(GObject      *object,
-                                               guint         property_id,
-                                               const GValue *value,
-                                               GParamSpec   *pspec)
+/**
+ * @brief 写入属性字段，调用方持有 config_lock。
+ *
+ * @param transport 置为 true 表示修改后需要重建目的地与套接字。
+ * @return 运行中修改后需要发布新的配置快照时返回 true。
+ */
+static bool gst_udpmulticast_sink_write_property(Gstudpmulticast_sink *self,
+                                                 guint                 property_id,
+                                                 const GValue         *value,
+                                                 GParamSpec           *pspec,
+                                                 bool                 *transport)
 {
-    Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(object);
+    bool live = false;
+
     switch (property_id)
     {
     case PROP_SILENT:
@@ -681,32 +2666,163 @@ static void gst_udpmulticast_sink_set_property(GObject      *object,
     case PROP_IP:
         g_free(self->ip);
         self->ip = g_value_dup_string(value);
-        if (self->ip)
-            self->multicast_addr.sin_addr.s_addr = inet_addr(self->ip);
+        live = *transport = true;
         break;
     case PROP_PORT:
         self->port = g_value_get_uint(value);
-        self->multicast_addr.sin_port = htons(self->port);
+        live = *transport = true;
         break;
     case PROP_IFACE:
         g_free(self->iface);
         self->iface = g_value_dup_string(value);
+        live = *transport = true;
+        break;
+    case PROP_DESTINATIONS:
+        g_free(self->destinations);
+        self->destinations = g_value_dup_string(value);
+        live = *transport = true;
+        break;
+    case PROP_ROUTES:
+        g_free(self->routes);
+        self->routes = g_value_dup_string(value);
+        live = *transport = true;
         break;
     case PROP_FPS:
         self->fps = g_value_get_uint(value);
         GST_INFO("Set report FPS to: %u", self->fps);
+        live = true;
+        break;
+    case PROP_FORMAT:
+        self->format = static_cast<guint>(g_value_get_enum(value));
+        break;
+    case PROP_ASYNC:
+        self->async = g_value_get_boolean(value);
+        break;
+    case PROP_QUEUE_DEPTH:
+        self->queue_depth = g_value_get_uint(value);
+        break;
+    case PROP_DROP_POLICY:
+        self->drop_policy = static_cast<guint>(g_value_get_enum(value));
+        break;
+    case PROP_BATCH_SEND:
+        self->batch_send = g_value_get_boolean(value);
+        break;
+    case PROP_STATS_MODE:
+        self->stats_mode = static_cast<guint>(g_value_get_enum(value));
+        break;
+    case PROP_STATS_INTERVAL:
+        self->stats_interval = g_value_get_uint(value);
+        break;
+    case PROP_STATS_PORT:
+        self->stats_port = g_value_get_uint(value);
+        break;
+    case PROP_MAP_BUFFER:
+        self->map_buffer = g_value_get_boolean(value);
+        break;
+    case PROP_LATENCY_TIMESTAMPS:
+        self->latency_timestamps = g_value_get_boolean(value);
+        break;
+    case PROP_LABEL_MAP_FILE:
+        g_free(self->label_map_file);
+        self->label_map_file = g_value_dup_string(value);
+        break;
+    case PROP_RATE_MODE:
+        self->rate_mode = static_cast<guint>(g_value_get_enum(value));
+        break;
+    case PROP_RATE_BURST:
+        self->rate_burst = g_value_get_uint(value);
+        break;
+    case PROP_SOURCE_FPS:
+        g_free(self->source_fps);
+        self->source_fps = g_value_dup_string(value);
+        live = true;
+        break;
+    case PROP_MTU:
+        self->mtu = g_value_get_uint(value);
+        break;
+    case PROP_KEYFRAME_INTERVAL:
+        self->keyframe_interval = g_value_get_uint(value);
+        break;
+    case PROP_MIN_CONFIDENCE:
+        self->min_confidence = g_value_get_float(value);
+        live = true;
+        break;
+    case PROP_CLASS_MIN_CONFIDENCE:
+        g_free(self->class_min_confidence);
+        self->class_min_confidence = g_value_dup_string(value);
+        live = true;
+        break;
+    case PROP_MIN_AREA:
+        self->min_area = g_value_get_uint(value);
+        live = true;
+        break;
+    case PROP_ROI:
+        g_free(self->roi);
+        self->roi = g_value_dup_string(value);
+        live = true;
+        break;
+    case PROP_MAX_TARGETS:
+        self->max_targets = g_value_get_uint(value);
+        live = true;
+        break;
+    case PROP_HEARTBEAT_INTERVAL:
+        self->heartbeat_interval = g_value_get_uint(value);
+        break;
+    case PROP_HEARTBEAT_AGGREGATE:
+        self->heartbeat_aggregate = g_value_get_boolean(value);
+        break;
+    case PROP_AGGREGATE:
+        self->aggregate = g_value_get_boolean(value);
+        break;
+    case PROP_FEC_GROUP_SIZE:
+        self->fec_group_size = g_value_get_uint(value);
+        break;
+    case PROP_FEC_PARITY:
+        self->fec_parity = g_value_get_uint(value);
+        break;
+    case PROP_COMPRESSION:
+        self->compression = static_cast<guint>(g_value_get_enum(value));
+        break;
+    case PROP_COMPRESSION_DICTIONARY:
+        g_free(self->compression_dictionary);
+        self->compression_dictionary = g_value_dup_string(value);
         break;
     default:
-        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(self, property_id, pspec);
     }
+    return live;
 }
 
-static void gst_udpmulticast_sink_get_property(GObject    *object,
-                                               guint       property_id,
-                                               GValue     *value,
-                                               GParamSpec *pspec)
+static void gst_udpmulticast_sink_set_property(GObject      *object,
+                                               guint         property_id,
+                                               const GValue *value,
+                                               GParamSpec   *pspec)
 {
     Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(object);
+    GValue                previous = G_VALUE_INIT;
+    bool                  transport = false;
+
+    g_mutex_lock(&self->config_lock);
+    g_value_init(&previous, G_PARAM_SPEC_VALUE_TYPE(pspec));
+    gst_udpmulticast_sink_read_property(self, property_id, &previous, pspec);
+    if (gst_udpmulticast_sink_write_property(self, property_id, value, pspec, &transport) &&
+        !update_live_config(self, transport))
+    {
+        // 被拒绝的值不保留：恢复生效中的值，get_property 与之后的修改都以它为准
+        gst_udpmulticast_sink_write_property(self, property_id, &previous, pspec, &transport);
+    }
+    g_mutex_unlock(&self->config_lock);
+    g_value_unset(&previous);
+}
+
+/**
+ * @brief 读取属性字段，调用方持有 config_lock。
+ */
+static void gst_udpmulticast_sink_read_property(Gstudpmulticast_sink *self,
+                                                guint                 property_id,
+                                                GValue               *value,
+                                                GParamSpec           *pspec)
+{
     switch (property_id)
     {
     case PROP_SILENT:
@@ -721,24 +2837,155 @@ static void gst_udpmulticast_sink_get_property(GObject    *object,
     case PROP_IFACE:
         g_value_set_string(value, self->iface);
         break;
+    case PROP_DESTINATIONS:
+        g_value_set_string(value, self->destinations);
+        break;
+    case PROP_ROUTES:
+        g_value_set_string(value, self->routes);
+        break;
     case PROP_FPS:
         g_value_set_uint(value, self->fps);
         break;
+    case PROP_FORMAT:
+        g_value_set_enum(value, static_cast<gint>(self->format));
+        break;
+    case PROP_ASYNC:
+        g_value_set_boolean(value, self->async);
+        break;
+    case PROP_QUEUE_DEPTH:
+        g_value_set_uint(value, self->queue_depth);
+        break;
+    case PROP_DROP_POLICY:
+        g_value_set_enum(value, static_cast<gint>(self->drop_policy));
+        break;
+    case PROP_DROPPED_FRAMES:
+        g_value_set_uint64(value, self->dropped_frames.load());
+        break;
+    case PROP_TRUNCATED_OBJECTS:
+        g_value_set_uint64(value, self->truncated_objects.load());
+        break;
+    case PROP_BATCH_SEND:
+        g_value_set_boolean(value, self->batch_send);
+        break;
+    case PROP_STATS_MODE:
+        g_value_set_enum(value, static_cast<gint>(self->stats_mode));
+        break;
+    case PROP_STATS_INTERVAL:
+        g_value_set_uint(value, self->stats_interval);
+        break;
+    case PROP_STATS_PORT:
+        g_value_set_uint(value, self->stats_port);
+        break;
+    case PROP_MAP_BUFFER:
+        g_value_set_boolean(value, self->map_buffer);
+        break;
+    case PROP_LATENCY_TIMESTAMPS:
+        g_value_set_boolean(value, self->latency_timestamps);
+        break;
+    case PROP_LABEL_MAP_FILE:
+        g_value_set_string(value, self->label_map_file);
+        break;
+    case PROP_RATE_MODE:
+        g_value_set_enum(value, static_cast<gint>(self->rate_mode));
+        break;
+    case PROP_RATE_BURST:
+        g_value_set_uint(value, self->rate_burst);
+        break;
+    case PROP_SOURCE_FPS:
+        g_value_set_string(value, self->source_fps);
+        break;
+    case PROP_MTU:
+        g_value_set_uint(value, self->mtu);
+        break;
+    case PROP_KEYFRAME_INTERVAL:
+        g_value_set_uint(value, self->keyframe_interval);
+        break;
+    case PROP_MIN_CONFIDENCE:
+        g_value_set_float(value, self->min_confidence);
+        break;
+    case PROP_CLASS_MIN_CONFIDENCE:
+        g_value_set_string(value, self->class_min_confidence);
+        break;
+    case PROP_MIN_AREA:
+        g_value_set_uint(value, self->min_area);
+        break;
+    case PROP_ROI:
+        g_value_set_string(value, self->roi);
+        break;
+    case PROP_MAX_TARGETS:
+        g_value_set_uint(value, self->max_targets);
+        break;
+    case PROP_FILTERED_OBJECTS:
+        g_value_set_uint64(value, self->filtered_objects.load());
+        break;
+    case PROP_HEARTBEAT_INTERVAL:
+        g_value_set_uint(value, self->heartbeat_interval);
+        break;
+    case PROP_HEARTBEAT_AGGREGATE:
+        g_value_set_boolean(value, self->heartbeat_aggregate);
+        break;
+    case PROP_AGGREGATE:
+        g_value_set_boolean(value, self->aggregate);
+        break;
+    case PROP_FEC_GROUP_SIZE:
+        g_value_set_uint(value, self->fec_group_size);
+        break;
+    case PROP_FEC_PARITY:
+        g_value_set_uint(value, self->fec_parity);
+        break;
+    case PROP_COMPRESSION:
+        g_value_set_enum(value, static_cast<gint>(self->compression));
+        break;
+    case PROP_COMPRESSION_DICTIONARY:
+        g_value_set_string(value, self->compression_dictionary);
+        break;
     default:
-        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, property_id, pspec);
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(self, property_id, pspec);
     }
 }
 
+static void gst_udpmulticast_sink_get_property(GObject    *object,
+                                               guint       property_id,
+                                               GValue     *value,
+                                               GParamSpec *pspec)
+{
+    Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(object);
+    g_mutex_lock(&self->config_lock);
+    gst_udpmulticast_sink_read_property(self, property_id, value, pspec);
+    g_mutex_unlock(&self->config_lock);
+}
+
 static void gst_udpmulticast_sink_finalize(GObject *object)
 {
     Gstudpmulticast_sink *self = GST_UDPMULTICAST_SINK(object);
-    if (self->sockfd >= 0)
-    {
-        close(self->sockfd);
-        self->sockfd = -1;
-    }
+    delete self->live_config;
+    self->live_config = NULL;
+    g_mutex_clear(&self->config_lock);
     g_clear_pointer(&self->ip, g_free);
     g_clear_pointer(&self->iface, g_free);
+    g_clear_pointer(&self->destinations, g_free);
+    g_clear_pointer(&self->routes, g_free);
+    delete self->async_ring;
+    self->async_ring = NULL;
+    delete self->send_batch;
+    self->send_batch = NULL;
+    delete self->delta_encoder;
+    self->delta_encoder = NULL;
+    delete self->stats;
+    self->stats = NULL;
+    delete self->label_map;
+    self->label_map = NULL;
+    g_clear_pointer(&self->label_map_file, g_free);
+    g_clear_pointer(&self->compression_dictionary, g_free);
+    delete self->rate_limiter;
+    self->rate_limiter = NULL;
+    g_clear_pointer(&self->source_fps, g_free);
+    delete self->async_objects;
+    self->async_objects = NULL;
+    g_clear_pointer(&self->class_min_confidence, g_free);
+    g_clear_pointer(&self->roi, g_free);
+    g_mutex_clear(&self->sender_lock);
+    g_cond_clear(&self->sender_cond);
     GST_DEBUG_OBJECT(self, "finalize");
     G_OBJECT_CLASS(parent_class)->finalize(object);
 }
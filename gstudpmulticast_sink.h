@@ -6,9 +6,12 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <sys/time.h>
 #include <unistd.h>
 #ifdef __cplusplus
-#include <map>
+#include <atomic>
+#include "rcu_snapshot.h"
+#include "spsc_ring.h"
 #endif
 
 #define PACKAGE "_udpmulticast_sink"
@@ -18,6 +21,36 @@
 #define BINARY_PACKAGE "NVIDIA DeepStream 3rdparty plugin"
 #define URL "https://github.com/karmueo/"
 
+// UDP 单个报文最大负载（65535 - 8 字节 UDP 头 - 20 字节 IP 头）
+#define UDPMULTICAST_MAX_PAYLOAD 65507
+#define UDPMULTICAST_UDP_OVERHEAD 28  // IPv4 头(20) + UDP 头(8)
+#define UDPMULTICAST_UDP6_OVERHEAD 48 // IPv6 头(40) + UDP 头(8)
+
+// 异步发送模式下单帧记录最多携带的目标数，超出部分丢弃并计数
+#define UDPMULTICAST_ASYNC_MAX_OBJECTS 64
+// 单次 sendmmsg 最多合并的报文数，超出时提前冲刷
+#define UDPMULTICAST_MAX_BATCH_MESSAGES 64
+// FEC 未满的分组最多等待的时间（纳秒），超时后按已有报文生成校验报文
+#define UDPMULTICAST_FEC_MAX_DELAY_NS (50 * 1000 * 1000LL)
+// 统计信息按类别编号直接索引的上限
+#define UDPMULTICAST_MAX_CLASSES 128
+// 检测统计按 source_id 直接索引的上限，超出的视频源不参与统计
+#define UDPMULTICAST_MAX_STATS_SOURCES 1024
+// 无锁读取配置快照的线程数：流线程（render）与异步发送线程
+#define UDPMULTICAST_CONFIG_READERS 2
+
+struct TargetLabelEntry;
+#ifdef __cplusplus
+class SourceRateLimiter;
+class TargetLabelMap;
+class TargetFilter;
+class EODeltaEncoder;
+struct UdpSendBatch;
+struct UdpLiveConfig;
+struct DetectStatsWindow;
+struct AsyncFrameObjects;
+#endif
+
 G_BEGIN_DECLS
 
 typedef struct _Gstudpmulticast_sinkClass Gstudpmulticast_sinkClass;
@@ -25,8 +58,46 @@ typedef struct _Gstudpmulticast_sink Gstudpmulticast_sink;
 typedef struct _SendData SendData;
 typedef struct _BboxInfo BboxInfo;
 typedef struct _DetectAnalysis DetectAnalysis;
+typedef struct _AsyncObjectRecord AsyncObjectRecord;
+typedef struct _AsyncFrameRecord AsyncFrameRecord;
+
+// 异步发送队列满时的丢弃策略
+typedef enum
+{
+    UDPMULTICAST_DROP_OLDEST = 0, // 丢弃队列中最旧的帧，保证发送最新结果
+    UDPMULTICAST_DROP_NEWEST = 1  // 丢弃当前帧，保留已排队的帧
+} GstUdpMulticastSinkDropPolicy;
+
+// 按源限速方式，取值与 SourceRateLimiter::Mode 一致
+typedef enum
+{
+    UDPMULTICAST_RATE_INTERVAL = 0,    // 固定间隔
+    UDPMULTICAST_RATE_TOKEN_BUCKET = 1 // 令牌桶，允许 rate-burst 帧突发
+} GstUdpMulticastSinkRateMode;
+
+// 报文压缩方式，取值与 EOCompression 一致
+typedef enum
+{
+    UDPMULTICAST_COMPRESSION_NONE = 0,   // 不压缩
+    UDPMULTICAST_COMPRESSION_LZ4 = 1,    // LZ4 块格式，速度优先
+    UDPMULTICAST_COMPRESSION_DEFLATE = 2 // 原始 deflate，压缩率优先
+} GstUdpMulticastSinkCompression;
+
+// 检测统计的发布方式
+typedef enum
+{
+    UDPMULTICAST_STATS_NONE = 0,    // 不统计
+    UDPMULTICAST_STATS_LOG = 1,     // 每个窗口输出一条 GST_INFO 日志
+    UDPMULTICAST_STATS_MESSAGE = 2, // 每个窗口向总线发送 element 消息
+    UDPMULTICAST_STATS_DATAGRAM = 3 // 每个窗口发送一个 JSON 组播统计报文
+} GstUdpMulticastSinkStatsMode;
 
 #define GST_TYPE_UDPMULTICAST_SINK (gst_udpmulticast_sink_get_type())
+#define GST_TYPE_UDPMULTICAST_SINK_FORMAT (gst_udpmulticast_sink_format_get_type())
+#define GST_TYPE_UDPMULTICAST_SINK_DROP_POLICY (gst_udpmulticast_sink_drop_policy_get_type())
+#define GST_TYPE_UDPMULTICAST_SINK_STATS_MODE (gst_udpmulticast_sink_stats_mode_get_type())
+#define GST_TYPE_UDPMULTICAST_SINK_RATE_MODE (gst_udpmulticast_sink_rate_mode_get_type())
+#define GST_TYPE_UDPMULTICAST_SINK_COMPRESSION (gst_udpmulticast_sink_compression_get_type())
 #define GST_UDPMULTICAST_SINK(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_UDPMULTICAST_SINK, Gstudpmulticast_sink))
 
 struct _Gstudpmulticast_sink
@@ -37,17 +108,117 @@ struct _Gstudpmulticast_sink
 
     guint gpu_id;
 
-    int sockfd;
-    struct sockaddr_in multicast_addr;
     // configurable multicast params
-    gchar *ip;   // multicast ip string
+    // 目的地、网卡、fps 与发送前过滤可在运行中修改：属性修改后整体生成新的配置快照
+    // （live_config）并原子替换，render 与发送线程无锁读取，无需重启管线
+    gchar *ip;   // destination ip string (IPv4 or IPv6, multicast or unicast)
     guint  port; // multicast port
-    gchar *iface; // multicast network interface name
+    gchar *iface; // multicast network interface name，运行中修改时按新网卡重建套接字
+    // 多目的地：报文只编码一次，按路由表发往各目的地
+    gchar *destinations; // "ip:port[/iface],..."，为空时只发往 ip:port
+    gchar *routes;       // source_id → 目的地下标，如 "0:0,1:0|1"；未列出的视频源发往全部目的地
     guint  fps;  // report rate in frames per second (default: 25)
+    guint  format; // payload format, values of BodyType (0: json, 1: binary)
+
+    // 按源限速
+    guint  rate_mode;  // GstUdpMulticastSinkRateMode
+    guint  rate_burst; // 令牌桶模式下允许的突发帧数
+    gchar *source_fps; // 按源覆盖的帧率，如 "0:25,3:10"
 #ifdef __cplusplus
-    std::map<guint, gdouble> last_send_time_by_source; // per-source send timestamp
+    SourceRateLimiter *rate_limiter;
 #endif
     guint16 send_count; // packet counter
+    guint   mtu;        // 路径 MTU，报文超过 mtu - 28 字节（IPv6 为 mtu - 48）时按目标拆分为多个报文
+    guint   keyframe_interval; // delta 格式下两个关键帧之间的差分帧数，start() 时生效
+#ifdef __cplusplus
+    EODeltaEncoder *delta_encoder;
+#endif
+
+    // 空闲心跳：无目标的视频源只在跳变时发送占位报文，之后按间隔发送心跳，start() 时生效
+    guint    heartbeat_interval;  // 心跳间隔（毫秒），0 表示每个空帧都发送 "none" 占位报文
+    gboolean heartbeat_aggregate; // 是否将各视频源的心跳合并为一个报文
+
+    // 聚合发送：同一 NvDsBatchMeta 中各视频源的目标按 source_id 合并编码，start() 时生效
+    gboolean aggregate; // delta 格式下不生效
+
+    // 前向纠错：每 fec_group_size 个目标 / 心跳报文追加 fec_parity 个校验报文，start() 时生效
+    guint fec_group_size; // 0 表示关闭
+    guint fec_parity;     // 1 为 XOR，大于 1 为 Reed-Solomon
+
+    // 报文压缩：目标 / 心跳报文整体压缩（可带共享字典），先压缩再计算 FEC，start() 时生效
+    guint  compression;            // GstUdpMulticastSinkCompression
+    gchar *compression_dictionary; // 字典文件，为空时不用字典
+
+    // 批量发送：同一 NvDsBatchMeta 产生的报文用一次 sendmmsg 发出
+    gboolean batch_send; // 是否启用 sendmmsg 批量发送
+#ifdef __cplusplus
+    UdpSendBatch *send_batch;
+#endif
+
+    // 检测统计：按视频源聚合，每个窗口发布一次
+    guint    stats_mode;         // GstUdpMulticastSinkStatsMode
+    guint    stats_interval;     // 统计窗口（毫秒）
+    guint    stats_port;         // 统计报文端口，0 表示与 port 相同
+    gboolean map_buffer;         // 是否映射输入缓冲区（render 不读取帧数据）
+    gboolean latency_timestamps; // 是否记录 nvds 延迟测量时间戳
+#ifdef __cplusplus
+    DetectStatsWindow *stats;
+#endif
+
+    gchar *label_map_file; // 标签映射文件，start() 时加载；为空使用内置映射
+#ifdef __cplusplus
+    TargetLabelMap *label_map;
+#endif
+
+    // 发送前过滤：逐目标条件与单帧上限
+    gfloat min_confidence;       // 默认最小置信度，-1 表示不过滤
+    gchar *class_min_confidence; // 按类别覆盖的最小置信度，如 "0:0.5,2:0.3"
+    guint  min_area;             // 最小检测框面积（像素），0 表示不过滤
+    gchar *roi;                  // 按源的 ROI 多边形，如 "0:0,0,1920,0,1920,800,0,800"
+    guint  max_targets;          // 单帧最多上报的目标数（按置信度取前 K 个），0 不限制
+
+    // 运行中可修改的配置：属性写入与快照发布由 config_lock 串行化，读端不加锁
+    GMutex config_lock;
+#ifdef __cplusplus
+    RcuSnapshot<UdpLiveConfig, UDPMULTICAST_CONFIG_READERS> *live_config;
+    guint64 render_generation; // render 已应用到 rate_limiter 的快照代数
+#endif
+
+    // 异步发送：render 只拷贝目标字段入队，由发送线程编码并发送
+    gboolean async;       // 是否启用独立发送线程（start() 时生效）
+    guint    queue_depth; // 发送队列深度（帧）
+    guint    drop_policy; // 队列满时的丢弃策略，GstUdpMulticastSinkDropPolicy
+    GThread *sender_thread;
+    GMutex   sender_lock;
+    GCond    sender_cond;
+#ifdef __cplusplus
+    SpscRing<AsyncFrameRecord> *async_ring;
+    AsyncFrameObjects          *async_objects; // 当前帧通过过滤的目标，帧末写入发送记录
+    std::atomic<bool>           sender_running;
+    std::atomic<bool>           sender_waiting;
+    std::atomic<guint64>        dropped_frames;    // 队列满丢弃的帧数
+    std::atomic<guint64>        truncated_objects; // 超出单帧上限丢弃的目标数
+    std::atomic<guint64>        filtered_objects;  // 被发送前过滤剔除的目标数
+#endif
+};
+
+// 异步发送记录：单个目标在 render 中拷贝出的字段
+struct _AsyncObjectRecord
+{
+    gint                           tar_rect;    // 目标中心的像素值
+    gfloat                         confidence;  // 最终置信度（有二级分类结果时取分类置信度）
+    const struct TargetLabelEntry *label_entry; // render 中查好的标签映射
+};
+
+// 异步发送记录：单帧
+struct _AsyncFrameRecord
+{
+    guint             source_id;
+    guint             object_count;
+    struct timeval    timestamp; // 帧时间戳，render 中采集一次
+    guint             batch_seq; // 所属 NvDsBatchMeta 的序号，聚合发送时用于划分批次
+    gboolean          batch_end; // 聚合发送的批次结束标记，不含目标
+    AsyncObjectRecord objects[UDPMULTICAST_ASYNC_MAX_OBJECTS];
 };
 
 struct _Gstudpmulticast_sinkClass
@@ -63,24 +234,27 @@ struct _BboxInfo
     float height;
 };
 
-// 统计信息结构体 (only used in C++)
-#ifdef __cplusplus
+// 统计信息结构体：单路视频源在一个统计窗口内的检测统计，类别按编号直接索引
 struct _DetectAnalysis {
-    guint64 frameNum;
-    std::map<guint16, guint> primaryClassCountMap;
-    std::map<guint16, guint> secondaryClassCountMap;
+    guint64 frameNum;      // 窗口内最后一帧的帧号
+    guint64 frameCount;    // 窗口内帧数
+    guint64 objectCount;   // 窗口内目标数
+    guint64 pixelSum;      // 目标像素面积之和，用于计算平均值
+    guint64 filteredCount; // 发送帧中被过滤条件剔除、未上报的目标数
+    guint   primaryClassCount[UDPMULTICAST_MAX_CLASSES];   // 一级检测各类别目标数
+    guint   secondaryClassCount[UDPMULTICAST_MAX_CLASSES]; // 二级分类各类别标签数
+    guint   primaryClassOverflow;   // 类别编号超出上限的一级目标数
+    guint   secondaryClassOverflow; // 类别编号超出上限的二级标签数
     guint16 minPixel;  // 目标最小像素值
     guint16 meanPixel; // 平均像素值
 };
-#else
-typedef struct _DetectAnalysis {
-    guint64 frameNum;
-    guint16 minPixel;
-    guint16 meanPixel;
-} _DetectAnalysis;
-#endif
 
 GType gst_udpmulticast_sink_get_type(void);
+GType gst_udpmulticast_sink_format_get_type(void);
+GType gst_udpmulticast_sink_drop_policy_get_type(void);
+GType gst_udpmulticast_sink_stats_mode_get_type(void);
+GType gst_udpmulticast_sink_rate_mode_get_type(void);
+GType gst_udpmulticast_sink_compression_get_type(void);
 
 G_END_DECLS
 
@@ -0,0 +1,113 @@
+#ifndef RCU_SNAPSHOT_H
+#define RCU_SNAPSHOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// 单写多读的只读快照（RCU）。
+// 写端构建完整的新快照后以一次原子交换发布；读端无锁取得当前快照，持有期间快照不会被释放。
+// 读端以风险指针声明正在使用的快照：每个读线程固定使用一个槽位（reader < kReaders），
+// Lock() 与 Unlock() 之间可以任意读取快照，但不能再次 Lock() 同一槽位。
+// 被替换的旧快照进入待回收列表，写端每次发布时释放不再被任何槽位引用的旧快照；
+// 写端从不等待读端，读端从不阻塞。Publish() / Reclaim() 须由调用方串行调用。
+template <typename T, size_t kReaders> class RcuSnapshot
+{
+  public:
+    RcuSnapshot() = default;
+    RcuSnapshot(const RcuSnapshot &) = delete;
+    RcuSnapshot &operator=(const RcuSnapshot &) = delete;
+
+    // 析构时不应再有读端持有快照
+    ~RcuSnapshot()
+    {
+        delete current_.load(std::memory_order_relaxed);
+        for (T *snapshot : retired_)
+        {
+            delete snapshot;
+        }
+    }
+
+    // 读端：取得当前快照（未发布时为 nullptr），至 Unlock() 前有效
+    const T *Lock(size_t reader)
+    {
+        T *snapshot = current_.load(std::memory_order_seq_cst);
+        for (;;)
+        {
+            hazards_[reader].snapshot.store(snapshot, std::memory_order_seq_cst);
+            // 声明之后快照仍是当前快照，写端回收前的扫描必然看到该声明
+            T *again = current_.load(std::memory_order_seq_cst);
+            if (again == snapshot)
+            {
+                return snapshot;
+            }
+            snapshot = again;
+        }
+    }
+
+    // 读端：不再使用 Lock() 返回的快照
+    void Unlock(size_t reader)
+    {
+        hazards_[reader].snapshot.store(nullptr, std::memory_order_release);
+    }
+
+    // 写端：发布新快照（可为 nullptr），接管其所有权，并回收不再被引用的旧快照
+    void Publish(T *snapshot)
+    {
+        T *previous = current_.exchange(snapshot, std::memory_order_seq_cst);
+        if (previous != nullptr)
+        {
+            retired_.push_back(previous);
+        }
+        Reclaim();
+    }
+
+    // 写端：当前快照，用于在其基础上构建新快照。只有写端会释放快照，因此无需声明
+    const T *current() const { return current_.load(std::memory_order_acquire); }
+
+    // 写端：释放不再被任何读端引用的旧快照
+    void Reclaim()
+    {
+        size_t kept = 0;
+        for (T *snapshot : retired_)
+        {
+            if (InUse(snapshot))
+            {
+                retired_[kept++] = snapshot;
+            }
+            else
+            {
+                delete snapshot;
+            }
+        }
+        retired_.resize(kept);
+    }
+
+    // 写端：尚未释放的旧快照数
+    size_t retired() const { return retired_.size(); }
+
+  private:
+    // 每个槽位独占一个缓存行，读端之间不共享写入
+    struct alignas(64) Hazard
+    {
+        std::atomic<T *> snapshot{nullptr};
+    };
+
+    bool InUse(const T *snapshot) const
+    {
+        for (const Hazard &hazard : hazards_)
+        {
+            if (hazard.snapshot.load(std::memory_order_seq_cst) == snapshot)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::atomic<T *> current_{nullptr};
+    Hazard           hazards_[kReaders];
+    std::vector<T *> retired_; // 仅写端访问
+};
+
+#endif // RCU_SNAPSHOT_H
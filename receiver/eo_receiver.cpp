@@ -1,4 +1,5 @@
 #include "eo_receiver.h"
+#include "udp_address.h"
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
@@ -9,6 +10,7 @@
 #include <chrono>
 #include <net/if.h>
 #include <sys/ioctl.h>
+#include <linux/filter.h>
 
 // 辅助函数：通过网卡名称获取IP地址
 static bool getInterfaceIP(const std::string& ifname, std::string& ipAddr) {
@@ -31,54 +33,30 @@ static bool getInterfaceIP(const std::string& ifname, std::string& ipAddr) {
     return true;
 }
 
-EOReceiver::EOReceiver(const std::string& mcastIp, uint16_t port, const std::string& localIf)
-    : mcastIp_(mcastIp), port_(port), localIf_(localIf) {}
-
-EOReceiver::~EOReceiver() { stop(); }
-
-bool EOReceiver::start() {
-    if (running_) return true;
-
-    sockfd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
-    if (sockfd_ < 0) {
-        std::cerr << "EOReceiver: socket create failed: " << strerror(errno) << std::endl;
-        return false;
-    }
-
-    int reuse = 1;
-    if (setsockopt(sockfd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
-        std::cerr << "EOReceiver: setsockopt SO_REUSEADDR failed: " << strerror(errno) << std::endl;
-    }
-
-    sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    addr.sin_port = htons(port_);
-    if (bind(sockfd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-        std::cerr << "EOReceiver: bind failed: " << strerror(errno) << std::endl;
-        ::close(sockfd_);
-        sockfd_ = -1;
-        return false;
-    }
-
+// 加入 IPv4 组播组。localIf 为网卡名或本机 IPv4 地址，为空时由系统选择网卡
+static bool joinGroupV4(int fd, const UdpAddress& group, const std::string& localIf, bool verbose) {
     ip_mreq mreq{};
-    mreq.imr_multiaddr.s_addr = inet_addr(mcastIp_.c_str());
-    if (!localIf_.empty()) {
+    mreq.imr_multiaddr = reinterpret_cast<const sockaddr_in*>(&group.storage)->sin_addr;
+    if (!localIf.empty()) {
         // 尝试判断是网卡名称还是IP地址
         struct in_addr addr;
-        if (inet_aton(localIf_.c_str(), &addr) != 0) {
+        if (inet_aton(localIf.c_str(), &addr) != 0) {
             // 输入是有效的IP地址
             mreq.imr_interface.s_addr = addr.s_addr;
-            std::cout << "EOReceiver: Binding to interface IP: " << localIf_ << std::endl;
+            if (verbose) {
+                std::cout << "EOReceiver: Binding to interface IP: " << localIf << std::endl;
+            }
         } else {
             // 输入可能是网卡名称，尝试获取其IP
             std::string ifIP;
-            if (getInterfaceIP(localIf_, ifIP)) {
+            if (getInterfaceIP(localIf, ifIP)) {
                 mreq.imr_interface.s_addr = inet_addr(ifIP.c_str());
-                std::cout << "EOReceiver: Binding to interface " << localIf_ 
-                          << " (IP: " << ifIP << ")" << std::endl;
+                if (verbose) {
+                    std::cout << "EOReceiver: Binding to interface " << localIf
+                              << " (IP: " << ifIP << ")" << std::endl;
+                }
             } else {
-                std::cerr << "EOReceiver: Failed to get IP for interface: " << localIf_ 
+                std::cerr << "EOReceiver: Failed to get IP for interface: " << localIf 
                           << ", using INADDR_ANY" << std::endl;
                 mreq.imr_interface.s_addr = htonl(INADDR_ANY);
             }
@@ -87,67 +65,500 @@ bool EOReceiver::start() {
         mreq.imr_interface.s_addr = htonl(INADDR_ANY);
     }
 
-    if (setsockopt(sockfd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+    if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
         std::cerr << "EOReceiver: join multicast failed: " << strerror(errno) << std::endl;
-        ::close(sockfd_);
-        sockfd_ = -1;
         return false;
     }
+    return true;
+}
+
+// 加入 IPv6 组播组（MLD）。网卡取地址中的作用域（"%eth0"），其次为 localIf 网卡名，
+// 都没有时由系统选择网卡
+static bool joinGroupV6(int fd, const UdpAddress& group, const std::string& localIf, bool verbose) {
+    ipv6_mreq mreq{};
+    mreq.ipv6mr_multiaddr = reinterpret_cast<const sockaddr_in6*>(&group.storage)->sin6_addr;
+    mreq.ipv6mr_interface = group.scope_id();
+    if (mreq.ipv6mr_interface == 0 && !localIf.empty()) {
+        mreq.ipv6mr_interface = if_nametoindex(localIf.c_str());
+        if (mreq.ipv6mr_interface == 0) {
+            std::cerr << "EOReceiver: IPv6 group needs an interface name, got: " << localIf << std::endl;
+            return false;
+        }
+    }
+    if (verbose && mreq.ipv6mr_interface != 0) {
+        char name[IF_NAMESIZE] = "";
+        if_indextoname(mreq.ipv6mr_interface, name);
+        std::cout << "EOReceiver: Joining " << FormatUdpAddress(group) << " on interface "
+                  << name << std::endl;
+    }
+    if (setsockopt(fd, IPPROTO_IPV6, IPV6_JOIN_GROUP, &mreq, sizeof(mreq)) < 0) {
+        std::cerr << "EOReceiver: join IPv6 multicast failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+EOReceiver::EOReceiver(const std::string& mcastIp, uint16_t port, const std::string& localIf)
+    : mcastIp_(mcastIp), port_(port), localIf_(localIf) {}
+
+EOReceiver::~EOReceiver() { stop(); }
+
+void EOReceiver::setRingSize(size_t slots, EOOverflowPolicy policy) {
+    ringSlots_ = slots < 1 ? 1 : slots;
+    ringPolicy_ = policy;
+}
+
+void EOReceiver::setQueueSize(size_t messages, EOOverflowPolicy policy) {
+    queueSize_ = messages < 1 ? 1 : messages;
+    queuePolicy_ = policy;
+}
+
+void EOReceiver::setWorkerCount(unsigned count) {
+    if (count < 1) count = 1;
+    if (count > kMaxWorkers) count = kMaxWorkers;
+    workerCount_ = count;
+}
+
+// 组播报文会投递给组内每个 SO_REUSEPORT 套接字（内核只对单播做负载均衡），
+// 因此给每个套接字挂一个经典 BPF 过滤器，只保留 hash(源地址, 源端口) % count == index 的报文。
+// 过滤在入队前执行，其余线程的报文不占用本套接字的接收缓冲区。IPv6 取源地址的最后 4 字节。
+static bool attachShardFilter(int fd, unsigned index, unsigned count, int family) {
+    const uint32_t sourceOffset = family == AF_INET6 ? 20 : 12;
+    sock_filter code[] = {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_NET_OFF) + sourceOffset), // 源地址
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 0),                                          // UDP 源端口
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, 2654435761u),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+        BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, count),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, index, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, 0xffffffffu),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+    sock_fprog prog{};
+    prog.len = sizeof(code) / sizeof(code[0]);
+    prog.filter = code;
+    return setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == 0;
+}
+
+int EOReceiver::openSocket(unsigned index) {
+    // 组播 / 单播地址，IPv4 或 IPv6；localIf_ 为网卡名时作为链路本地 IPv6 地址的作用域
+    UdpAddress group;
+    std::string error;
+    in_addr ifAddr{};
+    const bool ifIsIPv4 = !localIf_.empty() && inet_aton(localIf_.c_str(), &ifAddr) != 0;
+    if (!ParseUdpAddress(mcastIp_, port_, ifIsIPv4 ? "" : localIf_, group, error)) {
+        std::cerr << "EOReceiver: " << error << std::endl;
+        return -1;
+    }
+
+    int fd = ::socket(group.family(), SOCK_DGRAM, 0);
+    if (fd < 0) {
+        std::cerr << "EOReceiver: socket create failed: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int reuse = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
+        std::cerr << "EOReceiver: setsockopt SO_REUSEADDR failed: " << strerror(errno) << std::endl;
+    }
+    if (workerCount_ > 1) {
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+            std::cerr << "EOReceiver: setsockopt SO_REUSEPORT failed: " << strerror(errno) << std::endl;
+            ::close(fd);
+            return -1;
+        }
+        // 过滤器须在 bind 之前挂上，否则绑定后、挂载前到达的报文会被多个线程重复处理。
+        // 单播报文由内核按四元组哈希分给其中一个套接字，不需要过滤
+        if (group.multicast() && !attachShardFilter(fd, index, workerCount_, group.family())) {
+            std::cerr << "EOReceiver: attach shard filter failed: " << strerror(errno) << std::endl;
+            ::close(fd);
+            return -1;
+        }
+    }
+
+    if (recvBufferSize_ > 0) {
+        // 优先用 SO_RCVBUFFORCE 越过 net.core.rmem_max（需要 CAP_NET_ADMIN）
+        if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &recvBufferSize_, sizeof(recvBufferSize_)) < 0 &&
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &recvBufferSize_, sizeof(recvBufferSize_)) < 0) {
+            std::cerr << "EOReceiver: setsockopt SO_RCVBUF failed: " << strerror(errno) << std::endl;
+        }
+        int actual = 0;
+        socklen_t len = sizeof(actual);
+        // 内核返回值为设置值的两倍（含簿记开销）
+        if (index == 0 && getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &actual, &len) == 0 && actual / 2 < recvBufferSize_) {
+            std::cerr << "EOReceiver: SO_RCVBUF limited to " << actual / 2
+                      << " bytes, raise net.core.rmem_max" << std::endl;
+        }
+    }
+
+    if (group.family() == AF_INET6) {
+        sockaddr_in6 addr{};
+        addr.sin6_family = AF_INET6;
+        addr.sin6_addr = in6addr_any;
+        addr.sin6_port = htons(port_);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "EOReceiver: bind failed: " << strerror(errno) << std::endl;
+            ::close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port_);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "EOReceiver: bind failed: " << strerror(errno) << std::endl;
+            ::close(fd);
+            return -1;
+        }
+    }
+
+    // 单播地址（发送端 destinations 中的单播目的地）只需绑定端口
+    if (!group.multicast()) {
+        if (index == 0) {
+            std::cout << "EOReceiver: Receiving unicast on port " << port_ << std::endl;
+        }
+    } else if (group.family() == AF_INET6 && !joinGroupV6(fd, group, localIf_, index == 0)) {
+        ::close(fd);
+        return -1;
+    } else if (group.family() == AF_INET && !joinGroupV4(fd, group, localIf_, index == 0)) {
+        ::close(fd);
+        return -1;
+    }
+
+    // 在控制消息中携带内核丢包计数。分片过滤器拒收的报文同样计入该计数，因此仅单套接字时开启
+    int ovfl = 1;
+    if (workerCount_ == 1 && setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &ovfl, sizeof(ovfl)) < 0) {
+        std::cerr << "EOReceiver: setsockopt SO_RXQ_OVFL failed: " << strerror(errno) << std::endl;
+    }
+
+    // 接收超时，使接收线程及时检查停止标志
+    timeval timeout{};
+    timeout.tv_usec = 20 * 1000;
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+        std::cerr << "EOReceiver: setsockopt SO_RCVTIMEO failed: " << strerror(errno) << std::endl;
+    }
+    return fd;
+}
+
+bool EOReceiver::start() {
+    if (running_) return true;
+
+    workers_.clear();
+    for (unsigned i = 0; i < workerCount_; ++i) {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->index = i;
+        worker->ring.reset(new EODatagramRing(ringSlots_, kDatagramSize));
+        worker->decompressor.SetDictionary(compressionDictionary_);
+        worker->sockfd = openSocket(i);
+        if (worker->sockfd < 0) {
+            for (auto& w : workers_) ::close(w->sockfd);
+            workers_.clear();
+            return false;
+        }
+        workers_.push_back(std::move(worker));
+    }
+    queue_.reset(new EOMpscQueue<Parsed>(queueSize_));
+    dispatched_ = 0;
 
     running_ = true;
-    th_ = std::thread(&EOReceiver::recvLoop, this);
+    dispatchThread_ = std::thread(&EOReceiver::dispatchLoop, this);
+    for (auto& worker : workers_) {
+        worker->parseThread = std::thread(&EOReceiver::parseLoop, this, worker.get());
+        worker->recvThread = std::thread(&EOReceiver::recvLoop, this, worker.get());
+    }
     return true;
 }
 
 void EOReceiver::stop() {
     if (!running_) return;
     running_ = false;
-    if (sockfd_ >= 0) {
-        ::shutdown(sockfd_, SHUT_RDWR);
+    for (auto& worker : workers_) {
+        ::shutdown(worker->sockfd, SHUT_RDWR);
     }
-    if (th_.joinable()) th_.join();
-    if (sockfd_ >= 0) {
-        ::close(sockfd_);
-        sockfd_ = -1;
+    for (auto& worker : workers_) {
+        if (worker->recvThread.joinable()) worker->recvThread.join();
+        worker->ringWakeup.Notify();
+        if (worker->parseThread.joinable()) worker->parseThread.join();
+        ::close(worker->sockfd);
+        worker->sockfd = -1;
     }
+    queueWakeup_.Notify();
+    if (dispatchThread_.joinable()) dispatchThread_.join();
+    // 保留 workers_ 中的计数，下次 start() 时重建
 }
 
-void EOReceiver::recvLoop() {
-    constexpr size_t BUF_SIZE = 64 * 1024; // 足够容纳当前 JSON 报文
-    std::vector<uint8_t> buf(BUF_SIZE);
+void EOReceiver::recvLoop(Worker* worker) {
+    constexpr unsigned BATCH = 32; // 每次 recvmmsg 最多收取的报文数
+    mmsghdr msgs[BATCH];
+    iovec iovs[BATCH];
+    sockaddr_storage froms[BATCH];
+    alignas(cmsghdr) char controls[BATCH][CMSG_SPACE(sizeof(uint32_t))];
+    std::vector<uint8_t> discard; // DROP 策略下报文环已满时的临时缓冲区
+    EODatagramRing& ring = *worker->ring;
 
     while (running_) {
-        ssize_t n = ::recv(sockfd_, buf.data(), buf.size(), 0);
+        size_t count = ring.Writable();
+        if (count == 0) {
+            if (ringPolicy_ == EOOverflowPolicy::BLOCK) {
+                // 暂停收包，由套接字接收缓冲区继续缓冲，满后由内核丢弃
+                worker->ringWaits.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                continue;
+            }
+            // 仍然收取并丢弃，排队时延不超过报文环深度
+            discard.resize(kDatagramSize);
+            ssize_t n = ::recv(worker->sockfd, discard.data(), discard.size(), 0);
+            if (n >= 0) {
+                worker->datagrams.fetch_add(1, std::memory_order_relaxed);
+                worker->ringDrops.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        if (count > BATCH) count = BATCH;
+
+        for (size_t i = 0; i < count; ++i) {
+            iovs[i].iov_base = ring.WriteSlot(i).data;
+            iovs[i].iov_len = ring.slot_size();
+            memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &froms[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(froms[i]);
+            msgs[i].msg_hdr.msg_control = controls[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+        }
+        // 阻塞等待第一个报文（受 SO_RCVTIMEO 限制），随后取走已排队的报文，直接写入报文环
+        int n = ::recvmmsg(worker->sockfd, msgs, static_cast<unsigned>(count), MSG_WAITFORONE, nullptr);
         if (n <= 0) {
             if (!running_) break;
-            if (n < 0 && (errno == EINTR)) continue;
+            if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
             if (n < 0) {
                 std::cerr << "EOReceiver: recv error: " << strerror(errno) << std::endl;
             }
             continue;
         }
 
-        MessageHeader header{};
-        std::vector<EOTargetInfo> targets;
-        if (EOProtocolParser::ParseEOTargetMessage(buf.data(), static_cast<size_t>(n), header, targets)) {
-            if (callback_) {
-                callback_(header, targets);
-            } else {
-                std::cout << "Received EO Target Message: msg_sn=" << header.msg_sn 
-                          << " cont_sum=" << header.cont_sum 
-                          << " targets=" << targets.size() << std::endl;
-                for (const auto& t : targets) {
-                    std::cout << "  source_id=" << t.source_id
-                              << " tar_id=" << t.tar_id
-                              << " tar_category=" << t.tar_category
-                              << " tar_iden=" << t.tar_iden
-                              << " tar_cfid=" << t.tar_cfid
-                              << " offset_h=" << t.offset_h << " offset_v=" << t.offset_v
-                              << " tar_rect=" << t.tar_rect << std::endl;
+        for (int i = 0; i < n; ++i) {
+            // SO_RXQ_OVFL：套接字自创建以来因接收缓冲区满被内核丢弃的报文数
+            for (cmsghdr* c = CMSG_FIRSTHDR(&msgs[i].msg_hdr); c != nullptr; c = CMSG_NXTHDR(&msgs[i].msg_hdr, c)) {
+                if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL) {
+                    uint32_t drops = 0;
+                    memcpy(&drops, CMSG_DATA(c), sizeof(drops));
+                    worker->kernelDrops.store(drops, std::memory_order_relaxed);
                 }
             }
+            EODatagramRing::Slot& slot = ring.WriteSlot(i);
+            slot.length = msgs[i].msg_len;
+            // 按发送端地址与端口区分不同发送端的同号报文
+            slot.sender = UdpSenderKey(reinterpret_cast<const sockaddr*>(&froms[i]));
+        }
+        ring.Commit(n);
+        worker->datagrams.fetch_add(n, std::memory_order_relaxed);
+        worker->ringWakeup.Notify();
+    }
+}
+
+void EOReceiver::parseLoop(Worker* worker) {
+    EODatagramRing& ring = *worker->ring;
+    worker->output = [this, worker](const MessageHeader& h, const std::vector<EOTargetInfo>& t, bool complete) {
+        if (!t.empty() && t[0].source_id >= 0) {
+            recordSequence(static_cast<uint32_t>(t[0].source_id), h);
+        }
+        worker->deltaDecoder.OnKeyframe(h, t, complete);
+        enqueue(worker, h, t, complete);
+    };
+    auto nowNs = []() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+
+    while (running_) {
+        size_t count = ring.Readable();
+        if (count == 0) {
+            // 空闲时也定期检查分片是否超时
+            worker->ringWakeup.WaitFor([&ring, this]() { return ring.Readable() > 0 || !running_; },
+                                       std::chrono::milliseconds(20));
+            expire(worker, nowNs());
+            continue;
+        }
+
+        int64_t now = nowNs();
+        for (size_t i = 0; i < count; ++i) {
+            const EODatagramRing::Slot& slot = ring.ReadSlot(i);
+            if (slot.length > 0) {
+                handleDatagram(worker, slot.data, slot.length, slot.sender, now);
+            }
+        }
+        ring.Release(count);
+        expire(worker, now);
+    }
+}
+
+void EOReceiver::dispatchLoop() {
+    Parsed message;
+    while (running_) {
+        if (!queue_->TryPop(message)) {
+            queueWakeup_.WaitFor([this]() { return !queue_->Empty() || !running_; },
+                                 std::chrono::milliseconds(20));
+            continue;
+        }
+        deliver(message.header, message.targets, message.complete);
+        dispatched_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void EOReceiver::enqueue(Worker* worker, const MessageHeader& header, const std::vector<EOTargetInfo>& targets, bool complete) {
+    Parsed& spare = worker->spare;
+    spare.header = header;
+    spare.targets = targets; // 复用上一轮换回的容量
+    spare.complete = complete;
+    while (!queue_->TryPush(spare)) {
+        if (queuePolicy_ == EOOverflowPolicy::DROP || !running_) {
+            worker->queueDrops.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        worker->queueWaits.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    queueWakeup_.Notify();
+}
+
+void EOReceiver::expire(Worker* worker, int64_t nowNs) {
+    worker->reassembler.Expire(nowNs, worker->output);
+    worker->fec.Expire(nowNs);
+    worker->fecUnrecoverable.store(worker->fec.unrecoverable(), std::memory_order_relaxed);
+}
+
+void EOReceiver::handleDatagram(Worker* worker, const uint8_t* data, size_t length, uint64_t sender, int64_t nowNs) {
+    if (EOProtocolParser::IsFecMessage(data, length)) {
+        bool ok = worker->fec.OnParity(sender, data, length, nowNs,
+                                       [this, worker, sender, nowNs](const uint8_t* recovered, size_t size) {
+                                           handlePayload(worker, recovered, size, sender, nowNs);
+                                       });
+        if (!ok) {
+            worker->parseErrors.fetch_add(1, std::memory_order_relaxed);
+        }
+        worker->fecRecovered.store(worker->fec.recovered(), std::memory_order_relaxed);
+        worker->fecUnrecoverable.store(worker->fec.unrecoverable(), std::memory_order_relaxed);
+        return;
+    }
+    // 已由校验报文恢复过的报文迟到时丢弃，避免重复回调
+    if (worker->fec.OnData(sender, data, length)) {
+        handlePayload(worker, data, length, sender, nowNs);
+    }
+}
+
+void EOReceiver::handlePayload(Worker* worker, const uint8_t* data, size_t length, uint64_t sender, int64_t nowNs) {
+    if (IsEOCompressedMessage(data, length)) {
+        const size_t original = worker->decompressor.Decompress(data, length);
+        if (original == 0) {
+            worker->parseErrors.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "EOReceiver: decompress failed (size=" << length << "): "
+                      << worker->decompressor.error() << std::endl;
+            return;
+        }
+        data = worker->decompressor.output();
+        length = original;
+    }
+    MessageHeader& header = worker->header;
+    std::vector<EOTargetInfo>& targets = worker->targets;
+    if (EOProtocolParser::IsHeartbeatMessage(data, length)) {
+        // 空闲心跳只更新统计：视频源在线但没有目标，不交给回调
+        int64_t sendUs = 0;
+        if (EOProtocolParser::ParseEOHeartbeatMessage(data, length, worker->heartbeats, sendUs)) {
+            recordHeartbeats(worker->heartbeats);
         } else {
-            std::cerr << "EOReceiver: parse failed (size=" << n << ")" << std::endl;
+            worker->parseErrors.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else if (EOProtocolParser::IsDeltaMessage(data, length)) {
+        // 差分帧：先按帧头统计序号，丢包后无法还原的帧被丢弃，等待下一个关键帧
+        uint32_t sourceId = 0;
+        uint16_t baseSn = 0;
+        if (EOProtocolParser::ReadEOTargetDeltaInfo(data, length, header, sourceId, baseSn)) {
+            recordSequence(sourceId, header);
         }
+        if (worker->deltaDecoder.Decode(data, length, header, targets)) {
+            enqueue(worker, header, targets, true);
+        }
+    } else if (EOProtocolParser::ParseEOTargetMessage(data, length, header, targets)) {
+        worker->reassembler.Push(sender, header, targets, nowNs, worker->output);
+    } else {
+        worker->parseErrors.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "EOReceiver: parse failed (size=" << length << ")" << std::endl;
+    }
+}
+
+void EOReceiver::recordSequence(uint32_t sourceId, const MessageHeader& header) {
+    if (header.src_sn == 0) return;
+    int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    if (header.src_cnt > 0) {
+        batchTracker_.Record(0, header.src_sn, header.send_us, nowUs);
+    } else {
+        tracker_.Record(sourceId, header.src_sn, header.send_us, nowUs);
+    }
+}
+
+void EOReceiver::recordHeartbeats(const std::vector<EOHeartbeat>& heartbeats) {
+    int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    for (const EOHeartbeat& heartbeat : heartbeats) {
+        tracker_.RecordHeartbeat(heartbeat.source_id, heartbeat.src_sn, nowUs);
+    }
+}
+
+std::vector<EOSourceStats> EOReceiver::stats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return tracker_.Snapshot();
+}
+
+std::vector<EOSourceStats> EOReceiver::batchStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return batchTracker_.Snapshot();
+}
+
+EOReceiver::PipelineStats EOReceiver::pipelineStats() const {
+    PipelineStats s;
+    for (const auto& worker : workers_) {
+        s.datagrams += worker->datagrams.load(std::memory_order_relaxed);
+        s.kernelDrops += worker->kernelDrops.load(std::memory_order_relaxed);
+        s.ringDrops += worker->ringDrops.load(std::memory_order_relaxed);
+        s.ringWaits += worker->ringWaits.load(std::memory_order_relaxed);
+        s.parseErrors += worker->parseErrors.load(std::memory_order_relaxed);
+        s.queueDrops += worker->queueDrops.load(std::memory_order_relaxed);
+        s.queueWaits += worker->queueWaits.load(std::memory_order_relaxed);
+        s.fecRecovered += worker->fecRecovered.load(std::memory_order_relaxed);
+        s.fecUnrecoverable += worker->fecUnrecoverable.load(std::memory_order_relaxed);
+    }
+    s.dispatched = dispatched_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void EOReceiver::deliver(const MessageHeader& header, const std::vector<EOTargetInfo>& targets, bool complete) {
+    if (!complete) {
+        std::cerr << "EOReceiver: msg_sn=" << header.msg_sn << " incomplete, "
+                  << "delivering " << targets.size() << " targets of "
+                  << header.frag_cnt << " fragments" << std::endl;
+    }
+    if (callback_) {
+        callback_(header, targets);
+        return;
+    }
+    std::cout << "Received EO Target Message: msg_sn=" << header.msg_sn
+              << " cont_sum=" << header.cont_sum
+              << " targets=" << targets.size() << std::endl;
+    for (const auto& t : targets) {
+        std::cout << "  source_id=" << t.source_id
+                  << " tar_id=" << t.tar_id
+                  << " tar_category=" << t.tar_category
+                  << " tar_iden=" << t.tar_iden
+                  << " tar_cfid=" << t.tar_cfid
+                  << " offset_h=" << t.offset_h << " offset_v=" << t.offset_v
+                  << " tar_rect=" << t.tar_rect << std::endl;
     }
 }
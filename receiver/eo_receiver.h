@@ -7,37 +7,161 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 // 头文件位于上级目录，CMake 中通过 target_include_directories 添加当前列表目录即可找到
 #include "eo_protocol_parser.h"
+#include "eo_fragment_reassembler.h"
+#include "eo_delta_codec.h"
+#include "eo_sequence_stats.h"
+#include "eo_handoff_queue.h"
+#include "eo_fec.h"
+#include "eo_compression.h"
 
-// 简单的 UDP 组播接收器, 接收 EO 多目标报文并解析打印
+// UDP 组播接收器, 接收 EO 多目标报文并解析打印。
+// 流水线：接收线程 -> 报文环 -> 解析线程 -> 多生产者队列 -> 分发线程（回调）。
+// 可开启多个分片，每个分片一个 SO_REUSEPORT 套接字（recvmmsg 批量收包直接写入报文环）
+// 和一个解析线程；内核按发送端地址分片，同一发送端（及其全部视频源）的报文固定由
+// 同一分片处理。回调只在分发线程中串行调用，慢回调不会阻塞收包。
 class EOReceiver {
 public:
     using TargetCallback = std::function<void(const MessageHeader&, const std::vector<EOTargetInfo>&)>;
 
+    // 各级计数，自 start() 起累计
+    struct PipelineStats {
+        uint64_t datagrams = 0;   // 收到的 UDP 报文
+        uint64_t kernelDrops = 0; // 套接字接收缓冲区满被内核丢弃的报文（SO_RXQ_OVFL，仅单分片时统计）
+        uint64_t ringDrops = 0;   // 报文环已满被丢弃的报文（DROP）
+        uint64_t ringWaits = 0;   // 报文环已满时接收线程的等待次数（BLOCK）
+        uint64_t parseErrors = 0; // 解析失败的报文
+        uint64_t queueDrops = 0;  // 分发队列已满被丢弃的消息（DROP）
+        uint64_t queueWaits = 0;  // 分发队列已满时解析线程的等待次数（BLOCK）
+        uint64_t dispatched = 0;  // 已回调的消息
+        uint64_t fecRecovered = 0;     // 由 FEC 校验报文恢复的报文
+        uint64_t fecUnrecoverable = 0; // 丢失且 FEC 无法恢复的报文（仅统计发送了校验报文的发送端）
+    };
+
+    // mcastIp 为 IPv4 或 IPv6 地址，组播时加入该组（IPv6 可带 "%网卡" 作用域），单播时只绑定端口；
+    // localIf 为网卡名或本机 IPv4 地址（IPv6 组播只接受网卡名）
     EOReceiver(const std::string& mcastIp, uint16_t port, const std::string& localIf = "");
     ~EOReceiver();
 
-    // 启动接收线程
+    // 以下设置在 start() 前调用
+    // 分片数（接收线程与解析线程各一个，1~kMaxWorkers）
+    void setWorkerCount(unsigned count);
+    // 每个套接字的 SO_RCVBUF 字节数，0 表示使用系统默认值
+    void setRecvBufferSize(int bytes) { recvBufferSize_ = bytes; }
+    // 每个分片报文环的槽位数（每槽 64 KB）与报文环满时的处理方式。
+    // BLOCK（默认）暂停收包，由套接字接收缓冲区继续缓冲；DROP 继续收包并丢弃，排队时延不超过报文环深度
+    void setRingSize(size_t slots, EOOverflowPolicy policy);
+    // 分发队列容量（消息数）与队列满时的处理方式
+    void setQueueSize(size_t messages, EOOverflowPolicy policy);
+    // 压缩报文的共享字典，须与发送端 compression-dictionary 相同；不设置时只能解压不带字典的报文
+    void setCompressionDictionary(const std::vector<uint8_t>& dictionary) { compressionDictionary_ = dictionary; }
+
+    // 启动接收、解析、分发线程
     bool start();
-    // 停止接收线程
+    // 停止全部线程，未分发的消息被丢弃
     void stop();
 
+    // 回调在分发线程中串行调用，同一发送端的报文按到达顺序回调
     void setCallback(TargetCallback cb) { callback_ = std::move(cb); }
 
+    // 按视频源的丢包、乱序、时延统计快照（可在任意线程调用）
+    std::vector<EOSourceStats> stats() const;
+    // 聚合报文（src_cnt > 0）按批次序号的统计，source_id 恒为 0；未收到聚合报文时为空
+    std::vector<EOSourceStats> batchStats() const;
+    // 流水线各级计数（start() 之后可在任意线程调用）
+    PipelineStats pipelineStats() const;
+
+    static constexpr unsigned kMaxWorkers = 64;
+
 private:
-    void recvLoop();
+    static constexpr size_t kDatagramSize = 64 * 1024; // UDP 报文上限
+
+    // 解析线程交给分发线程的消息
+    struct Parsed {
+        MessageHeader header{};
+        std::vector<EOTargetInfo> targets;
+        bool complete{};
+    };
+
+    // 单个分片：接收线程写报文环，解析线程读报文环；分片重组与差分帧参考按发送端分属各分片
+    struct Worker {
+        unsigned index{};
+        int sockfd{-1};
+        std::thread recvThread;
+        std::thread parseThread;
+        std::unique_ptr<EODatagramRing> ring;
+        EOWakeup ringWakeup;
+
+        // 以下仅在解析线程中访问
+        EOFragmentReassembler reassembler;
+        EODeltaDecoder deltaDecoder;
+        EOFecDecoder fec;
+        EODecompressor decompressor;
+        EOFragmentReassembler::Output output;
+        MessageHeader header{};
+        std::vector<EOTargetInfo> targets;
+        std::vector<EOHeartbeat> heartbeats;
+        Parsed spare; // 与队列交换的消息，复用 targets 容量
+
+        std::atomic<uint64_t> datagrams{0};
+        std::atomic<uint64_t> kernelDrops{0};
+        std::atomic<uint64_t> ringDrops{0};
+        std::atomic<uint64_t> ringWaits{0};
+        std::atomic<uint64_t> parseErrors{0};
+        std::atomic<uint64_t> queueDrops{0};
+        std::atomic<uint64_t> queueWaits{0};
+        std::atomic<uint64_t> fecRecovered{0};
+        std::atomic<uint64_t> fecUnrecoverable{0};
+    };
+
+    int openSocket(unsigned index);
+    void recvLoop(Worker* worker);
+    void parseLoop(Worker* worker);
+    void dispatchLoop();
+    // sender 为发送端地址与端口，用于区分不同发送端的同号分片。
+    // FEC 校验报文在此处理，恢复出的报文与收到的报文一样交给 handlePayload()。
+    // 发送端先压缩再计算校验，压缩报文在 handlePayload() 中解压
+    void handleDatagram(Worker* worker, const uint8_t* data, size_t length, uint64_t sender, int64_t nowNs);
+    void handlePayload(Worker* worker, const uint8_t* data, size_t length, uint64_t sender, int64_t nowNs);
+    // 分片重组与 FEC 分组超时处理
+    void expire(Worker* worker, int64_t nowNs);
+    // 解析线程：把一条完整（或超时后部分重组）的报文放入分发队列
+    void enqueue(Worker* worker, const MessageHeader& header, const std::vector<EOTargetInfo>& targets, bool complete);
+    // 分发线程：回调或打印一条报文
+    void deliver(const MessageHeader& header, const std::vector<EOTargetInfo>& targets, bool complete);
+    // 记录报文的 src_sn 与发送时刻，src_sn 为 0（旧版发送端）时忽略
+    // 聚合报文的 src_sn 是批次序号，单独统计
+    void recordSequence(uint32_t sourceId, const MessageHeader& header);
+    void recordHeartbeats(const std::vector<EOHeartbeat>& heartbeats);
 
     std::string mcastIp_;
     uint16_t port_{};
     std::string localIf_;
 
-    int sockfd_{-1};
-    std::thread th_;
+    unsigned workerCount_{1};
+    int recvBufferSize_{0};
+    size_t ringSlots_{64};
+    EOOverflowPolicy ringPolicy_{EOOverflowPolicy::BLOCK};
+    size_t queueSize_{1024};
+    EOOverflowPolicy queuePolicy_{EOOverflowPolicy::BLOCK};
+    std::vector<uint8_t> compressionDictionary_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
     std::atomic<bool> running_{false};
 
+    std::unique_ptr<EOMpscQueue<Parsed>> queue_;
+    EOWakeup queueWakeup_;
+    std::thread dispatchThread_;
+    std::atomic<uint64_t> dispatched_{0};
     TargetCallback callback_;
+
+    mutable std::mutex statsMutex_;
+    EOSequenceTracker tracker_;         // 受 statsMutex_ 保护
+    EOSequenceTracker batchTracker_;    // 聚合报文的批次序号，受 statsMutex_ 保护
 };
 
 #endif // EO_RECEIVER_H
@@ -11,6 +11,65 @@ static std::atomic<bool> g_stop{false};
 
 static void handleSig(int){ g_stop = true; }
 
+// 打印流水线各级计数，以及每个视频源的丢包、乱序与单向时延统计。
+// since_seen_ms 为距最近一次报文或心跳的时间，持续增长说明视频源已失效。
+// 发送端开启 aggregate 时目标报文按批次统计，视频源统计只含心跳
+static void printStats(const EOReceiver& receiver) {
+    int64_t nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+    EOReceiver::PipelineStats p = receiver.pipelineStats();
+    std::vector<EOSourceStats> stats = receiver.stats();
+    std::vector<EOSourceStats> batches = receiver.batchStats();
+    if (p.datagrams == 0) return;
+    std::cout << "---- Pipeline Stats ----" << std::endl;
+    std::cout << "datagrams=" << p.datagrams
+              << " kernel_drops=" << p.kernelDrops
+              << " ring_drops=" << p.ringDrops << " ring_waits=" << p.ringWaits
+              << " parse_errors=" << p.parseErrors
+              << " queue_drops=" << p.queueDrops << " queue_waits=" << p.queueWaits
+              << " dispatched=" << p.dispatched << std::endl;
+    if (p.fecRecovered > 0 || p.fecUnrecoverable > 0) {
+        std::cout << "fec_recovered=" << p.fecRecovered
+                  << " fec_unrecoverable=" << p.fecUnrecoverable << std::endl;
+    }
+    for (const auto& b : batches) {
+        uint64_t expected = b.received + b.lost;
+        std::cout << "---- Batch Stats ----" << std::endl;
+        std::cout << "batches=" << b.received << " lost=" << b.lost
+                  << " loss=" << (expected ? 100.0 * b.lost / expected : 0.0) << "%"
+                  << " reordered=" << b.reordered << " restarts=" << b.restarts;
+        if (b.latency_us.count() > 0) {
+            std::cout << " latency_us p50=" << b.latency_us.Percentile(50)
+                      << " p99=" << b.latency_us.Percentile(99)
+                      << " max=" << b.latency_us.max();
+        }
+        std::cout << std::endl;
+    }
+    if (stats.empty()) return;
+    std::cout << "---- Source Stats ----" << std::endl;
+    for (const auto& s : stats) {
+        uint64_t expected = s.received + s.lost;
+        double lossPct = expected ? 100.0 * s.lost / expected : 0.0;
+        std::cout << "source_id=" << s.source_id
+                  << " received=" << s.received
+                  << " lost=" << s.lost << " (" << lossPct << "%)"
+                  << " reordered=" << s.reordered
+                  << " duplicates=" << s.duplicates
+                  << " restarts=" << s.restarts
+                  << " heartbeats=" << s.heartbeats
+                  << " since_seen_ms=" << (nowUs - s.last_seen_us) / 1000;
+        if (s.latency_us.count() > 0) {
+            std::cout << " latency_us p50=" << s.latency_us.Percentile(50)
+                      << " p99=" << s.latency_us.Percentile(99)
+                      << " max=" << s.latency_us.max();
+        }
+        if (s.clock_skew > 0) {
+            std::cout << " clock_skew=" << s.clock_skew;
+        }
+        std::cout << std::endl;
+    }
+}
+
 int main(int argc, char** argv) {
     std::string ip = "230.1.8.31";
     uint16_t port = 8128;
@@ -18,7 +77,19 @@ int main(int argc, char** argv) {
     
     if (argc > 1) ip = argv[1];
     if (argc > 2) port = static_cast<uint16_t>(std::stoi(argv[2]));
-    if (argc > 3) bind_if = argv[3];  // 第三个参数可以是网卡名称(如eno2)或IP地址
+    unsigned workers = 1;     // 接收线程数
+    int rcvbuf = 0;           // 每个套接字的 SO_RCVBUF 字节数，0 为系统默认
+    if (argc > 3) bind_if = argv[3];  // 第三个参数可以是网卡名称(如eno2)或IP地址，IPv6 组播须为网卡名称
+    if (argc > 4) workers = static_cast<unsigned>(std::stoul(argv[4]));
+    if (argc > 5) rcvbuf = std::stoi(argv[5]);
+    std::vector<uint8_t> dictionary;  // 压缩字典文件，与发送端 compression-dictionary 相同
+    if (argc > 6) {
+        std::string error;
+        if (!EOLoadDictionaryFile(argv[6], dictionary, error)) {
+            std::cerr << "Failed to load compression dictionary: " << error << std::endl;
+            return 1;
+        }
+    }
 
     std::cout << "EO Receiver listen multicast " << ip << ":" << port;
     if (!bind_if.empty()) {
@@ -27,6 +98,9 @@ int main(int argc, char** argv) {
     std::cout << std::endl;
 
     EOReceiver receiver(ip, port, bind_if);
+    receiver.setWorkerCount(workers);
+    receiver.setRecvBufferSize(rcvbuf);
+    receiver.setCompressionDictionary(dictionary);
     receiver.setCallback([](const MessageHeader& header, const std::vector<EOTargetInfo>& targets){
         using Clock = std::chrono::steady_clock;
         static std::map<int, Clock::time_point> last_seen_by_source;
@@ -36,6 +110,7 @@ int main(int argc, char** argv) {
         std::cout << "---- Parsed Message ----" << std::endl;
         std::cout << "msg_id=0x" << std::hex << header.msg_id << std::dec 
                   << " msg_sn=" << header.msg_sn
+                  << " src_sn=" << header.src_sn
                   << " cont_sum=" << header.cont_sum 
                   << " Targets=" << targets.size() << std::endl;
         for (const auto& t : targets) {
@@ -83,11 +158,18 @@ int main(int argc, char** argv) {
     std::signal(SIGINT, handleSig);
     std::signal(SIGTERM, handleSig);
 
+    auto lastStats = std::chrono::steady_clock::now();
     while (!g_stop.load()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastStats >= std::chrono::seconds(5)) {
+            lastStats = now;
+            printStats(receiver);
+        }
     }
 
     receiver.stop();
+    printStats(receiver);
     std::cout << "Receiver stopped" << std::endl;
     return 0;
 }
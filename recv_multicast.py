@@ -1,10 +1,12 @@
 #!/usr/bin/env python3
 import argparse
+import ipaddress
 import json
 import socket
 import struct
 import sys
 import time
+import zlib
 from datetime import datetime
 
 # 兼容旧版二进制报文的结构体布局。
@@ -12,6 +14,68 @@ from datetime import datetime
 STRUCT_FMT = '<ffffiQfQIii f'.replace(' ', '')
 STRUCT_SIZE = struct.calcsize(STRUCT_FMT)
 
+# 二进制 EO 报文（BodyType::BINARY，插件 format=binary）的帧格式，全部小端序。
+BINARY_SYNC = b'\xeb\x90'
+BINARY_TAIL = b'\xaa\x55'
+BINARY_VERSION = 1
+BINARY_FRAGMENT_VERSION = 2  # 分片报文：报文头后追加 frag_idx、frag_cnt（各 2 字节）
+BINARY_FRAGMENT_FMT = '<HH'
+BINARY_SEQUENCE_VERSION = 3  # 报文头后追加 src_sn(4)、send_us(8)、frag_idx(2)、frag_cnt(2)
+BINARY_SEQUENCE_FMT = '<IqHH'
+BINARY_BATCH_VERSION = 4  # 聚合报文：版本 3 的字段后追加 src_cnt(2)、保留(2)
+BINARY_BATCH_FMT = '<IqHHHxx'
+BINARY_VERSIONS = (BINARY_VERSION, BINARY_FRAGMENT_VERSION, BINARY_SEQUENCE_VERSION,
+                   BINARY_BATCH_VERSION)
+BINARY_PREAMBLE_FMT = '<2sBBI'
+BINARY_HEADER_FMT = '<11iH5BxfHH'
+BINARY_TARGET_FIXED_FMT = '<HHH5Bxf10ifB'
+BINARY_DOUBLE_FIELDS = (
+    'fov_angle', 'lon', 'lat', 'alt', 'tar_a', 'tar_e',
+    'tar_rng', 'tar_av', 'tar_ev', 'tar_rv', 'fov_h', 'fov_v',
+)
+BINARY_HEADER_FIELDS = (
+    'msg_id', 'msg_sn', 'msg_type', 'tx_sys_id', 'tx_dev_type', 'tx_dev_id',
+    'tx_subdev_id', 'rx_sys_id', 'rx_dev_type', 'rx_dev_id', 'rx_subdev_id',
+    'yr', 'mo', 'dy', 'h', 'min', 'sec', 'msec', 'cont_type', 'cont_sum',
+)
+
+# 差分帧（BodyType::DELTA，插件 format=delta）：报文头后为 source_id、base_sn，
+# 每个目标以变长字段掩码开头，只携带与参考目标不同的字段。
+BODY_TYPE_BINARY = 1
+BODY_TYPE_DELTA = 2
+BODY_TYPE_HEARTBEAT = 3
+BINARY_HEARTBEAT_FMT = '<qH'  # send_us(8)、视频源个数(2)，其后为 (source_id, src_sn) x 个数
+BINARY_HEARTBEAT_ENTRY_FMT = '<II'
+# FEC 校验报文（插件 fec-group-size > 0）：本脚本不做恢复，只打印分组信息。
+BODY_TYPE_FEC = 4
+FEC_INFO_FMT = '<IBBBBHxx'  # group_sn、k、m、parity_idx、scheme、symbol_size、保留
+FEC_ENTRY_SIZE = 6          # 每个数据报文的 length(2) + hash(4)
+# 压缩报文（插件 compression != none）：12 字节报文头后为整个原报文的压缩数据。
+COMPRESSED_MAGIC = b'\xec\x5a'
+COMPRESSED_VERSION = 1
+COMPRESSED_HEADER_FMT = '<2sBBIHxx'  # 魔数、版本、压缩方式、字典 ID、原报文长度、保留
+COMPRESSION_LZ4 = 1
+COMPRESSION_DEFLATE = 2
+MAX_DICTIONARY_SIZE = 32 * 1024
+DELTA_INFO_FMT = '<IH'
+DELTA_TIME_FIELDS = ('sec', 'min', 'h', 'dy', 'mo', 'yr', 'msec')  # 参考本报文前一个目标
+# 整型字段的掩码位，按编码顺序排列。
+DELTA_INT_FIELDS = (
+    (1, 'sec'), (2, 'tar_rect'), (4, 'trk_stat'), (5, 'tar_category'),
+    (7, 'min'), (8, 'h'), (9, 'dy'), (10, 'mo'), (11, 'yr'),
+    (12, 'offset_h'), (13, 'offset_v'), (14, 'source_id'), (15, 'tar_id'),
+    (16, 'guid_id'), (17, 'dev_id'), (18, 'trk_mod'),
+)
+DELTA_MSEC_BIT = 0
+DELTA_CFID_BIT = 3
+DELTA_IDEN_BIT = 6
+DELTA_DOUBLE_BIT = 19
+DELTA_TARGET_FIELDS = (
+    'yr', 'mo', 'dy', 'h', 'min', 'sec', 'msec', 'dev_id', 'guid_id', 'tar_id',
+    'trk_stat', 'trk_mod', 'tar_category', 'offset_h', 'offset_v', 'tar_rect',
+    'source_id', 'tar_cfid', 'tar_iden',
+) + BINARY_DOUBLE_FIELDS
+
 # 当前 app_config.yml 中 sink2 的默认组播参数。
 DEFAULT_GROUP = '230.1.8.31'
 DEFAULT_PORT = 8128
@@ -30,7 +94,7 @@ def parse_args():
     parser.add_argument(
         '--group',
         default=DEFAULT_GROUP,
-        help='组播地址，默认与 app_config.yml 的 sink2.ip 保持一致。',
+        help='组播地址（IPv4 或 IPv6，也可为本机单播地址），默认与 app_config.yml 的 sink2.ip 保持一致。',
     )
     parser.add_argument(
         '--port',
@@ -41,7 +105,7 @@ def parse_args():
     parser.add_argument(
         '--iface',
         default=DEFAULT_IFACE,
-        help='本机接收网卡名或 IPv4 地址，默认与 app_config.yml 的 sink2.multicast-iface 保持一致。',
+        help='本机接收网卡名或 IPv4 地址（IPv6 组播须为网卡名），默认与 app_config.yml 的 sink2.multicast-iface 保持一致。',
     )
     parser.add_argument(
         '--buffer-size',
@@ -54,6 +118,14 @@ def parse_args():
         action='store_true',
         help='强制按旧的二进制结构体格式解析，便于兼容历史报文。',
     )
+    parser.add_argument(
+        '--dictionary',
+        help='压缩字典文件，须与插件 compression-dictionary 相同；不指定时只能解压不带字典的报文。',
+    )
+    parser.add_argument(
+        '--capture',
+        help='把收到的报文（解压后，不含 FEC 校验报文）写入抓包文件，供 eo_dict_train 训练字典。',
+    )
     parser.add_argument(
         '--hex',
         action='store_true',
@@ -101,6 +173,24 @@ def resolve_iface_ip(iface: str) -> str:
         query_sock.close()
 
 
+def join_multicast_v6(sock: socket.socket, group: str, iface: str):
+    """让 IPv6 套接字加入组播组（MLD）。
+
+    Args:
+        sock: 已绑定端口的 AF_INET6 UDP 套接字。
+        group: IPv6 组播地址，可带作用域后缀（如 `ff02::1%eth0`）。
+        iface: 本机网卡名；`0.0.0.0` 或空表示由系统选择网卡。
+    """
+    address, _, zone = group.partition('%')
+    index = 0  # 接收网卡索引，0 表示由系统选择。
+    if zone:
+        index = int(zone) if zone.isdigit() else socket.if_nametoindex(zone)
+    elif iface and iface != '0.0.0.0':
+        index = socket.if_nametoindex(iface)
+    membership = socket.inet_pton(socket.AF_INET6, address) + struct.pack('@I', index)
+    sock.setsockopt(socket.IPPROTO_IPV6, socket.IPV6_JOIN_GROUP, membership)
+
+
 def join_multicast(sock: socket.socket, group: str, iface_ip: str):
     """让套接字加入指定组播组。
 
@@ -146,6 +236,384 @@ def decode_json_packet(data: bytes):
     return payload
 
 
+def calculate_checksum(data: bytes) -> int:
+    """计算与 EOProtocolParser::CalculateChecksum 一致的 16 位反码和。
+
+    Args:
+        data: 参与校验的字节流。
+
+    Returns:
+        int: 16 位校验和。
+    """
+    total = 0
+    for index in range(0, len(data) - 1, 2):
+        total += (data[index] << 8) | data[index + 1]
+    if len(data) % 2:
+        total += data[-1] << 8
+    while total >> 16:
+        total = (total & 0xFFFF) + (total >> 16)
+    return ~total & 0xFFFF
+
+
+def is_binary_packet(data: bytes) -> bool:
+    """判断负载是否为二进制 EO 报文。"""
+    return data[:2] == BINARY_SYNC
+
+
+def check_binary_frame(data: bytes, body_types, versions, body_size=None):
+    """校验二进制帧的帧头、帧长、校验和与帧尾。
+
+    Args:
+        body_size: 帧头之后固定部分的最小字节数，默认为目标报文头大小。
+
+    Returns:
+        tuple: (版本, 报文类型, 校验和偏移)。
+
+    Raises:
+        ValueError: 帧不合法时抛出。
+    """
+    preamble_size = struct.calcsize(BINARY_PREAMBLE_FMT)
+    if len(data) < preamble_size:
+        raise ValueError(f'Binary packet too small ({len(data)} bytes)')
+
+    sync, version, body_type, frame_length = struct.unpack_from(BINARY_PREAMBLE_FMT, data)
+    if sync != BINARY_SYNC or version not in versions or body_type not in body_types:
+        raise ValueError(f'Unsupported binary frame: version={version} body_type={body_type}')
+    if body_size is None:
+        body_size = struct.calcsize(BINARY_HEADER_FMT)
+    if frame_length > len(data) or frame_length < preamble_size + body_size + 4:
+        raise ValueError(f'Invalid frame length {frame_length} for {len(data)} bytes')
+    if data[frame_length - 2:frame_length] != BINARY_TAIL:
+        raise ValueError('Frame tail mismatch')
+    checksum_offset = frame_length - 4
+    (checksum,) = struct.unpack_from('<H', data, checksum_offset)
+    if checksum != calculate_checksum(data[:checksum_offset]):
+        raise ValueError('Checksum mismatch')
+    return version, body_type, checksum_offset
+
+
+def read_binary_extension(data: bytes, version: int, offset: int, payload: dict) -> int:
+    """读取报文头后的扩展字段（版本 2 的分片字段、版本 3 的序号与发送时刻、版本 4 的视频源个数）。
+
+    Returns:
+        int: 扩展字段之后的偏移。
+    """
+    if version == BINARY_FRAGMENT_VERSION:
+        payload['frag_idx'], payload['frag_cnt'] = struct.unpack_from(BINARY_FRAGMENT_FMT, data, offset)
+        return offset + struct.calcsize(BINARY_FRAGMENT_FMT)
+    if version == BINARY_SEQUENCE_VERSION:
+        (payload['src_sn'], payload['send_us'],
+         payload['frag_idx'], payload['frag_cnt']) = struct.unpack_from(BINARY_SEQUENCE_FMT, data, offset)
+        return offset + struct.calcsize(BINARY_SEQUENCE_FMT)
+    if version == BINARY_BATCH_VERSION:
+        (payload['src_sn'], payload['send_us'], payload['frag_idx'],
+         payload['frag_cnt'], payload['src_cnt']) = struct.unpack_from(BINARY_BATCH_FMT, data, offset)
+        return offset + struct.calcsize(BINARY_BATCH_FMT)
+    return offset
+
+
+def decode_binary_packet(data: bytes):
+    """将二进制 EO 报文解析为与 JSON 报文结构相同的字典。
+
+    Args:
+        data: UDP 负载字节流。
+
+    Returns:
+        dict: 报文头字段与 `cont` 目标数组。
+
+    Raises:
+        ValueError: 当帧头、帧长、校验和或帧尾不合法时抛出。
+    """
+    version, _, checksum_offset = check_binary_frame(data, (BODY_TYPE_BINARY,), BINARY_VERSIONS)
+    preamble_size = struct.calcsize(BINARY_PREAMBLE_FMT)
+
+    offset = preamble_size
+    header = struct.unpack_from(BINARY_HEADER_FMT, data, offset)
+    offset += struct.calcsize(BINARY_HEADER_FMT)
+    payload = dict(zip(BINARY_HEADER_FIELDS, header))
+    offset = read_binary_extension(data, version, offset, payload)
+
+    cont = []  # 解析出的目标数组。
+    fixed_size = struct.calcsize(BINARY_TARGET_FIXED_FMT)
+    for _ in range(payload['cont_sum']):
+        if offset + fixed_size > checksum_offset:
+            raise ValueError('Target record truncated')
+        fields = struct.unpack_from(BINARY_TARGET_FIXED_FMT, data, offset)
+        record_length, mask = fields[0], fields[1]
+        target = dict(zip(
+            ('yr', 'mo', 'dy', 'h', 'min', 'sec', 'msec', 'dev_id', 'guid_id',
+             'tar_id', 'trk_stat', 'trk_mod', 'tar_category', 'offset_h',
+             'offset_v', 'tar_rect', 'source_id', 'tar_cfid'),
+            fields[2:-1],
+        ))
+        iden_length = fields[-1]
+        cursor = offset + fixed_size
+        target['tar_iden'] = data[cursor:cursor + iden_length].decode('utf-8', errors='replace')
+        cursor += iden_length
+        for bit, name in enumerate(BINARY_DOUBLE_FIELDS):
+            if mask & (1 << bit):
+                (target[name],) = struct.unpack_from('<d', data, cursor)
+                cursor += 8
+            else:
+                target[name] = 0.0
+        if cursor - offset > record_length:
+            raise ValueError('Target record length mismatch')
+        offset += record_length  # 按记录长度跳过新版本追加的字段。
+        cont.append(target)
+
+    payload['cont'] = cont
+    return payload
+
+
+def is_heartbeat_packet(data: bytes) -> bool:
+    """判断负载是否为二进制心跳（JSON 心跳在 JSON 解析后按 `heartbeat` 键识别）。"""
+    return is_binary_packet(data) and len(data) > 3 and data[3] == BODY_TYPE_HEARTBEAT
+
+
+def decode_binary_heartbeat(data: bytes):
+    """将二进制心跳解析为与 JSON 心跳结构相同的字典。
+
+    Raises:
+        ValueError: 帧不合法或视频源个数与帧长不符时抛出。
+    """
+    _, _, checksum_offset = check_binary_frame(
+        data, (BODY_TYPE_HEARTBEAT,), (BINARY_VERSION,), struct.calcsize(BINARY_HEARTBEAT_FMT))
+    offset = struct.calcsize(BINARY_PREAMBLE_FMT)
+    send_us, count = struct.unpack_from(BINARY_HEARTBEAT_FMT, data, offset)
+    offset += struct.calcsize(BINARY_HEARTBEAT_FMT)
+    entry_size = struct.calcsize(BINARY_HEARTBEAT_ENTRY_FMT)
+    if count == 0 or offset + count * entry_size != checksum_offset:
+        raise ValueError(f'Heartbeat source count {count} does not match frame length')
+    sources = []
+    for _ in range(count):
+        source_id, src_sn = struct.unpack_from(BINARY_HEARTBEAT_ENTRY_FMT, data, offset)
+        offset += entry_size
+        sources.append({'source_id': source_id, 'src_sn': src_sn})
+    return {'heartbeat': sources, 'send_us': send_us}
+
+
+def is_fec_packet(data: bytes) -> bool:
+    """判断负载是否为 FEC 校验报文。"""
+    return is_binary_packet(data) and len(data) > 3 and data[3] == BODY_TYPE_FEC
+
+
+def decode_fec_packet(data: bytes):
+    """解析 FEC 校验报文的分组信息（不含校验数据）。
+
+    Raises:
+        ValueError: 帧不合法或长度与分组信息不符时抛出。
+    """
+    _, _, checksum_offset = check_binary_frame(
+        data, (BODY_TYPE_FEC,), (BINARY_VERSION,), struct.calcsize(FEC_INFO_FMT))
+    offset = struct.calcsize(BINARY_PREAMBLE_FMT)
+    group_sn, k, m, idx, scheme, symbol_size = struct.unpack_from(FEC_INFO_FMT, data, offset)
+    offset += struct.calcsize(FEC_INFO_FMT)
+    if k == 0 or idx >= m or offset + k * FEC_ENTRY_SIZE + symbol_size != checksum_offset:
+        raise ValueError(f'FEC group info k={k} m={m} does not match frame length')
+    return {'group_sn': group_sn, 'k': k, 'm': m, 'parity_idx': idx,
+            'scheme': 'xor' if scheme == 0 else 'rs', 'symbol_size': symbol_size}
+
+
+def dictionary_id(dictionary: bytes) -> int:
+    """字典 ID：FNV-1a 32 位哈希，结果为 0 时取 1；空字典为 0。"""
+    if not dictionary:
+        return 0
+    value = 2166136261
+    for byte in dictionary:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value or 1
+
+
+def is_compressed_packet(data: bytes) -> bool:
+    """判断负载是否为压缩报文。"""
+    return len(data) >= struct.calcsize(COMPRESSED_HEADER_FMT) and data[:2] == COMPRESSED_MAGIC
+
+
+def lz4_block_decompress(src: bytes, prefix: bytes, original: int) -> bytes:
+    """解压 LZ4 块，prefix 为字典（匹配可引用字典末尾）。
+
+    Raises:
+        ValueError: 数据损坏或长度不符时抛出。
+    """
+    out = bytearray(prefix)
+    end = len(prefix) + original
+    offset = 0
+    while offset < len(src):
+        token = src[offset]
+        offset += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                if offset >= len(src):
+                    raise ValueError('LZ4 literal length truncated')
+                byte = src[offset]
+                offset += 1
+                literals += byte
+                if byte != 255:
+                    break
+        if offset + literals > len(src) or len(out) + literals > end:
+            raise ValueError('LZ4 literals out of range')
+        out += src[offset:offset + literals]
+        offset += literals
+        if offset == len(src):
+            break
+        if offset + 2 > len(src):
+            raise ValueError('LZ4 match offset truncated')
+        distance = src[offset] | (src[offset + 1] << 8)
+        offset += 2
+        match = (token & 15) + 4
+        if token & 15 == 15:
+            while True:
+                if offset >= len(src):
+                    raise ValueError('LZ4 match length truncated')
+                byte = src[offset]
+                offset += 1
+                match += byte
+                if byte != 255:
+                    break
+        if distance == 0 or distance > len(out) or len(out) + match > end:
+            raise ValueError('LZ4 match out of range')
+        start = len(out) - distance
+        for i in range(match):  # 匹配可与输出重叠，逐字节复制
+            out.append(out[start + i])
+    if len(out) != end:
+        raise ValueError('LZ4 length mismatch')
+    return bytes(out[len(prefix):])
+
+
+class Decompressor:
+    """解压压缩报文，字典 ID 须与报文头一致（不带字典的报文总能解压）。"""
+
+    def __init__(self, dictionary: bytes = b''):
+        self.dictionary = dictionary[-MAX_DICTIONARY_SIZE:]
+        self.dictionary_id = dictionary_id(self.dictionary)
+
+    def decompress(self, data: bytes) -> bytes:
+        """返回原报文。
+
+        Raises:
+            ValueError: 格式错误、字典不一致或数据损坏时抛出。
+        """
+        _, version, codec, dict_id, original = struct.unpack_from(COMPRESSED_HEADER_FMT, data)
+        if version != COMPRESSED_VERSION:
+            raise ValueError(f'Unsupported compressed version {version}')
+        if dict_id != 0 and dict_id != self.dictionary_id:
+            raise ValueError(f'Compression dictionary mismatch (id {dict_id:08x})')
+        dictionary = self.dictionary if dict_id else b''
+        body = data[struct.calcsize(COMPRESSED_HEADER_FMT):]
+        if codec == COMPRESSION_LZ4:
+            return lz4_block_decompress(body, dictionary, original)
+        if codec == COMPRESSION_DEFLATE:
+            stream = zlib.decompressobj(wbits=-15, zdict=dictionary) if dictionary else \
+                zlib.decompressobj(wbits=-15)
+            payload = stream.decompress(body, original)
+            if len(payload) != original or not stream.eof or stream.unconsumed_tail:
+                raise ValueError('Deflate length mismatch')
+            return payload
+        raise ValueError(f'Unknown compression {codec}')
+
+
+def is_delta_packet(data: bytes) -> bool:
+    """判断负载是否为差分帧。"""
+    return is_binary_packet(data) and len(data) > 3 and data[3] == BODY_TYPE_DELTA
+
+
+def read_varint(data: bytes, offset: int, end: int):
+    """读取无符号 LEB128 变长整数，返回 (数值, 新偏移)。"""
+    value = 0
+    shift = 0
+    while offset < end and shift < 64:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, offset
+        shift += 7
+    raise ValueError('Varint truncated')
+
+
+def unzigzag(value: int) -> int:
+    return (value >> 1) ^ -(value & 1)
+
+
+class DeltaDecoder:
+    """按视频源保存上一报文的目标，还原差分帧。"""
+
+    def __init__(self):
+        self.sources = {}  # source_id -> (msg_sn, 目标数组)
+
+    def on_keyframe(self, payload: dict):
+        """记录一条完整的非差分报文；分片报文未重组，使该视频源失效。聚合报文不作参考。"""
+        cont = payload.get('cont') or []
+        if not cont or int(payload.get('src_cnt', 0) or 0) > 0:
+            return
+        source_id = int(cont[0].get('source_id', 0))
+        if int(payload.get('frag_cnt', 0) or 0) > 1:
+            self.sources.pop(source_id, None)
+            return
+        self.sources[source_id] = (int(payload.get('msg_sn', 0)), cont)
+
+    def decode(self, data: bytes):
+        """还原差分帧，缺少参考或 base_sn 不连续时返回 None。
+
+        Raises:
+            ValueError: 帧不合法时抛出。
+        """
+        version, _, checksum_offset = check_binary_frame(
+            data, (BODY_TYPE_DELTA,), (BINARY_VERSION, BINARY_SEQUENCE_VERSION))
+        offset = struct.calcsize(BINARY_PREAMBLE_FMT)
+        payload = dict(zip(BINARY_HEADER_FIELDS, struct.unpack_from(BINARY_HEADER_FMT, data, offset)))
+        offset += struct.calcsize(BINARY_HEADER_FMT)
+        offset = read_binary_extension(data, version, offset, payload)
+        source_id, base_sn = struct.unpack_from(DELTA_INFO_FMT, data, offset)
+        offset += struct.calcsize(DELTA_INFO_FMT)
+
+        state = self.sources.get(source_id)
+        if state is None or state[0] != base_sn:
+            self.sources.pop(source_id, None)
+            return None
+        reference = state[1]
+        zero = dict.fromkeys(DELTA_TARGET_FIELDS, 0)
+        zero['tar_iden'] = ''
+
+        cont = []  # 还原出的目标数组。
+        for index in range(payload['cont_sum']):
+            ref = reference[min(index, len(reference) - 1)] if reference else zero
+            time_ref = cont[index - 1] if index > 0 else (reference[0] if reference else zero)
+            target = {name: ref.get(name, zero[name]) for name in DELTA_TARGET_FIELDS}
+            for name in DELTA_TIME_FIELDS:
+                target[name] = time_ref.get(name, 0)
+
+            mask, offset = read_varint(data, offset, checksum_offset)
+            if mask >> (DELTA_DOUBLE_BIT + len(BINARY_DOUBLE_FIELDS)):
+                raise ValueError(f'Invalid delta field mask {mask:#x}')
+            if mask & (1 << DELTA_MSEC_BIT):
+                (target['msec'],) = struct.unpack_from('<f', data, offset)
+                offset += 4
+            if mask & (1 << DELTA_CFID_BIT):
+                (target['tar_cfid'],) = struct.unpack_from('<f', data, offset)
+                offset += 4
+            if mask & (1 << DELTA_IDEN_BIT):
+                iden_length = data[offset]
+                target['tar_iden'] = data[offset + 1:offset + 1 + iden_length].decode('utf-8', errors='replace')
+                offset += 1 + iden_length
+            for bit, name in DELTA_INT_FIELDS:
+                if mask & (1 << bit):
+                    value, offset = read_varint(data, offset, checksum_offset)
+                    target[name] = int(target[name]) + unzigzag(value)
+            for bit, name in enumerate(BINARY_DOUBLE_FIELDS):
+                if mask & (1 << (DELTA_DOUBLE_BIT + bit)):
+                    (target[name],) = struct.unpack_from('<d', data, offset)
+                    offset += 8
+            if offset > checksum_offset:
+                raise ValueError('Delta target truncated')
+            cont.append(target)
+
+        payload['cont'] = cont
+        self.sources[source_id] = (payload['msg_sn'], cont)
+        return payload
+
+
 def decode_legacy_packet(data: bytes):
     """将旧版二进制结构体报文解析为字典。
 
@@ -235,6 +703,25 @@ def summarize_json_target(target: dict) -> str:
     )
 
 
+def print_stats_packet(payload: dict, addr, recv_time: float):
+    """打印 stats-mode=datagram 时发送的检测统计报文。"""
+    print(
+        f"ts={recv_time:.6f} src={addr[0]}:{addr[1]} stats "
+        f"source_id={payload.get('source_id')} window_ms={payload.get('window_ms')} "
+        f"frames={payload.get('frames')} objects={payload.get('objects')} "
+        f"min_pixel={payload.get('min_pixel')} mean_pixel={payload.get('mean_pixel')} "
+        f"primary={payload.get('primary')} secondary={payload.get('secondary')}"
+    )
+
+
+def print_heartbeat_packet(payload: dict, addr, recv_time: float):
+    """打印空闲心跳：列出的视频源在线但当前无目标。"""
+    sources = ','.join(
+        f"{entry.get('source_id')}@{entry.get('src_sn')}" for entry in payload.get('heartbeat', [])
+    )
+    print(f"ts={recv_time:.6f} src={addr[0]}:{addr[1]} heartbeat sources={{{sources}}}")
+
+
 def print_json_packet(payload: dict, addr, recv_time: float, hex_dump: bool, quiet: bool, raw_data: bytes):
     """打印 JSON 报文内容。
 
@@ -254,13 +741,22 @@ def print_json_packet(payload: dict, addr, recv_time: float, hex_dump: bool, qui
     msg_sn = int(payload.get('msg_sn', 0) or 0)  # 发送计数。
     cont_sum = int(payload.get('cont_sum', len(cont)) or 0)  # 目标数量字段。
     source_ids = sorted({target.get('source_id', 0) for target in cont}) if cont else []  # 本报文涉及的视频源编号。
+    frag_cnt = int(payload.get('frag_cnt', 0) or 0)  # 分片总数，未分片报文为 0。
+    frag_text = f" frag={int(payload.get('frag_idx', 0) or 0) + 1}/{frag_cnt}" if frag_cnt > 1 else ''  # 分片摘要。
+    src_sn = int(payload.get('src_sn', 0) or 0)  # 按视频源递增的序号（聚合报文为批次序号），旧版发送端为 0。
+    send_us = int(payload.get('send_us', 0) or 0)  # 发送时刻（Unix 微秒），旧版发送端为 0。
+    src_cnt = int(payload.get('src_cnt', 0) or 0)  # 聚合报文中的视频源个数，单视频源报文为 0。
+    if src_sn:
+        frag_text += f' batch_sn={src_sn} sources={src_cnt}' if src_cnt else f' src_sn={src_sn}'
+    if send_us:
+        frag_text += f' latency_us={int(recv_time * 1e6) - send_us}'
 
     if quiet:
         source_id_text = ','.join(str(source_id) for source_id in source_ids) if source_ids else '-'  # 摘要中的源编号文本。
         first_target = summarize_json_target(cont[0]) if cont else 'no-target'  # 精简模式下展示第一个目标。
         print(
             f"ts={recv_time:.6f} src={addr[0]}:{addr[1]} "
-            f"msg_id={msg_id} msg_sn={msg_sn} cont_sum={cont_sum} "
+            f"msg_id={msg_id} msg_sn={msg_sn}{frag_text} cont_sum={cont_sum} "
             f"targets={len(cont)} sources={source_id_text} {first_target}"
         )
         return
@@ -269,7 +765,7 @@ def print_json_packet(payload: dict, addr, recv_time: float, hex_dump: bool, qui
     print(f'Received from {addr[0]}:{addr[1]} bytes={len(raw_data)}')
     print(f' Local recv time: {datetime.fromtimestamp(recv_time).isoformat()}')
     print(f' msg_id: {msg_id}')
-    print(f' msg_sn: {msg_sn}')
+    print(f' msg_sn: {msg_sn}{frag_text}')
     print(f' msg_type: {payload.get("msg_type", 0)}')
     print(f' cont_type: {payload.get("cont_type", 0)}')
     print(f' cont_sum: {cont_sum}')
@@ -341,18 +837,26 @@ def print_legacy_packet(decoded: dict, addr, recv_time: float, hex_dump: bool, q
 def main():
     """程序入口，接收组播报文并打印解析结果。"""
     args = parse_args()  # 命令行参数对象。
-    iface_ip = resolve_iface_ip(args.iface)  # 用于加入组播的本机 IPv4 地址。
+    ipv6 = ':' in args.group  # IPv6 地址一定含冒号。
+    family = socket.AF_INET6 if ipv6 else socket.AF_INET
+    multicast = ipaddress.ip_address(args.group.partition('%')[0]).is_multicast
+    # 用于加入 IPv4 组播的本机地址；IPv6 按网卡名加入。
+    iface_ip = resolve_iface_ip(args.iface) if multicast and not ipv6 else args.iface
 
-    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)  # UDP 组播接收套接字。
+    sock = socket.socket(family, socket.SOCK_DGRAM, socket.IPPROTO_UDP)  # UDP 组播接收套接字。
     # 先绑定端口，再加入组播，避免某些平台对接口/端口顺序更敏感。
     try:
-        sock.bind(('', args.port))
+        sock.bind(('::' if ipv6 else '', args.port))
     except OSError as exc:
         print(f'Bind failed on port {args.port}: {exc}', file=sys.stderr)
         sys.exit(1)
 
     try:
-        join_multicast(sock, args.group, iface_ip)
+        # 单播地址（插件 destinations 中的单播目的地）只需绑定端口。
+        if multicast and ipv6:
+            join_multicast_v6(sock, args.group, args.iface)
+        elif multicast:
+            join_multicast(sock, args.group, iface_ip)
     except OSError as exc:
         print(
             f'加入组播失败: group={args.group}, iface={args.iface}, iface_ip={iface_ip}, error={exc}',
@@ -366,6 +870,13 @@ def main():
         f'buffer={args.buffer_size} legacy_binary={args.legacy_binary}'
     )
 
+    delta_decoder = DeltaDecoder()  # 差分帧参考状态。
+    dictionary = b''  # 压缩字典，与插件 compression-dictionary 相同。
+    if args.dictionary:
+        with open(args.dictionary, 'rb') as file:
+            dictionary = file.read()
+    decompressor = Decompressor(dictionary)
+    capture = open(args.capture, 'wb') if args.capture else None  # 训练字典用的抓包文件。
     while True:
         data, addr = sock.recvfrom(args.buffer_size)  # 本次收到的 UDP 负载和发送端地址。
         recv_time = time.time()  # 本地接收时间戳。
@@ -381,8 +892,75 @@ def main():
             print_legacy_packet(decoded, addr, recv_time, args.hex, args.quiet, data)
             continue
 
+        if is_compressed_packet(data):
+            try:
+                data = decompressor.decompress(data)  # 解压后按原报文类型继续解析。
+            except Exception as exc:
+                print(f'[WARN] {addr} len={len(data)} decompress error: {exc}')
+                continue
+
+        if capture is not None and not is_fec_packet(data):
+            capture.write(struct.pack('<I', len(data)) + data)
+            capture.flush()
+
+        if is_heartbeat_packet(data):
+            try:
+                payload = decode_binary_heartbeat(data)  # 二进制心跳，结构与 JSON 心跳一致。
+            except Exception as exc:
+                print(f'[WARN] {addr} len={len(data)} heartbeat decode error: {exc}')
+                continue
+            if not args.quiet:
+                print_heartbeat_packet(payload, addr, recv_time)
+            continue
+
+        if is_fec_packet(data):
+            try:
+                info = decode_fec_packet(data)  # 校验报文只用于接收端恢复丢包，此处仅打印。
+            except Exception as exc:
+                print(f'[WARN] {addr} len={len(data)} fec decode error: {exc}')
+                continue
+            if not args.quiet:
+                print(
+                    f"ts={recv_time:.6f} src={addr[0]}:{addr[1]} fec group={info['group_sn']} "
+                    f"parity={info['parity_idx'] + 1}/{info['m']} k={info['k']} "
+                    f"scheme={info['scheme']} symbol_size={info['symbol_size']}"
+                )
+            continue
+
+        if is_delta_packet(data):
+            try:
+                payload = delta_decoder.decode(data)  # 差分帧还原结果，结构与 JSON 一致。
+            except Exception as exc:
+                print(f'[WARN] {addr} len={len(data)} delta decode error: {exc}')
+                continue
+            if payload is None:
+                if not args.quiet:
+                    print(f'[INFO] {addr} len={len(data)} delta frame skipped, waiting for keyframe')
+                continue
+            print_json_packet(payload, addr, recv_time, args.hex, args.quiet, data)
+            continue
+
+        if is_binary_packet(data):
+            try:
+                payload = decode_binary_packet(data)  # 二进制报文解析结果，结构与 JSON 一致。
+                delta_decoder.on_keyframe(payload)
+            except Exception as exc:
+                print(f'[WARN] {addr} len={len(data)} binary decode error: {exc}')
+                if args.hex:
+                    print(data.hex())
+                continue
+            print_json_packet(payload, addr, recv_time, args.hex, args.quiet, data)
+            continue
+
         try:
             payload = decode_json_packet(data)
+            if 'stats_type' in payload:
+                print_stats_packet(payload, addr, recv_time)
+                continue
+            if 'heartbeat' in payload:
+                if not args.quiet:
+                    print_heartbeat_packet(payload, addr, recv_time)
+                continue
             print_json_packet(payload, addr, recv_time, args.hex, args.quiet, data)
         except Exception as json_error:
             # 兼容历史二进制报文，JSON 失败后再尝试旧格式。
@@ -0,0 +1,88 @@
+#include "source_heartbeat.h"
+
+void SourceHeartbeat::Configure(int64_t interval_ns, bool aggregate)
+{
+    interval_ns_ = (interval_ns > 0) ? interval_ns : 0;
+    aggregate_ = aggregate;
+    Reset();
+}
+
+void SourceHeartbeat::Reset()
+{
+    sources_.clear();
+    next_due_ns_ = 0;
+}
+
+SourceHeartbeat::SourceState &SourceHeartbeat::State(unsigned source_id)
+{
+    if (source_id >= sources_.size())
+    {
+        sources_.resize(source_id + 1, SourceState{0, 0, false});
+    }
+    return sources_[source_id];
+}
+
+SourceHeartbeat::Action SourceHeartbeat::OnFrame(unsigned source_id, bool has_targets,
+                                                 int64_t now_ns)
+{
+    if (!enabled())
+    {
+        return Action::REPORT;
+    }
+
+    SourceState &state = State(source_id);
+    if (has_targets)
+    {
+        state.idle = false;
+        return Action::REPORT;
+    }
+
+    state.last_frame_ns = now_ns;
+    if (!state.idle)
+    {
+        // 首个空帧或 "有目标 → 无目标" 跳变：照常发送一次占位报文
+        state.idle = true;
+        state.last_heartbeat_ns = now_ns;
+        if (aggregate_ && next_due_ns_ == 0)
+        {
+            next_due_ns_ = now_ns + interval_ns_;
+        }
+        return Action::REPORT;
+    }
+
+    if (aggregate_ || now_ns - state.last_heartbeat_ns < interval_ns_)
+    {
+        return Action::SKIP;
+    }
+    state.last_heartbeat_ns = now_ns;
+    return Action::HEARTBEAT;
+}
+
+bool SourceHeartbeat::CollectDue(int64_t now_ns, std::vector<uint32_t> &sources)
+{
+    sources.clear();
+    if (!enabled() || !aggregate_ || next_due_ns_ == 0 || now_ns < next_due_ns_)
+    {
+        return false;
+    }
+
+    // 超过两个间隔没有出帧的视频源视为已停止，不再代其发送心跳
+    for (size_t i = 0; i < sources_.size(); ++i)
+    {
+        SourceState &state = sources_[i];
+        if (state.idle && now_ns - state.last_frame_ns <= 2 * interval_ns_ &&
+            now_ns - state.last_heartbeat_ns >= interval_ns_ / 2)
+        {
+            state.last_heartbeat_ns = now_ns;
+            sources.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // 沿网格推进截止时间；落后超过一个间隔（无空闲视频源、停顿）时重新对齐
+    next_due_ns_ += interval_ns_;
+    if (next_due_ns_ <= now_ns)
+    {
+        next_due_ns_ = now_ns + interval_ns_;
+    }
+    return !sources.empty();
+}
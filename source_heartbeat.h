@@ -0,0 +1,58 @@
+#ifndef SOURCE_HEARTBEAT_H
+#define SOURCE_HEARTBEAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 空闲视频源的心跳节流。
+// 未启用时每个空帧都发送 "none" 占位报文（原有行为）；启用后某路视频源只在
+// "有目标 → 无目标" 的跳变帧发送一次占位报文，此后改为每 interval 发送一次心跳：
+// 按源模式由 OnFrame() 直接返回 HEARTBEAT，聚合模式由 CollectDue() 按统一截止时间
+// 收集所有到期的空闲视频源，合并为一个多源心跳报文。
+// 心跳只由仍在产生帧的视频源触发，视频源停止出帧后心跳随之停止，
+// 接收端据此区分 "无目标"（有心跳）与 "视频源失效"（既无报文也无心跳）。
+// 状态为按 source_id 直接索引的数组，时间为 CLOCK_MONOTONIC 纳秒。非线程安全，
+// 只能在发送线程中调用。
+class SourceHeartbeat
+{
+  public:
+    enum class Action
+    {
+        REPORT = 0,    // 发送目标报文（有目标，或空闲跳变帧的 "none" 占位报文）
+        HEARTBEAT = 1, // 发送该视频源的心跳（仅按源模式）
+        SKIP = 2       // 不发送
+    };
+
+    // interval_ns 为 0 表示不启用（每个空帧都发送占位报文）；aggregate 为 true 时心跳合并发送
+    void Configure(int64_t interval_ns, bool aggregate);
+
+    // 清空所有视频源的状态
+    void Reset();
+
+    bool enabled() const { return interval_ns_ > 0; }
+    bool aggregate() const { return aggregate_; }
+
+    // 判断某路视频源本帧的发送方式；has_targets 为本帧（过滤后）是否有目标
+    Action OnFrame(unsigned source_id, bool has_targets, int64_t now_ns);
+
+    // 聚合模式：到达统一截止时间时，把仍在出帧的空闲视频源写入 sources 并返回 true
+    bool CollectDue(int64_t now_ns, std::vector<uint32_t> &sources);
+
+  private:
+    struct SourceState
+    {
+        int64_t last_heartbeat_ns; // 最近一次占位报文或心跳的时间
+        int64_t last_frame_ns;     // 最近一个空帧的时间
+        bool    idle;              // 已发送跳变占位报文，处于无目标状态
+    };
+
+    SourceState &State(unsigned source_id);
+
+    int64_t                  interval_ns_ = 0;
+    bool                     aggregate_ = false;
+    int64_t                  next_due_ns_ = 0; // 聚合模式下次心跳时间，0 表示未开始
+    std::vector<SourceState> sources_;
+};
+
+#endif // SOURCE_HEARTBEAT_H
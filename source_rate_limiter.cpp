@@ -0,0 +1,118 @@
+#include "source_rate_limiter.h"
+#include "spec_parser.h"
+#include <ctime>
+
+namespace
+{
+const int64_t  kNsPerSecond = 1000000000LL;
+const unsigned kMaxFps = 1000;
+} // namespace
+
+void SourceRateLimiter::Configure(Mode mode, unsigned burst)
+{
+    mode_ = mode;
+    burst_ = (burst == 0) ? 1 : burst;
+}
+
+bool SourceRateLimiter::SetSourceFps(const std::string &spec,
+                                     std::string       &error)
+{
+    std::vector<std::pair<unsigned, unsigned>> overrides;
+    size_t                                     pos = 0;
+
+    while (pos < spec.size())
+    {
+        unsigned source_id;
+        unsigned fps;
+        if (!ParseSpecKey(spec, pos, kMaxSourceId, "source_id:fps", source_id, error))
+            return false;
+        if (!ParseUnsigned(spec, pos, kMaxFps, fps))
+        {
+            error = "invalid fps at offset " + std::to_string(pos) + " (0~" +
+                    std::to_string(kMaxFps) + ")";
+            return false;
+        }
+        if (!ParseSpecSeparator(spec, pos, ',', error))
+            return false;
+        overrides.push_back(std::make_pair(source_id, fps));
+    }
+
+    for (SourceState &state : sources_)
+    {
+        state.fps = kNoOverride;
+    }
+    for (const auto &item : overrides)
+    {
+        State(item.first).fps = static_cast<int32_t>(item.second);
+    }
+    return true;
+}
+
+void SourceRateLimiter::Reset()
+{
+    for (SourceState &state : sources_)
+    {
+        state.deadline_ns = 0;
+        state.started = false;
+    }
+}
+
+SourceRateLimiter::SourceState &SourceRateLimiter::State(unsigned source_id)
+{
+    if (source_id >= sources_.size())
+    {
+        sources_.resize(source_id + 1, SourceState{0, kNoOverride, false});
+    }
+    return sources_[source_id];
+}
+
+bool SourceRateLimiter::ShouldSend(unsigned source_id, int64_t now_ns,
+                                   unsigned default_fps)
+{
+    SourceState   &state = State(source_id);
+    const unsigned fps =
+        (state.fps == kNoOverride) ? default_fps : static_cast<unsigned>(state.fps);
+    if (fps == 0)
+    {
+        return false;
+    }
+    const int64_t interval = kNsPerSecond / fps;
+
+    if (!state.started)
+    {
+        state.started = true;
+        state.deadline_ns = now_ns + interval; // 两种模式下首帧都占用一个间隔
+        return true;
+    }
+
+    if (mode_ == Mode::TOKEN_BUCKET)
+    {
+        // GCRA：理论到达时间 deadline 领先当前时间不超过 (burst - 1) 个间隔即可发送
+        if (state.deadline_ns - now_ns > (int64_t)(burst_ - 1) * interval)
+        {
+            return false;
+        }
+        state.deadline_ns =
+            ((state.deadline_ns > now_ns) ? state.deadline_ns : now_ns) + interval;
+        return true;
+    }
+
+    if (now_ns < state.deadline_ns)
+    {
+        return false;
+    }
+    // 沿网格推进截止时间；落后超过一个间隔（停顿、帧率变化）时重新对齐，避免补发突发
+    state.deadline_ns += interval;
+    if (state.deadline_ns <= now_ns)
+    {
+        state.deadline_ns = now_ns + interval;
+    }
+    return true;
+}
+
+int64_t SourceRateLimiter::NowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * kNsPerSecond + ts.tv_nsec;
+}
@@ -0,0 +1,53 @@
+#ifndef SOURCE_RATE_LIMITER_H
+#define SOURCE_RATE_LIMITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 按视频源限制上报频率。
+// 状态为按 source_id 直接索引的定长数组，每路只保存一个 CLOCK_MONOTONIC 纳秒截止时间，
+// 不受系统时间跳变影响。非线程安全，只能在流线程中调用。
+class SourceRateLimiter
+{
+  public:
+    enum class Mode
+    {
+        INTERVAL = 0,    // 固定间隔：按 1/fps 网格发送，输入帧率不整除时不累积漂移
+        TOKEN_BUCKET = 1 // 令牌桶（GCRA）：平均 fps，允许最多 burst 帧的短时突发
+    };
+
+    // 配置发送模式；burst 仅在 TOKEN_BUCKET 模式下生效，最小为 1
+    void Configure(Mode mode, unsigned burst);
+
+    // 解析按源覆盖的帧率，格式 "0:25,3:10"；fps 为 0 表示该路不发送。
+    // 失败时返回 false 并给出原因，原有覆盖保持不变。
+    bool SetSourceFps(const std::string &spec, std::string &error);
+
+    // 清空所有视频源的发送状态（覆盖的帧率保留）
+    void Reset();
+
+    // 判断某路视频源当前是否应发送；default_fps 用于未覆盖的视频源
+    bool ShouldSend(unsigned source_id, int64_t now_ns, unsigned default_fps);
+
+    // CLOCK_MONOTONIC 当前时间（纳秒）
+    static int64_t NowNs();
+
+  private:
+    static const int32_t kNoOverride = -1;
+
+    struct SourceState
+    {
+        int64_t deadline_ns; // INTERVAL：下次允许发送的时间；TOKEN_BUCKET：理论到达时间
+        int32_t fps;         // 覆盖的帧率，kNoOverride 表示使用默认值
+        bool    started;     // 是否已发送过
+    };
+
+    SourceState &State(unsigned source_id);
+
+    Mode                     mode_ = Mode::INTERVAL;
+    unsigned                 burst_ = 1;
+    std::vector<SourceState> sources_;
+};
+
+#endif // SOURCE_RATE_LIMITER_H
@@ -0,0 +1,76 @@
+#include "spec_parser.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+void SkipSpaces(const std::string &text, size_t &pos)
+{
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t'))
+        ++pos;
+}
+
+bool ParseUnsigned(const std::string &text, size_t &pos, unsigned maxValue, unsigned &value)
+{
+    SkipSpaces(text, pos);
+    if (pos >= text.size() || text[pos] < '0' || text[pos] > '9')
+        return false;
+
+    const char   *begin = text.c_str() + pos;
+    char         *end = NULL;
+    unsigned long parsed;
+    errno = 0;
+    parsed = strtoul(begin, &end, 10);
+    if (errno != 0 || parsed > maxValue)
+        return false;
+    pos += end - begin;
+    SkipSpaces(text, pos);
+    value = static_cast<unsigned>(parsed);
+    return true;
+}
+
+bool ParseFloat(const std::string &text, size_t &pos, float &value)
+{
+    SkipSpaces(text, pos);
+    if (pos >= text.size())
+        return false;
+
+    const char *begin = text.c_str() + pos;
+    char       *end = NULL;
+    errno = 0;
+    float parsed = strtof(begin, &end);
+    if (end == begin || errno != 0 || !std::isfinite(parsed))
+        return false;
+    pos += end - begin;
+    SkipSpaces(text, pos);
+    value = parsed;
+    return true;
+}
+
+bool ParseSpecKey(const std::string &spec, size_t &pos, unsigned maxId, const char *format,
+                  unsigned &id, std::string &error)
+{
+    if (!ParseUnsigned(spec, pos, maxId, id) || pos >= spec.size() || spec[pos] != ':')
+    {
+        const char *colon = strchr(format, ':');
+        const std::string name(format, colon != NULL ? colon - format : strlen(format));
+        error = "expected " + std::string(format) + " at offset " + std::to_string(pos) +
+                " (" + name + " 0~" + std::to_string(maxId) + ")";
+        return false;
+    }
+    ++pos;
+    return true;
+}
+
+bool ParseSpecSeparator(const std::string &spec, size_t &pos, char separator,
+                        std::string &error)
+{
+    if (pos < spec.size() && spec[pos] != separator)
+    {
+        error = std::string("expected '") + separator + "' at offset " + std::to_string(pos);
+        return false;
+    }
+    if (pos < spec.size())
+        ++pos;
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef SPEC_PARSER_H
+#define SPEC_PARSER_H
+
+#include <cstddef>
+#include <string>
+
+// 属性中 "id:value,id:value" 形式列表的解析工具，source-fps、class-min-confidence、roi、routes 共用。
+// 各函数从 pos 开始解析，成功时 pos 移到所解析内容及其后的空白之后。
+
+// 按视频源配置的列表中允许的最大 source_id
+const unsigned kMaxSourceId = 4095;
+
+// 跳过空格与制表符
+void SkipSpaces(const std::string &text, size_t &pos);
+
+// 十进制无符号整数，不超过 maxValue
+bool ParseUnsigned(const std::string &text, size_t &pos, unsigned maxValue, unsigned &value);
+
+// 有限的单精度浮点数
+bool ParseFloat(const std::string &text, size_t &pos, float &value);
+
+// 列表项的 "id:" 前缀，id 不超过 maxId，成功时 pos 移到 ':' 之后。
+// format 为项的格式（如 "source_id:fps"），失败时给出
+// "expected <format> at offset N (<id 名称> 0~maxId)"
+bool ParseSpecKey(const std::string &spec, size_t &pos, unsigned maxId, const char *format,
+                  unsigned &id, std::string &error);
+
+// 列表项之后应为末尾或 separator，是分隔符时跳过
+bool ParseSpecSeparator(const std::string &spec, size_t &pos, char separator,
+                        std::string &error);
+
+#endif // SPEC_PARSER_H
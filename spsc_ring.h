@@ -0,0 +1,138 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// 有界无锁环形队列（单生产者、单消费者）。
+// 每个槽位带序号（Vyukov 有界队列算法），读写均在槽位内原地进行，避免大记录的二次拷贝。
+// 生产者可以像消费者一样认领最旧的槽位并直接丢弃，用于实现 drop-oldest 策略。
+template <typename T> class SpscRing
+{
+  public:
+    // 容量向上取整到 2 的幂
+    explicit SpscRing(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        slots_.reset(new Slot[size]);
+        for (size_t i = 0; i < size; ++i)
+        {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // 生产者：获取下一个可写槽位，队列满时返回 nullptr
+    T *BeginWrite()
+    {
+        const size_t pos = write_pos_.load(std::memory_order_relaxed);
+        Slot        &slot = slots_[pos & mask_];
+        if (slot.seq.load(std::memory_order_acquire) != pos)
+        {
+            return nullptr;
+        }
+        return &slot.value;
+    }
+
+    // 生产者：提交 BeginWrite 返回的槽位
+    void CommitWrite()
+    {
+        const size_t pos = write_pos_.load(std::memory_order_relaxed);
+        slots_[pos & mask_].seq.store(pos + 1, std::memory_order_release);
+        write_pos_.store(pos + 1, std::memory_order_release);
+    }
+
+    // 消费者：获取最旧的可读槽位，队列空时返回 nullptr；读完后必须调用 EndRead
+    T *BeginRead()
+    {
+        size_t pos;
+        Slot  *slot = ClaimOldest(pos);
+        if (slot == nullptr)
+        {
+            return nullptr;
+        }
+        read_slot_ = slot;
+        read_pos_ = pos;
+        return &slot->value;
+    }
+
+    // 消费者：归还 BeginRead 返回的槽位
+    void EndRead()
+    {
+        Release(read_slot_, read_pos_);
+        read_slot_ = nullptr;
+    }
+
+    // 生产者：丢弃最旧的一条记录，成功返回 true。
+    // 若最旧记录正被消费者读取则返回 false，此时队列仍然是满的。
+    bool DropOldest()
+    {
+        size_t pos;
+        Slot  *slot = ClaimOldest(pos);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        Release(slot, pos);
+        return true;
+    }
+
+    bool empty() const
+    {
+        const size_t pos = read_pos_claim_.load(std::memory_order_acquire);
+        return slots_[pos & mask_].seq.load(std::memory_order_acquire) !=
+               pos + 1;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+  private:
+    struct Slot
+    {
+        std::atomic<size_t> seq;
+        T                   value;
+    };
+
+    // 通过 CAS 认领最旧的已提交槽位，生产者（丢弃）与消费者（读取）互斥
+    Slot *ClaimOldest(size_t &pos)
+    {
+        pos = read_pos_claim_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot        &slot = slots_[pos & mask_];
+            const size_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != pos + 1)
+            {
+                return nullptr;
+            }
+            if (read_pos_claim_.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_acq_rel,
+                    std::memory_order_relaxed))
+            {
+                return &slot;
+            }
+        }
+    }
+
+    void Release(Slot *slot, size_t pos)
+    {
+        slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t                  mask_ = 0;
+    alignas(64) std::atomic<size_t> write_pos_{0};
+    alignas(64) std::atomic<size_t> read_pos_claim_{0};
+    Slot  *read_slot_ = nullptr; // 仅消费者访问
+    size_t read_pos_ = 0;        // 仅消费者访问
+};
+
+#endif // SPSC_RING_H
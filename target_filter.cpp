@@ -0,0 +1,198 @@
+#include "target_filter.h"
+#include "spec_parser.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+const unsigned kMaxClassId = 1023; // class-min-confidence 可覆盖的最大 class_id
+const size_t   kMaxPolygonPoints = 64;
+} // namespace
+
+TargetFilter::TargetFilter() : min_confidence_(-INFINITY) {}
+
+void TargetFilter::SetMinConfidence(float min_confidence)
+{
+    min_confidence_ = (min_confidence <= -1.0f) ? -INFINITY : min_confidence;
+    Rebuild();
+}
+
+bool TargetFilter::SetClassMinConfidence(const std::string &spec, std::string &error)
+{
+    std::vector<std::pair<int, float>> overrides;
+    size_t                             pos = 0;
+
+    while (pos < spec.size())
+    {
+        unsigned class_id;
+        float    threshold;
+        if (!ParseSpecKey(spec, pos, kMaxClassId, "class_id:confidence", class_id, error))
+            return false;
+        if (!ParseFloat(spec, pos, threshold))
+        {
+            error = "invalid confidence at offset " + std::to_string(pos);
+            return false;
+        }
+        if (!ParseSpecSeparator(spec, pos, ',', error))
+            return false;
+        overrides.push_back(std::make_pair(static_cast<int>(class_id), threshold));
+    }
+
+    class_overrides_.swap(overrides);
+    Rebuild();
+    return true;
+}
+
+void TargetFilter::SetMinArea(float min_area)
+{
+    min_area_ = (min_area > 0.0f) ? min_area : 0.0f;
+    Rebuild();
+}
+
+bool TargetFilter::SetRoi(const std::string &spec, std::string &error)
+{
+    std::vector<std::vector<Polygon>> roi;
+    size_t                            pos = 0;
+
+    while (pos < spec.size())
+    {
+        unsigned source_id;
+        if (!ParseSpecKey(spec, pos, kMaxSourceId, "source_id:x1,y1,...", source_id, error))
+            return false;
+
+        Polygon polygon;
+        for (;;)
+        {
+            Point point;
+            if (!ParseFloat(spec, pos, point.x) || pos >= spec.size() ||
+                spec[pos] != ',')
+            {
+                error = "expected x,y at offset " + std::to_string(pos);
+                return false;
+            }
+            ++pos;
+            if (!ParseFloat(spec, pos, point.y))
+            {
+                error = "expected y at offset " + std::to_string(pos);
+                return false;
+            }
+            polygon.points.push_back(point);
+            if (pos >= spec.size() || spec[pos] != ',')
+                break;
+            ++pos;
+        }
+        if (polygon.points.size() < 3 || polygon.points.size() > kMaxPolygonPoints)
+        {
+            error = "polygon for source_id " + std::to_string(source_id) +
+                    " needs 3~" + std::to_string(kMaxPolygonPoints) + " points";
+            return false;
+        }
+        if (!ParseSpecSeparator(spec, pos, ';', error))
+            return false;
+
+        polygon.min_x = polygon.max_x = polygon.points[0].x;
+        polygon.min_y = polygon.max_y = polygon.points[0].y;
+        for (const Point &point : polygon.points)
+        {
+            polygon.min_x = std::min(polygon.min_x, point.x);
+            polygon.max_x = std::max(polygon.max_x, point.x);
+            polygon.min_y = std::min(polygon.min_y, point.y);
+            polygon.max_y = std::max(polygon.max_y, point.y);
+        }
+        if (roi.size() <= source_id)
+            roi.resize(source_id + 1);
+        roi[source_id].push_back(polygon);
+    }
+
+    roi_.swap(roi);
+    Rebuild();
+    return true;
+}
+
+void TargetFilter::Rebuild()
+{
+    int max_class = -1;
+    for (const auto &item : class_overrides_)
+    {
+        max_class = std::max(max_class, item.first);
+    }
+    class_min_.assign(static_cast<size_t>(max_class + 1), min_confidence_);
+    for (const auto &item : class_overrides_)
+    {
+        class_min_[item.first] = item.second;
+    }
+    active_ = min_confidence_ != -INFINITY || !class_overrides_.empty() ||
+              min_area_ > 0.0f || !roi_.empty();
+}
+
+bool TargetFilter::Contains(const Polygon &polygon, float x, float y)
+{
+    if (x < polygon.min_x || x > polygon.max_x || y < polygon.min_y || y > polygon.max_y)
+        return false;
+
+    // 射线法：向 +x 方向的射线与边相交奇数次时在多边形内
+    const std::vector<Point> &points = polygon.points;
+    bool                      inside = false;
+    for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+    {
+        if ((points[i].y > y) != (points[j].y > y) &&
+            x < (points[j].x - points[i].x) * (y - points[i].y) /
+                        (points[j].y - points[i].y) +
+                    points[i].x)
+        {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool TargetFilter::Accept(unsigned source_id, int class_id, float confidence,
+                          float left, float top, float width, float height) const
+{
+    const float min_confidence =
+        (class_id >= 0 && static_cast<size_t>(class_id) < class_min_.size())
+            ? class_min_[class_id]
+            : min_confidence_;
+    if (confidence < min_confidence)
+        return false;
+    if (width * height < min_area_)
+        return false;
+
+    if (source_id < roi_.size() && !roi_[source_id].empty())
+    {
+        const float x = left + width / 2;
+        const float y = top + height / 2;
+        for (const Polygon &polygon : roi_[source_id])
+        {
+            if (Contains(polygon, x, y))
+                return true;
+        }
+        return false;
+    }
+    return true;
+}
+
+float TargetFilter::TopConfidence(const float *confidence, size_t count, size_t k,
+                                  size_t &ties) const
+{
+    scratch_.assign(confidence, confidence + count);
+    for (float &value : scratch_)
+    {
+        if (std::isnan(value))
+            value = -INFINITY;
+    }
+
+    // 部分选择：第 k 大的值就位，前 k - 1 个不小于它，无需整体排序
+    std::nth_element(scratch_.begin(), scratch_.begin() + (k - 1), scratch_.end(),
+                     std::greater<float>());
+    const float kth = scratch_[k - 1];
+    size_t      greater = 0;
+    for (size_t i = 0; i + 1 < k; ++i)
+    {
+        if (scratch_[i] > kth)
+            ++greater;
+    }
+    ties = k - greater;
+    return kth;
+}
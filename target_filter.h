@@ -0,0 +1,83 @@
+#ifndef TARGET_FILTER_H
+#define TARGET_FILTER_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 发送前的目标过滤：按类别的最小置信度、最小检测框面积、按视频源的 ROI 多边形，
+// 以及单帧按置信度保留前 max_targets 个目标。
+// 逐目标条件由 Accept() 在遍历元数据时判断，未通过的目标不做标签映射、不进入报文；
+// 单帧上限由 TopConfidence() 在帧末用部分选择（std::nth_element）求出第 K 大的置信度，
+// 再由调用方按阈值原地剔除，不对整帧排序。
+// 配置完成后只读，可整体作为配置快照发布；TopConfidence() 复用内部缓冲，
+// 同一对象只能由一个线程调用。
+class TargetFilter
+{
+  public:
+    TargetFilter();
+
+    // 默认最小置信度，低于该值的目标被剔除；小于等于 -1 表示不按置信度过滤
+    void SetMinConfidence(float min_confidence);
+
+    // 解析按类别覆盖的最小置信度，格式 "0:0.5,2:0.3"，未列出的类别使用默认值。
+    // 失败时返回 false 并给出原因，原有覆盖保持不变。
+    bool SetClassMinConfidence(const std::string &spec, std::string &error);
+
+    // 最小检测框面积（宽 × 高，像素），0 表示不过滤
+    void SetMinArea(float min_area);
+
+    // 解析按视频源配置的 ROI 多边形，格式 "0:x1,y1,x2,y2,x3,y3;1:..."，
+    // 坐标为像素；同一 source_id 可出现多次，目标落入任一多边形即保留。
+    // 未配置 ROI 的视频源不按位置过滤。失败时返回 false，原有 ROI 保持不变。
+    bool SetRoi(const std::string &spec, std::string &error);
+
+    // 单帧最多上报的目标数，0 表示不限制
+    void SetMaxTargets(unsigned max_targets) { max_targets_ = max_targets; }
+
+    unsigned max_targets() const { return max_targets_; }
+
+    // 是否配置了逐目标条件；未配置时调用方可跳过 Accept()
+    bool active() const { return active_; }
+
+    // 判断单个目标是否保留。位置按检测框中心判断是否落在 ROI 内。
+    bool Accept(unsigned source_id, int class_id, float confidence, float left,
+                float top, float width, float height) const;
+
+    // 取 count 个置信度中第 k 大的值（0 < k < count），NaN 视为最小。
+    // 置信度大于返回值的目标全部保留；等于返回值的目标按原有顺序保留前 ties 个。
+    float TopConfidence(const float *confidence, size_t count, size_t k, size_t &ties) const;
+
+  private:
+    struct Point
+    {
+        float x;
+        float y;
+    };
+
+    // ROI 多边形，外接矩形用于快速排除
+    struct Polygon
+    {
+        std::vector<Point> points;
+        float              min_x;
+        float              min_y;
+        float              max_x;
+        float              max_y;
+    };
+
+    static bool Contains(const Polygon &polygon, float x, float y);
+
+    void Rebuild();
+
+    float                              min_confidence_; // 默认最小置信度，不过滤时为 -inf
+    std::vector<std::pair<int, float>> class_overrides_;
+    std::vector<float>                 class_min_; // class_id → 最小置信度（含默认值）
+    float                              min_area_ = 0.0f;
+    std::vector<std::vector<Polygon>>  roi_; // source_id → ROI 多边形
+    unsigned                           max_targets_ = 0;
+    bool                               active_ = false;
+    mutable std::vector<float>         scratch_; // TopConfidence 的选择缓冲
+};
+
+#endif // TARGET_FILTER_H
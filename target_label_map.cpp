@@ -0,0 +1,287 @@
+#include "target_label_map.h"
+#include "eo_protocol_parser.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+// FNV-1a 64 位哈希，同时返回字符串长度
+uint64_t HashLabel(const char *label, size_t &length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    size_t   i = 0;
+    for (; label[i] != '\0'; ++i)
+    {
+        hash ^= static_cast<unsigned char>(label[i]);
+        hash *= 1099511628211ULL;
+    }
+    length = i;
+    return hash;
+}
+
+std::string Trim(const std::string &text)
+{
+    const char *spaces = " \t\r\n";
+    size_t      begin = text.find_first_not_of(spaces);
+    if (begin == std::string::npos)
+    {
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(spaces);
+    return text.substr(begin, end - begin + 1);
+}
+
+bool ParseInt(const std::string &text, long minValue, long maxValue, int &value)
+{
+    if (text.empty())
+    {
+        return false;
+    }
+    char *end = NULL;
+    errno = 0;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || parsed < minValue || parsed > maxValue)
+    {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+} // namespace
+
+TargetLabelMap::TargetLabelMap()
+{
+    empty_.tar_category = static_cast<int>(TargetClass::UNKNOWN);
+    empty_.tar_iden = "unknown";
+    fallback_.tar_category = static_cast<int>(TargetClass::UNKNOWN);
+    fallback_.tar_iden = "unknown";
+    LoadDefaults();
+}
+
+void TargetLabelMap::Clear()
+{
+    entries_.clear();
+    slots_.assign(64, Slot{0, -1});
+    class_table_.clear();
+    configured_ = 0;
+}
+
+void TargetLabelMap::LoadDefaults()
+{
+    static const char *kPedestrianLabels[] = {"人", "person", "Person",
+                                              "pedestrian", "Pedestrian"};
+    static const char *kUavLabels[] = {"无人机", "uav", "UAV", "drone", "Drone"};
+
+    Clear();
+    for (const char *label : kPedestrianLabels)
+    {
+        Insert(label, static_cast<int>(TargetClass::PEDESTRIAN), label);
+    }
+    for (const char *label : kUavLabels)
+    {
+        Insert(label, static_cast<int>(TargetClass::UAV), label);
+    }
+    configured_ = entries_.size();
+}
+
+bool TargetLabelMap::LoadFile(const char *path, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = std::string("cannot open ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    struct Row
+    {
+        int         class_id;
+        std::string label;
+        int         tar_category;
+        std::string tar_iden;
+    };
+    std::vector<Row> rows;
+    std::string      line;
+    int              line_number = 0;
+
+    while (std::getline(file, line))
+    {
+        ++line_number;
+        std::string content = Trim(line);
+        if (content.empty() || content[0] == '#')
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        size_t                   begin = 0;
+        for (;;)
+        {
+            size_t comma = content.find(',', begin);
+            fields.push_back(Trim(content.substr(begin, comma - begin)));
+            if (comma == std::string::npos)
+                break;
+            begin = comma + 1;
+        }
+
+        Row row;
+        if (fields.size() < 3 || fields.size() > 4)
+        {
+            error = "line " + std::to_string(line_number) +
+                    ": expected class_id, label, tar_category[, tar_iden]";
+            return false;
+        }
+        row.class_id = -1;
+        if (!fields[0].empty() &&
+            !ParseInt(fields[0], 0, kMaxClassId - 1, row.class_id))
+        {
+            error = "line " + std::to_string(line_number) +
+                    ": class_id must be empty or 0~" +
+                    std::to_string(kMaxClassId - 1);
+            return false;
+        }
+        row.label = fields[1];
+        if (row.label.empty() && row.class_id < 0)
+        {
+            error = "line " + std::to_string(line_number) +
+                    ": label and class_id are both empty";
+            return false;
+        }
+        if (!ParseInt(fields[2], -2147483647L - 1, 2147483647L,
+                      row.tar_category))
+        {
+            error = "line " + std::to_string(line_number) +
+                    ": invalid tar_category '" + fields[2] + "'";
+            return false;
+        }
+        row.tar_iden = (fields.size() == 4 && !fields[3].empty()) ? fields[3]
+                                                                  : row.label;
+        rows.push_back(row);
+    }
+
+    // 全部解析成功后再替换，失败时保留原映射
+    Clear();
+    for (const Row &row : rows)
+    {
+        int32_t entry = Insert(row.label, row.tar_category, row.tar_iden);
+        if (row.class_id >= 0)
+        {
+            if (class_table_.size() <= static_cast<size_t>(row.class_id))
+            {
+                class_table_.resize(row.class_id + 1, -1);
+            }
+            class_table_[row.class_id] = entry;
+        }
+    }
+    configured_ = entries_.size();
+    return true;
+}
+
+const TargetLabelEntry &TargetLabelMap::Lookup(int class_id, const char *label)
+{
+    if (class_id >= 0 && static_cast<size_t>(class_id) < class_table_.size() &&
+        class_table_[class_id] >= 0)
+    {
+        return entries_[class_table_[class_id]];
+    }
+    if (label == NULL || label[0] == '\0')
+    {
+        return empty_;
+    }
+
+    size_t   length;
+    uint64_t hash = HashLabel(label, length);
+    int32_t  entry = Find(label, length, hash);
+    if (entry >= 0)
+    {
+        return entries_[entry];
+    }
+
+    // 未配置的标签：类别为 UNKNOWN，tar_iden 沿用原始标签名；
+    // 驻留已满时统一返回固定的 "unknown" 条目，已返回的条目内容不再改变
+    if (entries_.size() - configured_ >= kMaxInternedLabels)
+    {
+        return fallback_;
+    }
+    entry = Insert(std::string(label, length),
+                   static_cast<int>(TargetClass::UNKNOWN),
+                   std::string(label, length));
+    return entries_[entry];
+}
+
+int32_t TargetLabelMap::Insert(const std::string &label, int tar_category,
+                               const std::string &tar_iden)
+{
+    size_t   length;
+    uint64_t hash = HashLabel(label.c_str(), length);
+    int32_t  entry = label.empty() ? -1 : Find(label.c_str(), length, hash);
+    if (entry >= 0)
+    {
+        entries_[entry].tar_category = tar_category;
+        entries_[entry].tar_iden = tar_iden;
+        return entry;
+    }
+
+    entries_.push_back(TargetLabelEntry{label, tar_category, tar_iden});
+    entry = static_cast<int32_t>(entries_.size() - 1);
+    if (!label.empty())
+    {
+        // 负载因子保持在 1/2 以下
+        if ((entries_.size() + 1) * 2 > slots_.size())
+        {
+            Rehash(slots_.size() * 2);
+        }
+        InsertSlot(hash, entry);
+    }
+    return entry;
+}
+
+int32_t TargetLabelMap::Find(const char *label, size_t length,
+                             uint64_t hash) const
+{
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const Slot &slot = slots_[i];
+        if (slot.entry < 0)
+        {
+            return -1;
+        }
+        if (slot.hash == hash)
+        {
+            const std::string &key = entries_[slot.entry].label;
+            if (key.size() == length && memcmp(key.data(), label, length) == 0)
+            {
+                return slot.entry;
+            }
+        }
+    }
+}
+
+void TargetLabelMap::InsertSlot(uint64_t hash, int32_t entry)
+{
+    const size_t mask = slots_.size() - 1;
+    size_t       i = hash & mask;
+    while (slots_[i].entry >= 0)
+    {
+        i = (i + 1) & mask;
+    }
+    slots_[i].hash = hash;
+    slots_[i].entry = entry;
+}
+
+void TargetLabelMap::Rehash(size_t slot_count)
+{
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.assign(slot_count, Slot{0, -1});
+    for (const Slot &slot : old)
+    {
+        if (slot.entry >= 0)
+        {
+            InsertSlot(slot.hash, slot.entry);
+        }
+    }
+}
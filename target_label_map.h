@@ -0,0 +1,72 @@
+#ifndef TARGET_LABEL_MAP_H
+#define TARGET_LABEL_MAP_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// 标签映射结果（驻留字符串，地址在所属 TargetLabelMap 生命周期内不变）
+struct TargetLabelEntry
+{
+    std::string label;        // DeepStream 标签名（查找键）
+    int         tar_category; // 映射后的目标类别编码
+    std::string tar_iden;     // 映射后的目标标签名
+};
+
+// DeepStream 标签到 EO 目标类别的映射表
+// 先按 class_id 直接索引，未配置时按标签名开放寻址哈希查找；
+// 未配置的标签首次出现时驻留为 UNKNOWN 类别，之后的查找不再分配内存；
+// 驻留已满后未配置的标签统一映射为 tar_iden 为 "unknown" 的固定条目。
+// 查找可能驻留新标签，只能在单个线程中调用；返回的条目内容不再改变，
+// 可交给其他线程读取，直到下一次 LoadFile() 或析构。
+class TargetLabelMap
+{
+  public:
+    // 构造后即包含内置默认映射（人/person/pedestrian → 行人，无人机/uav/drone → 无人机）
+    TargetLabelMap();
+
+    TargetLabelMap(const TargetLabelMap &) = delete;
+    TargetLabelMap &operator=(const TargetLabelMap &) = delete;
+
+    // 从映射文件加载，替换内置默认映射。
+    // 每行格式：class_id, label, tar_category[, tar_iden]，# 开头为注释；
+    // class_id 留空表示只按标签名匹配，tar_iden 留空表示沿用 label。
+    // 失败时返回 false 并在 error 中给出行号和原因，原有映射保持不变。
+    bool LoadFile(const char *path, std::string &error);
+
+    // 查找标签映射，class_id < 0 或未按编号配置时按 label 查找；label 可为 NULL
+    const TargetLabelEntry &Lookup(int class_id, const char *label);
+
+    size_t size() const { return entries_.size(); }
+
+  private:
+    struct Slot
+    {
+        uint64_t hash;
+        int32_t  entry; // entries_ 下标，-1 为空槽
+    };
+
+    // 未配置标签的驻留上限，超出后统一返回 fallback_
+    static const size_t kMaxInternedLabels = 256;
+    // 按 class_id 直接索引的上限
+    static const int kMaxClassId = 1024;
+
+    void Clear();
+    void LoadDefaults();
+    // 插入映射，同名标签以后者为准；返回条目下标
+    int32_t Insert(const std::string &label, int tar_category,
+                   const std::string &tar_iden);
+    int32_t Find(const char *label, size_t length, uint64_t hash) const;
+    void    InsertSlot(uint64_t hash, int32_t entry);
+    void    Rehash(size_t slot_count);
+
+    std::deque<TargetLabelEntry> entries_;     // deque 保证条目地址稳定
+    std::vector<Slot>            slots_;       // 开放寻址表，容量为 2 的幂
+    std::vector<int32_t>         class_table_; // class_id → entries_ 下标，-1 未配置
+    size_t                       configured_ = 0; // 配置条目数，其余为驻留的未知标签
+    TargetLabelEntry             empty_;          // 空标签
+    TargetLabelEntry             fallback_;       // 驻留已满时的未知标签，内容固定
+};
+
+#endif // TARGET_LABEL_MAP_H
@@ -0,0 +1,155 @@
+#include "eo_protocol_parser.h"
+#include <cstring>
+#include <iostream>
+
+// 二进制报文（BodyType::BINARY）往返与校验测试
+
+static bool SameTarget(const EOTargetInfo &a, const EOTargetInfo &b)
+{
+    return a.yr == b.yr && a.mo == b.mo && a.dy == b.dy && a.h == b.h &&
+           a.min == b.min && a.sec == b.sec && a.msec == b.msec &&
+           a.dev_id == b.dev_id && a.guid_id == b.guid_id &&
+           a.tar_id == b.tar_id && a.trk_stat == b.trk_stat &&
+           a.trk_mod == b.trk_mod && a.fov_angle == b.fov_angle &&
+           a.lon == b.lon && a.lat == b.lat && a.alt == b.alt &&
+           a.tar_a == b.tar_a && a.tar_e == b.tar_e && a.tar_rng == b.tar_rng &&
+           a.tar_av == b.tar_av && a.tar_ev == b.tar_ev &&
+           a.tar_rv == b.tar_rv && a.tar_category == b.tar_category &&
+           a.tar_iden == b.tar_iden && a.tar_cfid == b.tar_cfid &&
+           a.fov_h == b.fov_h && a.fov_v == b.fov_v &&
+           a.offset_h == b.offset_h && a.offset_v == b.offset_v &&
+           a.tar_rect == b.tar_rect && a.source_id == b.source_id;
+}
+
+int main()
+{
+    std::vector<EOTargetInfo> targets;
+    for (int i = 0; i < 20; ++i)
+    {
+        EOTargetInfo t = {};
+        t.yr = 2025;
+        t.mo = 10;
+        t.dy = 28;
+        t.h = 14;
+        t.min = 30;
+        t.sec = 45;
+        t.msec = 123.456f + i;
+        t.trk_stat = 1;
+        t.tar_category = static_cast<int>(TargetClass::UAV);
+        t.tar_iden = (i % 2) ? "无人机" : "person";
+        t.tar_cfid = 0.5f + i * 0.01f;
+        t.tar_rect = 100 * i - 500;
+        t.source_id = i % 4;
+        if (i == 3)
+        {
+            t.lon = 116.3912345678;
+            t.lat = 39.9;
+            t.fov_v = -0.0001;
+        }
+        targets.push_back(t);
+    }
+
+    std::vector<uint8_t> buffer(
+        EOProtocolParser::GetMaxEOTargetBinaryMessageSize(targets.size()));
+    size_t length = EOProtocolParser::PackEOTargetBinaryMessage(
+        targets.data(), targets.size(), 77, buffer.data(), buffer.size());
+    if (length == 0 || !EOProtocolParser::IsBinaryMessage(buffer.data(), length))
+    {
+        std::cerr << "Failed to pack binary message!" << std::endl;
+        return 1;
+    }
+
+    // 通过统一入口自动识别格式
+    MessageHeader             header;
+    std::vector<EOTargetInfo> parsed;
+    if (!EOProtocolParser::ParseEOTargetMessage(buffer.data(), length, header,
+                                                parsed) ||
+        header.msg_sn != 77 || header.cont_sum != 20 ||
+        header.msg_id != 0x7112 || parsed.size() != targets.size())
+    {
+        std::cerr << "Binary round-trip parse failed" << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        if (!SameTarget(parsed[i], targets[i]))
+        {
+            std::cerr << "Target " << i << " differs after round-trip"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // 任意单字节损坏都必须被拒绝
+    for (size_t i = 0; i < length; ++i)
+    {
+        std::vector<uint8_t> corrupted(buffer.begin(), buffer.begin() + length);
+        corrupted[i] ^= 0x5A;
+        if (EOProtocolParser::ParseEOTargetMessage(corrupted.data(), length,
+                                                   header, parsed) &&
+            parsed.size() == targets.size() && SameTarget(parsed[0], targets[0]) &&
+            header.msg_sn == 77)
+        {
+            // 校验和允许极少数互相抵消的情况，但帧结构字段必须被拒绝
+            if (i < 8 || i >= length - 4)
+            {
+                std::cerr << "Corruption at byte " << i << " not detected"
+                          << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // 截断报文
+    if (EOProtocolParser::ParseEOTargetMessage(buffer.data(), length - 1, header,
+                                               parsed))
+    {
+        std::cerr << "Truncated message was accepted" << std::endl;
+        return 1;
+    }
+
+    // 超长标签按 UTF-8 字符边界截断到不超过 63 字节，二进制与 JSON 往返结果一致
+    std::string longLabel = "a";
+    for (int i = 0; i < 30; ++i)
+    {
+        longLabel += "鸟";
+    }
+    const EOIdenString truncated(longLabel);
+    if (truncated.size() != 61 || truncated != longLabel.substr(0, 61))
+    {
+        std::cerr << "Label truncated to " << truncated.size() << " bytes" << std::endl;
+        return 1;
+    }
+    EOIdenString ascii;
+    ascii = std::string(70, 'a');
+    if (ascii.size() != EOIdenString::kCapacity)
+    {
+        std::cerr << "ASCII label truncated to " << ascii.size() << " bytes" << std::endl;
+        return 1;
+    }
+    targets[0].tar_iden = longLabel;
+    length = EOProtocolParser::PackEOTargetBinaryMessage(
+        targets.data(), targets.size(), 78, buffer.data(), buffer.size());
+    if (length == 0 ||
+        !EOProtocolParser::ParseEOTargetMessage(buffer.data(), length, header, parsed) ||
+        parsed[0].tar_iden != truncated)
+    {
+        std::cerr << "Long label binary round-trip failed" << std::endl;
+        return 1;
+    }
+    std::vector<uint8_t> longJson =
+        EOProtocolParser::PackEOTargetMessage(targets, 78);
+    if (!EOProtocolParser::ParseEOTargetMessage(longJson.data(), longJson.size(), header,
+                                                parsed) ||
+        parsed[0].tar_iden != truncated)
+    {
+        std::cerr << "Long label JSON round-trip failed" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> json =
+        EOProtocolParser::PackEOTargetMessage(targets, 77);
+    std::cout << "Binary round-trip OK: " << length << " bytes (JSON "
+              << json.size() << " bytes)" << std::endl;
+    return 0;
+}
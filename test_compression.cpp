@@ -0,0 +1,213 @@
+#include "eo_compression.h"
+#include "test_expect.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 压缩测试：LZ4 与 deflate 带/不带字典往返、不值得压缩的报文、损坏与截断的压缩报文、
+// 字典不一致、训练字典提高压缩率、抓包文件读写
+
+// 与实际 JSON 报文结构相近的样本：字段名固定、数值随机
+static std::vector<uint8_t> MakeMessage(unsigned index)
+{
+    std::string text = "{\"source_id\":" + std::to_string(index % 4) + ",\"frame_num\":" +
+                       std::to_string(1000 + index) + ",\"timestamp\":" +
+                       std::to_string(1700000000000LL + index * 40) + ",\"targets\":[";
+    const int targets = 1 + rand() % 6;
+    for (int t = 0; t < targets; ++t)
+    {
+        if (t > 0)
+            text += ",";
+        text += "{\"object_id\":" + std::to_string(rand() % 500) +
+                ",\"class_id\":" + std::to_string(rand() % 5) +
+                ",\"label\":\"vehicle\",\"confidence\":0." + std::to_string(rand() % 1000) +
+                ",\"bbox\":{\"left\":" + std::to_string(rand() % 1920) +
+                ",\"top\":" + std::to_string(rand() % 1080) +
+                ",\"width\":" + std::to_string(rand() % 300) +
+                ",\"height\":" + std::to_string(rand() % 300) + "}}";
+    }
+    text += "]}";
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+static bool RoundTrip(EOCompressor &compressor, EODecompressor &decompressor,
+                      const std::vector<uint8_t> &message, size_t *compressedSize = nullptr)
+{
+    const size_t size = compressor.Compress(message.data(), message.size());
+    if (compressedSize != nullptr)
+        *compressedSize = size > 0 ? size : message.size();
+    if (size == 0)
+        return true; // 不值得压缩，发送原报文
+    if (!IsEOCompressedMessage(compressor.output(), size))
+        return false;
+    const size_t length = decompressor.Decompress(compressor.output(), size);
+    return length == message.size() &&
+           std::equal(message.begin(), message.end(), decompressor.output());
+}
+
+// 各样本压缩后总长 / 原总长
+static double Ratio(EOCompression codec, const std::vector<uint8_t> &dictionary,
+                    const std::vector<std::vector<uint8_t>> &messages, bool &intact)
+{
+    EOCompressor   compressor;
+    EODecompressor decompressor;
+    std::string    error;
+    compressor.Configure(codec, dictionary, error);
+    decompressor.SetDictionary(dictionary);
+    size_t original = 0;
+    size_t compressed = 0;
+    for (const std::vector<uint8_t> &message : messages)
+    {
+        size_t size = 0;
+        intact &= RoundTrip(compressor, decompressor, message, &size);
+        original += message.size();
+        compressed += size;
+    }
+    return static_cast<double>(compressed) / original;
+}
+
+int main()
+{
+    bool ok = true;
+    srand(7);
+
+    std::vector<std::vector<uint8_t>> training;
+    std::vector<std::vector<uint8_t>> messages;
+    for (unsigned i = 0; i < 400; ++i)
+        training.push_back(MakeMessage(i));
+    for (unsigned i = 0; i < 200; ++i)
+        messages.push_back(MakeMessage(10000 + i));
+
+    // 参数检查与默认状态
+    {
+        EOCompressor compressor;
+        std::string  error;
+        ok &= Expect(compressor.Compress(messages[0].data(), messages[0].size()) == 0,
+                     "disabled by default");
+        ok &= Expect(!compressor.Configure(static_cast<EOCompression>(9), {}, error),
+                     "unknown codec");
+        ok &= Expect(!compressor.Configure(EOCompression::LZ4,
+                                           std::vector<uint8_t>(kEOMaxDictionarySize + 1),
+                                           error),
+                     "dictionary too large");
+        ok &= Expect(compressor.codec() == EOCompression::NONE, "configuration unchanged");
+    }
+
+    // 训练的字典：大小受限、有 ID、明显提高压缩率
+    const std::vector<uint8_t> dictionary = EOTrainDictionary(training, 4096);
+    ok &= Expect(!dictionary.empty() && dictionary.size() <= 4096, "trained dictionary size",
+                 static_cast<int>(dictionary.size()));
+    ok &= Expect(EODictionaryId(dictionary.data(), dictionary.size()) != 0, "dictionary id");
+    ok &= Expect(EODictionaryId(nullptr, 0) == 0, "empty dictionary id");
+
+    for (EOCompression codec : {EOCompression::LZ4, EOCompression::DEFLATE})
+    {
+        const int  id = static_cast<int>(codec);
+        bool       intact = true;
+        const double plain = Ratio(codec, {}, messages, intact);
+        const double trained = Ratio(codec, dictionary, messages, intact);
+        ok &= Expect(intact, "round trip", id);
+        ok &= Expect(plain < 1.0, "compresses without dictionary", id);
+        ok &= Expect(trained < plain * 0.8, "dictionary improves ratio", id);
+        std::cout << (codec == EOCompression::LZ4 ? "lz4" : "deflate") << " ratio " << plain
+                  << " -> " << trained << " with dictionary" << std::endl;
+
+        EOCompressor   compressor;
+        EODecompressor decompressor;
+        std::string    error;
+        compressor.Configure(codec, dictionary, error);
+        decompressor.SetDictionary(dictionary);
+
+        // 太短与不可压缩的报文不压缩
+        const std::vector<uint8_t> tiny = {'{', '}'};
+        ok &= Expect(compressor.Compress(tiny.data(), tiny.size()) == 0, "tiny message", id);
+        std::vector<uint8_t> noise(1200);
+        for (uint8_t &byte : noise)
+            byte = static_cast<uint8_t>(rand());
+        ok &= Expect(compressor.Compress(noise.data(), noise.size()) == 0, "incompressible", id);
+
+        // 长重复（匹配长度扩展字节）与重叠匹配
+        std::vector<uint8_t> repeated(5000, 'a');
+        repeated[100] = 'b';
+        ok &= Expect(RoundTrip(compressor, decompressor, repeated), "long repeat", id);
+
+        // 损坏与截断的压缩报文被拒绝，不越界
+        const std::vector<uint8_t> &message = messages[3];
+        const size_t size = compressor.Compress(message.data(), message.size());
+        ok &= Expect(size > 0, "compressed", id);
+        std::vector<uint8_t> packet(compressor.output(), compressor.output() + size);
+        for (size_t cut = kEOCompressedHeaderSize; cut < packet.size(); cut += 7)
+        {
+            ok &= Expect(decompressor.Decompress(packet.data(), cut) == 0, "truncated",
+                         static_cast<int>(cut));
+        }
+        size_t accepted = 0;
+        for (size_t i = kEOCompressedHeaderSize; i < packet.size(); ++i)
+        {
+            std::vector<uint8_t> corrupt = packet;
+            corrupt[i] ^= 0xA5;
+            const size_t length = decompressor.Decompress(corrupt.data(), corrupt.size());
+            accepted += length == message.size();
+        }
+        ok &= Expect(accepted < packet.size() / 2, "corruption mostly detected",
+                     static_cast<int>(accepted));
+        std::vector<uint8_t> wrong_length = packet;
+        wrong_length[8] ^= 1;
+        ok &= Expect(decompressor.Decompress(wrong_length.data(), wrong_length.size()) == 0,
+                     "length mismatch", id);
+
+        // 字典不一致或接收端没有字典
+        EODecompressor other;
+        ok &= Expect(other.Decompress(packet.data(), packet.size()) == 0, "missing dictionary",
+                     id);
+        std::vector<uint8_t> changed = dictionary;
+        changed[0] ^= 1;
+        other.SetDictionary(changed);
+        ok &= Expect(other.Decompress(packet.data(), packet.size()) == 0 &&
+                         std::string(other.error()) == "compression dictionary mismatch",
+                     "dictionary mismatch", id);
+
+        // 不用字典压缩的报文，有字典的接收端也能解压
+        EOCompressor plain_compressor;
+        plain_compressor.Configure(codec, {}, error);
+        ok &= Expect(RoundTrip(plain_compressor, decompressor, message), "plain to dictionary",
+                     id);
+    }
+
+    // 非压缩报文不被识别
+    ok &= Expect(!IsEOCompressedMessage(messages[0].data(), messages[0].size()), "json");
+
+    // 抓包文件与字典文件读写
+    {
+        const char *capture = "test_compression.capture";
+        FILE       *file = fopen(capture, "wb");
+        for (size_t i = 0; i < 3; ++i)
+            EOAppendCaptureRecord(file, messages[i].data(), messages[i].size());
+        fclose(file);
+        std::vector<std::vector<uint8_t>> samples;
+        std::string                       error;
+        ok &= Expect(EOReadCaptureFile(capture, samples, error) && samples.size() == 3 &&
+                         samples[2] == messages[2],
+                     "capture file");
+
+        file = fopen(capture, "ab");
+        fputc(1, file);
+        fclose(file);
+        ok &= Expect(!EOReadCaptureFile(capture, samples, error), "truncated capture file");
+
+        std::vector<uint8_t> loaded;
+        ok &= Expect(EOLoadDictionaryFile(capture, loaded, error) && !loaded.empty(),
+                     "dictionary file");
+        remove(capture);
+        ok &= Expect(!EOLoadDictionaryFile(capture, loaded, error), "missing dictionary file");
+    }
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "compression OK" << std::endl;
+    return 0;
+}
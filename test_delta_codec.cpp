@@ -0,0 +1,200 @@
+#include "eo_delta_codec.h"
+#include "eo_protocol_parser.h"
+#include "test_expect.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 差分帧测试：关键帧/差分帧往返一致、关键帧间隔、丢帧后等待关键帧、报文校验
+
+static bool SameTarget(const EOTargetInfo &a, const EOTargetInfo &b)
+{
+    return a.yr == b.yr && a.mo == b.mo && a.dy == b.dy && a.h == b.h &&
+           a.min == b.min && a.sec == b.sec &&
+           memcmp(&a.msec, &b.msec, sizeof(a.msec)) == 0 &&
+           a.tar_id == b.tar_id && a.trk_stat == b.trk_stat &&
+           a.trk_mod == b.trk_mod && a.fov_angle == b.fov_angle &&
+           a.offset_h == b.offset_h && a.offset_v == b.offset_v &&
+           a.tar_category == b.tar_category && a.tar_iden == b.tar_iden &&
+           memcmp(&a.tar_cfid, &b.tar_cfid, sizeof(a.tar_cfid)) == 0 &&
+           a.tar_rect == b.tar_rect && a.tar_rng == b.tar_rng &&
+           a.lon == b.lon && a.lat == b.lat && a.alt == b.alt &&
+           a.source_id == b.source_id && a.guid_id == b.guid_id &&
+           a.dev_id == b.dev_id;
+}
+
+// 第 frame 帧的目标：位置逐帧移动，第 7 帧起多一个目标，第 9 帧改标签
+static std::vector<EOTargetInfo> MakeFrame(int frame, int source)
+{
+    std::vector<EOTargetInfo> targets(frame >= 7 ? 6 : 5);
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        EOTargetInfo &t = targets[i];
+        t = EOTargetInfo();
+        t.yr = 2025;
+        t.mo = 6;
+        t.dy = 1;
+        t.h = 23;
+        t.min = 59;
+        t.sec = 59 + frame / 25;
+        t.msec = static_cast<float>((frame * 40) % 1000);
+        t.tar_id = static_cast<int>(i);
+        t.trk_stat = 1;
+        t.tar_category = 9;
+        t.tar_iden = (frame >= 9 && i == 2) ? "鸟" : "无人机";
+        t.tar_cfid = 0.5f + 0.01f * static_cast<float>(i) + 0.001f * frame;
+        t.tar_rect = static_cast<int>(100 * i) + frame;
+        t.offset_h = -3 * frame;
+        t.source_id = source;
+        t.tar_rng = (i == 1) ? 1234.5 + frame : 0.0;
+        t.lon = 116.3;
+    }
+    return targets;
+}
+
+static bool SameTargets(const std::vector<EOTargetInfo> &a,
+                        const std::vector<EOTargetInfo> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (!SameTarget(a[i], b[i]))
+            return false;
+    }
+    return true;
+}
+
+// 按插件的方式发送一帧：优先差分帧，否则发送关键帧并记录参考
+static size_t Send(EODeltaEncoder &encoder, int source,
+                   const std::vector<EOTargetInfo> &targets, uint16_t sn,
+                   std::vector<uint8_t> &buffer, bool &isDelta)
+{
+    size_t size = encoder.PackDelta(source, targets.data(), targets.size(), sn,
+                                    buffer.data(), 1472);
+    isDelta = size > 0;
+    if (!isDelta)
+    {
+        size = EOProtocolParser::PackEOTargetBinaryMessage(
+            targets.data(), targets.size(), sn, buffer.data(), buffer.size());
+        encoder.CommitKeyframe(source, targets.data(), targets.size(), sn);
+    }
+    return size;
+}
+
+// 按接收端的方式处理一个报文
+static bool Receive(EODeltaDecoder &decoder, const std::vector<uint8_t> &buffer,
+                    size_t size, std::vector<EOTargetInfo> &out)
+{
+    MessageHeader header;
+    if (EOProtocolParser::IsDeltaMessage(buffer.data(), size))
+    {
+        return decoder.Decode(buffer.data(), size, header, out);
+    }
+    if (!EOProtocolParser::ParseEOTargetMessage(buffer.data(), size, header, out))
+    {
+        return false;
+    }
+    decoder.OnKeyframe(header, out, true);
+    return true;
+}
+
+int main()
+{
+    bool                      ok = true;
+    EODeltaEncoder            encoder(4);
+    EODeltaDecoder            decoder;
+    std::vector<uint8_t>      buffer(65536);
+    std::vector<EOTargetInfo> out;
+    size_t                    keyframes = 0;
+    size_t                    delta_bytes = 0;
+    size_t                    key_bytes = 0;
+    uint16_t                  sn = 65530; // 跨越 msg_sn 回绕
+
+    // 两个视频源交替发送，msg_sn 全局递增
+    for (int frame = 0; frame < 12; ++frame)
+    {
+        for (int source = 0; source < 2; ++source)
+        {
+            std::vector<EOTargetInfo> targets = MakeFrame(frame, source);
+            bool   is_delta = false;
+            size_t size = Send(encoder, source, targets, ++sn, buffer, is_delta);
+            keyframes += is_delta ? 0 : 1;
+            (is_delta ? delta_bytes : key_bytes) += size;
+
+            ok &= Expect(Receive(decoder, buffer, size, out), "receive", frame);
+            ok &= Expect(SameTargets(out, targets), "round trip", frame);
+            if (is_delta)
+            {
+                MessageHeader header;
+                std::vector<EOTargetInfo> ignored;
+                ok &= Expect(!EOProtocolParser::ParseEOTargetMessage(
+                                 buffer.data(), size, header, ignored),
+                             "full parser rejects delta frame");
+            }
+        }
+    }
+    // 每个源：第 0、5、10 帧为关键帧
+    ok &= Expect(keyframes == 6, "keyframe interval", (long)keyframes);
+    ok &= Expect(delta_bytes * keyframes * 3 < key_bytes * (24 - keyframes),
+                 "delta frames a third of keyframes",
+                 (long)delta_bytes);
+    ok &= Expect(decoder.decoded() == 18 && decoder.gaps() == 0, "decoded count",
+                 (long)decoder.decoded());
+
+    // 丢失一个差分帧：后续差分帧被丢弃，直到下一个关键帧
+    encoder.Reset();
+    decoder.Reset();
+    bool   is_delta = false;
+    size_t size = Send(encoder, 3, MakeFrame(0, 3), ++sn, buffer, is_delta);
+    ok &= Expect(!is_delta && Receive(decoder, buffer, size, out), "keyframe after reset");
+    Send(encoder, 3, MakeFrame(1, 3), ++sn, buffer, is_delta); // 丢失
+    size = Send(encoder, 3, MakeFrame(2, 3), ++sn, buffer, is_delta);
+    ok &= Expect(is_delta && !Receive(decoder, buffer, size, out) &&
+                     decoder.gaps() == 1,
+                 "gap detected");
+    size = Send(encoder, 3, MakeFrame(3, 3), ++sn, buffer, is_delta);
+    ok &= Expect(is_delta && !Receive(decoder, buffer, size, out),
+                 "waiting for keyframe");
+    Send(encoder, 3, MakeFrame(4, 3), ++sn, buffer, is_delta);
+    size = Send(encoder, 3, MakeFrame(5, 3), ++sn, buffer, is_delta);
+    ok &= Expect(!is_delta && Receive(decoder, buffer, size, out) &&
+                     SameTargets(out, MakeFrame(5, 3)),
+                 "recovered at keyframe");
+
+    // 损坏的差分帧
+    size = Send(encoder, 3, MakeFrame(6, 3), ++sn, buffer, is_delta);
+    buffer[size / 2] ^= 0x40;
+    ok &= Expect(is_delta && !Receive(decoder, buffer, size, out) &&
+                     decoder.invalid() == 1,
+                 "corrupted delta rejected");
+    for (size_t cut = 0; cut < size; ++cut)
+    {
+        MessageHeader header;
+        uint32_t      source_id = 0;
+        uint16_t      base_sn = 0;
+        if (EOProtocolParser::ReadEOTargetDeltaInfo(buffer.data(), cut, header,
+                                                    source_id, base_sn))
+        {
+            ok &= Expect(false, "truncated delta accepted", (long)cut);
+            break;
+        }
+    }
+
+    // 关键帧间隔为 0 时只发送关键帧
+    EODeltaEncoder keyframes_only(0);
+    std::vector<EOTargetInfo> targets = MakeFrame(0, 1);
+    keyframes_only.CommitKeyframe(1, targets.data(), targets.size(), 1);
+    ok &= Expect(keyframes_only.PackDelta(1, targets.data(), targets.size(), 2,
+                                          buffer.data(), buffer.size()) == 0,
+                 "interval 0 disables delta");
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Delta codec OK (keyframe " << key_bytes / keyframes << " bytes, delta "
+              << delta_bytes / (24 - keyframes) << " bytes)" << std::endl;
+    return 0;
+}
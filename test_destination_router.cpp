@@ -0,0 +1,87 @@
+#include "destination_router.h"
+#include "test_expect.h"
+#include <iostream>
+#include <string>
+
+// 目的地列表与路由表：解析、格式错误时保持原配置、按 source_id 取目的地掩码
+
+int main()
+{
+    bool              ok = true;
+    DestinationRouter router;
+    std::string       error;
+
+    // 未配置：单一目的地
+    ok &= Expect(router.size() == 0 && router.Route(7) == 1 && !router.routed(), "default");
+    ok &= Expect(!router.SetRoutes("0:0", error), "routes need destinations");
+    ok &= Expect(router.SetDestinations("", error) && router.size() == 0, "empty list");
+
+    // 目的地列表
+    ok &= Expect(router.SetDestinations(" 239.1.1.1:5000/eth0, 239.2.2.2:6000 ,10.0.0.5:7000/lo",
+                                        error),
+                 "parse destinations");
+    ok &= Expect(router.size() == 3, "destination count", static_cast<int>(router.size()));
+    ok &= Expect(router.destination(0).host == "239.1.1.1" && router.destination(0).port == 5000 &&
+                     router.destination(0).iface == "eth0",
+                 "first destination");
+    ok &= Expect(router.destination(1).host == "239.2.2.2" && router.destination(1).port == 6000 &&
+                     router.destination(1).iface.empty(),
+                 "destination without iface");
+    ok &= Expect(router.destination(2).iface == "lo", "last destination");
+    ok &= Expect(router.all() == 7 && router.Route(0) == 7, "all destinations");
+
+    // IPv6 目的地写在方括号内，可带作用域
+    ok &= Expect(router.SetDestinations("[ff15::1]:5000/lo,[::1]:6000,[ff02::2%lo]:7000", error) &&
+                     router.size() == 3,
+                 "parse ipv6 destinations");
+    ok &= Expect(router.destination(0).host == "ff15::1" && router.destination(0).iface == "lo" &&
+                     router.destination(2).host == "ff02::2%lo" &&
+                     router.destination(2).port == 7000,
+                 "ipv6 destinations");
+    ok &= Expect(router.SetDestinations(" 239.1.1.1:5000/eth0, 239.2.2.2:6000 ,10.0.0.5:7000/lo",
+                                        error),
+                 "restore destinations");
+
+    // 格式错误：原配置不变
+    const char *invalid[] = {"239.1.1.1", "239.1.1.1:0", "239.1.1.1:70000", "host:5000",
+                             "239.1.1.1:5000/", "239.1.1.1:5000;239.2.2.2:5000",
+                             "239.1.1.1:5000/averyveryverylonginterfacename", "ff15::1:5000",
+                             "[ff15::1:5000", "[ff15::zz]:5000", "[ff02::1%nosuchif0]:5000"};
+    for (const char *spec : invalid)
+    {
+        if (!Expect(!router.SetDestinations(spec, error), spec))
+            ok = false;
+    }
+    ok &= Expect(router.size() == 3, "unchanged after error");
+    std::string many;
+    for (size_t i = 0; i <= DestinationRouter::kMaxDestinations; ++i)
+        many += (i ? "," : "") + std::string("239.0.0.1:") + std::to_string(5000 + i);
+    ok &= Expect(!router.SetDestinations(many, error), "too many destinations");
+
+    // 路由表：未列出的视频源发往全部目的地，重复 source_id 取并集
+    ok &= Expect(router.SetRoutes("0:0, 1:1|2, 5:2, 5:0", error), "parse routes");
+    ok &= Expect(router.routed(), "routed");
+    ok &= Expect(router.Route(0) == 1 && router.Route(1) == 6 && router.Route(5) == 5,
+                 "routes", static_cast<int>(router.Route(5)));
+    ok &= Expect(router.Route(2) == 7 && router.Route(4000) == 7, "unrouted sources");
+
+    const char *invalid_routes[] = {"0:3", "0:", "0", "0:1;1:0", "5000:0", "0:1|"};
+    for (const char *spec : invalid_routes)
+    {
+        if (!Expect(!router.SetRoutes(spec, error), spec))
+            ok = false;
+    }
+    ok &= Expect(router.Route(1) == 6, "routes unchanged after error");
+
+    // 重新配置目的地时清空路由
+    ok &= Expect(router.SetDestinations("239.3.3.3:5000", error) && !router.routed() &&
+                     router.Route(1) == 1,
+                 "reset routes");
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "destination router OK" << std::endl;
+    return 0;
+}
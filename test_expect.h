@@ -0,0 +1,16 @@
+#ifndef TEST_EXPECT_H
+#define TEST_EXPECT_H
+
+#include <iostream>
+
+// 测试断言：条件不成立时打印说明与相关取值，返回条件本身，用法为 ok &= Expect(...)
+inline bool Expect(bool condition, const char *what, long long value = 0)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << what << " (" << value << ")" << std::endl;
+    }
+    return condition;
+}
+
+#endif // TEST_EXPECT_H
@@ -0,0 +1,234 @@
+#include "eo_fec.h"
+#include "eo_protocol_parser.h"
+#include "test_expect.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+// FEC 测试：XOR 与 Reed-Solomon 按丢包模式恢复、超出校验能力计入无法恢复、
+// 迟到原报文去重、格式错误的校验报文
+
+static const int64_t kMs = 1000000LL;
+
+// 长度不一的随机数据报文（实际报文带序号与时间戳，不会重复）
+static std::vector<std::vector<uint8_t>> MakeDatagrams(size_t count, unsigned seed)
+{
+    srand(seed);
+    std::vector<std::vector<uint8_t>> datagrams(count);
+    for (std::vector<uint8_t> &datagram : datagrams)
+    {
+        datagram.resize(1 + rand() % 1200);
+        for (uint8_t &byte : datagram)
+            byte = static_cast<uint8_t>(rand());
+    }
+    return datagrams;
+}
+
+struct Outcome
+{
+    size_t delivered = 0; // 直接收到与恢复出的数据报文
+    bool   intact = true; // 恢复出的报文与原报文一致
+};
+
+// 发送一个分组，按 lost 丢弃数据报文、按 lostParity 丢弃校验报文
+static Outcome RunGroup(EOFecEncoder &encoder, EOFecDecoder &decoder,
+                        const std::vector<std::vector<uint8_t>> &datagrams,
+                        const std::set<size_t> &lost, const std::set<size_t> &lostParity,
+                        int64_t nowNs)
+{
+    Outcome                 outcome;
+    std::vector<uint8_t>    buffer;
+    std::vector<EOFragment> parities;
+    for (size_t i = 0; i < datagrams.size(); ++i)
+    {
+        encoder.Add(datagrams[i].data(), datagrams[i].size(), nowNs);
+        if (lost.count(i) == 0 && decoder.OnData(1, datagrams[i].data(), datagrams[i].size()))
+            ++outcome.delivered;
+    }
+    encoder.Finish(buffer, 0, parities);
+    for (size_t j = 0; j < parities.size(); ++j)
+    {
+        if (lostParity.count(j))
+            continue;
+        decoder.OnParity(1, buffer.data() + parities[j].offset, parities[j].length, nowNs,
+                         [&](const uint8_t *data, size_t length) {
+                             ++outcome.delivered;
+                             bool found = false;
+                             for (size_t i : lost)
+                                 found |= datagrams[i].size() == length &&
+                                          std::equal(data, data + length, datagrams[i].begin());
+                             outcome.intact &= found;
+                         });
+    }
+    return outcome;
+}
+
+// 先发一个分组让接收端开始缓存该发送端
+static void Prime(EOFecEncoder &encoder, EOFecDecoder &decoder, int64_t nowNs)
+{
+    std::vector<std::vector<uint8_t>> datagrams = MakeDatagrams(encoder.group_size(), 99);
+    RunGroup(encoder, decoder, datagrams, std::set<size_t>(), std::set<size_t>(), nowNs);
+}
+
+int main()
+{
+    bool ok = true;
+
+    // 参数检查
+    EOFecEncoder encoder;
+    ok &= Expect(!encoder.enabled(), "disabled by default");
+    ok &= Expect(!encoder.Configure(EOFecEncoder::kMaxGroupSize + 1, 1), "group size limit");
+    ok &= Expect(!encoder.Configure(8, 0), "parity count zero");
+    ok &= Expect(!encoder.Configure(8, EOFecEncoder::kMaxParity + 1), "parity count limit");
+    ok &= Expect(encoder.Configure(0, 0) && !encoder.enabled(), "disable");
+
+    // XOR：每组丢任意一个都能恢复，丢两个则计入无法恢复
+    {
+        EOFecEncoder xor_encoder;
+        EOFecDecoder decoder;
+        xor_encoder.Configure(8, 1);
+        ok &= Expect(xor_encoder.overhead() ==
+                         EOProtocolParser::GetEOFecParityMessageSize(8, 0),
+                     "xor overhead");
+        Prime(xor_encoder, decoder, 0);
+        for (size_t lost = 0; lost < 8; ++lost)
+        {
+            Outcome outcome = RunGroup(xor_encoder, decoder, MakeDatagrams(8, 1000 + lost),
+                                       std::set<size_t>{lost}, std::set<size_t>(), 0);
+            ok &= Expect(outcome.delivered == 8 && outcome.intact, "xor recovery",
+                         static_cast<int>(lost));
+        }
+        ok &= Expect(decoder.recovered() == 8, "xor recovered count",
+                     static_cast<int>(decoder.recovered()));
+
+        Outcome outcome = RunGroup(xor_encoder, decoder, MakeDatagrams(8, 50),
+                                   std::set<size_t>{1, 6}, std::set<size_t>(), 0);
+        ok &= Expect(outcome.delivered == 6, "xor double loss",
+                     static_cast<int>(outcome.delivered));
+        decoder.Expire(EOFecDecoder::kTimeoutNs + kMs);
+        ok &= Expect(decoder.unrecoverable() == 2, "xor unrecoverable",
+                     static_cast<int>(decoder.unrecoverable()));
+    }
+
+    // Reed-Solomon：m = 2..4、k 最大 64，随机丢失不超过 m 个（数据与校验合计）都能恢复
+    for (unsigned m = 2; m <= 4; ++m)
+    {
+        for (unsigned k : {4u, 16u, 64u})
+        {
+            EOFecEncoder rs_encoder;
+            EOFecDecoder decoder;
+            rs_encoder.Configure(k, m);
+            Prime(rs_encoder, decoder, 0);
+            srand(k * 31 + m);
+            for (int round = 0; round < 20; ++round)
+            {
+                std::set<size_t> lost;
+                std::set<size_t> lost_parity;
+                const unsigned   loss = 1 + rand() % m;
+                const unsigned   parity_loss = rand() % (m - loss + 1);
+                while (lost.size() < loss)
+                    lost.insert(rand() % k);
+                while (lost_parity.size() < parity_loss)
+                    lost_parity.insert(rand() % m);
+                Outcome outcome = RunGroup(rs_encoder, decoder, MakeDatagrams(k, round + 100 * m),
+                                           lost, lost_parity, 0);
+                ok &= Expect(outcome.delivered == k && outcome.intact, "rs recovery",
+                             static_cast<int>(k * 100 + m));
+            }
+            ok &= Expect(decoder.unrecoverable() == 0, "rs nothing unrecoverable",
+                         static_cast<int>(decoder.unrecoverable()));
+
+            // 丢失超过 m 个：计入无法恢复
+            if (m >= k)
+                continue;
+            std::set<size_t> too_many;
+            for (size_t i = 0; i <= m; ++i)
+                too_many.insert(i);
+            RunGroup(rs_encoder, decoder, MakeDatagrams(k, 7), too_many, std::set<size_t>(), 0);
+            decoder.Expire(EOFecDecoder::kTimeoutNs + kMs);
+            ok &= Expect(decoder.unrecoverable() == m + 1, "rs unrecoverable",
+                         static_cast<int>(decoder.unrecoverable()));
+        }
+    }
+
+    // 未满的分组（Finish 提前结束）同样可恢复；恢复后迟到的原报文被丢弃
+    {
+        EOFecEncoder partial;
+        EOFecDecoder decoder;
+        partial.Configure(16, 2);
+        Prime(partial, decoder, 0);
+        std::vector<std::vector<uint8_t>> datagrams = MakeDatagrams(5, 3);
+        Outcome outcome = RunGroup(partial, decoder, datagrams, std::set<size_t>{0, 4},
+                                   std::set<size_t>(), 0);
+        ok &= Expect(outcome.delivered == 5 && outcome.intact, "partial group",
+                     static_cast<int>(outcome.delivered));
+        ok &= Expect(!decoder.OnData(1, datagrams[4].data(), datagrams[4].size()),
+                     "late duplicate dropped");
+        ok &= Expect(decoder.OnData(1, datagrams[4].data(), datagrams[4].size()),
+                     "later copy delivered");
+    }
+
+    // 第一次收到校验报文之前的分组不处理：接收端还没有缓存该发送端的数据报文
+    {
+        EOFecEncoder fresh;
+        EOFecDecoder decoder;
+        fresh.Configure(4, 1);
+        Outcome outcome = RunGroup(fresh, decoder, MakeDatagrams(4, 11), std::set<size_t>{2},
+                                   std::set<size_t>(), 0);
+        ok &= Expect(outcome.delivered == 3 && decoder.unrecoverable() == 0, "first group",
+                     static_cast<int>(outcome.delivered));
+    }
+
+    // 格式错误的校验报文被拒绝，数据报文不被识别为校验报文
+    {
+        EOFecEncoder            rs_encoder;
+        EOFecDecoder            decoder;
+        std::vector<uint8_t>    buffer;
+        std::vector<EOFragment> parities;
+        rs_encoder.Configure(4, 2);
+        std::vector<std::vector<uint8_t>> datagrams = MakeDatagrams(4, 5);
+        for (const std::vector<uint8_t> &datagram : datagrams)
+            rs_encoder.Add(datagram.data(), datagram.size(), 0);
+        ok &= Expect(rs_encoder.Finish(buffer, 0, parities) == 2, "parity count");
+        const uint8_t *parity = buffer.data() + parities[0].offset;
+        const size_t   length = parities[0].length;
+        ok &= Expect(EOProtocolParser::IsFecMessage(parity, length), "fec recognized");
+
+        EOFecParity             info;
+        std::vector<EOFecEntry> entries;
+        const uint8_t          *symbol = nullptr;
+        ok &= Expect(EOProtocolParser::ParseEOFecParityMessage(parity, length, info, entries,
+                                                               symbol) &&
+                         info.data_count == 4 && info.parity_count == 2 && info.scheme == 1 &&
+                         entries.size() == 4 && entries[2].length == datagrams[2].size(),
+                     "parse parity");
+
+        std::vector<uint8_t> corrupt(parity, parity + length);
+        corrupt[20] ^= 0x40;
+        ok &= Expect(!EOProtocolParser::ParseEOFecParityMessage(corrupt.data(), corrupt.size(),
+                                                                info, entries, symbol),
+                     "checksum mismatch");
+        ok &= Expect(!decoder.OnParity(1, corrupt.data(), corrupt.size(), 0,
+                                       [](const uint8_t *, size_t) {}),
+                     "decoder rejects corrupt");
+        ok &= Expect(!EOProtocolParser::ParseEOFecParityMessage(parity, length - 1, info,
+                                                                entries, symbol),
+                     "truncated parity");
+
+        const EOHeartbeat source = {1, 2};
+        uint8_t           data[512];
+        size_t            heartbeat = EOProtocolParser::PackEOHeartbeatMessage(
+            &source, 1, BodyType::BINARY, 0, data, sizeof(data));
+        ok &= Expect(heartbeat > 0 && !EOProtocolParser::IsFecMessage(data, heartbeat),
+                     "heartbeat is not fec");
+    }
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "FEC OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include "eo_fragment_reassembler.h"
+#include "eo_protocol_parser.h"
+#include "test_expect.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 分片封装与重组测试：MTU 内拆分、分片自描述、乱序/重复重组、丢片超时输出部分目标
+
+static std::vector<EOTargetInfo> MakeTargets(size_t count)
+{
+    std::vector<EOTargetInfo> targets(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        EOTargetInfo &t = targets[i];
+        t = EOTargetInfo();
+        t.yr = 2025;
+        t.mo = 6;
+        t.dy = 1;
+        t.msec = 12.5f;
+        t.trk_stat = 1;
+        t.tar_category = 9;
+        t.tar_iden = (i % 3 == 0) ? "无人机" : "drone-" + std::to_string(i);
+        t.tar_cfid = 0.5f + (i % 50) * 0.01f;
+        t.tar_rect = static_cast<int>(i * 7);
+        t.source_id = 2;
+        t.tar_rng = (i % 2) ? 1234.5 : 0.0;
+    }
+    return targets;
+}
+
+struct Collected
+{
+    MessageHeader             header;
+    std::vector<EOTargetInfo> targets;
+    bool                      complete;
+    int                       calls = 0;
+};
+
+static bool CheckFormat(BodyType format, const char *name)
+{
+    bool                      ok = true;
+    const size_t              kMaxDatagram = 1472;
+    std::vector<EOTargetInfo> targets = MakeTargets(150);
+    std::vector<uint8_t>      buffer(EOProtocolParser::GetMaxEOTargetFragmentsSize(
+        targets.data(), targets.size(), format));
+    std::vector<EOFragment> fragments;
+
+    size_t n = EOProtocolParser::PackEOTargetFragments(
+        targets.data(), targets.size(), 77, format, kMaxDatagram, buffer.data(),
+        buffer.size(), fragments);
+    ok &= Expect(n > 1 && n == fragments.size(), name, (long)n);
+
+    // 每个分片不超过上限，且能独立解析
+    std::vector<MessageHeader>             headers(n);
+    std::vector<std::vector<EOTargetInfo>> parsed(n);
+    size_t                                 total = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        ok &= Expect(fragments[i].length <= kMaxDatagram, "fragment size",
+                     (long)fragments[i].length);
+        ok &= Expect(EOProtocolParser::ParseEOTargetMessage(
+                         buffer.data() + fragments[i].offset,
+                         fragments[i].length, headers[i], parsed[i]),
+                     "parse fragment", (long)i);
+        ok &= Expect(headers[i].msg_sn == 77 && headers[i].frag_idx == (int)i &&
+                         headers[i].frag_cnt == (int)n &&
+                         headers[i].cont_sum == (int)parsed[i].size() &&
+                         parsed[i].size() == fragments[i].count,
+                     "fragment header", (long)i);
+        total += parsed[i].size();
+    }
+    ok &= Expect(total == targets.size(), "fragment target total", (long)total);
+
+    // 乱序 + 重复分片：收齐后输出一次，目标顺序与发送一致
+    EOFragmentReassembler reassembler;
+    Collected             out;
+    auto                  collect = [&out](const MessageHeader           &header,
+                          const std::vector<EOTargetInfo> &merged,
+                          bool                             complete) {
+        out.header = header;
+        out.targets = merged;
+        out.complete = complete;
+        ++out.calls;
+    };
+    std::vector<size_t> order;
+    for (size_t i = 0; i < n; ++i)
+        order.push_back(n - 1 - i);
+    order.insert(order.begin() + 1, order[0]);
+    for (size_t index : order)
+    {
+        std::vector<EOTargetInfo> copy = parsed[index];
+        reassembler.Push(1, headers[index], copy, 0, collect);
+    }
+    ok &= Expect(out.calls == 1 && out.complete, "reassembled once", out.calls);
+    ok &= Expect(out.targets.size() == targets.size() &&
+                     out.header.cont_sum == (int)targets.size(),
+                 "reassembled size", (long)out.targets.size());
+    for (size_t i = 0; i < out.targets.size() && i < targets.size(); ++i)
+    {
+        if (out.targets[i].tar_rect != targets[i].tar_rect ||
+            out.targets[i].tar_iden != targets[i].tar_iden)
+        {
+            ok &= Expect(false, "reassembled order", (long)i);
+            break;
+        }
+    }
+
+    // 丢失一个分片：超时后输出其余分片的目标
+    out = Collected();
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i == 1)
+            continue;
+        std::vector<EOTargetInfo> copy = parsed[i];
+        reassembler.Push(1, headers[i], copy, 1000, collect);
+    }
+    ok &= Expect(out.calls == 0 && reassembler.pending() == 1, "waiting for loss");
+    reassembler.Expire(1000 + 50 * 1000000LL, collect);
+    ok &= Expect(out.calls == 0, "not yet expired");
+    reassembler.Expire(1000 + 100 * 1000000LL, collect);
+    ok &= Expect(out.calls == 1 && !out.complete &&
+                     out.targets.size() == targets.size() - parsed[1].size(),
+                 "partial after timeout", (long)out.targets.size());
+    ok &= Expect(reassembler.lost_fragments() == 1 && reassembler.pending() == 0,
+                 "loss accounting");
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // 不超过上限时为普通报文：不带分片字段（msec 随时间变化，长度按 ±24 字节比较）
+    std::vector<EOTargetInfo> small = MakeTargets(2);
+    std::vector<uint8_t>      buffer(65536);
+    std::vector<uint8_t>      plain(65536);
+    std::vector<EOFragment>   fragments;
+    size_t n = EOProtocolParser::PackEOTargetFragments(
+        small.data(), small.size(), 5, BodyType::JSON, 1472, buffer.data(),
+        buffer.size(), fragments);
+    size_t plain_size = EOProtocolParser::PackEOTargetMessage(
+        small.data(), small.size(), 5, plain.data(), plain.size());
+    std::string text(reinterpret_cast<char *>(buffer.data()), fragments[0].length);
+    ok &= Expect(n == 1 && text.find("frag_") == std::string::npos,
+                 "single datagram has no fragment fields");
+    ok &= Expect(fragments[0].length + 24 >= plain_size &&
+                     fragments[0].length <= plain_size + 24,
+                 "single datagram size",
+                 (long)fragments[0].length);
+
+    MessageHeader             header;
+    std::vector<EOTargetInfo> parsed;
+    ok &= Expect(EOProtocolParser::ParseEOTargetMessage(
+                     buffer.data(), fragments[0].length, header, parsed) &&
+                     header.frag_cnt == 0,
+                 "single datagram parses unfragmented");
+
+    // 未分片报文直接通过重组器
+    EOFragmentReassembler reassembler;
+    int                   calls = 0;
+    reassembler.Push(0, header, parsed, 0,
+                     [&calls](const MessageHeader &, const std::vector<EOTargetInfo> &,
+                              bool complete) { calls += complete ? 1 : 0; });
+    ok &= Expect(calls == 1, "unfragmented passthrough");
+
+    // 非法分片被拒绝
+    header.frag_cnt = 3;
+    header.frag_idx = 3;
+    reassembler.Push(0, header, parsed, 0,
+                     [&calls](const MessageHeader &, const std::vector<EOTargetInfo> &,
+                              bool) { ++calls; });
+    ok &= Expect(calls == 1 && reassembler.invalid_fragments() == 1,
+                 "invalid fragment index");
+
+    // 单个目标超过上限时独占一个分片：上限 700 字节时普通目标各占一个分片，
+    // 63 字节汉字标签（转义后 126 字节）的目标单独也超过上限
+    std::vector<EOTargetInfo> big = MakeTargets(3);
+    std::string               long_iden;
+    for (int i = 0; i < 21; ++i)
+    {
+        long_iden += "鸟";
+    }
+    big[1].tar_iden = long_iden;
+    n = EOProtocolParser::PackEOTargetFragments(big.data(), big.size(), 6,
+                                                BodyType::JSON, 700, buffer.data(),
+                                                buffer.size(), fragments);
+    ok &= Expect(n == 3 && fragments[1].count == 1 && fragments[1].length > 700 &&
+                     fragments[0].length <= 700 && fragments[2].length <= 700,
+                 "oversized target isolated", (long)n);
+
+    ok &= CheckFormat(BodyType::JSON, "json fragments");
+    ok &= CheckFormat(BodyType::BINARY, "binary fragments");
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Fragmentation OK" << std::endl;
+    return 0;
+}
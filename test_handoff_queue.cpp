@@ -0,0 +1,192 @@
+#include "eo_handoff_queue.h"
+#include "test_expect.h"
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// 交接队列测试：报文环与多生产者队列的满/空边界、跨线程顺序与元素复用
+
+static bool CheckRingBounds()
+{
+    bool           ok = true;
+    EODatagramRing ring(4, 16);
+    ok &= Expect(ring.Writable() == 4 && ring.Readable() == 0, "empty ring");
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EODatagramRing::Slot &slot = ring.WriteSlot(i);
+        slot.data[0] = static_cast<uint8_t>(i);
+        slot.length = i + 1;
+        slot.sender = 100 + i;
+    }
+    ring.Commit(3);
+    ok &= Expect(ring.Writable() == 1 && ring.Readable() == 3, "after commit");
+    ok &= Expect(ring.ReadSlot(2).data[0] == 2 && ring.ReadSlot(2).sender == 102, "read slot");
+    ring.Release(2);
+    ring.WriteSlot(0).length = 9;
+    ring.WriteSlot(1).length = 10;
+    ring.WriteSlot(2).length = 11;
+    ring.Commit(3); // 跨越环尾
+    ok &= Expect(ring.Writable() == 0 && ring.Readable() == 4, "full ring",
+                 (long)ring.Readable());
+    ok &= Expect(ring.ReadSlot(0).length == 3 && ring.ReadSlot(3).length == 11,
+                 "wrapped order");
+    return ok;
+}
+
+// 接收线程写、解析线程读：顺序与内容不变
+static bool CheckRingThreads()
+{
+    const uint32_t kCount = 200000;
+    EODatagramRing ring(64, 8);
+    bool           ok = true;
+
+    std::thread producer([&ring]() {
+        uint32_t next = 0;
+        while (next < kCount)
+        {
+            size_t count = ring.Writable();
+            for (size_t i = 0; i < count && next + i < kCount; ++i)
+            {
+                EODatagramRing::Slot &slot = ring.WriteSlot(i);
+                uint32_t              value = next + static_cast<uint32_t>(i);
+                memcpy(slot.data, &value, sizeof(value));
+                slot.length = sizeof(value);
+            }
+            size_t written = count < kCount - next ? count : kCount - next;
+            ring.Commit(written);
+            next += static_cast<uint32_t>(written);
+            if (written == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    while (expected < kCount && ok)
+    {
+        size_t count = ring.Readable();
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t value = 0;
+            memcpy(&value, ring.ReadSlot(i).data, sizeof(value));
+            ok &= Expect(value == expected, "ring order", (long)value);
+            ++expected;
+        }
+        ring.Release(count);
+    }
+    producer.join();
+    return ok;
+}
+
+struct Item
+{
+    uint32_t              producer = 0;
+    uint32_t              sequence = 0;
+    std::vector<uint32_t> payload;
+};
+
+static bool CheckQueueBounds()
+{
+    bool              ok = true;
+    EOMpscQueue<Item> queue(3); // 取 2 的幂为 4
+    ok &= Expect(queue.capacity() == 4 && queue.Empty(), "capacity",
+                 (long)queue.capacity());
+
+    Item item;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        item.sequence = i;
+        item.payload.assign(8, i);
+        ok &= Expect(queue.TryPush(item), "push", i);
+    }
+    item.sequence = 99;
+    ok &= Expect(!queue.TryPush(item) && item.sequence == 99, "push when full");
+
+    Item out;
+    ok &= Expect(queue.TryPop(out) && out.sequence == 0 && out.payload.size() == 8,
+                 "pop order");
+    // 消费者交回的元素在下一轮被生产者换回，容量得以复用
+    out.payload.clear();
+    const uint32_t *storage = out.payload.data();
+    ok &= Expect(queue.TryPush(item), "push after pop");
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        ok &= Expect(queue.TryPop(out) && out.sequence == i, "pop", i);
+    }
+    ok &= Expect(queue.TryPop(out) && out.sequence == 99, "pop last");
+    ok &= Expect(!queue.TryPop(out) && queue.Empty(), "empty");
+    queue.TryPush(item);
+    ok &= Expect(item.payload.capacity() >= 8 && item.payload.data() == storage,
+                 "recycled capacity");
+    return ok;
+}
+
+// 多个解析线程写、分发线程读：每个生产者内部保持顺序，不丢不重
+static bool CheckQueueThreads()
+{
+    const uint32_t    kProducers = 4;
+    const uint32_t    kPerProducer = 100000;
+    EOMpscQueue<Item> queue(256);
+    EOWakeup          wakeup;
+    bool              ok = true;
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&queue, &wakeup, p]() {
+            Item item;
+            for (uint32_t i = 0; i < kPerProducer; ++i)
+            {
+                item.producer = p;
+                item.sequence = i;
+                item.payload.assign(1, i);
+                while (!queue.TryPush(item))
+                {
+                    std::this_thread::yield();
+                }
+                wakeup.Notify();
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(kProducers, 0);
+    uint32_t              received = 0;
+    Item                  item;
+    while (received < kProducers * kPerProducer && ok)
+    {
+        if (!queue.TryPop(item))
+        {
+            wakeup.WaitFor([&queue]() { return !queue.Empty(); },
+                           std::chrono::milliseconds(20));
+            continue;
+        }
+        ok &= Expect(item.producer < kProducers && item.sequence == next[item.producer] &&
+                         item.payload.size() == 1 && item.payload[0] == item.sequence,
+                     "per-producer order", (long)item.sequence);
+        ++next[item.producer];
+        ++received;
+    }
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+    ok &= Expect(queue.Empty(), "drained");
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= CheckRingBounds();
+    ok &= CheckRingThreads();
+    ok &= CheckQueueBounds();
+    ok &= CheckQueueThreads();
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Handoff queue OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "eo_protocol_parser.h"
+#include <iostream>
+#include <jsoncpp/json/reader.h>
+#include <jsoncpp/json/value.h>
+#include <memory>
+
+// 单遍解码器与原 jsoncpp DOM 解析路径的一致性测试
+
+// 原 jsoncpp 路径：解析为 DOM 后按键取值
+static bool ReferenceParse(const std::string         &text,
+                           MessageHeader             &header,
+                           std::vector<EOTargetInfo> &targetInfos)
+{
+    Json::CharReaderBuilder           builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    Json::Value                       json;
+    std::string                       errors;
+    if (!reader->parse(text.data(), text.data() + text.size(), &json, &errors))
+    {
+        return false;
+    }
+
+    header.msg_id = json["msg_id"].asInt();
+    header.msg_sn = json["msg_sn"].asInt();
+    header.msg_type = json["msg_type"].asInt();
+    header.yr = json["yr"].asInt();
+    header.msec = json["msec"].asFloat();
+    header.cont_type = json["cont_type"].asInt();
+    header.cont_sum = json["cont_sum"].asInt();
+
+    targetInfos.clear();
+    for (const auto &t : json["cont"])
+    {
+        EOTargetInfo info = {};
+        info.yr = t["yr"].asInt();
+        info.msec = t["msec"].asFloat();
+        info.trk_stat = t["trk_stat"].asInt();
+        info.lon = t["lon"].asDouble();
+        info.tar_category = t["tar_category"].asInt();
+        info.tar_iden = t["tar_iden"].asString();
+        info.tar_cfid = t["tar_cfid"].asFloat();
+        info.tar_rect = t["tar_rect"].asInt();
+        info.source_id = t.get("source_id", 0).asInt();
+        targetInfos.push_back(info);
+    }
+    return !targetInfos.empty();
+}
+
+static bool SameTargets(const std::vector<EOTargetInfo> &a,
+                        const std::vector<EOTargetInfo> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].yr != b[i].yr || a[i].msec != b[i].msec ||
+            a[i].trk_stat != b[i].trk_stat || a[i].lon != b[i].lon ||
+            a[i].tar_category != b[i].tar_category ||
+            a[i].tar_iden != b[i].tar_iden || a[i].tar_cfid != b[i].tar_cfid ||
+            a[i].tar_rect != b[i].tar_rect || a[i].source_id != b[i].source_id)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const std::string cases[] = {
+        // 编码器实际输出格式
+        R"({"cont":[{"lon":116.39123456780001,"msec":123.45600128173828,"source_id":3,"tar_category":9,"tar_cfid":0.94999998807907104,"tar_iden":"无人机","tar_rect":1024,"trk_stat":1,"yr":2025}],"cont_sum":1,"cont_type":1,"msec":958.28997802734375,"msg_id":28946,"msg_sn":7,"msg_type":3,"yr":2026})",
+        // 报文头在前、带空白、缺失 source_id、未知键（含嵌套对象/数组）
+        " {\n \"msg_id\" : 28946, \"extra\": {\"a\": [1, 2, {\"b\": null}], \"c\": \"x\\\"y\"},\n"
+        " \"cont\": [ {\"tar_iden\": \"q\\\"\\\\\\/\\n\\ud83d\\ude81\", \"unknown\": true, \"tar_rect\": -5},\n"
+        "            {\"yr\": 2025, \"trk_stat\": 2.9, \"lon\": -1e-5} ],\n"
+        " \"msg_sn\": 8 }\r\n",
+        // 空目标数组
+        R"({"cont":[],"msg_sn":9})",
+        // 非法 JSON
+        R"({"cont":[{"yr":2025}],"msg_sn":)",
+    };
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        const std::string        &text = cases[i];
+        MessageHeader             expectedHeader = {};
+        MessageHeader             header = {};
+        std::vector<EOTargetInfo> expected;
+        std::vector<EOTargetInfo> parsed(4); // 复用已有元素
+        bool expectedOk = ReferenceParse(text, expectedHeader, expected);
+        bool ok = EOProtocolParser::ParseEOTargetMessage(
+            reinterpret_cast<const uint8_t *>(text.data()), text.size(), header,
+            parsed);
+
+        if (ok != expectedOk ||
+            (ok && (header.msg_id != expectedHeader.msg_id ||
+                    header.msg_sn != expectedHeader.msg_sn ||
+                    header.msec != expectedHeader.msec ||
+                    header.cont_sum != expectedHeader.cont_sum ||
+                    !SameTargets(parsed, expected))))
+        {
+            std::cerr << "Case " << i << " differs from jsoncpp" << std::endl;
+            ++failures;
+        }
+    }
+
+    if (failures != 0)
+    {
+        return 1;
+    }
+    std::cout << "Decoder matches jsoncpp on all cases" << std::endl;
+    return 0;
+}
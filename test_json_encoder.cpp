@@ -0,0 +1,213 @@
+#include "eo_protocol_parser.h"
+#include <cmath>
+#include <iostream>
+#include <jsoncpp/json/reader.h>
+#include <jsoncpp/json/value.h>
+#include <jsoncpp/json/writer.h>
+#include <limits>
+#include <memory>
+
+// 流式编码器与 jsoncpp 路径的逐字节一致性测试
+
+// 原 jsoncpp 路径：由 Json::Value 构建目标对象
+static Json::Value BuildTargetJson(const EOTargetInfo &t)
+{
+    Json::Value json;
+    json["yr"] = t.yr;
+    json["mo"] = t.mo;
+    json["dy"] = t.dy;
+    json["h"] = t.h;
+    json["min"] = t.min;
+    json["sec"] = t.sec;
+    json["msec"] = t.msec;
+    json["dev_id"] = t.dev_id;
+    json["guid_id"] = t.guid_id;
+    json["tar_id"] = t.tar_id;
+    json["trk_stat"] = t.trk_stat;
+    json["trk_mod"] = t.trk_mod;
+    json["fov_angle"] = t.fov_angle;
+    json["lon"] = t.lon;
+    json["lat"] = t.lat;
+    json["alt"] = t.alt;
+    json["tar_a"] = t.tar_a;
+    json["tar_e"] = t.tar_e;
+    json["tar_rng"] = t.tar_rng;
+    json["tar_av"] = t.tar_av;
+    json["tar_ev"] = t.tar_ev;
+    json["tar_rv"] = t.tar_rv;
+    json["tar_category"] = t.tar_category;
+    json["tar_iden"] = t.tar_iden.str();
+    json["tar_cfid"] = t.tar_cfid;
+    json["fov_h"] = t.fov_h;
+    json["fov_v"] = t.fov_v;
+    json["offset_h"] = t.offset_h;
+    json["offset_v"] = t.offset_v;
+    json["tar_rect"] = t.tar_rect;
+    json["source_id"] = t.source_id;
+    return json;
+}
+
+// 原 jsoncpp 路径：报文头取自流式报文本身（时间戳在封装时生成）
+static std::string BuildReferenceMessage(const Json::Value               &parsed,
+                                         const std::vector<EOTargetInfo> &targets)
+{
+    static const char *kHeaderKeys[] = {
+        "msg_id",    "msg_sn",      "msg_type",  "tx_sys_id",    "tx_dev_type",
+        "tx_dev_id", "tx_subdev_id", "rx_sys_id", "rx_dev_type", "rx_dev_id",
+        "rx_subdev_id", "yr",       "mo",        "dy",           "h",
+        "min",       "sec",         "cont_type", "cont_sum"};
+
+    Json::Value jsonMessage;
+    for (const char *key : kHeaderKeys)
+    {
+        jsonMessage[key] = parsed[key].asInt();
+    }
+    jsonMessage["msec"] = parsed["msec"].asFloat();
+    jsonMessage["cont"] = Json::Value(Json::arrayValue);
+    for (const auto &t : targets)
+    {
+        jsonMessage["cont"].append(BuildTargetJson(t));
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder.settings_["indentation"] = "";
+    return Json::writeString(builder, jsonMessage);
+}
+
+int main()
+{
+    std::vector<EOTargetInfo> targets;
+
+    EOTargetInfo base = {};
+    base.yr = 2025;
+    base.mo = 10;
+    base.dy = 28;
+    base.h = 14;
+    base.min = 30;
+    base.sec = 45;
+    base.msec = 123.456f;
+    base.trk_stat = 1;
+    base.tar_category = static_cast<int>(TargetClass::UAV);
+    base.tar_iden = "uav";
+    base.tar_cfid = 0.95f;
+    base.tar_rect = 1024;
+    base.source_id = 3;
+    targets.push_back(base);
+
+    // 中文标签、浮点边界值
+    EOTargetInfo t2 = base;
+    t2.tar_iden = "无人机";
+    t2.tar_cfid = -0.25f;
+    t2.lon = 116.3912345678;
+    t2.lat = -39.9;
+    t2.alt = -0.0;
+    t2.tar_rng = 1e300;
+    t2.tar_a = 123456789012345.0;
+    t2.tar_e = 1e16;
+    t2.tar_av = 5e-324;
+    t2.tar_rect = -512;
+    t2.offset_h = std::numeric_limits<int>::min();
+    t2.offset_v = std::numeric_limits<int>::max();
+    targets.push_back(t2);
+
+    // 需要转义的字符、四字节 UTF-8、非法 UTF-8 序列
+    EOTargetInfo t3 = base;
+    t3.tar_iden = std::string("q\"b\\s/\b\f\n\r\t\x01\x1f") + "\xF0\x9F\x9A\x81" +
+                  "\xC3" + "\xE4\xBA";
+    targets.push_back(t3);
+
+    std::vector<uint8_t> buffer(
+        EOProtocolParser::GetMaxEOTargetMessageSize(targets.data(), targets.size()));
+    size_t length = EOProtocolParser::PackEOTargetMessage(
+        targets.data(), targets.size(), 42, buffer.data(), buffer.size());
+    if (length == 0)
+    {
+        std::cerr << "Failed to pack message!" << std::endl;
+        return 1;
+    }
+    std::string encoded(buffer.begin(), buffer.begin() + length);
+
+    Json::CharReaderBuilder             readerBuilder;
+    std::unique_ptr<Json::CharReader>   reader(readerBuilder.newCharReader());
+    Json::Value                         parsed;
+    std::string                         errors;
+    if (!reader->parse(encoded.data(), encoded.data() + encoded.size(), &parsed,
+                       &errors))
+    {
+        std::cerr << "jsoncpp failed to parse encoder output: " << errors
+                  << std::endl;
+        return 1;
+    }
+
+    std::string reference = BuildReferenceMessage(parsed, targets);
+    if (encoded != reference)
+    {
+        std::cerr << "Encoder output differs from jsoncpp output" << std::endl;
+        std::cerr << "encoder: " << encoded << std::endl;
+        std::cerr << "jsoncpp: " << reference << std::endl;
+        return 1;
+    }
+
+    // 缓冲区不足时必须返回0而不是截断的报文
+    if (EOProtocolParser::PackEOTargetMessage(targets.data(), targets.size(), 42,
+                                              buffer.data(), length - 1) != 0)
+    {
+        std::cerr << "Truncated buffer was not rejected" << std::endl;
+        return 1;
+    }
+
+    // NaN/Inf 输出 jsoncpp 自身无法再解析，仅比较 "cont" 数组部分
+    EOTargetInfo special = base;
+    special.fov_h = std::numeric_limits<double>::quiet_NaN();
+    special.fov_v = std::numeric_limits<double>::infinity();
+    special.fov_angle = -std::numeric_limits<double>::infinity();
+    size_t specialLength = EOProtocolParser::PackEOTargetMessage(
+        &special, 1, 1, buffer.data(), buffer.size());
+    std::string specialEncoded(buffer.begin(), buffer.begin() + specialLength);
+    size_t      arrayBegin = specialEncoded.find('[');
+    size_t      arrayEnd = specialEncoded.find("],\"cont_sum\"");
+    Json::Value specialArray(Json::arrayValue);
+    specialArray.append(BuildTargetJson(special));
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder.settings_["indentation"] = "";
+    if (specialLength == 0 || arrayEnd == std::string::npos ||
+        specialEncoded.substr(arrayBegin, arrayEnd - arrayBegin + 1) !=
+            Json::writeString(writerBuilder, specialArray))
+    {
+        std::cerr << "NaN/Inf encoding differs from jsoncpp output" << std::endl;
+        return 1;
+    }
+
+    // 往返解析
+    MessageHeader             header;
+    std::vector<EOTargetInfo> parsedTargets;
+    length = EOProtocolParser::PackEOTargetMessage(
+        targets.data(), targets.size(), 42, buffer.data(), buffer.size());
+    if (!EOProtocolParser::ParseEOTargetMessage(buffer.data(), length, header,
+                                                parsedTargets) ||
+        parsedTargets.size() != targets.size() || header.msg_sn != 42)
+    {
+        std::cerr << "Round-trip parse failed" << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        if (parsedTargets[i].tar_iden != targets[i].tar_iden &&
+            i != 2) // 非法 UTF-8 序列被替换为 U+FFFD
+        {
+            std::cerr << "tar_iden mismatch at target " << i << std::endl;
+            return 1;
+        }
+        if (parsedTargets[i].tar_cfid != targets[i].tar_cfid ||
+            parsedTargets[i].lon != targets[i].lon ||
+            parsedTargets[i].offset_h != targets[i].offset_h)
+        {
+            std::cerr << "Field mismatch at target " << i << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Encoder output matches jsoncpp (" << length << " bytes)"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "eo_protocol_parser.h"
+#include "target_label_map.h"
+#include "test_expect.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+// 标签映射表测试：内置映射、映射文件、class_id 优先、未知标签驻留
+
+int main()
+{
+    bool ok = true;
+
+    // 内置映射与原硬编码规则一致
+    TargetLabelMap defaults;
+    ok &= Expect(defaults.Lookup(-1, "人").tar_category ==
+                     static_cast<int>(TargetClass::PEDESTRIAN),
+                 "default 人");
+    ok &= Expect(defaults.Lookup(0, "Drone").tar_category ==
+                         static_cast<int>(TargetClass::UAV) &&
+                     defaults.Lookup(0, "Drone").tar_iden == "Drone",
+                 "default Drone");
+    ok &= Expect(defaults.Lookup(-1, NULL).tar_iden == "unknown" &&
+                     defaults.Lookup(-1, "").tar_category == 0,
+                 "empty label");
+
+    // 未知标签驻留：类别 0，tar_iden 为原始标签，地址稳定
+    const TargetLabelEntry &car = defaults.Lookup(3, "car");
+    ok &= Expect(car.tar_category == 0 && car.tar_iden == "car", "unknown label");
+    for (int i = 0; i < 100; ++i)
+    {
+        defaults.Lookup(-1, ("label" + std::to_string(i)).c_str());
+    }
+    ok &= Expect(&defaults.Lookup(3, "car") == &car, "interned address stable");
+
+    // 驻留数量有上限
+    for (int i = 0; i < 1000; ++i)
+    {
+        defaults.Lookup(-1, ("extra" + std::to_string(i)).c_str());
+    }
+    ok &= Expect(defaults.size() <= 10 + 256, "intern limit");
+    // 超出上限的标签共用固定条目，已返回的条目不被后续查找改写
+    const TargetLabelEntry &overflow = defaults.Lookup(-1, "overflow-label");
+    defaults.Lookup(-1, "another-overflow-label");
+    ok &= Expect(overflow.tar_iden == "unknown" && overflow.tar_category == 0,
+                 "label beyond intern limit");
+
+    // 映射文件
+    const char *path = "/tmp/test_label_map.txt";
+    FILE       *file = fopen(path, "w");
+    fputs("# class_id, label, tar_category, tar_iden\n"
+          "0, person, 7, 行人\n"
+          ", 无人机, 9\n"
+          "2, traffic light, 4, signal\n"
+          "\n",
+          file);
+    fclose(file);
+
+    TargetLabelMap mapped;
+    std::string    error;
+    ok &= Expect(mapped.LoadFile(path, error), "load mapping file");
+    ok &= Expect(mapped.Lookup(0, "anything").tar_iden == "行人",
+                 "class_id takes precedence");
+    ok &= Expect(mapped.Lookup(5, "person").tar_category == 7,
+                 "label fallback for unconfigured class_id");
+    ok &= Expect(mapped.Lookup(-1, "无人机").tar_iden == "无人机",
+                 "empty tar_iden keeps label");
+    ok &= Expect(mapped.Lookup(-1, "traffic light").tar_iden == "signal",
+                 "label with spaces");
+    ok &= Expect(mapped.Lookup(-1, "uav").tar_category == 0,
+                 "file replaces defaults");
+
+    // 非法文件：报错且保留原映射
+    file = fopen(path, "w");
+    fputs("0, person, seven\n", file);
+    fclose(file);
+    ok &= Expect(!mapped.LoadFile(path, error) &&
+                     error.find("line 1") != std::string::npos,
+                 "invalid tar_category rejected");
+    ok &= Expect(mapped.Lookup(0, "x").tar_iden == "行人",
+                 "mapping kept after failed load");
+    ok &= Expect(!mapped.LoadFile("/nonexistent/labels.txt", error),
+                 "missing file rejected");
+    remove(path);
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Label map OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "source_rate_limiter.h"
+#include "test_expect.h"
+#include <iostream>
+#include <string>
+
+// 按源限速测试：固定间隔无漂移、令牌桶突发、按源覆盖帧率
+
+static const int64_t kMs = 1000000LL;
+
+// 以 input_fps 输入 duration_ms 毫秒，返回某路视频源的发送帧数
+static int CountSent(SourceRateLimiter &limiter, unsigned source_id,
+                     int input_fps, int duration_ms, unsigned default_fps,
+                     int64_t start_ns = 0)
+{
+    int     sent = 0;
+    int64_t frame_ns = 1000000000LL / input_fps;
+    for (int64_t t = 0; t < duration_ms * kMs; t += frame_ns)
+    {
+        sent += limiter.ShouldSend(source_id, start_ns + t, default_fps) ? 1 : 0;
+    }
+    return sent;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // 60 fps 输入按 25 fps 上报：10 秒内应发送约 250 帧（原实现只有约 200 帧）
+    SourceRateLimiter interval;
+    int               sent = CountSent(interval, 0, 60, 10000, 25);
+    ok &= Expect(sent >= 249 && sent <= 251, "interval 60->25 fps", sent);
+
+    // 停顿后不补发
+    interval.Reset();
+    interval.ShouldSend(1, 0, 25);
+    ok &= Expect(interval.ShouldSend(1, 5000 * kMs, 25), "send after stall");
+    ok &= Expect(!interval.ShouldSend(1, 5001 * kMs, 25), "no burst after stall");
+
+    // 令牌桶：长期速率不变，停顿后允许 burst 帧突发
+    SourceRateLimiter bucket;
+    bucket.Configure(SourceRateLimiter::Mode::TOKEN_BUCKET, 4);
+    sent = CountSent(bucket, 0, 60, 10000, 25);
+    ok &= Expect(sent >= 249 && sent <= 254, "token bucket average rate", sent);
+    int burst = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        burst += bucket.ShouldSend(0, 20000 * kMs + i, 25) ? 1 : 0;
+    }
+    ok &= Expect(burst == 4, "token bucket burst", burst);
+
+    // 按源覆盖帧率；0 表示不发送
+    SourceRateLimiter overrides;
+    std::string       error;
+    ok &= Expect(overrides.SetSourceFps("0:25, 3:10,200:0", error),
+                 "parse source-fps");
+    sent = CountSent(overrides, 3, 60, 10000, 25);
+    ok &= Expect(sent == 100, "source 3 at 10 fps", sent);
+    ok &= Expect(CountSent(overrides, 200, 60, 1000, 25) == 0, "source 200 muted");
+    sent = CountSent(overrides, 150, 60, 10000, 5);
+    ok &= Expect(sent == 50, "default fps for other sources", sent);
+
+    ok &= Expect(!overrides.SetSourceFps("0:25,x:3", error), "reject bad id");
+    ok &= Expect(!overrides.SetSourceFps("0:25;1:3", error), "reject bad sep");
+    ok &= Expect(!overrides.SetSourceFps("0:2000", error), "reject fps range");
+    ok &= Expect(overrides.SetSourceFps("", error), "empty clears overrides");
+    overrides.Reset();
+    sent = CountSent(overrides, 200, 60, 1000, 25);
+    ok &= Expect(sent == 25, "override cleared", sent);
+
+    // 单调时钟
+    int64_t a = SourceRateLimiter::NowNs();
+    int64_t b = SourceRateLimiter::NowNs();
+    ok &= Expect(b >= a, "monotonic clock");
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Rate limiter OK" << std::endl;
+    return 0;
+}
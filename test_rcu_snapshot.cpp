@@ -0,0 +1,102 @@
+#include "rcu_snapshot.h"
+#include "test_expect.h"
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+// 配置快照：读端持有期间不被释放、发布后读端看到完整的新快照、旧快照最终全部释放
+
+namespace
+{
+std::atomic<long> g_live{0}; // 尚未释放的快照数
+
+struct Snapshot
+{
+    explicit Snapshot(long value) : value(value), check(~value) { g_live.fetch_add(1); }
+    ~Snapshot()
+    {
+        check = 0; // 释放后仍被读取时校验失败
+        g_live.fetch_sub(1);
+    }
+
+    long value;
+    long check;
+};
+} // namespace
+
+int main()
+{
+    bool ok = true;
+
+    {
+        RcuSnapshot<Snapshot, 2> rcu;
+        ok &= Expect(rcu.Lock(0) == nullptr, "empty");
+        rcu.Unlock(0);
+
+        rcu.Publish(new Snapshot(1));
+        const Snapshot *held = rcu.Lock(0);
+        ok &= Expect(held != nullptr && held->value == 1, "lock current");
+
+        // 读端持有的旧快照发布后保留，新的读端看到新快照
+        rcu.Publish(new Snapshot(2));
+        ok &= Expect(rcu.retired() == 1 && held->check == ~1L, "held snapshot kept");
+        ok &= Expect(rcu.Lock(1)->value == 2 && rcu.current()->value == 2, "new snapshot");
+        rcu.Unlock(1);
+
+        rcu.Unlock(0);
+        rcu.Reclaim();
+        ok &= Expect(rcu.retired() == 0 && g_live.load() == 1, "reclaimed", g_live.load());
+
+        rcu.Publish(nullptr);
+        ok &= Expect(rcu.current() == nullptr && g_live.load() == 0, "publish null",
+                     g_live.load());
+        rcu.Publish(new Snapshot(3));
+    }
+    ok &= Expect(g_live.load() == 0, "destructor", g_live.load());
+
+    // 并发：两个读端反复取快照并校验内容，写端持续发布
+    {
+        const long               kPublishes = 200000;
+        RcuSnapshot<Snapshot, 2> rcu;
+        std::atomic<bool>        done{false};
+        std::atomic<long>        errors{0};
+        rcu.Publish(new Snapshot(0));
+
+        auto reader = [&](size_t slot) {
+            long last = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const Snapshot *snapshot = rcu.Lock(slot);
+                // 单一写端按顺序发布，读端看到的值不会回退
+                if (snapshot->check != ~snapshot->value || snapshot->value < last)
+                    errors.fetch_add(1);
+                last = snapshot->value;
+                rcu.Unlock(slot);
+            }
+        };
+        std::thread first(reader, 0);
+        std::thread second(reader, 1);
+        for (long i = 1; i <= kPublishes; ++i)
+        {
+            rcu.Publish(new Snapshot(i));
+            // 写端从不等待读端，待回收的旧快照不超过读端数
+            if (rcu.retired() > 2)
+                errors.fetch_add(1);
+        }
+        done.store(true);
+        first.join();
+        second.join();
+
+        ok &= Expect(errors.load() == 0, "concurrent readers", errors.load());
+        rcu.Reclaim();
+        ok &= Expect(rcu.retired() == 0 && g_live.load() == 1, "all reclaimed", g_live.load());
+    }
+    ok &= Expect(g_live.load() == 0, "no leak", g_live.load());
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "rcu snapshot OK" << std::endl;
+    return 0;
+}
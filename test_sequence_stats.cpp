@@ -0,0 +1,222 @@
+#include "eo_delta_codec.h"
+#include "eo_protocol_parser.h"
+#include "eo_sequence_stats.h"
+#include "test_expect.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 序号统计测试：丢包、乱序、重复、回绕、发送端重启、时延直方图、报文头 src_sn / send_us 往返
+
+static EOSourceStats Stats(const EOSequenceTracker &tracker, uint32_t sourceId)
+{
+    for (const EOSourceStats &stats : tracker.Snapshot())
+    {
+        if (stats.source_id == sourceId)
+        {
+            return stats;
+        }
+    }
+    return EOSourceStats();
+}
+
+static std::vector<EOTargetInfo> MakeTargets(size_t count, int source)
+{
+    std::vector<EOTargetInfo> targets(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        targets[i].yr = 2025;
+        targets[i].tar_id = static_cast<int>(i);
+        targets[i].tar_iden = "无人机";
+        targets[i].tar_rect = 100 + static_cast<int>(i);
+        targets[i].source_id = source;
+    }
+    return targets;
+}
+
+static bool CheckHistogram()
+{
+    bool ok = true;
+    for (uint64_t v = 0; v < (1ull << 20); v = v * 3 / 2 + 1)
+    {
+        size_t index = LatencyHistogram::BucketIndex(v);
+        ok &= Expect(v <= LatencyHistogram::BucketUpperBound(index) &&
+                         (index == 0 || v > LatencyHistogram::BucketUpperBound(index - 1)),
+                     "bucket bounds", (long)v);
+    }
+    ok &= Expect(LatencyHistogram::BucketIndex(~0ull) == LatencyHistogram::kBucketCount - 1,
+                 "overflow bucket");
+
+    // 1..1000 均匀分布：百分位相对误差不超过 1/16
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 1000; ++v)
+    {
+        histogram.Record(v);
+    }
+    uint64_t p50 = histogram.Percentile(50);
+    uint64_t p99 = histogram.Percentile(99);
+    ok &= Expect(p50 >= 500 && p50 <= 500 + 500 / 16, "p50", (long)p50);
+    ok &= Expect(p99 >= 990 && p99 <= 1000, "p99", (long)p99);
+    ok &= Expect(histogram.Percentile(100) == 1000 && histogram.max() == 1000, "p100");
+    ok &= Expect(histogram.mean() > 500.4 && histogram.mean() < 500.6, "mean");
+
+    LatencyHistogram other;
+    other.Record(5000);
+    histogram.Merge(other);
+    ok &= Expect(histogram.count() == 1001 && histogram.max() == 5000, "merge");
+    return ok;
+}
+
+static bool CheckTracker()
+{
+    bool              ok = true;
+    EOSequenceTracker tracker;
+    const int64_t     now = 1750000000000000LL;
+
+    // 源 1：1..10 中丢失 4、5，7 在 8 之后到达，9 重复
+    const uint32_t order[] = {1, 2, 3, 6, 8, 7, 9, 9, 10};
+    for (uint32_t sn : order)
+    {
+        tracker.Record(1, sn, now - 2000, now);
+    }
+    EOSourceStats s = Stats(tracker, 1);
+    ok &= Expect(s.received == 8, "received", (long)s.received);
+    ok &= Expect(s.lost == 2, "lost", (long)s.lost);
+    ok &= Expect(s.reordered == 1, "reordered", (long)s.reordered);
+    ok &= Expect(s.duplicates == 1, "duplicates", (long)s.duplicates);
+    ok &= Expect(s.highest_sn == 10 && s.restarts == 0, "highest", (long)s.highest_sn);
+    ok &= Expect(s.latency_us.count() == 8 && s.latency_us.max() == 2000, "latency",
+                 (long)s.latency_us.max());
+
+    // 源 2：跨越 uint32 回绕，不计丢失
+    for (uint32_t sn = 0xfffffffdu; sn != 3; ++sn)
+    {
+        tracker.Record(2, sn, 0, now);
+    }
+    s = Stats(tracker, 2);
+    ok &= Expect(s.received == 6 && s.lost == 0 && s.restarts == 0, "wraparound",
+                 (long)s.lost);
+    ok &= Expect(s.latency_us.count() == 0, "send_us 0 skips latency");
+
+    // 源 2 发送端重启：序号跳到 100000 再回到 1，两次都不计为乱序或丢包
+    tracker.Record(2, 100000, 0, now);
+    tracker.Record(2, 1, now + 10, now);
+    tracker.Record(2, 2, 0, now);
+    s = Stats(tracker, 2);
+    ok &= Expect(s.restarts == 2 && s.lost == 0 && s.reordered == 0 && s.highest_sn == 2, "restart",
+                 (long)s.restarts);
+    ok &= Expect(s.clock_skew == 1, "clock skew", (long)s.clock_skew);
+
+    // 超出窗口的迟到报文不会被误判为重复
+    tracker.Record(3, 1, 0, now);
+    tracker.Record(3, 1 + EOSequenceTracker::kWindow, 0, now);
+    tracker.Record(3, 2, 0, now);
+    s = Stats(tracker, 3);
+    ok &= Expect(s.duplicates == 0 && s.restarts == 0 && s.reordered == 1, "window",
+                 (long)s.duplicates);
+
+    // 心跳：携带的 src_sn 超前时其间的目标报文计为丢失，迟到后扣除；心跳不计入 received
+    tracker.Record(5, 1, 0, now);
+    tracker.RecordHeartbeat(5, 1, now + 1000000);
+    tracker.RecordHeartbeat(5, 3, now + 2000000);
+    s = Stats(tracker, 5);
+    ok &= Expect(s.heartbeats == 2 && s.received == 1 && s.lost == 2 &&
+                     s.highest_sn == 3 && s.last_seen_us == now + 2000000,
+                 "heartbeat", (long)s.lost);
+    tracker.Record(5, 3, 0, now + 2500000);
+    s = Stats(tracker, 5);
+    ok &= Expect(s.lost == 1 && s.reordered == 1 && s.duplicates == 0, "report after heartbeat",
+                 (long)s.lost);
+    tracker.RecordHeartbeat(6, 7, now);
+    ok &= Expect(Stats(tracker, 6).heartbeats == 1 && Stats(tracker, 6).received == 0,
+                 "heartbeat-only source");
+
+    ok &= Expect(tracker.Snapshot().size() == 5, "snapshot sources");
+    tracker.Record(EOSequenceTracker::kMaxSources, 1, 0, now);
+    ok &= Expect(tracker.Snapshot().size() == 5, "source id out of range");
+    tracker.Reset();
+    ok &= Expect(tracker.Snapshot().empty(), "reset");
+    return ok;
+}
+
+// src_sn / send_us 在 JSON、二进制与差分帧中往返，旧格式解析为 0
+static bool CheckHeaderFields()
+{
+    bool                      ok = true;
+    std::vector<uint8_t>      buffer(65536);
+    std::vector<EOFragment>   fragments;
+    std::vector<EOTargetInfo> targets = MakeTargets(3, 4);
+    const EOSequence          sequence = {4000000000u, 1750000000123456LL, 0};
+
+    const BodyType formats[] = {BodyType::JSON, BodyType::BINARY};
+    for (BodyType format : formats)
+    {
+        size_t n = EOProtocolParser::PackEOTargetFragments(
+            targets.data(), targets.size(), 9, format, 65507, buffer.data(), buffer.size(),
+            fragments, &sequence);
+        MessageHeader             header;
+        std::vector<EOTargetInfo> parsed;
+        ok &= Expect(n == 1 && EOProtocolParser::ParseEOTargetMessage(
+                                   buffer.data(), fragments[0].length, header, parsed),
+                     "parse with sequence", (long)format);
+        ok &= Expect(header.src_sn == sequence.src_sn && header.send_us == sequence.send_us &&
+                         header.msg_sn == 9 && parsed.size() == 3,
+                     "sequence round trip", (long)format);
+
+        // 大报文分片后每个分片都带序号
+        std::vector<EOTargetInfo> many = MakeTargets(200, 4);
+        n = EOProtocolParser::PackEOTargetFragments(many.data(), many.size(), 10, format,
+                                                    1472, buffer.data(), buffer.size(),
+                                                    fragments, &sequence);
+        for (size_t i = 0; i < n; ++i)
+        {
+            ok &= Expect(fragments[i].length <= 1472 &&
+                             EOProtocolParser::ParseEOTargetMessage(
+                                 buffer.data() + fragments[i].offset, fragments[i].length,
+                                 header, parsed) &&
+                             header.src_sn == sequence.src_sn &&
+                             header.frag_idx == static_cast<int>(i) &&
+                             header.frag_cnt == static_cast<int>(n),
+                         "fragment sequence", (long)i);
+        }
+
+        EOProtocolParser::PackEOTargetFragments(targets.data(), targets.size(), 11, format,
+                                                65507, buffer.data(), buffer.size(),
+                                                fragments);
+        ok &= Expect(EOProtocolParser::ParseEOTargetMessage(buffer.data(),
+                                                            fragments[0].length, header,
+                                                            parsed) &&
+                         header.src_sn == 0 && header.send_us == 0,
+                     "no sequence", (long)format);
+    }
+
+    EODeltaEncoder encoder(4);
+    encoder.CommitKeyframe(4, targets.data(), targets.size(), 20);
+    targets[1].tar_rect += 3;
+    size_t size = encoder.PackDelta(4, targets.data(), targets.size(), 21, buffer.data(),
+                                    1472, &sequence);
+    MessageHeader header;
+    uint32_t      source_id = 0;
+    uint16_t      base_sn = 0;
+    ok &= Expect(size > 0 &&
+                     EOProtocolParser::ReadEOTargetDeltaInfo(buffer.data(), size, header,
+                                                             source_id, base_sn) &&
+                     source_id == 4 && base_sn == 20 && header.src_sn == sequence.src_sn &&
+                     header.send_us == sequence.send_us,
+                 "delta sequence");
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= CheckHistogram();
+    ok &= CheckTracker();
+    ok &= CheckHeaderFields();
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Sequence stats OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "eo_protocol_parser.h"
+#include "source_heartbeat.h"
+#include "test_expect.h"
+#include <iostream>
+#include <string>
+
+// 空闲心跳测试：跳变帧占位报文、按源 / 聚合心跳节流、失效视频源停止心跳、心跳报文往返
+
+static const int64_t kMs = 1000000LL;
+
+int main()
+{
+    bool ok = true;
+    typedef SourceHeartbeat::Action Action;
+
+    // 未启用：每个空帧都上报
+    SourceHeartbeat legacy;
+    int             reports = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        reports += legacy.OnFrame(0, false, i * 40 * kMs) == Action::REPORT ? 1 : 0;
+    }
+    ok &= Expect(reports == 100, "legacy placeholder every frame", reports);
+
+    // 按源模式，25 fps、1 秒心跳：10 秒空闲只有 1 个占位报文 + 约 10 个心跳
+    SourceHeartbeat per_source;
+    per_source.Configure(1000 * kMs, false);
+    ok &= Expect(per_source.OnFrame(0, true, 0) == Action::REPORT, "targets reported");
+    reports = 0;
+    int heartbeats = 0;
+    for (int64_t t = 40 * kMs; t <= 10000 * kMs; t += 40 * kMs)
+    {
+        Action action = per_source.OnFrame(0, false, t);
+        reports += action == Action::REPORT ? 1 : 0;
+        heartbeats += action == Action::HEARTBEAT ? 1 : 0;
+    }
+    ok &= Expect(reports == 1, "single transition placeholder", reports);
+    ok &= Expect(heartbeats >= 9 && heartbeats <= 10, "per-source heartbeats", heartbeats);
+
+    // 目标重新出现后立即上报，再次空闲时重新发送跳变占位报文
+    ok &= Expect(per_source.OnFrame(0, true, 10040 * kMs) == Action::REPORT,
+                 "targets after idle");
+    ok &= Expect(per_source.OnFrame(0, false, 10080 * kMs) == Action::REPORT,
+                 "second transition");
+    ok &= Expect(per_source.OnFrame(0, false, 10120 * kMs) == Action::SKIP,
+                 "idle frame skipped");
+
+    // 聚合模式：3 路空闲视频源合并为一个心跳；停止出帧的视频源在两个间隔后退出
+    SourceHeartbeat aggregate;
+    aggregate.Configure(1000 * kMs, true);
+    std::vector<uint32_t> due;
+    for (unsigned source = 0; source < 3; ++source)
+    {
+        ok &= Expect(aggregate.OnFrame(source, false, 0) == Action::REPORT,
+                     "aggregate transition", source);
+    }
+    int collected = 0;
+    for (int64_t t = 40 * kMs; t <= 5000 * kMs; t += 40 * kMs)
+    {
+        for (unsigned source = 0; source < 3; ++source)
+        {
+            if (source == 2 && t > 2000 * kMs)
+                continue; // 视频源 2 失效
+            ok &= Expect(aggregate.OnFrame(source, false, t) == Action::SKIP,
+                         "aggregate idle frame", source);
+        }
+        if (aggregate.CollectDue(t, due))
+        {
+            ++collected;
+            const bool expect_two = t > 4000 * kMs;
+            ok &= Expect(due.size() == (expect_two ? 2u : 3u), "aggregate sources",
+                         static_cast<int>(due.size()));
+        }
+    }
+    ok &= Expect(collected == 5, "aggregate heartbeats", collected);
+
+    // 心跳报文往返（JSON 与二进制），目标报文不被识别为心跳
+    std::vector<EOHeartbeat> sources;
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        sources.push_back(EOHeartbeat{i * 3, 1000000u + i});
+    }
+    for (BodyType format : {BodyType::JSON, BodyType::BINARY})
+    {
+        std::vector<uint8_t> buffer(
+            EOProtocolParser::GetMaxEOHeartbeatMessageSize(sources.size(), format));
+        size_t length = EOProtocolParser::PackEOHeartbeatMessage(
+            sources.data(), sources.size(), format, 1234567890123LL, buffer.data(),
+            buffer.size());
+        std::vector<EOHeartbeat> parsed;
+        int64_t                  send_us = 0;
+        ok &= Expect(length > 0 && EOProtocolParser::IsHeartbeatMessage(buffer.data(), length),
+                     "pack heartbeat", static_cast<int>(format));
+        ok &= Expect(EOProtocolParser::ParseEOHeartbeatMessage(buffer.data(), length, parsed,
+                                                               send_us) &&
+                         send_us == 1234567890123LL && parsed.size() == sources.size() &&
+                         parsed[39].source_id == 117 && parsed[39].src_sn == 1000039u,
+                     "heartbeat round-trip", static_cast<int>(format));
+        ok &= Expect(!EOProtocolParser::ParseEOHeartbeatMessage(buffer.data(), length - 1,
+                                                                parsed, send_us),
+                     "truncated heartbeat rejected", static_cast<int>(format));
+
+        const size_t fit = EOProtocolParser::GetMaxEOHeartbeatSources(1472, format);
+        ok &= Expect(fit > 0 && EOProtocolParser::GetMaxEOHeartbeatMessageSize(fit, format) <= 1472,
+                     "heartbeat sources per datagram", static_cast<int>(fit));
+    }
+
+    std::vector<EOTargetInfo> targets(1, EOTargetInfo());
+    std::vector<uint8_t>      report = EOProtocolParser::PackEOTargetMessage(targets, 1);
+    ok &= Expect(!EOProtocolParser::IsHeartbeatMessage(report.data(), report.size()),
+                 "target report is not a heartbeat");
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Source heartbeat OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,405 @@
+#include "eo_protocol_parser.h"
+#include "eo_target_columns.h"
+#include "test_expect.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// 列式目标测试：列式编码与逐个 EOTargetInfo 编码一致（含分片、序号与多视频源聚合）、
+// 置信度过滤与像素统计核与标量实现一致、tar_cfid 快速格式化与 %.17g 一致
+
+static bool SameTarget(const EOTargetInfo &a, const EOTargetInfo &b)
+{
+    return a.yr == b.yr && a.mo == b.mo && a.dy == b.dy && a.h == b.h &&
+           a.min == b.min && a.sec == b.sec && a.msec == b.msec &&
+           a.dev_id == b.dev_id && a.guid_id == b.guid_id &&
+           a.tar_id == b.tar_id && a.trk_stat == b.trk_stat &&
+           a.trk_mod == b.trk_mod && a.fov_angle == b.fov_angle &&
+           a.lon == b.lon && a.lat == b.lat && a.alt == b.alt &&
+           a.tar_a == b.tar_a && a.tar_e == b.tar_e && a.tar_rng == b.tar_rng &&
+           a.tar_av == b.tar_av && a.tar_ev == b.tar_ev &&
+           a.tar_rv == b.tar_rv && a.tar_category == b.tar_category &&
+           a.tar_iden == b.tar_iden && a.tar_cfid == b.tar_cfid &&
+           a.fov_h == b.fov_h && a.fov_v == b.fov_v &&
+           a.offset_h == b.offset_h && a.offset_v == b.offset_v &&
+           a.tar_rect == b.tar_rect && a.source_id == b.source_id;
+}
+
+static const char *const kLabels[] = {"bird", "无人机", "person", "q\"b\\s\t",
+                                      "鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟鸟"};
+
+static void FillColumns(EOTargetColumns &columns, size_t count, std::mt19937 &rng,
+                        int sourceId = 7)
+{
+    EOTargetInfo common = {};
+    common.yr = 2025;
+    common.mo = 10;
+    common.dy = 28;
+    common.h = 14;
+    common.min = 30;
+    common.sec = 45;
+    common.msec = 123.456f;
+    common.source_id = sourceId;
+    common.fov_angle = 12.5; // 非零浮点字段进入二进制记录末尾
+    common.alt = -0.25;
+    columns.Reset(common);
+
+    std::uniform_real_distribution<float> confidence(-0.2f, 1.0f);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char *label = kLabels[rng() % 5];
+        const float cfid = confidence(rng);
+        columns.Append(static_cast<int32_t>(rng() % 4000) - 100,
+                       static_cast<int32_t>(rng() % 12), cfid, cfid < 0.0f ? 2 : 1, label,
+                       strlen(label));
+    }
+}
+
+// 二进制记录无损，逐目标比较；JSON 额外比较 "cont" 数组的字节（报文头时间每次不同）
+static bool SameMessage(const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength,
+                        BodyType format)
+{
+    MessageHeader             ha;
+    MessageHeader             hb;
+    std::vector<EOTargetInfo> ta;
+    std::vector<EOTargetInfo> tb;
+    if (!EOProtocolParser::ParseEOTargetMessage(a, aLength, ha, ta) ||
+        !EOProtocolParser::ParseEOTargetMessage(b, bLength, hb, tb) || ta.size() != tb.size() ||
+        ha.cont_sum != hb.cont_sum || ha.frag_idx != hb.frag_idx ||
+        ha.frag_cnt != hb.frag_cnt || ha.msg_sn != hb.msg_sn || ha.src_sn != hb.src_sn ||
+        ha.src_cnt != hb.src_cnt)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < ta.size(); ++i)
+    {
+        if (!SameTarget(ta[i], tb[i]))
+            return false;
+    }
+    if (format == BodyType::BINARY)
+    {
+        return aLength == bLength;
+    }
+    const std::string sa(reinterpret_cast<const char *>(a), aLength);
+    const std::string sb(reinterpret_cast<const char *>(b), bLength);
+    const size_t      end = sa.find("],\"cont_sum\"");
+    return end != std::string::npos && sb.compare(0, end + 1, sa, 0, end + 1) == 0;
+}
+
+static bool CheckEncoding()
+{
+    bool                      ok = true;
+    std::mt19937              rng(17);
+    EOTargetColumns           columns;
+    std::vector<EOTargetInfo> targets;
+    std::vector<uint8_t>      columnBuffer;
+    std::vector<uint8_t>      targetBuffer;
+    std::vector<EOFragment>   columnFragments;
+    std::vector<EOFragment>   targetFragments;
+    const EOSequence          sequence = {123456u, 1750000000123456LL, 0};
+
+    const size_t   counts[] = {1, 3, 40, 500};
+    const size_t   limits[] = {65507, 1472};
+    const BodyType formats[] = {BodyType::JSON, BodyType::BINARY};
+    for (size_t count : counts)
+    {
+        FillColumns(columns, count, rng);
+        columns.ExpandTo(targets);
+        for (BodyType format : formats)
+        {
+            for (size_t limit : limits)
+            {
+                columnBuffer.resize(
+                    EOProtocolParser::GetMaxEOTargetColumnFragmentsSize(columns, format));
+                targetBuffer.resize(EOProtocolParser::GetMaxEOTargetFragmentsSize(
+                    targets.data(), targets.size(), format));
+                size_t n = EOProtocolParser::PackEOTargetColumnFragments(
+                    columns, 42, format, limit, columnBuffer.data(), columnBuffer.size(),
+                    columnFragments, &sequence);
+                size_t m = EOProtocolParser::PackEOTargetFragments(
+                    targets.data(), targets.size(), 42, format, limit, targetBuffer.data(),
+                    targetBuffer.size(), targetFragments, &sequence);
+                ok &= Expect(n > 0 && n == m, "fragment count", (long)count);
+                for (size_t i = 0; i < n && i < m; ++i)
+                {
+                    const EOFragment &a = columnFragments[i];
+                    const EOFragment &b = targetFragments[i];
+                    ok &= Expect(a.first == b.first && a.count == b.count && a.length <= limit &&
+                                     SameMessage(columnBuffer.data() + a.offset, a.length,
+                                                 targetBuffer.data() + b.offset, b.length,
+                                                 format),
+                                 "column message", (long)(count * 10 + i));
+                }
+            }
+        }
+    }
+
+    // 标签去重与截断
+    ok &= Expect(columns.iden_count() == 5, "iden count", (long)columns.iden_count());
+    EOTargetInfo target;
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        columns.Get(i, target);
+        ok &= Expect(target.tar_iden.size() <= EOIdenString::kCapacity &&
+                         target.source_id == 7 && SameTarget(target, targets[i]),
+                     "expand", (long)i);
+    }
+    columns.Clear();
+    bool accepted = true;
+    for (size_t i = 0; i <= EOTargetColumns::kMaxIdens && accepted; ++i)
+    {
+        const std::string label = "label" + std::to_string(i);
+        accepted = columns.Append(0, 0, 0.5f, 1, label.data(), label.size());
+    }
+    ok &= Expect(!accepted && columns.size() == EOTargetColumns::kMaxIdens, "iden limit",
+                 (long)columns.size());
+    return ok;
+}
+
+// 聚合报文：多帧依次编码，与拼接后的 EOTargetInfo 编码一致，报文头带 src_cnt
+static bool CheckBatchEncoding()
+{
+    bool                      ok = true;
+    std::mt19937              rng(23);
+    EOTargetColumns           frames[3];
+    std::vector<EOTargetInfo> targets;
+    std::vector<EOTargetInfo> expanded;
+    std::vector<uint8_t>      batchBuffer;
+    std::vector<uint8_t>      targetBuffer;
+    std::vector<EOFragment>   batchFragments;
+    std::vector<EOFragment>   targetFragments;
+    const EOSequence          sequence = {99u, 1750000000123456LL, 2};
+
+    FillColumns(frames[0], 3, rng, 1);
+    FillColumns(frames[1], 5, rng, 1);
+    FillColumns(frames[2], 40, rng, 4);
+    const EOTargetColumns *order[] = {&frames[0], &frames[1], &frames[2]};
+    for (const EOTargetColumns &frame : frames)
+    {
+        frame.ExpandTo(expanded);
+        targets.insert(targets.end(), expanded.begin(), expanded.end());
+    }
+
+    const size_t   limits[] = {65507, 1472};
+    const BodyType formats[] = {BodyType::JSON, BodyType::BINARY};
+    for (BodyType format : formats)
+    {
+        for (size_t limit : limits)
+        {
+            batchBuffer.resize(
+                EOProtocolParser::GetMaxEOTargetBatchFragmentsSize(order, 3, format));
+            targetBuffer.resize(EOProtocolParser::GetMaxEOTargetFragmentsSize(
+                targets.data(), targets.size(), format));
+            size_t n = EOProtocolParser::PackEOTargetBatchFragments(
+                order, 3, 42, format, limit, batchBuffer.data(), batchBuffer.size(),
+                batchFragments, &sequence);
+            size_t m = EOProtocolParser::PackEOTargetFragments(
+                targets.data(), targets.size(), 42, format, limit, targetBuffer.data(),
+                targetBuffer.size(), targetFragments, &sequence);
+            ok &= Expect(n > 0 && n == m, "batch fragment count", (long)limit);
+            for (size_t i = 0; i < n && i < m; ++i)
+            {
+                const EOFragment &a = batchFragments[i];
+                const EOFragment &b = targetFragments[i];
+                ok &= Expect(a.first == b.first && a.count == b.count && a.length <= limit &&
+                                 SameMessage(batchBuffer.data() + a.offset, a.length,
+                                             targetBuffer.data() + b.offset, b.length,
+                                             format),
+                             "batch message", (long)i);
+            }
+
+            MessageHeader             header;
+            std::vector<EOTargetInfo> parsed;
+            ok &= Expect(n > 0 &&
+                             EOProtocolParser::ParseEOTargetMessage(
+                                 batchBuffer.data(), batchFragments[0].length, header,
+                                 parsed) &&
+                             header.src_cnt == 2 && header.src_sn == 99 &&
+                             header.send_us == sequence.send_us &&
+                             parsed[0].source_id == 1 &&
+                             (n > 1 || parsed.back().source_id == 4),
+                         "batch header", (long)format);
+        }
+    }
+
+    // 单视频源报文不带 src_cnt
+    const EOSequence single = {5u, 1750000000123456LL, 0};
+    size_t n = EOProtocolParser::PackEOTargetBatchFragments(
+        order, 1, 43, BodyType::JSON, 65507, batchBuffer.data(), batchBuffer.size(),
+        batchFragments, &single);
+    const std::string json(reinterpret_cast<const char *>(batchBuffer.data()),
+                           n > 0 ? batchFragments[0].length : 0);
+    ok &= Expect(n == 1 && json.find("src_cnt") == std::string::npos, "single src_cnt");
+    ok &= Expect(EOProtocolParser::PackEOTargetBatchFragments(
+                     order, 0, 44, BodyType::JSON, 65507, batchBuffer.data(),
+                     batchBuffer.size(), batchFragments, &single) == 0,
+                 "empty batch");
+    return ok;
+}
+
+static bool CheckFilter()
+{
+    bool            ok = true;
+    std::mt19937    rng(3);
+    EOTargetColumns columns;
+    for (size_t count = 0; count < 40; ++count)
+    {
+        FillColumns(columns, count, rng);
+        if (count > 5)
+        {
+            // NaN 置信度总被剔除
+            EOTargetColumns copy = columns;
+            columns.Reset(copy.common());
+            for (size_t i = 0; i < copy.size(); ++i)
+            {
+                const float cfid =
+                    (i == 5) ? std::numeric_limits<float>::quiet_NaN() : copy.tar_cfid()[i];
+                const EOIdenString &iden = copy.iden(copy.iden_index()[i]);
+                columns.Append(copy.tar_rect()[i], copy.tar_category()[i], cfid,
+                               copy.trk_stat()[i], iden.data(), iden.size());
+            }
+        }
+        std::vector<EOTargetInfo> before;
+        std::vector<EOTargetInfo> expected;
+        std::vector<EOTargetInfo> after;
+        columns.ExpandTo(before);
+        for (const EOTargetInfo &t : before)
+        {
+            if (t.tar_cfid >= 0.4f)
+                expected.push_back(t);
+        }
+        size_t removed = columns.FilterByConfidence(0.4f);
+        columns.ExpandTo(after);
+        ok &= Expect(removed == before.size() - expected.size() &&
+                         after.size() == expected.size(),
+                     "filter count", (long)count);
+        for (size_t i = 0; i < after.size() && i < expected.size(); ++i)
+        {
+            ok &= Expect(SameTarget(after[i], expected[i]), "filter order", (long)i);
+        }
+    }
+    FillColumns(columns, 33, rng);
+    ok &= Expect(columns.FilterByConfidence(-1.0f) == 0 && columns.size() == 33,
+                 "filter keeps all");
+    return ok;
+}
+
+static bool CheckPixelStats()
+{
+    bool                  ok = true;
+    std::mt19937          rng(5);
+    std::vector<uint32_t> pixels;
+    for (size_t count = 0; count < 40; ++count)
+    {
+        pixels.resize(count);
+        for (uint32_t &pixel : pixels)
+        {
+            pixel = (rng() % 4 == 0) ? rng() : rng() % 100000;
+        }
+        if (count > 7)
+            pixels[7] = 0xFFFFFFFFu;
+        uint32_t expectedMin = 60000;
+        uint64_t expectedSum = 10;
+        for (uint32_t pixel : pixels)
+        {
+            expectedMin = pixel < expectedMin ? pixel : expectedMin;
+            expectedSum += pixel;
+        }
+        uint32_t minPixel = 60000;
+        uint64_t pixelSum = 10;
+        EOAccumulatePixelStats(pixels.data(), pixels.size(), minPixel, pixelSum);
+        ok &= Expect(minPixel == expectedMin && pixelSum == expectedSum, "pixel stats",
+                     (long)count);
+    }
+    return ok;
+}
+
+// tar_cfid 的格式化结果与 jsoncpp 的 %.17g 规则一致
+static bool CheckFloatFormatting()
+{
+    bool                 ok = true;
+    std::mt19937         rng(11);
+    std::vector<float>   values = {0.0f, -0.0f, 1.0f, 0.5f, 0.1f, 0.95f, 1e-4f, 9.99e-5f,
+                                   123.456f, 8388607.5f, 16777216.0f, 3e10f, -0.75f,
+                                   std::numeric_limits<float>::denorm_min(),
+                                   std::numeric_limits<float>::max(),
+                                   std::numeric_limits<float>::infinity()};
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int i = 0; i < 2000; ++i)
+    {
+        values.push_back(unit(rng));
+        uint32_t bits = static_cast<uint32_t>(rng());
+        float    any;
+        memcpy(&any, &bits, sizeof(any));
+        if (std::isfinite(any))
+            values.push_back(any);
+    }
+
+    EOTargetColumns columns;
+    columns.Reset(EOTargetInfo());
+    for (float value : values)
+    {
+        columns.Append(0, 0, value, 1, "x", 1);
+    }
+    std::vector<uint8_t>    buffer(
+        EOProtocolParser::GetMaxEOTargetColumnFragmentsSize(columns, BodyType::JSON));
+    std::vector<EOFragment> fragments;
+    size_t n = EOProtocolParser::PackEOTargetColumnFragments(
+        columns, 1, BodyType::JSON, 1u << 30, buffer.data(), buffer.size(), fragments);
+    ok &= Expect(n == 1, "single message", (long)n);
+    if (n != 1)
+        return ok;
+
+    const std::string json(reinterpret_cast<const char *>(buffer.data()), fragments[0].length);
+    size_t            pos = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        pos = json.find("\"tar_cfid\":", pos);
+        if (pos == std::string::npos)
+        {
+            ok &= Expect(false, "tar_cfid missing", (long)i);
+            break;
+        }
+        pos += strlen("\"tar_cfid\":");
+        const std::string text = json.substr(pos, json.find(',', pos) - pos);
+
+        char expected[40];
+        if (std::isinf(values[i]))
+        {
+            snprintf(expected, sizeof(expected), "%s", values[i] > 0 ? "1e+9999" : "-1e+9999");
+        }
+        else
+        {
+            snprintf(expected, sizeof(expected), "%.17g", static_cast<double>(values[i]));
+            if (strpbrk(expected, ".e") == nullptr)
+                strcat(expected, ".0");
+        }
+        if (text != expected)
+        {
+            std::cerr << "tar_cfid " << text << " != " << expected << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= CheckEncoding();
+    ok &= CheckBatchEncoding();
+    ok &= CheckFilter();
+    ok &= CheckPixelStats();
+    ok &= CheckFloatFormatting();
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Target columns OK" << std::endl;
+    return 0;
+}
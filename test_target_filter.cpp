@@ -0,0 +1,148 @@
+#include "eo_target_columns.h"
+#include "target_filter.h"
+#include "test_expect.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// 发送前过滤测试：配置解析、逐目标条件（置信度/面积/ROI）与按置信度取前 K 个
+
+static bool CheckParse()
+{
+    bool         ok = true;
+    TargetFilter filter;
+    std::string  error;
+
+    ok &= Expect(!filter.active(), "inactive by default");
+    ok &= Expect(filter.SetClassMinConfidence("0:0.5, 2:0.3", error), "class spec");
+    ok &= Expect(filter.active(), "active after class spec");
+    ok &= Expect(!filter.SetClassMinConfidence("0:0.5,x", error), "bad class spec");
+    ok &= Expect(!filter.SetClassMinConfidence("5000:0.5", error), "class_id range");
+    ok &= Expect(!filter.SetClassMinConfidence("1:nan", error), "nan threshold");
+    // 解析失败时原有覆盖保持不变
+    ok &= Expect(!filter.Accept(0, 0, 0.4f, 0, 0, 10, 10), "override kept");
+    ok &= Expect(filter.SetClassMinConfidence("", error) && !filter.active(),
+                 "cleared overrides");
+
+    ok &= Expect(filter.SetRoi("0:0,0,100,0,100,100;3:1,2,3,4,5,6", error), "roi spec");
+    ok &= Expect(!filter.SetRoi("0:0,0,100,0", error), "too few points");
+    ok &= Expect(!filter.SetRoi("0:0,0,100,0,100", error), "odd coordinates");
+    ok &= Expect(!filter.SetRoi("0:0,0,1,0,1,1 1:0,0,1,0,1,1", error), "missing ';'");
+    ok &= Expect(filter.SetRoi("", error) && !filter.active(), "cleared roi");
+    return ok;
+}
+
+static bool CheckAccept()
+{
+    bool         ok = true;
+    TargetFilter filter;
+    std::string  error;
+
+    filter.SetMinConfidence(0.3f);
+    filter.SetClassMinConfidence("2:0.8", error);
+    filter.SetMinArea(100.0f);
+    ok &= Expect(filter.Accept(0, 0, 0.3f, 0, 0, 10, 10), "default threshold");
+    ok &= Expect(!filter.Accept(0, 0, 0.29f, 0, 0, 10, 10), "below default");
+    ok &= Expect(!filter.Accept(0, 2, 0.5f, 0, 0, 10, 10), "below class threshold");
+    ok &= Expect(filter.Accept(0, 2, 0.9f, 0, 0, 10, 10), "above class threshold");
+    ok &= Expect(!filter.Accept(0, 7, -0.1f, 0, 0, 10, 10), "tracker confidence");
+    ok &= Expect(!filter.Accept(0, 0, 0.9f, 0, 0, 9, 10), "below min area");
+
+    // -1 关闭默认阈值，跟踪器补出的负置信度目标保留
+    filter.SetMinConfidence(-1.0f);
+    ok &= Expect(filter.Accept(0, 7, -0.1f, 0, 0, 10, 10), "no default threshold");
+
+    // 凹多边形（U 形）：缺口处的点在外；source 1 有两个多边形取并集
+    filter.SetMinArea(0.0f);
+    filter.SetClassMinConfidence("", error);
+    ok &= Expect(filter.SetRoi("0:0,0,30,0,30,30,20,30,20,10,10,10,10,30,0,30;"
+                               "1:0,0,10,0,10,10,0,10;1:100,100,110,100,110,110",
+                               error),
+                 "roi");
+    ok &= Expect(filter.Accept(0, 0, 0.5f, 0, 0, 10, 10), "inside left arm");
+    ok &= Expect(filter.Accept(0, 0, 0.5f, 20, 18, 10, 10), "inside right arm");
+    ok &= Expect(!filter.Accept(0, 0, 0.5f, 10, 15, 10, 10), "in the notch");
+    ok &= Expect(!filter.Accept(0, 0, 0.5f, 40, 0, 10, 10), "outside bounds");
+    ok &= Expect(filter.Accept(1, 0, 0.5f, 104, 101, 4, 2), "second polygon");
+    ok &= Expect(!filter.Accept(1, 0, 0.5f, 20, 20, 4, 4), "outside both");
+    ok &= Expect(filter.Accept(2, 0, 0.5f, 500, 500, 4, 4), "source without roi");
+    return ok;
+}
+
+// 参考实现：按置信度稳定排序取前 k 个，恢复原有顺序
+static std::vector<int32_t> ReferenceTop(const std::vector<float> &confidence, size_t k)
+{
+    std::vector<size_t> order(confidence.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&confidence](size_t a, size_t b) {
+        return confidence[a] > confidence[b];
+    });
+    order.resize(std::min(k, order.size()));
+    std::sort(order.begin(), order.end());
+    return std::vector<int32_t>(order.begin(), order.end());
+}
+
+static bool CheckTopK()
+{
+    bool            ok = true;
+    TargetFilter    filter;
+    EOTargetColumns columns;
+    std::mt19937    rng(7);
+
+    for (int round = 0; round < 2000 && ok; ++round)
+    {
+        const size_t count = 2 + rng() % 300;
+        const size_t k = 1 + rng() % (count - 1);
+        // 置信度取值较少时大量并列，覆盖 ties 截断
+        const unsigned levels = (round % 2) ? 5 : 1000;
+
+        std::vector<float> confidence(count);
+        columns.Reset(EOTargetInfo());
+        for (size_t i = 0; i < count; ++i)
+        {
+            confidence[i] = static_cast<float>(rng() % levels) / levels;
+            columns.Append(static_cast<int32_t>(i), 0, confidence[i], 1, "t", 1);
+        }
+
+        size_t      ties = 0;
+        const float threshold =
+            filter.TopConfidence(columns.tar_cfid(), columns.size(), k, ties);
+        const size_t removed = columns.KeepTopConfidence(threshold, ties);
+
+        const std::vector<int32_t> expected = ReferenceTop(confidence, k);
+        ok &= Expect(removed == count - k && columns.size() == k, "kept count",
+                     (long)columns.size());
+        ok &= Expect(std::equal(expected.begin(), expected.end(), columns.tar_rect()),
+                     "kept targets", round);
+    }
+
+    // NaN 视为最低，总是先被剔除
+    const float values[] = {0.5f, NAN, 0.9f, 0.1f, NAN, 0.7f};
+    columns.Reset(EOTargetInfo());
+    for (size_t i = 0; i < 6; ++i)
+        columns.Append(static_cast<int32_t>(i), 0, values[i], 1, "t", 1);
+    size_t      ties = 0;
+    const float threshold = filter.TopConfidence(columns.tar_cfid(), 6, 3, ties);
+    columns.KeepTopConfidence(threshold, ties);
+    ok &= Expect(columns.size() == 3 && columns.tar_rect()[0] == 0 &&
+                     columns.tar_rect()[1] == 2 && columns.tar_rect()[2] == 5,
+                 "nan dropped", (long)columns.size());
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= CheckParse();
+    ok &= CheckAccept();
+    ok &= CheckTopK();
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "Target filter OK" << std::endl;
+    return 0;
+}
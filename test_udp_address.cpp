@@ -0,0 +1,119 @@
+#include "test_expect.h"
+#include "udp_address.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <iostream>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <string>
+#include <unistd.h>
+
+// 地址解析：IPv4 / IPv6、作用域、组播判断、格式化、发送端标识，以及经回环的 IPv4 / IPv6 收发
+
+// 经回环发送一个报文并接收，返回收到的发送端地址族（失败为 -1）
+static int LoopbackRoundTrip(const char *host)
+{
+    UdpAddress  address;
+    std::string error;
+    if (!ParseUdpAddress(host, 0, "", address, error))
+        return -1;
+
+    int receiver = socket(address.family(), SOCK_DGRAM, 0);
+    int sender = socket(address.family(), SOCK_DGRAM, 0);
+    int family = -1;
+    if (receiver >= 0 && sender >= 0 && bind(receiver, address.get(), address.length) == 0)
+    {
+        socklen_t length = address.length;
+        getsockname(receiver, reinterpret_cast<sockaddr *>(&address.storage), &length);
+        const char       message[] = "eo";
+        char             buffer[16];
+        sockaddr_storage from;
+        socklen_t        from_length = sizeof(from);
+        if (sendto(sender, message, sizeof(message), 0, address.get(), address.length) ==
+                static_cast<ssize_t>(sizeof(message)) &&
+            recvfrom(receiver, buffer, sizeof(buffer), 0, reinterpret_cast<sockaddr *>(&from),
+                     &from_length) == static_cast<ssize_t>(sizeof(message)) &&
+            memcmp(buffer, message, sizeof(message)) == 0)
+        {
+            family = from.ss_family;
+        }
+    }
+    if (receiver >= 0)
+        close(receiver);
+    if (sender >= 0)
+        close(sender);
+    return family;
+}
+
+int main()
+{
+    bool        ok = true;
+    UdpAddress  address;
+    std::string error;
+
+    // IPv4
+    ok &= Expect(ParseUdpAddress("239.1.2.3", 5000, "", address, error) &&
+                     address.family() == AF_INET && address.port() == 5000 &&
+                     address.multicast() && address.length == sizeof(sockaddr_in),
+                 "ipv4 multicast");
+    ok &= Expect(FormatUdpAddress(address) == "239.1.2.3:5000", "format ipv4");
+    ok &= Expect(ParseUdpAddress("10.0.0.5", 6000, "", address, error) && !address.multicast(),
+                 "ipv4 unicast");
+    ok &= Expect(!ParseUdpAddress("239.1.2.3%lo", 5000, "", address, error), "ipv4 with scope");
+
+    // IPv6
+    ok &= Expect(ParseUdpAddress("ff15::1234", 5000, "", address, error) &&
+                     address.family() == AF_INET6 && address.multicast() &&
+                     address.scope_id() == 0 && address.length == sizeof(sockaddr_in6),
+                 "ipv6 multicast");
+    address.set_port(5001);
+    ok &= Expect(FormatUdpAddress(address) == "[ff15::1234]:5001", "format ipv6");
+    ok &= Expect(ParseUdpAddress("::1", 5000, "", address, error) && !address.multicast(),
+                 "ipv6 unicast");
+
+    // 作用域：显式 %网卡，或链路本地地址使用 iface；全局地址不受 iface 影响
+    const unsigned lo = if_nametoindex("lo");
+    ok &= Expect(ParseUdpAddress("ff02::1%lo", 5000, "", address, error) &&
+                     address.scope_id() == lo,
+                 "explicit scope", static_cast<int>(address.scope_id()));
+    ok &= Expect(FormatUdpAddress(address) == "[ff02::1%lo]:5000", "format scope");
+    ok &= Expect(ParseUdpAddress("fe80::1", 5000, "lo", address, error) &&
+                     address.scope_id() == lo,
+                 "scope from iface");
+    ok &= Expect(ParseUdpAddress("ff02::1%" + std::to_string(lo), 5000, "", address, error) &&
+                     address.scope_id() == lo,
+                 "numeric scope");
+    ok &= Expect(ParseUdpAddress("ff15::1", 5000, "lo", address, error) &&
+                     address.scope_id() == 0,
+                 "global address unscoped");
+    ok &= Expect(!ParseUdpAddress("ff02::1%nosuchif0", 5000, "", address, error) &&
+                     !ParseUdpAddress("fe80::1", 5000, "nosuchif0", address, error),
+                 "unknown interface");
+    ok &= Expect(!ParseUdpAddress("", 5000, "", address, error) &&
+                     !ParseUdpAddress("ff15::zz", 5000, "", address, error) &&
+                     !ParseUdpAddress("eth0", 5000, "", address, error),
+                 "invalid address");
+
+    // 发送端标识：IPv4 与原有编码一致，IPv6 按地址与端口区分
+    ParseUdpAddress("10.1.2.3", 4000, "", address, error);
+    ok &= Expect(UdpSenderKey(address.get()) == ((0x0A010203ULL << 16) | 4000), "ipv4 key");
+    UdpAddress other;
+    ParseUdpAddress("fd00::2", 4000, "", address, error);
+    ParseUdpAddress("fd00::3", 4000, "", other, error);
+    ok &= Expect(UdpSenderKey(address.get()) != UdpSenderKey(other.get()) &&
+                     (UdpSenderKey(address.get()) & 0xFFFF) == 4000,
+                 "ipv6 key");
+    ParseUdpAddress("fd00::2", 4001, "", other, error);
+    ok &= Expect(UdpSenderKey(address.get()) != UdpSenderKey(other.get()), "ipv6 key port");
+
+    // 回环收发
+    ok &= Expect(LoopbackRoundTrip("127.0.0.1") == AF_INET, "ipv4 loopback");
+    ok &= Expect(LoopbackRoundTrip("::1") == AF_INET6, "ipv6 loopback");
+
+    if (!ok)
+    {
+        return 1;
+    }
+    std::cout << "udp address OK" << std::endl;
+    return 0;
+}
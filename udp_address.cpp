@@ -0,0 +1,145 @@
+#include "udp_address.h"
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <cstring>
+#include <net/if.h>
+#include <netinet/in.h>
+
+namespace
+{
+// 网卡名或十进制索引转为网卡索引，不存在时为 0
+unsigned InterfaceIndex(const std::string &name)
+{
+    char               *end = NULL;
+    const unsigned long index = strtoul(name.c_str(), &end, 10);
+    if (!name.empty() && *end == '\0')
+        return static_cast<unsigned>(index);
+    return if_nametoindex(name.c_str());
+}
+
+bool NeedsScope(const struct in6_addr &address)
+{
+    return IN6_IS_ADDR_LINKLOCAL(&address) || IN6_IS_ADDR_MC_LINKLOCAL(&address) ||
+           IN6_IS_ADDR_MC_NODELOCAL(&address);
+}
+} // namespace
+
+unsigned UdpAddress::port() const
+{
+    if (family() == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6 *>(&storage)->sin6_port);
+    return ntohs(reinterpret_cast<const sockaddr_in *>(&storage)->sin_port);
+}
+
+void UdpAddress::set_port(unsigned port)
+{
+    if (family() == AF_INET6)
+        reinterpret_cast<sockaddr_in6 *>(&storage)->sin6_port = htons(port);
+    else
+        reinterpret_cast<sockaddr_in *>(&storage)->sin_port = htons(port);
+}
+
+bool UdpAddress::multicast() const
+{
+    if (family() == AF_INET6)
+        return IN6_IS_ADDR_MULTICAST(&reinterpret_cast<const sockaddr_in6 *>(&storage)->sin6_addr);
+    return IN_MULTICAST(ntohl(reinterpret_cast<const sockaddr_in *>(&storage)->sin_addr.s_addr));
+}
+
+unsigned UdpAddress::scope_id() const
+{
+    if (family() != AF_INET6)
+        return 0;
+    return reinterpret_cast<const sockaddr_in6 *>(&storage)->sin6_scope_id;
+}
+
+bool ParseUdpAddress(const std::string &host, unsigned port, const std::string &iface,
+                     UdpAddress &address, std::string &error)
+{
+    UdpAddress parsed;
+    memset(&parsed.storage, 0, sizeof(parsed.storage));
+
+    const size_t      percent = host.find('%');
+    const std::string numeric = host.substr(0, percent);
+    sockaddr_in      *in4 = reinterpret_cast<sockaddr_in *>(&parsed.storage);
+    sockaddr_in6     *in6 = reinterpret_cast<sockaddr_in6 *>(&parsed.storage);
+
+    if (percent == std::string::npos && inet_pton(AF_INET, numeric.c_str(), &in4->sin_addr) == 1)
+    {
+        in4->sin_family = AF_INET;
+        in4->sin_port = htons(port);
+        parsed.length = sizeof(sockaddr_in);
+        address = parsed;
+        return true;
+    }
+    if (inet_pton(AF_INET6, numeric.c_str(), &in6->sin6_addr) != 1)
+    {
+        error = "invalid address " + host;
+        return false;
+    }
+    in6->sin6_family = AF_INET6;
+    in6->sin6_port = htons(port);
+    parsed.length = sizeof(sockaddr_in6);
+
+    if (percent != std::string::npos)
+    {
+        const std::string zone = host.substr(percent + 1);
+        in6->sin6_scope_id = InterfaceIndex(zone);
+        if (in6->sin6_scope_id == 0)
+        {
+            error = "unknown interface " + zone + " in " + host;
+            return false;
+        }
+    }
+    else if (NeedsScope(in6->sin6_addr) && !iface.empty())
+    {
+        in6->sin6_scope_id = InterfaceIndex(iface);
+        if (in6->sin6_scope_id == 0)
+        {
+            error = "unknown interface " + iface + " for " + host;
+            return false;
+        }
+    }
+    address = parsed;
+    return true;
+}
+
+std::string FormatUdpAddress(const UdpAddress &address)
+{
+    char text[INET6_ADDRSTRLEN + IF_NAMESIZE + 2] = "";
+    if (address.family() == AF_INET6)
+    {
+        const sockaddr_in6 *in6 = reinterpret_cast<const sockaddr_in6 *>(&address.storage);
+        inet_ntop(AF_INET6, &in6->sin6_addr, text, sizeof(text));
+        std::string out = std::string("[") + text;
+        char        name[IF_NAMESIZE];
+        if (in6->sin6_scope_id != 0)
+        {
+            out += '%';
+            out += if_indextoname(in6->sin6_scope_id, name) != NULL
+                       ? std::string(name)
+                       : std::to_string(in6->sin6_scope_id);
+        }
+        return out + "]:" + std::to_string(address.port());
+    }
+    const sockaddr_in *in4 = reinterpret_cast<const sockaddr_in *>(&address.storage);
+    inet_ntop(AF_INET, &in4->sin_addr, text, sizeof(text));
+    return std::string(text) + ":" + std::to_string(address.port());
+}
+
+uint64_t UdpSenderKey(const struct sockaddr *address)
+{
+    if (address->sa_family == AF_INET6)
+    {
+        const sockaddr_in6 *in6 = reinterpret_cast<const sockaddr_in6 *>(address);
+        uint64_t            hash = 14695981039346656037ULL; // FNV-1a
+        for (size_t i = 0; i < sizeof(in6->sin6_addr.s6_addr); ++i)
+        {
+            hash ^= in6->sin6_addr.s6_addr[i];
+            hash *= 1099511628211ULL;
+        }
+        return ((hash ^ (hash >> 48)) & 0xFFFFFFFFFFFFULL) << 16 | ntohs(in6->sin6_port);
+    }
+    const sockaddr_in *in4 = reinterpret_cast<const sockaddr_in *>(address);
+    return (static_cast<uint64_t>(ntohl(in4->sin_addr.s_addr)) << 16) | ntohs(in4->sin_port);
+}
@@ -0,0 +1,38 @@
+#ifndef UDP_ADDRESS_H
+#define UDP_ADDRESS_H
+
+#include <cstdint>
+#include <string>
+#include <sys/socket.h>
+
+// UDP 目的地址（IPv4 或 IPv6），可直接用于 sendto / bind。
+// 发送端与接收端共用，以便两端对地址与作用域的解析一致。
+struct UdpAddress
+{
+    struct sockaddr_storage storage;
+    socklen_t               length = 0;
+
+    int                    family() const { return storage.ss_family; }
+    const struct sockaddr *get() const
+    {
+        return reinterpret_cast<const struct sockaddr *>(&storage);
+    }
+    unsigned port() const;
+    void     set_port(unsigned port);
+    bool     multicast() const;
+    unsigned scope_id() const; // IPv6 的网卡索引，IPv4 或未限定作用域时为 0
+};
+
+// 解析数字地址：IPv4 "239.1.1.1"，IPv6 "ff15::1"，IPv6 可带作用域 "ff02::1%eth0"。
+// 链路本地 / 接口本地的 IPv6 地址未带作用域时，用 iface（网卡名，可为空）的索引作为 scope_id。
+// 失败时返回 false 并给出原因
+bool ParseUdpAddress(const std::string &host, unsigned port, const std::string &iface,
+                     UdpAddress &address, std::string &error);
+
+// "239.1.1.1:5000"、"[ff02::1%eth0]:5000"
+std::string FormatUdpAddress(const UdpAddress &address);
+
+// 发送端标识：IPv4 为 (地址 << 16) | 端口；IPv6 地址折叠为 48 位后同样拼接端口
+uint64_t UdpSenderKey(const struct sockaddr *address);
+
+#endif // UDP_ADDRESS_H
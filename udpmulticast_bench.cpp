@@ -0,0 +1,746 @@
+#include "bench_nvds_meta.h"
+#include "eo_compression.h"
+#include "eo_delta_codec.h"
+#include "eo_fec.h"
+#include "eo_protocol_parser.h"
+#include "eo_target_columns.h"
+#include "source_heartbeat.h"
+#include "source_rate_limiter.h"
+#include "target_filter.h"
+#include "target_label_map.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <string>
+#include <sys/time.h>
+#include <vector>
+
+// 离线基准：用合成的 NvDs 元数据走插件 render 的逐帧路径
+// （限速 → 遍历目标/二级分类 → 统计 → 过滤 → 标签映射 → 封装报文），
+// 输出 ns/frame、allocations/frame 与 bytes/datagram。不发送网络报文。
+//
+// 用法：udpmulticast_bench [--sources N] [--objects N] [--classifier-depth N]
+//                          [--batches N] [--input-fps N] [--fps N]
+//                          [--format json|binary|delta] [--mtu N]
+//                          [--keyframe-interval N] [--min-area N]
+//                          [--class-min-confidence SPEC] [--max-targets N]
+//                          [--heartbeat-interval MS] [--heartbeat-aggregate 0|1]
+//                          [--aggregate 0|1] [--fec-group-size N] [--fec-parity N]
+//                          [--compression none|lz4|deflate] [--dictionary FILE]
+//                          [--capture FILE]
+//
+// --capture 把压缩前的报文写入抓包文件，供 eo_dict_train 训练字典（写文件计入计时）
+
+namespace
+{
+// 全局分配计数，仅统计测量区间
+size_t g_allocations = 0;
+bool   g_count_allocations = false;
+} // namespace
+
+void *operator new(size_t size)
+{
+    if (g_count_allocations)
+        ++g_allocations;
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+// noinline：避免 GCC 内联后把 malloc/free 与 new/delete 误判为不匹配
+__attribute__((noinline)) void operator delete(void *p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace
+{
+const unsigned kMaxPayload = 65507;
+const unsigned kUdpOverhead = 28; // IPv4 头 + UDP 头
+const unsigned kMaxClasses = 128;
+const char    *kFormatNames[] = {"json", "binary", "delta"};
+
+struct BenchOptions
+{
+    unsigned      sources = 8;
+    unsigned      objects = 20;
+    unsigned      classifier_depth = 1;
+    unsigned      batches = 20000;
+    unsigned      input_fps = 60;
+    unsigned      fps = 25;
+    unsigned      mtu = 1500;
+    unsigned      keyframe_interval = 25;
+    unsigned      min_area = 0;
+    unsigned      max_targets = 0;
+    unsigned      heartbeat_interval = 0; // 毫秒，0 表示每个空帧都发送占位报文
+    bool          heartbeat_aggregate = false;
+    bool          aggregate = false; // 同一批次各视频源合并编码（delta 格式下不生效）
+    unsigned      fec_group_size = 0; // 0 表示不生成 FEC 校验报文
+    unsigned      fec_parity = 1;
+    EOCompression compression = EOCompression::NONE;
+    std::string   dictionary; // 压缩字典文件
+    std::string   capture;    // 抓包文件
+    std::string   class_min_confidence;
+    BodyType      format = BodyType::JSON;
+};
+
+// 合成批次：所有元数据与链表节点一次性分配，测量期间只修改字段值
+struct SyntheticBatch
+{
+    NvDsBatchMeta                   batch;
+    std::vector<NvDsFrameMeta>      frames;
+    std::vector<NvDsObjectMeta>     objects;
+    std::vector<NvDsClassifierMeta> classifiers;
+    std::vector<NvDsLabelInfo>      labels;
+    std::vector<NvDsMetaList>       nodes;
+};
+
+NvDsMetaList *Link(std::vector<NvDsMetaList> &nodes, size_t first, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        nodes[first + i].next = (i + 1 < count) ? &nodes[first + i + 1] : NULL;
+        nodes[first + i].prev = (i > 0) ? &nodes[first + i - 1] : NULL;
+    }
+    return count > 0 ? &nodes[first] : NULL;
+}
+
+void BuildBatch(const BenchOptions &options, SyntheticBatch &synthetic)
+{
+    static const char *kLabels[] = {"person", "无人机", "car", "drone"};
+    const size_t frames = options.sources;
+    const size_t objects = frames * options.objects;
+    const size_t classifiers = objects * options.classifier_depth;
+
+    synthetic.frames.resize(frames);
+    synthetic.objects.resize(objects);
+    synthetic.classifiers.resize(classifiers);
+    synthetic.labels.resize(classifiers);
+    synthetic.nodes.resize(frames + objects + classifiers * 2);
+
+    size_t node = 0;
+    size_t frame_list = node;
+    for (size_t f = 0; f < frames; ++f)
+        synthetic.nodes[node++].data = &synthetic.frames[f];
+    synthetic.batch.frame_meta_list = Link(synthetic.nodes, frame_list, frames);
+
+    for (size_t f = 0; f < frames; ++f)
+    {
+        NvDsFrameMeta &frame = synthetic.frames[f];
+        frame.pad_index = (unsigned)f;
+        frame.frame_num = 0;
+        size_t object_list = node;
+        for (size_t o = 0; o < options.objects; ++o)
+            synthetic.nodes[node++].data =
+                &synthetic.objects[f * options.objects + o];
+        frame.obj_meta_list = Link(synthetic.nodes, object_list, options.objects);
+    }
+
+    for (size_t o = 0; o < objects; ++o)
+    {
+        NvDsObjectMeta &object = synthetic.objects[o];
+        object.class_id = (int)(o % 4);
+        object.confidence = 0.5f + (o % 50) * 0.01f;
+        object.rect_params.left = 10.0f * (o % 100);
+        object.rect_params.top = 5.0f * (o % 80);
+        object.rect_params.width = 16.0f + o % 64;
+        object.rect_params.height = 24.0f + o % 48;
+        snprintf(object.obj_label, sizeof(object.obj_label), "%s",
+                 kLabels[o % 4]);
+
+        size_t classifier_list = node;
+        for (size_t c = 0; c < options.classifier_depth; ++c)
+        {
+            size_t index = o * options.classifier_depth + c;
+            synthetic.nodes[node++].data = &synthetic.classifiers[index];
+        }
+        object.classifier_meta_list =
+            Link(synthetic.nodes, classifier_list, options.classifier_depth);
+    }
+
+    for (size_t c = 0; c < classifiers; ++c)
+    {
+        synthetic.labels[c].result_class_id = (unsigned)(c % 7);
+        synthetic.labels[c].result_prob = 0.9f;
+        synthetic.nodes[node].data = &synthetic.labels[c];
+        synthetic.classifiers[c].label_info_list = Link(synthetic.nodes, node, 1);
+        ++node;
+    }
+}
+
+// 与插件 DetectAnalysis 相同的定长统计
+struct SourceStats
+{
+    unsigned long long frames;
+    unsigned long long objects;
+    uint64_t           pixel_sum;
+    unsigned           primary[kMaxClasses];
+    unsigned           secondary[kMaxClasses];
+    unsigned           overflow;
+    uint32_t           min_pixel;
+};
+
+struct BenchResult
+{
+    unsigned long long frames = 0;
+    unsigned long long datagrams = 0;
+    unsigned long long bytes = 0;
+    size_t             max_bytes = 0;
+    unsigned long long filtered = 0;
+    unsigned long long heartbeats = 0; // 心跳报文数（已计入 datagrams）
+    unsigned long long parities = 0;   // FEC 校验报文数（未计入 datagrams）
+    unsigned long long parity_bytes = 0;
+    unsigned long long raw_bytes = 0;  // 压缩前的报文字节数
+    unsigned long long compressed = 0; // 压缩后发送的报文数
+};
+
+// 与插件相同：目标 / 心跳报文逐个累加 FEC 校验，分组满时编码校验报文
+struct FecBench
+{
+    EOFecEncoder            encoder;
+    std::vector<uint8_t>    buffer;
+    std::vector<EOFragment> parities;
+};
+FecBench g_fec;
+
+// 与插件相同：目标 / 心跳报文先压缩（压缩后更短时），再累加 FEC 校验
+struct CompressionBench
+{
+    EOCompressor compressor;
+    FILE        *capture = NULL;
+};
+CompressionBench g_compression;
+
+// 与插件 max_datagram_size 相同：启用 FEC 时为校验报文的分组信息预留空间
+size_t MaxDatagram(const BenchOptions &options)
+{
+    size_t max_datagram = std::min(options.mtu - kUdpOverhead, kMaxPayload);
+    if (g_fec.encoder.enabled())
+        max_datagram -= std::min(g_fec.encoder.overhead(), max_datagram / 2);
+    return max_datagram;
+}
+
+// 聚合发送：本批次暂存的帧，批次末按 source_id 排序后合并编码
+struct AggregateBatch
+{
+    std::vector<EOTargetColumns>         frames;
+    size_t                               count = 0;
+    std::vector<const EOTargetColumns *> order;
+    uint32_t                             batch_sn = 0;
+};
+
+void FillTimestamp(EOTargetInfo &target, const struct timeval &tv)
+{
+    struct tm tm_info;
+    localtime_r(&tv.tv_sec, &tm_info);
+    target.yr = tm_info.tm_year + 1900;
+    target.mo = tm_info.tm_mon + 1;
+    target.dy = tm_info.tm_mday;
+    target.h = tm_info.tm_hour;
+    target.min = tm_info.tm_min;
+    target.sec = tm_info.tm_sec;
+    target.msec = tv.tv_usec / 1000.0f;
+}
+
+void CountDatagram(BenchResult &result, const uint8_t *data, size_t length)
+{
+    if (g_compression.capture != NULL)
+        EOAppendCaptureRecord(g_compression.capture, data, length);
+    result.raw_bytes += length;
+    const size_t compressed = g_compression.compressor.Compress(data, length);
+    if (compressed > 0)
+    {
+        ++result.compressed;
+        data = g_compression.compressor.output();
+        length = compressed;
+    }
+    ++result.datagrams;
+    result.bytes += length;
+    if (length > result.max_bytes)
+        result.max_bytes = length;
+    if (g_fec.encoder.Add(data, length, 0))
+    {
+        const size_t count = g_fec.encoder.Finish(g_fec.buffer, 0, g_fec.parities);
+        for (size_t i = 0; i < count; ++i)
+        {
+            ++result.parities;
+            result.parity_bytes += g_fec.parities[i].length;
+        }
+    }
+}
+
+// 编码一个心跳报文（json 格式为 JSON 心跳，其余为二进制）
+void PackHeartbeat(const BenchOptions &options, const std::vector<uint32_t> &source_ids,
+                   std::vector<EOHeartbeat> &heartbeats, std::vector<uint8_t> &buffer,
+                   BenchResult &result)
+{
+    const BodyType format =
+        (options.format == BodyType::JSON) ? BodyType::JSON : BodyType::BINARY;
+    heartbeats.resize(source_ids.size());
+    for (size_t i = 0; i < source_ids.size(); ++i)
+    {
+        heartbeats[i].source_id = source_ids[i];
+        heartbeats[i].src_sn = 0;
+    }
+    const size_t capacity =
+        EOProtocolParser::GetMaxEOHeartbeatMessageSize(heartbeats.size(), format);
+    if (buffer.size() < capacity)
+        buffer.resize(capacity);
+    size_t length = EOProtocolParser::PackEOHeartbeatMessage(
+        heartbeats.data(), heartbeats.size(), format, 0, buffer.data(), capacity);
+    if (length > 0)
+    {
+        CountDatagram(result, buffer.data(), length);
+        ++result.heartbeats;
+    }
+}
+
+// 与插件 send_batch_message 相同：按 source_id 稳定排序后合并编码
+void PackAggregate(const BenchOptions &options, AggregateBatch &aggregate,
+                   uint16_t &send_count, std::vector<uint8_t> &buffer,
+                   std::vector<EOFragment> &fragments, BenchResult &result)
+{
+    const size_t frame_count = aggregate.count;
+    if (frame_count == 0)
+        return;
+    aggregate.count = 0;
+
+    aggregate.order.resize(frame_count);
+    for (size_t i = 0; i < frame_count; ++i)
+        aggregate.order[i] = &aggregate.frames[i];
+    // 指针即暂存顺序：同一视频源按指针比较等价于稳定排序，且不申请临时缓冲
+    std::sort(aggregate.order.begin(), aggregate.order.end(),
+              [](const EOTargetColumns *a, const EOTargetColumns *b) {
+                  return a->common().source_id != b->common().source_id
+                             ? a->common().source_id < b->common().source_id
+                             : a < b;
+              });
+    int sources = 0;
+    for (size_t i = 0; i < frame_count; ++i)
+    {
+        if (i == 0 || aggregate.order[i]->common().source_id !=
+                          aggregate.order[i - 1]->common().source_id)
+            ++sources;
+    }
+
+    const size_t max_datagram = MaxDatagram(options);
+    const size_t capacity = EOProtocolParser::GetMaxEOTargetBatchFragmentsSize(
+        aggregate.order.data(), frame_count, options.format);
+    if (buffer.size() < capacity)
+        buffer.resize(capacity);
+    const EOSequence sequence = {++aggregate.batch_sn, 0, sources};
+    size_t           count = EOProtocolParser::PackEOTargetBatchFragments(
+        aggregate.order.data(), frame_count, ++send_count, options.format, max_datagram,
+        buffer.data(), capacity, fragments, &sequence);
+    for (size_t i = 0; i < count; ++i)
+    {
+        CountDatagram(result, buffer.data() + fragments[i].offset, fragments[i].length);
+    }
+}
+
+// 插件 render 中单个批次的处理
+void ProcessBatch(const BenchOptions &options, NvDsBatchMeta *batch_meta,
+                  int64_t now_ns, SourceRateLimiter &limiter,
+                  SourceHeartbeat &heartbeat, std::vector<uint32_t> &heartbeat_ids,
+                  std::vector<EOHeartbeat> &heartbeats, TargetFilter &filter,
+                  TargetLabelMap &label_map, std::vector<SourceStats> &stats,
+                  EOTargetColumns &columns, std::vector<EOTargetInfo> &target_infos,
+                  std::vector<uint32_t> &pixels, uint16_t &send_count,
+                  EODeltaEncoder &delta_encoder, std::vector<uint8_t> &buffer,
+                  std::vector<EOFragment> &fragments, AggregateBatch &aggregate,
+                  BenchResult &result)
+{
+    struct timeval batch_time = {0, 0};
+    EOTargetInfo   stamp = {};
+    bool           have_time = false;
+
+    for (NvDsMetaList *l_frame = batch_meta->frame_meta_list; l_frame != NULL;
+         l_frame = l_frame->next)
+    {
+        NvDsFrameMeta *frame_meta = (NvDsFrameMeta *)l_frame->data;
+        unsigned       source_id = frame_meta->pad_index;
+        SourceStats   &source_stats = stats[source_id];
+        bool should_send = limiter.ShouldSend(source_id, now_ns, options.fps);
+
+        ++result.frames;
+        ++source_stats.frames;
+        if (should_send)
+        {
+            if (!have_time)
+            {
+                gettimeofday(&batch_time, NULL);
+                FillTimestamp(stamp, batch_time);
+                have_time = true;
+            }
+            stamp.source_id = (int)source_id;
+            columns.Reset(stamp);
+        }
+        pixels.clear();
+
+        for (NvDsMetaList *l_obj = frame_meta->obj_meta_list; l_obj != NULL;
+             l_obj = l_obj->next)
+        {
+            NvDsObjectMeta *obj_meta = (NvDsObjectMeta *)l_obj->data;
+            if (obj_meta->class_id < 0)
+                continue;
+
+            float final_confidence = obj_meta->confidence;
+            bool  has_classifier = false;
+            for (NvDsMetaList *l_class = obj_meta->classifier_meta_list;
+                 l_class != NULL; l_class = l_class->next)
+            {
+                NvDsClassifierMeta *cmeta = (NvDsClassifierMeta *)l_class->data;
+                for (NvDsMetaList *l_label = cmeta->label_info_list;
+                     l_label != NULL; l_label = l_label->next)
+                {
+                    NvDsLabelInfo *label = (NvDsLabelInfo *)l_label->data;
+                    if (label->result_class_id < kMaxClasses)
+                        source_stats.secondary[label->result_class_id]++;
+                    else
+                        source_stats.overflow++;
+                    if (!has_classifier)
+                    {
+                        final_confidence = label->result_prob;
+                        has_classifier = true;
+                    }
+                }
+            }
+
+            if ((unsigned)obj_meta->class_id < kMaxClasses)
+                source_stats.primary[obj_meta->class_id]++;
+            else
+                source_stats.overflow++;
+            pixels.push_back((uint32_t)(obj_meta->rect_params.width *
+                                        obj_meta->rect_params.height));
+
+            if (!should_send)
+                continue;
+            if (filter.active() &&
+                !filter.Accept(source_id, obj_meta->class_id, final_confidence,
+                               obj_meta->rect_params.left, obj_meta->rect_params.top,
+                               obj_meta->rect_params.width,
+                               obj_meta->rect_params.height))
+            {
+                ++result.filtered;
+                continue;
+            }
+
+            const TargetLabelEntry &entry =
+                label_map.Lookup(obj_meta->class_id, obj_meta->obj_label);
+            columns.Append((int)(obj_meta->rect_params.left +
+                                 obj_meta->rect_params.width / 2),
+                           entry.tar_category, final_confidence,
+                           (final_confidence < 0.0f) ? 2 : 1, entry.tar_iden.data(),
+                           entry.tar_iden.size());
+        }
+
+        EOAccumulatePixelStats(pixels.data(), pixels.size(), source_stats.min_pixel,
+                               source_stats.pixel_sum);
+        source_stats.objects += pixels.size();
+
+        if (!should_send)
+            continue;
+        if (filter.max_targets() > 0 && columns.size() > filter.max_targets())
+        {
+            size_t ties = 0;
+            float  threshold = filter.TopConfidence(columns.tar_cfid(), columns.size(),
+                                                    filter.max_targets(), ties);
+            result.filtered += columns.KeepTopConfidence(threshold, ties);
+        }
+        // 与插件相同：持续空闲的视频源只发送心跳
+        const SourceHeartbeat::Action action =
+            heartbeat.OnFrame(source_id, !columns.empty(), now_ns);
+        if (action == SourceHeartbeat::Action::HEARTBEAT)
+        {
+            heartbeat_ids.assign(1, source_id);
+            PackHeartbeat(options, heartbeat_ids, heartbeats, buffer, result);
+        }
+        if (action != SourceHeartbeat::Action::REPORT)
+            continue;
+        if (columns.empty())
+        {
+            columns.Append(0, 0, 0.0f, 0, "none", 4);
+        }
+        if (options.aggregate && options.format != BodyType::DELTA)
+        {
+            if (aggregate.count == aggregate.frames.size())
+                aggregate.frames.emplace_back();
+            std::swap(columns, aggregate.frames[aggregate.count++]);
+            continue;
+        }
+
+        // 与插件相同：超过 mtu - 28 字节时按目标拆分，delta 格式优先发送差分帧
+        const bool     delta = (options.format == BodyType::DELTA);
+        const BodyType format = delta ? BodyType::BINARY : options.format;
+        const size_t   max_datagram = MaxDatagram(options);
+        const size_t   capacity =
+            EOProtocolParser::GetMaxEOTargetColumnFragmentsSize(columns, format);
+        if (buffer.size() < capacity)
+            buffer.resize(capacity);
+        ++send_count;
+        size_t count = 0;
+        if (delta)
+        {
+            columns.ExpandTo(target_infos);
+            size_t size = delta_encoder.PackDelta(
+                source_id, target_infos.data(), target_infos.size(), send_count,
+                buffer.data(), std::min(capacity, max_datagram));
+            if (size > 0)
+            {
+                EOFragment fragment = {0, size, 0, target_infos.size()};
+                fragments.assign(1, fragment);
+                count = 1;
+            }
+            if (count == 0)
+            {
+                count = EOProtocolParser::PackEOTargetFragments(
+                    target_infos.data(), target_infos.size(), send_count, format,
+                    max_datagram, buffer.data(), capacity, fragments);
+                if (count > 0)
+                    delta_encoder.CommitKeyframe(source_id, target_infos.data(),
+                                                 target_infos.size(), send_count);
+            }
+        }
+        else
+        {
+            count = EOProtocolParser::PackEOTargetColumnFragments(
+                columns, send_count, format, max_datagram, buffer.data(), capacity,
+                fragments);
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            CountDatagram(result, buffer.data() + fragments[i].offset, fragments[i].length);
+        }
+    }
+
+    PackAggregate(options, aggregate, send_count, buffer, fragments, result);
+    if (heartbeat.CollectDue(now_ns, heartbeat_ids))
+    {
+        PackHeartbeat(options, heartbeat_ids, heartbeats, buffer, result);
+    }
+}
+
+bool ParseOptions(int argc, char **argv, BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+            return false;
+        std::string value = argv[++i];
+        if (arg == "--format")
+        {
+            if (value == "json")
+                options.format = BodyType::JSON;
+            else if (value == "binary")
+                options.format = BodyType::BINARY;
+            else if (value == "delta")
+                options.format = BodyType::DELTA;
+            else
+                return false;
+            continue;
+        }
+        if (arg == "--compression")
+        {
+            if (value == "none")
+                options.compression = EOCompression::NONE;
+            else if (value == "lz4")
+                options.compression = EOCompression::LZ4;
+            else if (value == "deflate")
+                options.compression = EOCompression::DEFLATE;
+            else
+                return false;
+            continue;
+        }
+        if (arg == "--dictionary" || arg == "--capture")
+        {
+            (arg == "--dictionary" ? options.dictionary : options.capture) = value;
+            continue;
+        }
+        if (arg == "--class-min-confidence")
+        {
+            options.class_min_confidence = value;
+            continue;
+        }
+        unsigned long number = strtoul(value.c_str(), NULL, 10);
+        if (arg == "--sources" && number >= 1 && number <= 1024)
+            options.sources = (unsigned)number;
+        else if (arg == "--objects" && number <= 1000)
+            options.objects = (unsigned)number;
+        else if (arg == "--classifier-depth" && number <= 16)
+            options.classifier_depth = (unsigned)number;
+        else if (arg == "--batches" && number >= 1)
+            options.batches = (unsigned)number;
+        else if (arg == "--input-fps" && number >= 1 && number <= 1000)
+            options.input_fps = (unsigned)number;
+        else if (arg == "--fps" && number <= 1000)
+            options.fps = (unsigned)number;
+        else if (arg == "--mtu" && number >= 576 && number <= 65535)
+            options.mtu = (unsigned)number;
+        else if (arg == "--keyframe-interval" && number <= 10000)
+            options.keyframe_interval = (unsigned)number;
+        else if (arg == "--min-area")
+            options.min_area = (unsigned)number;
+        else if (arg == "--max-targets" && number <= 65535)
+            options.max_targets = (unsigned)number;
+        else if (arg == "--heartbeat-interval" && number <= 3600000)
+            options.heartbeat_interval = (unsigned)number;
+        else if (arg == "--heartbeat-aggregate" && number <= 1)
+            options.heartbeat_aggregate = (number == 1);
+        else if (arg == "--aggregate" && number <= 1)
+            options.aggregate = (number == 1);
+        else if (arg == "--fec-group-size" && number <= EOFecEncoder::kMaxGroupSize)
+            options.fec_group_size = (unsigned)number;
+        else if (arg == "--fec-parity" && number >= 1 && number <= EOFecEncoder::kMaxParity)
+            options.fec_parity = (unsigned)number;
+        else
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr,
+                "usage: %s [--sources N] [--objects N] [--classifier-depth N] "
+                "[--batches N] [--input-fps N] [--fps N] [--format json|binary|delta] "
+                "[--mtu N] [--keyframe-interval N] [--min-area N] "
+                "[--class-min-confidence SPEC] [--max-targets N] "
+                "[--heartbeat-interval MS] [--heartbeat-aggregate 0|1] "
+                "[--aggregate 0|1] [--fec-group-size N] [--fec-parity N] "
+                "[--compression none|lz4|deflate] [--dictionary FILE] [--capture FILE]\n",
+                argv[0]);
+        return 2;
+    }
+
+    SyntheticBatch synthetic;
+    BuildBatch(options, synthetic);
+
+    SourceRateLimiter         limiter;
+    SourceHeartbeat           heartbeat;
+    std::vector<uint32_t>     heartbeat_ids;
+    std::vector<EOHeartbeat>  heartbeats;
+    TargetFilter              filter;
+    TargetLabelMap            label_map;
+    std::vector<SourceStats>  stats(options.sources);
+    EOTargetColumns           columns;
+    std::vector<EOTargetInfo> target_infos;
+    std::vector<uint32_t>     pixels;
+    std::vector<uint8_t>      buffer(kMaxPayload);
+    std::vector<EOFragment>   fragments;
+    EODeltaEncoder            delta_encoder(options.keyframe_interval);
+    uint16_t                  send_count = 0;
+    AggregateBatch            aggregate;
+    BenchResult               result;
+    const int64_t             batch_interval_ns = 1000000000LL / options.input_fps;
+
+    heartbeat.Configure((int64_t)options.heartbeat_interval * 1000000,
+                        options.heartbeat_aggregate);
+    g_fec.encoder.Configure(options.fec_group_size, options.fec_parity);
+
+    std::vector<uint8_t> dictionary;
+    std::string          compression_error;
+    if (!options.dictionary.empty() &&
+        !EOLoadDictionaryFile(options.dictionary.c_str(), dictionary, compression_error))
+    {
+        fprintf(stderr, "invalid --dictionary: %s\n", compression_error.c_str());
+        return 2;
+    }
+    g_compression.compressor.Configure(options.compression, dictionary, compression_error);
+    if (!options.capture.empty() &&
+        (g_compression.capture = fopen(options.capture.c_str(), "wb")) == NULL)
+    {
+        fprintf(stderr, "cannot open --capture %s\n", options.capture.c_str());
+        return 2;
+    }
+
+    std::string filter_error;
+    filter.SetMinArea((float)options.min_area);
+    filter.SetMaxTargets(options.max_targets);
+    if (!filter.SetClassMinConfidence(options.class_min_confidence, filter_error))
+    {
+        fprintf(stderr, "invalid --class-min-confidence: %s\n", filter_error.c_str());
+        return 2;
+    }
+
+    for (SourceStats &source_stats : stats)
+    {
+        memset(&source_stats, 0, sizeof(source_stats));
+        source_stats.min_pixel = 0xffffffffu;
+    }
+
+    // 预热：填满复用容器、驻留标签
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        ProcessBatch(options, &synthetic.batch, i * batch_interval_ns, limiter,
+                     heartbeat, heartbeat_ids, heartbeats, filter, label_map, stats,
+                     columns, target_infos, pixels, send_count, delta_encoder, buffer,
+                     fragments, aggregate, result);
+    }
+    result = BenchResult();
+
+    const int64_t start_ns = 100 * batch_interval_ns;
+    g_count_allocations = true;
+    auto begin = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < options.batches; ++i)
+    {
+        for (NvDsFrameMeta &frame : synthetic.frames)
+            ++frame.frame_num;
+        // 目标逐帧平移，模拟稳定跟踪场景
+        for (NvDsObjectMeta &object : synthetic.objects)
+            object.rect_params.left =
+                (object.rect_params.left < 1900.0f) ? object.rect_params.left + 1.0f : 0.0f;
+        ProcessBatch(options, &synthetic.batch,
+                     start_ns + (int64_t)i * batch_interval_ns, limiter,
+                     heartbeat, heartbeat_ids, heartbeats, filter, label_map, stats,
+                     columns, target_infos, pixels, send_count, delta_encoder, buffer,
+                     fragments, aggregate, result);
+    }
+    auto end = std::chrono::steady_clock::now();
+    g_count_allocations = false;
+    if (g_compression.capture != NULL)
+        fclose(g_compression.capture);
+
+    double elapsed_ns =
+        std::chrono::duration<double, std::nano>(end - begin).count();
+    printf("sources=%u objects=%u classifier-depth=%u format=%s input-fps=%u "
+           "fps=%u mtu=%u keyframe-interval=%u batches=%u aggregate=%d fec=%u/%u\n",
+           options.sources, options.objects, options.classifier_depth,
+           kFormatNames[static_cast<int>(options.format)], options.input_fps,
+           options.fps, options.mtu, options.keyframe_interval, options.batches,
+           options.aggregate ? 1 : 0, options.fec_parity, options.fec_group_size);
+    printf("ns/frame:          %.1f\n", elapsed_ns / result.frames);
+    printf("allocations/frame: %.3f\n", (double)g_allocations / result.frames);
+    printf("datagrams:         %llu (%.2f per frame)\n", result.datagrams,
+           (double)result.datagrams / result.frames);
+    printf("bytes/datagram:    %.1f (max %zu)\n",
+           result.datagrams ? (double)result.bytes / result.datagrams : 0.0,
+           result.max_bytes);
+    printf("filtered/frame:    %.2f\n", (double)result.filtered / result.frames);
+    printf("heartbeats:        %llu\n", result.heartbeats);
+    if (g_fec.encoder.enabled())
+    {
+        printf("fec parities:      %llu (%.1f%% of data bytes)\n", result.parities,
+               result.bytes ? 100.0 * result.parity_bytes / result.bytes : 0.0);
+    }
+    if (g_compression.compressor.codec() != EOCompression::NONE)
+    {
+        printf("compression:       %.3f of %.1f raw bytes/datagram (%.1f%% compressed, "
+               "dictionary %zu bytes)\n",
+               result.raw_bytes ? (double)result.bytes / result.raw_bytes : 0.0,
+               result.datagrams ? (double)result.raw_bytes / result.datagrams : 0.0,
+               result.datagrams ? 100.0 * result.compressed / result.datagrams : 0.0,
+               dictionary.size());
+    }
+    return 0;
+}